@@ -274,6 +274,19 @@ namespace ImmersiveAudioBitstream
         kIABNoAssetFound            = 0x2
     };
 
+    /**
+     * @enum IABDLCEncodeEffortType
+     *
+     * @brief Enumerate DLC encoding effort levels. Higher levels produce smaller DLC payloads, at the cost of encoding time.
+     *
+     */
+    enum IABDLCEncodeEffortType
+    {
+        kIABDLCEncodeEffort_Minimal		= 0x0,			/**< PCM residuals, no predictors. Default. */
+        kIABDLCEncodeEffort_Fast		= 0x1,			/**< One predictor region, order and residual coding estimated from signal statistics */
+        kIABDLCEncodeEffort_Thorough	= 0x2			/**< Predictor region splits, orders and Rice parameters searched on exact bit costs */
+    };
+
     /**
      * @enum IABFrameRateType
 	 *
@@ -39,6 +39,7 @@
 #define	__IABELEMENTSAPI_H__
 
 #include <ostream>
+#include <set>
 
 #include "IABDataTypes.h"
 
@@ -407,6 +408,58 @@ namespace ImmersiveAudioBitstream
          */
 
 		virtual bool GetDeSerializeFailsOnVersionError() const = 0;
+
+		/**
+		 * Set element types to be skipped during DeSerialization.
+		 *
+		 * Elements of the listed types are bypassed using their element size field, instead
+		 * of being parsed and materialized. This applies to frame sub-elements as well as to
+		 * sub-elements of beds and objects, eg. kIABElementID_UserData, kIABElementID_AuthoringToolInfo
+		 * and kIABElementID_ObjectZoneDefinition19 can be skipped for a playback-only path.
+		 *
+		 * Skipped elements are not counted as unallowed or undefined, and are not included
+		 * in the sub-element count of their parent after DeSerialize(). Element types that are
+		 * not allowed at a given level are reported as unallowed regardless of this setting.
+		 *
+		 * Default is an empty set, ie. all elements are parsed.
+		 *
+		 * @memberof IABFrameInterface
+		 *
+		 * @param[in] iElementIDs set of element IDs to skip.
+		 */
+		virtual void SetDeSerializeSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs) = 0;
+
+		/**
+		 * Get element types to be skipped during DeSerialization.
+		 *
+		 * @memberof IABFrameInterface
+		 *
+		 * @param[out] oElementIDs set of element IDs to skip.
+		 */
+		virtual void GetDeSerializeSkippedElementIDs(std::set<IABElementIDType> &oElementIDs) const = 0;
+
+		/**
+		 * Set whether the 96kHz extension layer of DLC elements is skipped during DeSerialization.
+		 *
+		 * When set, the 96kHz predictor regions and residuals of IABAudioDataDLC sub-elements are
+		 * bypassed instead of being decoded and stored. Such DLC elements can only be decoded to 48kHz.
+		 *
+		 * Default is false, ie. both DLC layers are parsed.
+		 *
+		 * @memberof IABFrameInterface
+		 *
+		 * @param[in] iSkip96kLayer true to skip the 96kHz DLC layer.
+		 */
+		virtual void SetDeSerializeSkipsDLC96kLayer(bool iSkip96kLayer) = 0;
+
+		/**
+		 * Get whether the 96kHz extension layer of DLC elements is skipped during DeSerialization.
+		 *
+		 * @memberof IABFrameInterface
+		 *
+		 * @return true if the 96kHz DLC layer is skipped.
+		 */
+		virtual bool GetDeSerializeSkipsDLC96kLayer() const = 0;
         
 		/**
 		* Get number of known but unallowed frame sub-elements.
@@ -2044,6 +2097,34 @@ namespace ImmersiveAudioBitstream
 		virtual bool IsIncludedForPacking() = 0;
 	};
 
+	/**
+	 * @brief Decoded samples of DLC elements of a frame, as returned by IABAudioDataDLCInterface::DecodeAllDLC().
+	 *
+	 * Samples are stored in one contiguous planar block, one plane of sampleCount_ samples per decoded element,
+	 * as IABSampleType scaled to the 32-bit signed integer range, the format used by the renderer's working
+	 * sample buffers. Planes can be used in place.
+	 *
+	 */
+	struct IABDLCFrameSamples
+	{
+		IABDLCFrameSamples() : sampleCount_(0) {}
+
+		/// Returns the plane of the element with audio data ID iAudioDataID, or nullptr if it was not decoded
+		const IABSampleType* GetSamples(IABAudioDataIDType iAudioDataID) const;
+
+		/// Planar samples, plane n belongs to the element with audio data ID audioDataIDs_[n]
+		std::vector<IABSampleType> samples_;
+
+		/// Audio data ID of each plane
+		std::vector<IABAudioDataIDType> audioDataIDs_;
+
+		/// Number of samples per plane
+		uint32_t sampleCount_;
+
+		/// Integer working buffer for one batch of planes, reused across frames
+		std::vector<int32_t> batchSamples_;
+	};
+
 	/**
      * @brief IABAudioDataDLCInterface
      *
@@ -2076,6 +2157,32 @@ namespace ImmersiveAudioBitstream
          */
         static void Delete(IABAudioDataDLCInterface* iInstance);
 
+        /**
+         * Decodes the DLC elements of a frame, selected by audio data ID, into one planar block of
+         * IABSampleType samples. This is the frame-level counterpart of DecodeDLCToMonoPCM(): elements
+         * sharing a block length are decoded in batches, which is faster than decoding them one by one.
+         *
+         * Elements that fail to decode get no plane; their samples can still be decoded, and their error
+         * reported, by DecodeDLCToMonoPCM().
+         *
+         * @memberof IABAudioDataDLCInterface
+         *
+         * @param[in] iFrame frame holding the DLC elements, such as a parsed frame.
+         * @param[in] iAudioDataIDs audio data IDs of the elements to decode, for example those referenced by
+         *            the beds and objects activated for rendering. Other elements are skipped.
+         * @param[out] oSamples decoded samples. Buffers are reused when oSamples is passed again for the next frame.
+         * @param[in] iDecodeSampleRate sample rate of the decoded samples, kIABSampleRate_48000Hz or
+         *            kIABSampleRate_96000Hz. 96k decoding requires a 96k frame; 48k decoding of a 96k frame
+         *            down samples by 2.
+         *
+         * @returns \link kIABNoError \endlink if no errors. Other values indicate an error; the last error
+         *          encountered is returned.
+         */
+        static iabError DecodeAllDLC(const IABFrameInterface& iFrame
+            , const std::set<IABAudioDataIDType>& iAudioDataIDs
+            , IABDLCFrameSamples& oSamples
+            , IABSampleRateType iDecodeSampleRate);
+
         /// Destructor.
         virtual ~IABAudioDataDLCInterface() {}
 
@@ -2191,6 +2298,27 @@ namespace ImmersiveAudioBitstream
 		*/
 		virtual iabError EncodeMonoPCMToDLC(const int32_t* iSamples, uint32_t iSampleCount) = 0;
 
+		/**
+		* Gets the effort level used by EncodeMonoPCMToDLC().
+		*
+		* @memberof IABAudioDataDLCInterface
+		*
+		* @param[out] oEncodeEffort DLC encoding effort level
+		*/
+		virtual void GetDLCEncodeEffort(IABDLCEncodeEffortType &oEncodeEffort) const = 0;
+
+		/**
+		* Sets the effort level used by EncodeMonoPCMToDLC(). Higher levels use predictors and Rice/Golomb
+		* residuals for smaller DLC payloads, at the cost of encoding time. Default is kIABDLCEncodeEffort_Minimal.
+		*
+		* @memberof IABAudioDataDLCInterface
+		*
+		* @param[in] iEncodeEffort DLC encoding effort level
+		*
+		* @returns \link kIABNoError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError SetDLCEncodeEffort(IABDLCEncodeEffortType iEncodeEffort) = 0;
+
 		/**
 		* Decode (from internal DLC data) to a block of 24-bit PCM samples (as 3 MSBs of 32-bit int32_t).
 		* This function is intended to be used during DLC decoding process, such as
@@ -116,6 +116,7 @@ namespace ImmersiveAudioBitstream {
         kIABParserInvalidFrameRateError       = 2028,           /**< Parsing error: Found an invalid frame rate. Fatal. */
         kIABParserInvalidBitDepthError        = 2029,           /**< Parsing error: Found an invalid bit depth. Fatal. */
         kIABParserFrameRateNotImplementedError = 2030,          /**< Parsing error: Support for this frame rate is not implmented. Fatal. */
+        kIABParserFrameIndexError             = 2031,           /**< Parsing error: Unable to build, load or use the frame index of the bitstream. */
         
 		kIABRendererGeneralError              = 3000,           /**< IAB renderer general error. Fatal. Start of a block of errors used by IAB bitstream renderer only. */
         kIABRendererNotInitialisedError       = 3001,           /**< IAB renderer error. Fatal. IAB Renderer has not been fully initialised. */
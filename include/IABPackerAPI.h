@@ -37,6 +37,7 @@
 #define	__IABPACKERAPI_H__
 
 #include <memory>
+#include <ostream>
 
 #include "IABDataTypes.h"
 
@@ -282,7 +283,39 @@ namespace ImmersiveAudioBitstream
 		* @return \link iabError \endlink if no errors. Other values indicate an error.
 		*/
 		virtual iabError UpdateAudioSamples(std::map<IABAudioDataIDType, int32_t*> iAudioSources) = 0;
-        
+
+		/**
+		* Set the number of threads used by UpdateAudioSamples() to encode the IABAudioDataDLC
+		* elements of a frame.
+		*
+		* @note Elements are encoded independently, each on one thread. With a thread pool size
+		* of 1 (default), encoding runs on the calling thread. Multi-threaded encoding is
+		* available on Linux and macOS; on other platforms encoding always runs on the calling thread.
+		*
+		* @memberof IABPackerInterface
+		*
+		* @param[in] iThreadPoolSize number of encoding threads, including the calling thread.
+		*            Clamped to the range [1, 16].
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError SetDLCEncodeThreadPoolSize(uint32_t iThreadPoolSize) = 0;
+
+		/**
+		* Set the DLC encoding effort level of the IABAudioDataDLC elements of the internal IABFrame,
+		* and of those added later by AddDLCElements().
+		*
+		* @note Higher levels produce smaller DLC payloads, at the cost of encoding time.
+		* Default is kIABDLCEncodeEffort_Minimal.
+		*
+		* @memberof IABPackerInterface
+		*
+		* @param[in] iEncodeEffort DLC encoding effort level
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError SetDLCEncodeEffort(IABDLCEncodeEffortType iEncodeEffort) = 0;
+
 		/**
 		* Update meta data of an object element.
 		*
@@ -354,6 +387,143 @@ namespace ImmersiveAudioBitstream
         virtual iabError AddUserData(const uint8_t(&iUserID)[16], const std::vector<uint8_t> iUserDataBytes) = 0;
 
     };
+
+#ifdef MT_RENDERER_ENABLED
+
+	/**
+	*
+	* Source of frame content for IABPackerPipelineInterface. Must be implemented by the client.
+	*
+	* @class IABPackerPipelineSourceInterface
+	*/
+
+	class IABPackerPipelineSourceInterface
+	{
+	public:
+
+		/// Destructor
+		virtual ~IABPackerPipelineSourceInterface() {}
+
+		/**
+		* Reads the audio samples of a frame, for example from stem files. Called on the read
+		* stage thread, in frame order, ahead of packing.
+		*
+		* @memberof IABPackerPipelineSourceInterface
+		*
+		* @param[in] iFrameIndex zero-based index of the frame.
+		* @param[in] iAudioSources audio IDs with the buffer to fill for each. Each buffer holds one
+		*            frame of samples, in the format expected by IABPackerInterface::UpdateAudioSamples().
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error and stop the pipeline.
+		*/
+		virtual iabError ReadFrameSamples(uint32_t iFrameIndex, const std::map<IABAudioDataIDType, int32_t*> &iAudioSources) = 0;
+
+		/**
+		* Updates frame metadata, such as object panning, before the frame is packed. Called on the
+		* encode stage (the thread calling IABPackerPipelineInterface::Run()), in frame order.
+		* The default implementation leaves the frame unchanged.
+		*
+		* @memberof IABPackerPipelineSourceInterface
+		*
+		* @param[in] iFrameIndex zero-based index of the frame.
+		* @param[in] iPacker packer holding the frame.
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error and stop the pipeline.
+		*/
+		virtual iabError UpdateFrameMetadata(uint32_t iFrameIndex, IABPackerInterface &iPacker)
+		{
+			(void)iFrameIndex;
+			(void)iPacker;
+			return kIABNoError;
+		}
+	};
+
+	/**
+	* Throughput statistics of one IABPackerPipelineInterface stage.
+	*
+	*/
+	struct IABPackerPipelineStageStats
+	{
+		uint32_t frames_;			// frames completed by the stage
+		uint64_t bytes_;			// sample bytes read (read stage) or packed bytes (encode and write stages)
+		double busySeconds_;		// time spent reading, encoding or writing
+		double waitSeconds_;		// time spent waiting on the neighbouring stages
+	};
+
+	/**
+	*
+	* Streaming IAB Packer pipeline interface. Must be implemented.
+	*
+	* Packs a sequence of frames with a configured IABPackerInterface instance, overlapping three stages:
+	*     read - frame samples are read from an IABPackerPipelineSourceInterface on a reader thread
+	*     encode - frame metadata is updated, DLC elements encoded and the frame packed, on the calling thread.
+	*              DLC elements of a frame are encoded in parallel on the packer's DLC encode thread pool.
+	*     write - packed frames are written to the output stream on a writer thread
+	*
+	* Frames move between stages through a bounded ring of frame slots, and are written in frame order.
+	*
+	* @class IABPackerPipelineInterface
+	*/
+
+	class IABPackerPipelineInterface
+	{
+	public:
+
+		/**
+		* Creates an IABPackerPipeline instance.
+		*
+		* The caller must not access iPacker or iOutputStream until Run() returns.
+		*
+		* @memberof IABPackerPipelineInterface
+		*
+		* @param[in] iPacker packer, with frame rate, sample rate and frame elements set up.
+		* @param[in] iOutputStream stream the packed frames are written to.
+		* @param[in] iEncodeThreadPoolSize DLC encode thread pool size, as IABPackerInterface::SetDLCEncodeThreadPoolSize().
+		* @param[in] iMaxFramesInFlight maximum number of frames between the read and write stages. Minimum is 3.
+		*
+		* @returns a pointer to IABPackerPipelineInterface instance created
+		*/
+		static IABPackerPipelineInterface* Create(IABPackerInterface* iPacker, std::ostream* iOutputStream, uint32_t iEncodeThreadPoolSize, uint32_t iMaxFramesInFlight);
+
+		/**
+		* Deletes an IABPackerPipeline instance.
+		*
+		* @memberof IABPackerPipelineInterface
+		*
+		* @param[in] iInstance pointer to the instance of the IABPackerPipelineInterface
+		*/
+		static void Delete(IABPackerPipelineInterface* iInstance);
+
+		/// Destructor
+		virtual ~IABPackerPipelineInterface() {}
+
+		/**
+		* Packs frames [0, iFrameCount) and writes them to the output stream. Returns when all frames are
+		* written, or on the first error. Can only be called once per instance.
+		*
+		* @memberof IABPackerPipelineInterface
+		*
+		* @param[in] iSource source of frame samples and metadata.
+		* @param[in] iAudioDataIDs audio IDs of the frame's audio data elements updated each frame.
+		* @param[in] iFrameCount number of frames to pack.
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError Run(IABPackerPipelineSourceInterface* iSource, const std::vector<IABAudioDataIDType> &iAudioDataIDs, uint32_t iFrameCount) = 0;
+
+		/**
+		* Gets throughput statistics of each stage, for frames processed by Run().
+		*
+		* @memberof IABPackerPipelineInterface
+		*
+		* @param[out] oReadStats read stage statistics.
+		* @param[out] oEncodeStats encode stage statistics.
+		* @param[out] oWriteStats write stage statistics.
+		*/
+		virtual void GetStageStats(IABPackerPipelineStageStats &oReadStats, IABPackerPipelineStageStats &oEncodeStats, IABPackerPipelineStageStats &oWriteStats) const = 0;
+	};
+
+#endif // MT_RENDERER_ENABLED
     
 } // namespace ImmersiveAudioBitstream
 } // namespace SMPTE
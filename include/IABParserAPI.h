@@ -36,6 +36,8 @@
 #define	__IABPARSERAPI_H__
 
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 #include "IABDataTypes.h"
@@ -150,6 +152,56 @@ namespace ImmersiveAudioBitstream
          * @return false - Parser will attempt to parse bitstream with an invalid version
          */
         virtual bool GetParseFailsOnVersionError() const = 0;
+
+        /**
+         * Set element types to be skipped by the Parser.
+         *
+         * Use this function to register element types that the client does not need, eg.
+         * kIABElementID_UserData, kIABElementID_AuthoringToolInfo and kIABElementID_ObjectZoneDefinition19
+         * for a playback-only path. Elements of the listed types are bypassed using their element
+         * size field and are not present in the parsed frame.
+         *
+         * Default behaviour is to parse all elements.
+         *
+         * @memberof IABParserInterface
+         *
+         * @param[in] iElementIDs set of element IDs to skip. An empty set restores default behaviour.
+         */
+        virtual void SetParseSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs) = 0;
+
+        /**
+         * Get element types to be skipped by the Parser.
+         *
+         * @memberof IABParserInterface
+         *
+         * @return set of element IDs to skip
+         */
+        virtual const std::set<IABElementIDType>& GetParseSkippedElementIDs() const = 0;
+
+        /**
+         * Set whether the Parser skips the 96kHz extension layer of DLC elements.
+         *
+         * Use this function when 96kHz bitstreams are only ever decoded to 48kHz, eg. rendered
+         * with 96k to 48k rendering enabled. The 96kHz predictor regions and residuals of
+         * IABAudioDataDLC elements are then bypassed, instead of being decoded and stored. Parsed
+         * DLC elements can still be decoded to 48kHz, but decoding them to 96kHz returns an error.
+         *
+         * Default behaviour is to parse both layers.
+         *
+         * @memberof IABParserInterface
+         *
+         * @param[in] iSkip96kLayer true to skip the 96kHz DLC layer.
+         */
+        virtual void SetParseSkipsDLC96kLayer(bool iSkip96kLayer) = 0;
+
+        /**
+         * Get whether the Parser skips the 96kHz extension layer of DLC elements.
+         *
+         * @memberof IABParserInterface
+         *
+         * @return true if the 96kHz DLC layer is skipped
+         */
+        virtual bool GetParseSkipsDLC96kLayer() const = 0;
         
         /**
          *
@@ -180,6 +232,129 @@ namespace ImmersiveAudioBitstream
 		*/
 		virtual iabError ParseIABFrame(char* iIABFrameDataBuffer, uint32_t iBufferSize) = 0;
 
+		/**
+		*
+		* Push-mode parsing. Feeds an arbitrary chunk of IA bitstream data to the parser.
+		*
+		* Intended for streamed/piped input (eg. network ingest) where data arrives in chunks
+		* that are not aligned with frame boundaries, and the input cannot be seeked. Fed data
+		* is buffered internally until a complete IA bitstream frame (optional preamble subframe
+		* followed by IA subframe) is available. Complete frames are parsed in place and queued,
+		* to be retrieved with GetFedFrameReleased(). Bytes that do not belong to a frame (eg. when
+		* joining a stream mid-frame) are discarded until frame sync is found.
+		*
+		* Internal buffering is bounded to one partial frame (see kIABMaxFeedBufferSize). Caller
+		* should retrieve parsed frames after each call to keep the frame queue short.
+		*
+		* Note that Feed() does not update the frame returned by GetIABFrame().
+		*
+		* @memberof IABParserInterface
+		*
+		* @param[in] iData pointer to chunk of bitstream data. Caller retains ownership.
+		* @param[in] iSize size of chunk, in bytes.
+		*
+		* @return \link iabError \endlink if no errors. Otherwise, the first error encountered while
+		* parsing complete frames from the chunk. All data in the chunk is consumed in either case.
+		*/
+		virtual iabError Feed(const uint8_t* iData, size_t iSize) = 0;
+
+		/** Gets number of frames parsed by Feed() and not yet retrieved.
+		*
+		* @memberof IABParserInterface
+		*
+		* @return number of queued frames
+		*/
+		virtual uint32_t GetFedFrameCount() const = 0;
+
+		/** Get, take over and own the oldest frame parsed by Feed().
+		*
+		* Note that caller takes over ownership of the frame, and must delete object after use.
+		*
+		* @memberof IABParserInterface
+		*
+		* @param[out] oIABFrame released IABFrameInterface pointer.
+		*
+		* @return \link iabError \endlink if no errors. kIABParserNoParsedFrameError if no frame is queued.
+		*/
+		virtual iabError GetFedFrameReleased(IABFrameInterface*& oIABFrame) = 0;
+
+		/**
+		*
+		* Builds an index of the IA bitstream frames in the input stream, for random access.
+		*
+		* Only the preamble and IA subframe headers are read. Frame payloads are skipped using
+		* the subframe length fields, so building the index does not parse any frame content.
+		* The scan starts at the beginning of the input stream. On return, the stream is
+		* positioned at the first frame. A truncated frame at the end of the stream is not indexed.
+		*
+		* Only applicable to parsers created with an input stream.
+		*
+		* @memberof IABParserInterface
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError BuildFrameIndex() = 0;
+
+		/**
+		*
+		* Saves the frame index to a sidecar file, so that it can be re-used by LoadFrameIndex()
+		* without scanning the bitstream again.
+		*
+		* @memberof IABParserInterface
+		*
+		* @param[in] iIndexFilePath path of the sidecar file to write.
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError SaveFrameIndex(const std::string &iIndexFilePath) const = 0;
+
+		/**
+		*
+		* Loads a frame index from a sidecar file written by SaveFrameIndex(). The index is
+		* rejected if it does not match the size of the input stream.
+		*
+		* @memberof IABParserInterface
+		*
+		* @param[in] iIndexFilePath path of the sidecar file to read.
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError LoadFrameIndex(const std::string &iIndexFilePath) = 0;
+
+		/** Gets number of frames in the frame index. Returns 0 if no index has been built or loaded.
+		*
+		* @memberof IABParserInterface
+		*
+		* @return number of indexed frames
+		*/
+		virtual uint32_t GetIndexedFrameCount() const = 0;
+
+		/** Gets byte offset and size of an indexed frame in the input stream.
+		*
+		* @memberof IABParserInterface
+		*
+		* @param[in] iFrameIndex zero-based index of the frame.
+		* @param[out] oOffset byte offset of the frame (start of preamble, if present) in the input stream.
+		* @param[out] oSize size of the frame in bytes, including preamble and IA subframe header.
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError GetIndexedFrameLocation(uint32_t iFrameIndex, uint64_t &oOffset, uint32_t &oSize) const = 0;
+
+		/**
+		*
+		* Positions the input stream at the start of an indexed frame, such that the next call
+		* to ParseIABFrame() parses that frame. Requires a frame index, see BuildFrameIndex()
+		* and LoadFrameIndex().
+		*
+		* @memberof IABParserInterface
+		*
+		* @param[in] iFrameIndex zero-based index of the frame.
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError SeekToFrame(uint32_t iFrameIndex) = 0;
+
 		/** Gets a constant reference to IABFrameInterface pointer.
          *
          * An example use case could be to pass the pointer to an IAB renderer to render the frame.
@@ -278,6 +453,127 @@ namespace ImmersiveAudioBitstream
 
     };
     
+#ifdef MT_RENDERER_ENABLED
+
+	/**
+	*
+	* Multi-threaded IAB Parser interface. Must be implemented.
+	*
+	* IAB frames are self-contained. Given a frame index of the input stream (see
+	* IABParserInterface::BuildFrameIndex()), IABParserMTInterface parses upcoming frames on a pool
+	* of worker threads, ahead of the caller, and delivers them in bitstream order.
+	*
+	* The number of frames in flight (being parsed, or parsed and not yet delivered) is bounded,
+	* keeping memory use predictable.
+	*
+	* @class IABParserMTInterface
+	*/
+
+	class IABParserMTInterface
+	{
+	public:
+
+		/**
+		* Creates an IABParserMT instance.
+		*
+		* Frame data is read from iInputStream by the worker threads, one frame at a time, under a lock.
+		* The caller must not access iInputStream until the IABParserMT instance is deleted.
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @param[in] iInputStream input stream containing the IA bitstream.
+		* @param[in] iThreadPoolSize number of worker threads, in range [1, 8].
+		* @param[in] iMaxFramesInFlight maximum number of frames parsed ahead of the caller. Minimum is iThreadPoolSize.
+		*
+		* @returns a pointer to IABParserMTInterface instance created
+		*/
+		static IABParserMTInterface* Create(std::istream* iInputStream, uint32_t iThreadPoolSize, uint32_t iMaxFramesInFlight);
+
+		/**
+		* Deletes an IABParserMT instance. Worker threads are stopped and undelivered frames are deleted.
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @param[in] iInstance pointer to the instance of the IABParserMTInterface
+		*/
+		static void Delete(IABParserMTInterface* iInstance);
+
+		/// Destructor
+		virtual ~IABParserMTInterface() {}
+
+		/**
+		* Sets parser behaviour on bitstream version error, as IABParserInterface::SetParseFailsOnVersionError().
+		* Must be called before Start().
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @param[in] iFailOnVersionError true to fail parsing on version error
+		*/
+		virtual void SetParseFailsOnVersionError(bool iFailOnVersionError) = 0;
+
+		/**
+		* Sets element types skipped when parsing, as IABParserInterface::SetParseSkippedElementIDs().
+		* Must be called before Start().
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @param[in] iElementIDs set of element IDs to skip
+		*/
+		virtual void SetParseSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs) = 0;
+
+		/**
+		* Sets whether the 96kHz DLC layer is skipped when parsing, as IABParserInterface::SetParseSkipsDLC96kLayer().
+		* Must be called before Start().
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @param[in] iSkip96kLayer true to skip the 96kHz DLC layer
+		*/
+		virtual void SetParseSkipsDLC96kLayer(bool iSkip96kLayer) = 0;
+
+		/**
+		* Starts parsing frames [iStartFrame, iStartFrame + iFrameCount) on the worker threads.
+		* Can only be called once per instance.
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @param[in] iIndexedParser parser on the same input stream, with a frame index built or loaded.
+		* @param[in] iStartFrame zero-based index of the first frame to parse.
+		* @param[in] iFrameCount number of frames to parse. 0: parse to the last indexed frame.
+		*
+		* @return \link iabError \endlink if no errors. Other values indicate an error.
+		*/
+		virtual iabError Start(const IABParserInterface &iIndexedParser, uint32_t iStartFrame, uint32_t iFrameCount) = 0;
+
+		/**
+		* Gets the next parsed frame, in bitstream order, waiting for it to be parsed if needed.
+		* Ownership of the frame is transferred to the caller, who must delete it with IABFrameInterface::Delete().
+		*
+		* The return value is the parse result for the frame. A frame is returned for kIABNoError,
+		* kIABParserMissingPreambleError and, when version errors are tolerated, kIABParserInvalidVersionNumberError.
+		* For other errors oIABFrame is set to NULL. kIABParserEndOfStreamReached is returned when all
+		* frames have been delivered.
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @param[out] oIABFrame parsed frame.
+		*
+		* @return \link iabError \endlink parse result of the frame.
+		*/
+		virtual iabError GetNextIABFrameReleased(IABFrameInterface*& oIABFrame) = 0;
+
+		/**
+		* Gets the number of unallowed or undefined frame sub-elements found in frames delivered so far.
+		*
+		* @memberof IABParserMTInterface
+		*
+		* @return cumulative count of unallowed and undefined frame sub-elements
+		*/
+		virtual uint32_t GetUnallowedFrameSubElementCount() const = 0;
+	};
+
+#endif // MT_RENDERER_ENABLED
+
 } // namespace ImmersiveAudioBitstream
 } // namespace SMPTE
 
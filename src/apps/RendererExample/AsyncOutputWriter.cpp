@@ -0,0 +1,301 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include "AsyncOutputWriter.h"
+
+#if __linux__ || __APPLE__
+#include <sys/time.h>
+
+// Monotonic enough for stall statistics, in ms
+static uint64_t GetWaitTimeMS()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<uint64_t>(tv.tv_sec) * 1000 + static_cast<uint64_t>(tv.tv_usec / 1000);
+}
+
+// Writer thread entry point
+static void *AsyncOutputWriterThread(void *iParam)
+{
+    static_cast<AsyncOutputWriter*>(iParam)->WriteFrames();
+    return NULL;
+}
+#endif
+
+// Constructor
+AsyncOutputWriter::AsyncOutputWriter()
+{
+    writer_ = NULL;
+    writeIndex_ = 0;
+    queuedCount_ = 0;
+    started_ = false;
+    threaded_ = false;
+    writeError_ = false;
+    doTerminate_ = false;
+    
+    framesWritten_ = 0;
+    writerStalls_ = 0;
+    stallTimeMS_ = 0;
+    writerIdleWaits_ = 0;
+    occupancySum_ = 0;
+    maxOccupancy_ = 0;
+}
+
+// Destructor
+AsyncOutputWriter::~AsyncOutputWriter()
+{
+    Stop();
+}
+
+bool AsyncOutputWriter::Start(WAVStreamWriter *ioWriter, uint32_t iRingSize, uint32_t iChannelCount, uint32_t iMaxSampleCount)
+{
+    if (started_ || !ioWriter || (iChannelCount == 0))
+    {
+        return false;
+    }
+    
+    writer_ = ioWriter;
+    writeIndex_ = 0;
+    queuedCount_ = 0;
+    writeError_ = false;
+    doTerminate_ = false;
+    
+    framesWritten_ = 0;
+    writerStalls_ = 0;
+    stallTimeMS_ = 0;
+    writerIdleWaits_ = 0;
+    occupancySum_ = 0;
+    maxOccupancy_ = 0;
+    
+#if __linux__ || __APPLE__
+    threaded_ = (iRingSize > 0);
+#else
+    threaded_ = false;
+#endif
+    
+    // A single frame buffer when frames are written on the calling thread
+    ring_.clear();
+    ring_.resize(threaded_ ? iRingSize : 1);
+    
+    for (size_t i = 0; i < ring_.size(); i++)
+    {
+        FrameBuffer &frame = ring_[i];
+        frame.samples_.resize(static_cast<size_t>(iChannelCount) * iMaxSampleCount);
+        frame.channels_.resize(iChannelCount);
+        
+        for (uint32_t ch = 0; ch < iChannelCount; ch++)
+        {
+            frame.channels_[ch] = &frame.samples_[static_cast<size_t>(ch) * iMaxSampleCount];
+        }
+    }
+    
+#if __linux__ || __APPLE__
+    if (threaded_ && (0 != pthread_create(&thread_, NULL, AsyncOutputWriterThread, (void*) this)))
+    {
+        ring_.clear();
+        threaded_ = false;
+        return false;
+    }
+#endif
+    
+    started_ = true;
+    
+    return true;
+}
+
+int32_t** AsyncOutputWriter::AcquireFrame()
+{
+    if (!started_)
+    {
+        return NULL;
+    }
+    
+    if (!threaded_)
+    {
+        return writeError_ ? NULL : &ring_[0].channels_[0];
+    }
+    
+#if __linux__ || __APPLE__
+    mutex_.lock();
+    
+    // Ring full, wait for the writer thread to release a frame buffer
+    if (queuedCount_ == ring_.size())
+    {
+        uint64_t waitStart = GetWaitTimeMS();
+        writerStalls_++;
+        
+        while ((queuedCount_ == ring_.size()) && !writeError_)
+        {
+            frameWritten_.wait(mutex_);
+        }
+        
+        stallTimeMS_ += GetWaitTimeMS() - waitStart;
+    }
+    
+    bool writeError = writeError_;
+    uint32_t frameIndex = (writeIndex_ + queuedCount_) % static_cast<uint32_t>(ring_.size());
+    
+    mutex_.unlock();
+    
+    return writeError ? NULL : &ring_[frameIndex].channels_[0];
+#else
+    return NULL;
+#endif
+}
+
+bool AsyncOutputWriter::CommitFrame(uint32_t iSampleCount)
+{
+    if (!started_)
+    {
+        return false;
+    }
+    
+    if (!threaded_)
+    {
+        if (!writeError_ && (0 != writer_->writeSamples(&ring_[0].channels_[0], iSampleCount)))
+        {
+            writeError_ = true;
+        }
+        
+        framesWritten_++;
+        
+        return !writeError_;
+    }
+    
+#if __linux__ || __APPLE__
+    mutex_.lock();
+    
+    uint32_t frameIndex = (writeIndex_ + queuedCount_) % static_cast<uint32_t>(ring_.size());
+    ring_[frameIndex].sampleCount_ = iSampleCount;
+    queuedCount_++;
+    
+    occupancySum_ += queuedCount_;
+    
+    if (queuedCount_ > maxOccupancy_)
+    {
+        maxOccupancy_ = queuedCount_;
+    }
+    
+    bool writeError = writeError_;
+    frameQueued_.signal();
+    
+    mutex_.unlock();
+    
+    return !writeError;
+#else
+    return false;
+#endif
+}
+
+bool AsyncOutputWriter::Stop()
+{
+    if (!started_)
+    {
+        return !writeError_;
+    }
+    
+#if __linux__ || __APPLE__
+    if (threaded_)
+    {
+        mutex_.lock();
+        doTerminate_ = true;
+        frameQueued_.signal();
+        mutex_.unlock();
+        
+        pthread_join(thread_, NULL);
+    }
+#endif
+    
+    started_ = false;
+    
+    return !writeError_;
+}
+
+void AsyncOutputWriter::ReportStats(std::ostream &oStream) const
+{
+    if (!threaded_)
+    {
+        return;
+    }
+    
+    double averageOccupancy = (framesWritten_ > 0) ? (static_cast<double>(occupancySum_) / framesWritten_) : 0.0;
+    
+    oStream << "Output writer: " << framesWritten_ << " frames written, ring of " << ring_.size() << " frames" << std::endl;
+    oStream << "Output writer stalls: " << writerStalls_ << " (" << (stallTimeMS_ / 1000.0) << " s), writer idle waits: " << writerIdleWaits_ << std::endl;
+    oStream << "Output writer ring occupancy: average " << averageOccupancy << ", max " << maxOccupancy_ << std::endl << std::endl;
+}
+
+void AsyncOutputWriter::WriteFrames()
+{
+#if __linux__ || __APPLE__
+    mutex_.lock();
+    
+    while (1)
+    {
+        if ((queuedCount_ == 0) && !doTerminate_)
+        {
+            writerIdleWaits_++;
+            
+            while ((queuedCount_ == 0) && !doTerminate_)
+            {
+                frameQueued_.wait(mutex_);
+            }
+        }
+        
+        if (queuedCount_ == 0)
+        {
+            // Terminating, and all queued frames written
+            break;
+        }
+        
+        FrameBuffer &frame = ring_[writeIndex_];
+        bool skipWrite = writeError_;
+        
+        // Write outside the lock. The frame buffer stays queued, so it is not reused until released below.
+        mutex_.unlock();
+        
+        int error = skipWrite ? 0 : writer_->writeSamples(&frame.channels_[0], frame.sampleCount_);
+        
+        mutex_.lock();
+        
+        if (0 != error)
+        {
+            writeError_ = true;
+        }
+        
+        writeIndex_ = (writeIndex_ + 1) % static_cast<uint32_t>(ring_.size());
+        queuedCount_--;
+        framesWritten_++;
+        
+        frameWritten_.signal();
+    }
+    
+    mutex_.unlock();
+#endif
+}
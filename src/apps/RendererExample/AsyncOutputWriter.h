@@ -0,0 +1,139 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#ifndef ASYNCOUTPUTWRITER_H_
+#define ASYNCOUTPUTWRITER_H_
+
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+#include "waveutils/WAVStreamWriter.h"
+
+#if __linux__ || __APPLE__
+#include <pthread.h>
+#include "common/IABMutex.h"
+#endif
+
+/**
+ *
+ * Output writer stage of RenderIABToFiles. Rendered frames, converted to 32-bit integer PCM, are queued in a
+ * bounded ring of frame buffers and written to a WAVStreamWriter on a writer thread, so disk I/O overlaps
+ * with parsing and rendering of the following frames. When the ring is full, the rendering thread waits for
+ * the writer (a writer stall).
+ *
+ * Without thread support, or with a ring size of 0, frames are written on the calling thread.
+ */
+
+class AsyncOutputWriter
+{
+    
+public:
+    
+    // Constructor
+    AsyncOutputWriter();
+    
+    // Destructor, stops the writer thread
+    ~AsyncOutputWriter();
+    
+    /**
+     * Allocates iRingSize frame buffers of iChannelCount channels by iMaxSampleCount samples and starts the
+     * writer thread, writing to ioWriter. ioWriter must stay open until Stop().
+     * @returns true if no error.
+     */
+    bool Start(WAVStreamWriter *ioWriter, uint32_t iRingSize, uint32_t iChannelCount, uint32_t iMaxSampleCount);
+    
+    /**
+     * Gets a free frame buffer, as an array of channel pointers. Waits while all frame buffers are queued.
+     * @returns NULL if not started or if writing of a queued frame failed.
+     */
+    int32_t**   AcquireFrame();
+    
+    /**
+     * Queues the frame buffer from AcquireFrame() for writing iSampleCount samples of each channel.
+     * @returns false if writing of this or a previous frame failed.
+     */
+    bool        CommitFrame(uint32_t iSampleCount);
+    
+    /**
+     * Waits for queued frames to be written and stops the writer thread. Has no effect if not started.
+     * @returns false if writing of a frame failed.
+     */
+    bool        Stop();
+    
+    // Prints frame count, writer stalls and ring occupancy to oStream
+    void        ReportStats(std::ostream &oStream) const;
+    
+    // Writer thread loop. Writes queued frames in order until stopped.
+    void        WriteFrames();
+    
+private:
+    
+    struct FrameBuffer
+    {
+        FrameBuffer() : sampleCount_(0) {}
+        
+        std::vector<int32_t>    samples_;           // Samples of all channels, channel by channel
+        std::vector<int32_t*>   channels_;          // Pointer to each channel in samples_
+        uint32_t                sampleCount_;       // Samples per channel to write
+    };
+    
+    AsyncOutputWriter(const AsyncOutputWriter&);
+    AsyncOutputWriter& operator=(const AsyncOutputWriter&);
+    
+    WAVStreamWriter             *writer_;
+    
+    // Ring of frame buffers. Queued frames are [writeIndex_, writeIndex_ + queuedCount_), modulo ring size.
+    std::vector<FrameBuffer>    ring_;
+    uint32_t                    writeIndex_;
+    uint32_t                    queuedCount_;
+    
+    bool                        started_;
+    bool                        threaded_;
+    bool                        writeError_;
+    bool                        doTerminate_;
+    
+    // Back-pressure stats
+    uint64_t                    framesWritten_;
+    uint64_t                    writerStalls_;          // Frames for which the rendering thread waited for a free buffer
+    uint64_t                    stallTimeMS_;           // Total time waited by the rendering thread
+    uint64_t                    writerIdleWaits_;       // Times the writer thread waited for a queued frame
+    uint64_t                    occupancySum_;          // Sum of ring occupancy, sampled when a frame is queued
+    uint32_t                    maxOccupancy_;
+    
+#if __linux__ || __APPLE__
+    // Synchronisation of the ring state between rendering and writer threads
+    SMPTE::ImmersiveAudioBitstream::IABMutex                mutex_;
+    SMPTE::ImmersiveAudioBitstream::IABMutex::IABCondition  frameQueued_;
+    SMPTE::ImmersiveAudioBitstream::IABMutex::IABCondition  frameWritten_;
+    pthread_t                   thread_;
+#endif
+};
+
+#endif /* ASYNCOUTPUTWRITER_H_ */
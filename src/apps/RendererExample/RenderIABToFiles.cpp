@@ -30,6 +30,7 @@
 #include "RenderIABToFiles.h"
 #include "common/IABConstants.h"
 #include "IABUtilities.h"
+#include "commonstream/utils/PCMUtilities.h"
 #include <limits.h>
 
 #if __linux__ || __APPLE__
@@ -56,6 +57,11 @@ unsigned long getTimeMS()
 RenderIABToFiles::RenderIABToFiles()
 {
     inputFile_ = NULL;
+    interleavedOutput_ = false;
+    largeFileFormat_ = WAVStreamWriter::kLargeFileRF64;
+    writerRingSize_ = 0;
+    ditherOutput_ = false;
+    CommonStream::InitDitherState(ditherState_, 0);
     inputFrameCount_ = 0;
     errorCode_ = kIABNoError;
     
@@ -70,12 +76,27 @@ RenderIABToFiles::RenderIABToFiles()
 
 #ifdef MT_RENDERER_ENABLED
 	iabRendererMTinterface_ = NULL;
+	iabParserMT_ = NULL;
+	iabParserMTFrame_ = NULL;
 #endif
 }
 
 // Destructor
 RenderIABToFiles::~RenderIABToFiles()
 {
+#ifdef MT_RENDERER_ENABLED
+    // Stop parser threads before closing the input file they read from
+    if (iabParserMT_)
+    {
+        IABParserMTInterface::Delete(iabParserMT_);
+    }
+
+    if (iabParserMTFrame_)
+    {
+        IABFrameInterface::Delete(iabParserMTFrame_);
+    }
+#endif
+
     // Close input and output files
     CloseInputOutputFiles();
 
@@ -111,106 +132,31 @@ RenderIABToFiles::~RenderIABToFiles()
     }
     	
 }
-bool RenderIABToFiles::CreateOutputFilesForSpeakers(uint32_t iSampleRate, const std::map<std::string, int32_t> iSpeakerToOutputIndexMap)
+bool RenderIABToFiles::CreateOutputFilesForSpeakers(uint32_t iSampleRate, const std::map<std::string, int32_t> iSpeakerToOutputIndexMap, bool iInterleaved)
 {
-    bool createFileError = false;;
-    
-    uint32_t nWaveChannels = MONO_CHANNEL;
     uint32_t nWaveBytesPerSample = BITWIDTH_3BYTES;		// 24-bit sample width
     
     // Construct file name stem
     std::ostringstream oStrStream;
     std::string wavFileNameStem;
-    oStrStream << outputPath_.c_str() << SEPARATOR << "Output-";
+    oStrStream << outputPath_.c_str() << SEPARATOR << "Output";
     wavFileNameStem = oStrStream.str();
     
     // iSpeakerToOutputIndexMap contains the short name and corresponding renderer output index of each physical speaker in the configuration.
-    // Use this map information to link each output file wav writer to the corresonding renderer output channel and save in outputFileMap_
+    // Use this map information to link each output channel of the wav writer to the corresonding renderer output channel and save in outputFileMap_
     // outputFileMap_ enables the application to access correct rendered channel to write samples to the corresponding wav file.
     
     outputFileMap_.clear();
     
     std::map<std::string, int32_t>::const_iterator iter;
     
-    // Create one mono wav file for each physical output speaker/channel in the configuration
     for (iter = iSpeakerToOutputIndexMap.begin(); iter != iSpeakerToOutputIndexMap.end(); iter++)
     {
         OutputFileInfo outputFileInfo;
-        
-        // Create wav writer for the output channel
-        
-        WAVFile *pWav;
-
-        oStrStream.str("");
-        oStrStream << wavFileNameStem << iter->first << ".wav";     // add speaker name as file suffix and add file extension
-        
-        pWav = new WAVFile();
-        pWav->pFile = new std::fstream(oStrStream.str().c_str(), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
-        
-        if (! pWav->pFile->good())
-        {
-            createFileError = true;
-            delete pWav;
-            break;
-        }
-        
-        // construct header
-        
-#if defined(BROADCAST_WAVE)
-        
-        std::string originatorString;
-        std::ostringstream originatorStringStream;
-        
-        originatorStringStream << "Xperi ProAudio IAB-renderer-example";
-        originatorString = originatorStringStream.str();
-        
-        strncpy(pWav->bext_data.Originator, originatorString.c_str(), sizeof(pWav->bext_data.Originator));
-        
-        std::string originatorRefString;
-        std::ostringstream originatorRefStringStream;
-        
-        originatorRefStringStream << "Xperi ProAudio IAB-renderer-example v1.0.0.0";
-        
-        originatorRefString = originatorRefStringStream.str();
-        
-        strncpy(pWav->bext_data.OriginatorReference, originatorRefString.c_str(), sizeof(pWav->bext_data.OriginatorReference));
-        
-#endif						//if defined(BROADCAST_WAVE)
-        
-        pWav->fileSize = WAV_RIFF_HEADER_CHUNKSIZE;
-        pWav->header.fileSize = (uint32_t) WAV_RIFF_HEADER_CHUNKSIZE;
-        pWav->dataSize = 0;
-        pWav->header.dataChunkSize = 0;
-        pWav->header.fmtChunkSize = WAV_FMT_CHUNKSIZE;
-        pWav->header.wFormatTag = WAVE_FORMAT_PCM;
-        pWav->header.nChannels = nWaveChannels;
-        pWav->header.nSamplePerSec = iSampleRate;
-        pWav->header.nAvgBytesPerSec = nWaveChannels * iSampleRate * nWaveBytesPerSample;
-        pWav->header.nBlockAlign = nWaveChannels * nWaveBytesPerSample;
-        pWav->header.nBitsPerSample = nWaveBytesPerSample * 8;
-        pWav->header.cbSize = 0;
-        pWav->header.wValidBitsPerSample = nWaveBytesPerSample * 8;
-        pWav->header.dwChannelMask = 0;
-        
-        pWav->writeWavHeader();
-        
-        // A single buffer block is used to save all rendered channels and they are arranged in the order as they appear in the config file.
-        // iter->second is the speaker/channel's index indicating its position in the renderer output block.
-        
-        // Save to output file info map
-        outputFileInfo.outputWav_ = pWav;
         outputFileInfo.channelName_ = iter->first;
         outputFileMap_[iter->second] = outputFileInfo;
     }
     
-    if (createFileError)
-    {
-        std::cerr << "!Error in creating output wav files." << std::endl;
-        std::cerr << "Check the output folder specified with -o exists and has write permission." << std::endl;
-        std::cerr << "Check that the disk is not full." << std::endl;
-        return false;
-    }
-
     // Check wav file count against IABRenderer output channel count for consistency
     if (outputChannelCount_ != outputFileMap_.size())
     {
@@ -230,83 +176,115 @@ bool RenderIABToFiles::CreateOutputFilesForSpeakers(uint32_t iSampleRate, const
         }
     }
     
+    // Output index are 0 to outputChannelCount_ - 1, so writer channel order is rendered output index order.
+    // Create a single interleaved wav file, or one mono wav file for each physical output speaker/channel in the configuration
+    std::vector<std::string> wavFileNames;
+    
+    if (iInterleaved)
+    {
+        wavFileNames.push_back(wavFileNameStem + ".wav");
+        
+        std::cout << "Channel order in " << wavFileNames[0] << ":";
+        for (iterOutputFile = outputFileMap_.begin(); iterOutputFile != outputFileMap_.end(); iterOutputFile++)
+        {
+            std::cout << " " << iterOutputFile->second.channelName_;
+        }
+        std::cout << std::endl << std::endl;
+    }
+    else
+    {
+        for (iterOutputFile = outputFileMap_.begin(); iterOutputFile != outputFileMap_.end(); iterOutputFile++)
+        {
+            // add speaker name as file suffix and add file extension
+            wavFileNames.push_back(wavFileNameStem + "-" + iterOutputFile->second.channelName_ + ".wav");
+        }
+    }
+    
+    // construct header
+    
+    BEXT_data bextData = BEXT_data();
+    
+#if defined(BROADCAST_WAVE)
+    
+    std::string originatorString;
+    std::ostringstream originatorStringStream;
+    
+    originatorStringStream << "Xperi ProAudio IAB-renderer-example";
+    originatorString = originatorStringStream.str();
+    
+    strncpy(bextData.Originator, originatorString.c_str(), sizeof(bextData.Originator));
+    
+    std::string originatorRefString;
+    std::ostringstream originatorRefStringStream;
+    
+    originatorRefStringStream << "Xperi ProAudio IAB-renderer-example v1.0.0.0";
+    
+    originatorRefString = originatorRefStringStream.str();
+    
+    strncpy(bextData.OriginatorReference, originatorRefString.c_str(), sizeof(bextData.OriginatorReference));
+    
+#endif						//if defined(BROADCAST_WAVE)
+    
+    // Keep headers of the output files valid every 10 seconds of audio. Samples are written in large blocks in between.
+    wavWriter_.setHeaderUpdateInterval(10 * iSampleRate);
+    
+    // Files switch from RIFF to RF64 or BW64 beyond 4 GB
+    wavWriter_.setLargeFileFormat(largeFileFormat_);
+    
+    if (0 != wavWriter_.open(wavFileNames,
+                             iInterleaved ? WAVStreamWriter::kInterleavedFile : WAVStreamWriter::kPerChannelFiles,
+                             outputChannelCount_,
+                             iSampleRate,
+                             nWaveBytesPerSample,
+                             &bextData))
+    {
+        std::cerr << "!Error in creating output wav files." << std::endl;
+        std::cerr << "Check the output folder specified with -o exists and has write permission." << std::endl;
+        std::cerr << "Check that the disk is not full." << std::endl;
+        return false;
+    }
+    
+    // Start writer stage, with buffers for rendered output converted to 32-bit integer samples
+    if (!outputWriter_.Start(&wavWriter_, writerRingSize_, outputChannelCount_, maxOutputSampleCount_))
+    {
+        std::cerr << "!Error in starting output writer." << std::endl;
+        return false;
+    }
+    
     return true;
 }
 
 iabError RenderIABToFiles::WriteRendererOutputToFiles()
 {
-    int32_t *samples;
-    int32_t *ptrSample;
+    // Get a free frame buffer of the writer stage. Waits while the writer is behind.
+    int32_t **pcmPointers = outputWriter_.AcquireFrame();
     
-    // Note that WavIO class method writeSamplesToFile() used to write samples to wav file is designed to handle
-    // multi-channel file and expect an array of pointers to the audio sample buffers
-    // For this application, we use mono wav file, so the sample pointer array has just one pointer
-    
-    int32_t *data[1];
-    float sample;
-    
-    samples = new int32_t[iabFrameSampleCount_];
-    std::map<int32_t, OutputFileInfo>::iterator iterOutputFile;
-    int32_t rendererOutputIndex = 0;
+    if (!pcmPointers)
+    {
+        return kIABMemoryError;
+    }
     
-    // Write each output channel to its corresponding wav file
-    for (iterOutputFile = outputFileMap_.begin(); iterOutputFile != outputFileMap_.end(); iterOutputFile++)
+    // Convert each output channel to 32-bit integer samples
+    // Renderer output is in floating-point and could exceed +/- 1.0 range. Output is scaled to 32-bit integer range,
+    // rounded and limited. WAVStreamWriter class writes the upper 24 bits of each sample to wav.
+    for (uint32_t rendererOutputIndex = 0; rendererOutputIndex < outputChannelCount_; rendererOutputIndex++)
     {
-        ptrSample = samples;
-        rendererOutputIndex = iterOutputFile->first;
-        WAVFile *pWav = iterOutputFile->second.outputWav_;
-        
-        for(uint32_t k = 0; k < (uint32_t)iabFrameSampleCount_; k++)
+        if (ditherOutput_)
         {
-            // Renderer output is in floating-point and could exceed +/- 1.0 range
-            // WAVFile class accepts 32-bit integer samples as input and writes to wav as 24-bit data
-            // Scale renderer output to 32-bit integer range and apply limit
-            
-            sample = outPointers_[rendererOutputIndex][k] * kInt32BitMaxValue;
-            
-            // Apply rounding
-            if (sample >= 0.0f)
-            {
-                sample += 0.5;
-            }
-            else
-            {
-                sample -= 0.5;
-            }
-            
-            if (sample > kInt32BitMaxValue)
-            {
-                *ptrSample++ = INT_MAX;
-            }
-            else if (sample < kInt32BitMinValue)
-            {
-                *ptrSample++ = INT_MIN;
-            }
-            else
-            {
-                *ptrSample++ = (int32_t) sample;
-            }
+            CommonStream::FloatToInt32Dithered(pcmPointers[rendererOutputIndex], outPointers_[rendererOutputIndex],
+                                               iabFrameSampleCount_, BITWIDTH_3BYTES * 8, ditherState_);
         }
-        
-        // Update wav header parameters
-        pWav->fileSize += iabFrameSampleCount_ * 3;	// wav file is 24-bit
-        pWav->dataSize += iabFrameSampleCount_ * 3;
-        
-        pWav->header.fileSize = (int32_t) pWav->fileSize;
-        pWav->header.dataChunkSize = (int32_t) pWav->dataSize;
-        pWav->updateRIFFHeader();
-        
-        data[0] = samples;
-        
-        // Write audio samples to file
-        if( pWav->writeSamplesToFile(1, data, iabFrameSampleCount_) != 0 )
+        else
         {
-            delete [] samples;
-            return kIABMemoryError;
+            CommonStream::FloatToInt32(pcmPointers[rendererOutputIndex], outPointers_[rendererOutputIndex], iabFrameSampleCount_);
         }
     }
     
-    delete [] samples;
+    // Queue audio samples of all channels for writing to file(s)
+    if (!outputWriter_.CommitFrame(iabFrameSampleCount_))
+    {
+        return kIABMemoryError;
+    }
     
     return kIABNoError;
     
@@ -418,8 +396,8 @@ bool RenderIABToFiles::CreateAndInitializeRenderer(std::string iRendererConfigFi
         return false;
     }
     
-    // Create output wav file, one for each output speaker channel
-    if (!CreateOutputFilesForSpeakers(RENDERER_SAMPLERATE, speakerToOutputIndexMap))
+    // Create output wav files, one for each output speaker channel or a single interleaved file
+    if (!CreateOutputFilesForSpeakers(RENDERER_SAMPLERATE, speakerToOutputIndexMap, interleavedOutput_))
     {
         return false;
     }
@@ -427,11 +405,92 @@ bool RenderIABToFiles::CreateAndInitializeRenderer(std::string iRendererConfigFi
     return true;
 }
 
+iabError RenderIABToFiles::LoadOrBuildFrameIndex(const std::string &iIndexFilePath)
+{
+    // Re-use a cached index when possible, to avoid scanning the bitstream
+    if (kIABNoError != iabParser_->LoadFrameIndex(iIndexFilePath))
+    {
+        iabError ec = iabParser_->BuildFrameIndex();
+        
+        if (kIABNoError != ec)
+        {
+            std::cerr << "!Error in building frame index of the input file." << std::endl;
+            return ec;
+        }
+        
+        // Failure to cache the index is not an error
+        if (kIABNoError != iabParser_->SaveFrameIndex(iIndexFilePath))
+        {
+            std::cerr << "!Warning: Unable to save frame index file : " << iIndexFilePath << std::endl;
+        }
+    }
+    
+    return kIABNoError;
+}
+
+iabError RenderIABToFiles::SeekParserToFrame(uint32_t iStartFrame, const std::string &iIndexFilePath)
+{
+    iabError ec = LoadOrBuildFrameIndex(iIndexFilePath);
+    
+    if (kIABNoError != ec)
+    {
+        return ec;
+    }
+    
+    if (iStartFrame >= iabParser_->GetIndexedFrameCount())
+    {
+        std::cerr << "!Error: Start frame " << iStartFrame << " is beyond the last frame of the input file ("
+                  << iabParser_->GetIndexedFrameCount() << " frames)." << std::endl;
+        return kIABBadArgumentsError;
+    }
+    
+    return iabParser_->SeekToFrame(iStartFrame);
+}
+
+#ifdef MT_RENDERER_ENABLED
+iabError RenderIABToFiles::StartMTParser(CommandLineParams& iCparams, const std::string &iIndexFilePath)
+{
+    iabError ec = LoadOrBuildFrameIndex(iIndexFilePath);
+    
+    if (kIABNoError != ec)
+    {
+        return ec;
+    }
+    
+    // Keep two frames in flight per thread, so that workers do not stall while a frame is delivered
+    iabParserMT_ = IABParserMTInterface::Create(inputFile_, iCparams.threadPoolSize_, 2 * iCparams.threadPoolSize_);
+    
+    if (NULL == iabParserMT_)
+    {
+        return kIABMemoryError;
+    }
+    
+    if (iCparams.ignoreBitStreamVersion_)
+    {
+        iabParserMT_->SetParseFailsOnVersionError(false);
+    }
+    
+    // SDK v1.0 IAB renderer renders 96k to 48k output only, the 96k DLC layer is not needed
+    iabParserMT_->SetParseSkipsDLC96kLayer(true);
+    
+    ec = iabParserMT_->Start(*iabParser_, iCparams.startFrame_, iCparams.frameCount_);
+    
+    if (kIABNoError != ec)
+    {
+        std::cerr << "!Error in starting multi-threaded parser (" << ec << ")." << std::endl;
+    }
+    
+    return ec;
+}
+#endif
+
 iabError RenderIABToFiles::OpenInputFile(std::string iInputFileName)
 {
-    inputFile_ = new std::ifstream(iInputFileName.c_str(), std::ifstream::in | std::ifstream::binary);
+    // Input is memory mapped and parsed in place. Resident memory follows the frames being parsed,
+    // not the input file size.
+    inputFile_ = new CommonStream::MappedIStream();
     
-    if (!inputFile_->good())
+    if (CMNSTRM_OK != inputFile_->open(iInputFileName))
     {
         return kIABGeneralError;
     }
@@ -449,17 +508,12 @@ iabError RenderIABToFiles::CloseInputOutputFiles()
         inputFile_ = NULL;
     }
     
-    // Close output wav files and delete pointers
-    std::map<int32_t, OutputFileInfo>::iterator iter;
-
-    for (iter = outputFileMap_.begin(); iter != outputFileMap_.end(); iter++)
+    // Write queued frames and remaining samples, finalise headers and close output wav files
+    bool writerError = !outputWriter_.Stop();
+    
+    if ((0 != wavWriter_.close()) || writerError)
     {
-        if (iter->second.outputWav_->pFile)
-        {
-            iter->second.outputWav_->pFile->close();
-            delete iter->second.outputWav_->pFile;
-            delete iter->second.outputWav_;
-        }
+        return kIABGeneralError;
     }
     
     return kIABNoError;
@@ -499,6 +553,10 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
     inputFileStem_ = iCparams.inputFileStem_;
     inputFileExt_ = iCparams.inputFileExt_;
     outputPath_ = iCparams.outputPath_;
+    interleavedOutput_ = iCparams.interleavedOutput_;
+    largeFileFormat_ = iCparams.bw64Output_ ? WAVStreamWriter::kLargeFileBW64 : WAVStreamWriter::kLargeFileRF64;
+    writerRingSize_ = iCparams.writerRingSize_;
+    ditherOutput_ = iCparams.ditherOutput_;
     
     bool multiFilesInput = iCparams.multiFilesInput_;
     
@@ -524,7 +582,8 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
             iabParser_->SetParseFailsOnVersionError(false);
         }
 
-		char * inBuffer = NULL;
+        // SDK v1.0 IAB renderer renders 96k to 48k output only, the 96k DLC layer is not needed
+        iabParser_->SetParseSkipsDLC96kLayer(true);
 
 		while (1)
         {
@@ -545,25 +604,14 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
                 break;
             }
         
-			// Read whole frame into buffer.
+			// Whole frame in buffer.
 			// In GDC implementation, the buffer content will be read by the application code, likely to use asdcp read frame function
 			// or something similar
 
 			// For multi-file input of this tool, any single file contains a single frame.
-			// Read in currently open file in entirely.
-			inputFile_->seekg(0, inputFile_->end);
-			uint32_t fileLength = static_cast<uint32_t>(inputFile_->tellg());
-			inputFile_->seekg(0, inputFile_->beg);
-
-			// allocate memory for file:
-			if (inBuffer)
-			{
-				delete [] inBuffer;
-			}
-			inBuffer = new char[fileLength];
-
-			// read data as a block:
-			inputFile_->read(inBuffer, fileLength);
+			// The mapped file is the frame buffer, parsed in place. The parser does not modify the buffer.
+			uint32_t fileLength = static_cast<uint32_t>(inputFile_->size());
+			char *inBuffer = const_cast<char*>(inputFile_->data());
 
 #ifdef MT_RENDERER_ENABLED
             timeStart = getTimeMS();
@@ -704,13 +752,6 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
             }
         }
 
-		if (inBuffer)
-		{
-			// Error condition could leave this buffer allocated
-			delete [] inBuffer;
-			inBuffer = NULL;
-		}
-
 		if (iabParser_)
 		{
 			// Finished with IAB parser, delete
@@ -734,7 +775,8 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
         {
             if (inputFrameCount_ > 0)
             {
-                if (inputFile_->eof())
+                // The input stream belongs to the MT parser threads, which detect the end of stream
+                if (!iCparams.enableMTParse_ && inputFile_->eof())
                 {
                     // Finished processing
                     break;
@@ -766,23 +808,86 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
                 {
                     iabParser_->SetParseFailsOnVersionError(false);
                 }
+
+                // SDK v1.0 IAB renderer renders 96k to 48k output only, the 96k DLC layer is not needed
+                iabParser_->SetParseSkipsDLC96kLayer(true);
+
+#ifdef MT_RENDERER_ENABLED
+                // Parse ahead on worker threads. Frames are located with the frame index, which also
+                // covers partial render.
+                if (iCparams.enableMTParse_)
+                {
+                    errorCode_ = StartMTParser(iCparams, inputFileStem_ + inputFileExt_ + ".idx");
+                    
+                    if (kIABNoError != errorCode_)
+                    {
+                        noError = false;
+                        break;
+                    }
+                }
+                else
+#endif
+                // Partial render, jump to start frame
+                if (iCparams.startFrame_ > 0)
+                {
+                    errorCode_ = SeekParserToFrame(iCparams.startFrame_, inputFileStem_ + inputFileExt_ + ".idx");
+                    
+                    if (kIABNoError != errorCode_)
+                    {
+                        noError = false;
+                        break;
+                    }
+                }
+            }
+            else if ((iCparams.frameCount_ > 0) && (inputFrameCount_ >= iCparams.frameCount_))
+            {
+                // Partial render, requested number of frames processed
+                break;
             }
 
 #ifdef MT_RENDERER_ENABLED
             timeStart = getTimeMS();
-			// Parse the bitstream into IAB frame
-			errorCode_ = iabParser_->ParseIABFrame();
+
+			if (iabParserMT_)
+			{
+				// Get next frame parsed ahead by the MT parser, only waiting if not yet parsed.
+				// Previous frame has been rendered, delete it.
+				if (iabParserMTFrame_)
+				{
+					IABFrameInterface::Delete(iabParserMTFrame_);
+					iabParserMTFrame_ = NULL;
+				}
+
+				errorCode_ = iabParserMT_->GetNextIABFrameReleased(iabParserMTFrame_);
+				unallowedFrameSubElementCount = iabParserMT_->GetUnallowedFrameSubElementCount();
+			}
+			else
+			{
+				// Parse the bitstream into IAB frame
+				errorCode_ = iabParser_->ParseIABFrame();
+
+				// Drop mapped pages of frames already parsed
+				inputFile_->releaseConsumed();
+
+				// Get cumulative unallowed frame sub element count encontered
+				// Accumulate in multi-file mode
+				unallowedFrameSubElementCount = iabParser_->GetUnallowedFrameSubElementCount();
+			}
+
             timeTaken = (getTimeMS() - timeStart);
             frameParsingTotal += timeTaken;
 #else
 			// Parse the bitstream into IAB frame
 			errorCode_ = iabParser_->ParseIABFrame();
-#endif
-			// *************************************************
+
+			// Drop mapped pages of frames already parsed
+			inputFile_->releaseConsumed();
 
 			// Get cumulative unallowed frame sub element count encontered
 			// Accumulate in multi-file mode
 			unallowedFrameSubElementCount = iabParser_->GetUnallowedFrameSubElementCount();
+#endif
+			// *************************************************
 
 			// Issue one-time warning if unallowed frame sub elements (outside of the "allowed" list
 			// as defined in ST2098-2 spec.) are found.
@@ -829,7 +934,19 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
             
             const IABFrameInterface *frameInterface = NULL;
             
-            if (kIABNoError != iabParser_->GetIABFrame(frameInterface) || frameInterface == NULL)
+#ifdef MT_RENDERER_ENABLED
+            if (iabParserMT_)
+            {
+                frameInterface = iabParserMTFrame_;
+            }
+            else
+#endif
+            if (kIABNoError != iabParser_->GetIABFrame(frameInterface))
+            {
+                frameInterface = NULL;
+            }
+            
+            if (frameInterface == NULL)
             {
                 noError = false;
                 break;
@@ -924,6 +1041,16 @@ int32_t RenderIABToFiles::RenderIABitstreamToFiles(CommandLineParams& iCparams)
 
     IssueRendererWarnings();
 
+    // Finalise output files. Headers of the output files are complete after this point.
+    bool writerError = !outputWriter_.Stop();
+    outputWriter_.ReportStats(std::cout);
+    
+    if (noError && (writerError || (0 != wavWriter_.close())))
+    {
+        std::cerr << "!Error in writing output wav files. Check that the disk is not full." << std::endl;
+        noError = false;
+    }
+
     if (!noError)
     {
         return 1;
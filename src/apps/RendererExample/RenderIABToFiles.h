@@ -45,6 +45,9 @@
 #include "IABParserAPI.h"
 
 #include "waveutils/WaveIO.h"
+#include "waveutils/WAVStreamWriter.h"
+#include "AsyncOutputWriter.h"
+#include "commonstream/utils/MappedFile.h"
 
 #if (__GNUC__)
 #include <errno.h>
@@ -82,6 +85,18 @@ struct CommandLineParams
 		threadPoolSize_ = 4;				// default to 4 threads
 
         ignoreBitStreamVersion_ = false;
+
+        startFrame_ = 0;
+        frameCount_ = 0;
+
+        enableMTParse_ = false;
+
+        interleavedOutput_ = false;
+        bw64Output_ = false;
+
+        writerRingSize_ = 8;
+
+        ditherOutput_ = false;
     }
     
     std::string inputFileStem_;             // Stores input file name stem, including relative or full path
@@ -99,13 +114,32 @@ struct CommandLineParams
     // Dev control to allow parsing of bitstreams with invalid versions
     bool ignoreBitStreamVersion_;           // When set to true the app will attempt to parse bitstreams with
                                             // invalid version numbers.
+
+    // Partial rendering, single-file input only. Uses a frame index, cached in a sidecar file next to the input.
+    uint32_t startFrame_;                   // Index of first frame to render
+    uint32_t frameCount_;                   // Number of frames to render. 0: render to end of bitstream.
+
+    // Parse frames ahead of rendering, on threadPoolSize_ worker threads. Single-file input only.
+    bool enableMTParse_;
+
+    // Write all rendered channels to a single interleaved multichannel wav file, instead of one mono file per channel.
+    bool interleavedOutput_;
+
+    // Output files larger than 4 GB are written as BW64 instead of RF64.
+    bool bw64Output_;
+
+    // Number of rendered frames queued for the output writer thread. 0: write output on the rendering thread.
+    uint32_t writerRingSize_;
+
+    // Quantize rendered output to the 24-bit output sample size with TPDF dither, instead of rounding.
+    bool ditherOutput_;
 };
 
 /**
  *
  * Class to render SMPTE Immersive Audio bitstream to wav files.
  * The class uses an IAB Parser to parse the bitstream and an IAB Renderer to render the parsed IAB frame to the specified target configuration.
- * The rendered output audio samples are then written to mono wav files.
+ * The rendered output audio samples are then written to mono wav files, or to a single interleaved multichannel wav file.
  */
 
 class RenderIABToFiles
@@ -148,11 +182,9 @@ private:
     {
         OutputFileInfo()
         {
-            outputWav_ = NULL;
             channelName_ = "";            
         };
         
-        WAVFile         *outputWav_;
         std::string     channelName_;
         
     } OutputFileInfo;
@@ -163,14 +195,26 @@ private:
     // Closes input and output files
     iabError    CloseInputOutputFiles();
     
-    // Creates output mono wav file
-    bool        CreateOutputFilesForSpeakers(uint32_t iSampleRate, const std::map<std::string, int32_t> iSpeakerToOutputIndexMap);
+    // Creates output wav files, one mono file per speaker or a single interleaved file when iInterleaved is true
+    bool        CreateOutputFilesForSpeakers(uint32_t iSampleRate, const std::map<std::string, int32_t> iSpeakerToOutputIndexMap, bool iInterleaved);
     
     // Creates an IAB Renderer and initialises with the specified renderer configuration file
     bool        CreateAndInitializeRenderer(std::string iRendererConfigFilePath, bool iEnableMT, uint32_t iThreadPoolSize);
 
     // Writes a frame of rendered audio samples to wav files
     iabError    WriteRendererOutputToFiles();
+
+    // Loads the bitstream frame index into the parser from sidecar file iIndexFilePath if valid,
+    // otherwise builds it and saves it to iIndexFilePath.
+    iabError    LoadOrBuildFrameIndex(const std::string &iIndexFilePath);
+
+    // Positions the parser at iStartFrame using the bitstream frame index.
+    iabError    SeekParserToFrame(uint32_t iStartFrame, const std::string &iIndexFilePath);
+
+#ifdef MT_RENDERER_ENABLED
+    // Starts parsing the frames to render on worker threads, using the bitstream frame index.
+    iabError    StartMTParser(CommandLineParams& iCparams, const std::string &iIndexFilePath);
+#endif
     
     // ******************
     // Class data members
@@ -187,15 +231,30 @@ private:
     
     // Path to the output wav files
     std::string             outputPath_;
+
+    // Write rendered channels to a single interleaved wav file
+    bool                    interleavedOutput_;
+
+    // Format of output files larger than 4 GB
+    WAVStreamWriter::LargeFileFormat largeFileFormat_;
+
+    // Number of rendered frames queued for the output writer thread
+    uint32_t                writerRingSize_;
+
+    // Quantize rendered output to the output sample size with TPDF dither, and the dither generator state
+    bool                    ditherOutput_;
+    unsigned int            ditherState_[4];
     
     // Pointer to the current input file to be processed.
-    std::ifstream 			*inputFile_;
+    CommonStream::MappedIStream *inputFile_;
     
     // Rendering related
     IABRendererInterface                *iabRendererinterface_;     // Pointer to IAB renderer
 
 #if __linux__ || __APPLE__
 	IABRendererMTInterface              *iabRendererMTinterface_;   // Pointer to multi-threaded IAB renderer
+	IABParserMTInterface                *iabParserMT_;              // Pointer to multi-threaded IAB parser, when enabled
+	IABFrameInterface                   *iabParserMTFrame_;         // Frame delivered by iabParserMT_, owned until next frame
 #endif
 
 	RenderUtils::IRendererConfiguration *rendererConfig_;           // Pointer to the renderer configuration file
@@ -212,12 +271,18 @@ private:
     // the same throughtout
     IABRenderedOutputSampleCountType    iabFrameSampleCount_;
 
-    // This map provides output file information including channel name, rendered output index and wav writter
-    // Map key is the rendered output channel index. Map value is a struture containing channel name and wav writer pointer
+    // This map provides output file information including channel name and rendered output index
+    // Map key is the rendered output channel index. Map value is a struture containing channel name
     // This map is created from configuration speaker list during IABRenderer initialisation and is used to access the correct
     // channel when writing rendered samples to wav files.
     std::map<int32_t, OutputFileInfo>      outputFileMap_;
     
+    // Writer of the output wav files. Channel order is rendered output index order.
+    WAVStreamWriter         wavWriter_;
+
+    // Writer stage. Queues rendered output, converted to 32-bit integer PCM, for writing to wavWriter_ on a writer thread.
+    AsyncOutputWriter       outputWriter_;
+
     // Keeps track of issued warnings so they are only issued once
     std::map<iabError, int> issuedWarnings_;
 
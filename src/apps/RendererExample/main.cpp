@@ -63,6 +63,15 @@ void ShowUsage()
            "                When -o is not specified, the output files will be stored in the current working directory.\n"
            "                There is no space between -o and the output folder name.\n"
            "                WARNING: Existing wav files in the output folder with the same name will be over-written.\n"
+           " -f#            Index of the first frame to render. Single-file input (-s) only. Default: 0.\n"
+           "                A frame index of the input file is cached in a sidecar file <inputPath>.idx.\n"
+           " -n#            Number of frames to render. Single-file input (-s) only. Default: all frames.\n"
+           " --Interleaved  Write all rendered channels to a single interleaved multichannel wav file, Output.wav.\n"
+           "                Channels are in the order of the renderer outputs. Default: one mono wav file per channel.\n"
+           " --BW64         Write output files larger than 4 GB as BW64. Default: RF64.\n"
+           " --Dither       Quantize output to 24 bits with TPDF dither. Default: rounding.\n"
+           " -w#            Number of rendered frames buffered for the output writer thread, so writing overlaps with\n"
+           "                rendering. 0: write output on the rendering thread. Range: [0, 64], Default: 8.\n"
            " -h, --help     Show this application usage information.\n"
            "                With -h or --help, other command-line parameters are ignored, with the exception of\n"
            "                --ExtraHelp, which will have priority over -h or --help.\n"
@@ -77,7 +86,9 @@ void ShowUsage()
            "\n"
 #ifdef MT_RENDERER_ENABLED
            " --MTRender     Use multi-threaded renderer. Default: single-threaded renderer.\n"
-           " -t#            Thread pool size. Effective only when --MTRender is specified.\n"
+           " --MTParse      Parse frames ahead of rendering, on a pool of worker threads. Single-file input (-s) only.\n"
+           "                Uses the frame index of the input file, see -f#.\n"
+           " -t#            Thread pool size. Effective only when --MTRender or --MTParse is specified.\n"
            "                Range of thread pool size: [1, 8], Default to 4.\n"
            "\n"
 #else
@@ -94,7 +105,8 @@ void ShowExtendedHelpInformation()
            "and writes the audio samples of each rendered output channel to a 48kHz 24-bit mono PCM wav file.\n\n"
            "Naming convention for the wav file is Output-xxx.wav, where xxx is a channel label from the configuration\n"
            "file. For example, if the Left speaker in the configuration file has a label L, then its corresponding\n"
-           "wav file will be named Output-L.wav\n\n"
+           "wav file will be named Output-L.wav\n"
+           "With --Interleaved, all channels are written to a single multichannel wav file named Output.wav instead.\n\n"
            "Application usage examples:\n\n"
            "Example (1) multi-file input, assumming the current directory contains:\n"
            "    a) IAB-renderer-example application\n"
@@ -153,6 +165,10 @@ bool ExtractCommandlineParams(int argc, char* argv[], CommandLineParams&  cliPar
 		{
 			cliParams.enableMT_ = true;
 		}
+		else if (std::string(argv[i]).compare(0, 9, "--MTParse") == 0)
+		{
+			cliParams.enableMTParse_ = true;
+		}
 		else if (std::string(argv[i]).compare(0, 2, "-t") == 0)
 		{
 			std::string TPSizeString = argv[i];
@@ -177,6 +193,55 @@ bool ExtractCommandlineParams(int argc, char* argv[], CommandLineParams&  cliPar
 				return false;
 			}
 		}
+        else if (std::string(argv[i]).compare(0, 2, "-w") == 0)
+        {
+            std::string ringSizeString = argv[i];
+
+            if ((ringSizeString.size() < 3) || (ringSizeString.find_first_not_of("0123456789", 2) != std::string::npos))
+            {
+                std::cerr << "!Error:  Invalid -w option." << std::endl << std::endl;
+                return false;
+            }
+
+            cliParams.writerRingSize_ = static_cast<uint32_t>(strtoul(ringSizeString.c_str() + 2, NULL, 10));
+
+            if (cliParams.writerRingSize_ > 64)
+            {
+                std::cerr << "!Error: Output writer buffer count out of range." << std::endl << std::endl;
+                return false;
+            }
+        }
+        else if ((std::string(argv[i]).compare(0, 2, "-f") == 0) || (std::string(argv[i]).compare(0, 2, "-n") == 0))
+        {
+            std::string frameOptionString = argv[i];
+
+            if ((frameOptionString.size() < 3) || (frameOptionString.find_first_not_of("0123456789", 2) != std::string::npos))
+            {
+                std::cerr << "!Error:  Invalid " << frameOptionString.substr(0, 2) << " option." << std::endl << std::endl;
+                return false;
+            }
+
+            if (frameOptionString[1] == 'f')
+            {
+                cliParams.startFrame_ = static_cast<uint32_t>(strtoul(frameOptionString.c_str() + 2, NULL, 10));
+            }
+            else
+            {
+                cliParams.frameCount_ = static_cast<uint32_t>(strtoul(frameOptionString.c_str() + 2, NULL, 10));
+            }
+        }
+        else if (std::string(argv[i]).compare(0, 13, "--Interleaved") == 0)
+        {
+            cliParams.interleavedOutput_ = true;
+        }
+        else if (std::string(argv[i]).compare(0, 6, "--BW64") == 0)
+        {
+            cliParams.bw64Output_ = true;
+        }
+        else if (std::string(argv[i]).compare(0, 8, "--Dither") == 0)
+        {
+            cliParams.ditherOutput_ = true;
+        }
         else if (std::string(argv[i]).compare(0, 24, "--IgnoreBitstreamVersion") == 0)
         {
             cliParams.ignoreBitStreamVersion_ = true;
@@ -227,6 +292,18 @@ bool ExtractCommandlineParams(int argc, char* argv[], CommandLineParams&  cliPar
         cliParams.inputFileStem_.erase(cliParams.inputFileStem_.begin() + atmosOffset, cliParams.inputFileStem_.end());
     }
     
+    if (cliParams.multiFilesInput_ && ((cliParams.startFrame_ > 0) || (cliParams.frameCount_ > 0)))
+    {
+        std::cerr << "!Error: -f and -n options require single-file input (-s)." << std::endl << std::endl;
+        return false;
+    }
+
+    if (cliParams.multiFilesInput_ && cliParams.enableMTParse_)
+    {
+        std::cerr << "!Error: --MTParse option requires single-file input (-s)." << std::endl << std::endl;
+        return false;
+    }
+
     if (cliParams.outputPath_.size() != 0)
     {
         // no string after -o
@@ -34,7 +34,7 @@
 
 namespace dlc
 {
-    AudioData::AudioData() : shiftBits_(0), sampleRate_(eSampleRate_48000) {}
+    AudioData::AudioData() : shiftBits_(0), sampleRate_(eSampleRate_48000), packedResiduals_(false) {}
 
     AudioData::~AudioData()
     {
@@ -171,6 +171,8 @@ namespace dlc
             delete this->subBlocks48_.at(iBlockIndex);
         }
 
+        this->packedResiduals_ = false;
+
         switch (iCodeType)
         {
         case eCodeType_RICE_CODE_TYPE:
@@ -199,6 +201,8 @@ namespace dlc
             delete this->subBlocks96_.at(iBlockIndex);
         }
 
+        this->packedResiduals_ = false;
+
         switch (iCodeType)
         {
         case eCodeType_RICE_CODE_TYPE:
@@ -220,8 +224,66 @@ namespace dlc
         return this->subBlocks96_.at(iBlockIndex);
     }
 
+    void AudioData::initPackedResiduals(uint32_t iSubBlockSize48)
+    {
+        for (std::vector<ResidualSubBlock*>::iterator it = this->subBlocks48_.begin(); it < this->subBlocks48_.end(); it++)
+        {
+            delete *it;
+            *it = NULL;
+        }
+
+        for (std::vector<ResidualSubBlock*>::iterator it = this->subBlocks96_.begin(); it < this->subBlocks96_.end(); it++)
+        {
+            delete *it;
+            *it = NULL;
+        }
+
+        this->residualLayer48_.resize(this->getNumDLCSubBlocks(), iSubBlockSize48);
+
+        if (this->getSampleRate() == eSampleRate_96000)
+        {
+            this->residualLayer96_.resize(this->getNumDLCSubBlocks(), 2 * iSubBlockSize48);
+        }
+        else
+        {
+            this->residualLayer96_.resize(0, 0);
+        }
+
+        this->packedResiduals_ = true;
+    }
+
+    bool AudioData::hasPackedResiduals() const
+    {
+        return this->packedResiduals_;
+    }
+
+    ResidualLayer & AudioData::getResidualLayer48()
+    {
+        return this->residualLayer48_;
+    }
+
+    const ResidualLayer & AudioData::getResidualLayer48() const
+    {
+        return this->residualLayer48_;
+    }
+
+    ResidualLayer & AudioData::getResidualLayer96()
+    {
+        return this->residualLayer96_;
+    }
+
+    const ResidualLayer & AudioData::getResidualLayer96() const
+    {
+        return this->residualLayer96_;
+    }
+
     uint32_t AudioData::getSampleCount48() const
     {
+        if (this->packedResiduals_)
+        {
+            return this->residualLayer48_.getSize();
+        }
+
         uint32_t frameSize = 0;
 
         for (uint8_t i = 0; i < this->getNumDLCSubBlocks(); i++)
@@ -249,6 +311,11 @@ namespace dlc
             throw std::runtime_error("Sample rate of the Audio Data element is not 96 kHz.");
         }
 
+        if (this->packedResiduals_)
+        {
+            return this->residualLayer96_.getSize();
+        }
+
         uint32_t frameSize = 0;
 
         for (uint8_t i = 0; i < this->getNumDLCSubBlocks(); i++)
@@ -423,6 +490,69 @@ namespace dlc
         this->sign_ = iSign > 0 ? 1 : -1;
     }
 
+    ResidualLayer::ResidualLayer() : subBlockSize_(0)
+    {
+    }
+
+    void ResidualLayer::resize(uint8_t iNumSubBlocks, uint32_t iSubBlockSize)
+    {
+        // std::vector keeps its capacity when shrinking
+        this->subBlockSize_ = iSubBlockSize;
+        this->residuals_.resize(static_cast<size_t>(iNumSubBlocks) * iSubBlockSize);
+        this->codeTypes_.resize(iNumSubBlocks);
+        this->codingBits_.resize(iNumSubBlocks);
+    }
+
+    uint8_t ResidualLayer::getNumSubBlocks() const
+    {
+        return static_cast<uint8_t>(this->codeTypes_.size());
+    }
+
+    uint32_t ResidualLayer::getSubBlockSize() const
+    {
+        return this->subBlockSize_;
+    }
+
+    uint32_t ResidualLayer::getSize() const
+    {
+        return static_cast<uint32_t>(this->residuals_.size());
+    }
+
+    CodeType ResidualLayer::getCodeType(uint8_t iBlockIndex) const
+    {
+        return static_cast<CodeType>(this->codeTypes_.at(iBlockIndex));
+    }
+
+    void ResidualLayer::setCodeType(uint8_t iBlockIndex, CodeType iCodeType)
+    {
+        this->codeTypes_.at(iBlockIndex) = static_cast<uint8_t>(iCodeType);
+    }
+
+    uint5_t ResidualLayer::getCodingBits(uint8_t iBlockIndex) const
+    {
+        return this->codingBits_.at(iBlockIndex);
+    }
+
+    void ResidualLayer::setCodingBits(uint8_t iBlockIndex, uint5_t iNum)
+    {
+        if (iNum > UINT5_MAX)
+        {
+            throw std::out_of_range("Coding bits out of range.");
+        }
+
+        this->codingBits_.at(iBlockIndex) = iNum;
+    }
+
+    int32_t * ResidualLayer::getResiduals()
+    {
+        return this->residuals_.data();
+    }
+
+    const int32_t * ResidualLayer::getResiduals() const
+    {
+        return this->residuals_.data();
+    }
+
     PredRegion::PredRegion() : regionLength_(0), order_(0)
     {
         std::fill(kCoeff_, kCoeff_ + 32, (dlc::uint10_t) 0);
@@ -387,6 +387,104 @@ namespace dlc
 		std::vector<int32_t> residuals_;
 	};
 
+	/**
+	* Represents all residual sub blocks of one layer (either 48 kHz or 96 kHz) in packed form: a single
+	* array of signed residual values, in sub block order, and the entropy coding parameters of each sub block.
+	* All sub blocks of a layer have the same size, as required by ST 2098-2.
+	*
+	* Unlike RiceResidualsSubBlock, Rice/Golomb residuals are stored as their signed value. Storage is kept
+	* when the layer is resized, so that a layer can be refilled frame after frame without reallocation.
+	*/
+	class ResidualLayer
+	{
+	public:
+		ResidualLayer();
+
+		/**
+		* Sets the number and size of sub blocks of the layer. Residual values and coding parameters
+		* are left unspecified.
+		*
+		* @param[in] iNumSubBlocks Number of sub blocks
+		* @param[in] iSubBlockSize Size (in residuals) of each sub block
+		*/
+		void resize(uint8_t iNumSubBlocks, uint32_t iSubBlockSize);
+
+		/**
+		* Retrieves the number of sub blocks of the layer.
+		*
+		* @return Number of sub blocks
+		*/
+		uint8_t getNumSubBlocks() const;
+
+		/**
+		* Retrieves the size (in residuals) of each sub block of the layer.
+		*
+		* @return Sub block size
+		*/
+		uint32_t getSubBlockSize() const;
+
+		/**
+		* Retrieves the number of residuals of the layer, ie. getNumSubBlocks() * getSubBlockSize().
+		*
+		* @return Number of residuals
+		*/
+		uint32_t getSize() const;
+
+		/**
+		* Retrieves the IAB CodeType of a sub block.
+		*
+		* @param[in] iBlockIndex Index of the sub block in the range [0, getNumSubBlocks() )
+		* @return IAB CodeType of the sub block
+		*/
+		CodeType getCodeType(uint8_t iBlockIndex) const;
+
+		/**
+		* Sets the IAB CodeType of a sub block.
+		*
+		* @param[in] iBlockIndex Index of the sub block in the range [0, getNumSubBlocks() )
+		* @param[in] iCodeType IAB CodeType of the sub block
+		*/
+		void setCodeType(uint8_t iBlockIndex, CodeType iCodeType);
+
+		/**
+		* Retrieves the IAB BitDepth (PCM sub block) or RiceRemBits (Rice/Golomb sub block) field of a sub block.
+		*
+		* @param[in] iBlockIndex Index of the sub block in the range [0, getNumSubBlocks() )
+		* @return IAB BitDepth or RiceRemBits field value
+		*/
+		uint5_t getCodingBits(uint8_t iBlockIndex) const;
+
+		/**
+		* Sets the IAB BitDepth (PCM sub block) or RiceRemBits (Rice/Golomb sub block) field of a sub block.
+		*
+		* @param[in] iBlockIndex Index of the sub block in the range [0, getNumSubBlocks() )
+		* @param[in] iNum IAB BitDepth or RiceRemBits field value
+		* @throws std::out_of_range if iNum is out of range
+		*/
+		void setCodingBits(uint8_t iBlockIndex, uint5_t iNum);
+
+		/**
+		* Retrieves the residuals of the layer, which can be modified in-place.
+		*
+		* @return Pointer to an array of getSize() residual values, in sub block order.
+		*/
+		int32_t* getResiduals();
+
+		/**
+		* Retrieves a read-only array of the residuals of the layer.
+		*
+		* @return Pointer to a constant array of getSize() residual values, in sub block order.
+		*/
+		const int32_t* getResiduals() const;
+
+	private:
+
+		uint32_t subBlockSize_;
+		std::vector<int32_t> residuals_;
+		std::vector<uint8_t> codeTypes_;
+		std::vector<uint5_t> codingBits_;
+	};
+
 	/**
 	* Represents the contents of a single IAB AudioDataDLC element.
 	* Serialization to an actual IAB AudioDataDLC element (or other representation) is not included.
@@ -607,7 +705,59 @@ namespace dlc
 		virtual const ResidualSubBlock* getDLCSubBlock96(uint8_t iBlockIndex) const;
 
 		/****************
-		* 96 kHz sub blocks
+		* Packed residuals
+		*
+		*/
+
+		/**
+		* Stores the residuals of the element in packed form, ie. in getResidualLayer48() and getResidualLayer96(),
+		* instead of individual sub blocks. Existing sub blocks are released. Calling initDLCSubBlock48() or
+		* initDLCSubBlock96() afterwards reverts to individual sub blocks.
+		*
+		* The layers are sized from getNumDLCSubBlocks() and getSampleRate(), which must be set beforehand. The
+		* 96 kHz layer is only sized for a 96 kHz element.
+		*
+		* @param[in] iSubBlockSize48 Size (in residuals) of the 48 kHz sub blocks. 96 kHz sub blocks are twice as large.
+		*/
+		virtual void initPackedResiduals(uint32_t iSubBlockSize48);
+
+		/**
+		* Indicates whether the residuals of the element are in packed form.
+		*
+		* @return true following initPackedResiduals(), false following initDLCSubBlock48() or initDLCSubBlock96()
+		*/
+		virtual bool hasPackedResiduals() const;
+
+		/**
+		* Retrieves the packed 48 kHz residuals, which can be modified in place
+		*
+		* @return Reference to the 48 kHz residual layer
+		*/
+		virtual ResidualLayer& getResidualLayer48();
+
+		/**
+		* Retrieves the read-only packed 48 kHz residuals
+		*
+		* @return Reference to the 48 kHz residual layer
+		*/
+		virtual const ResidualLayer& getResidualLayer48() const;
+
+		/**
+		* Retrieves the packed 96 kHz residuals, which can be modified in place
+		*
+		* @return Reference to the 96 kHz residual layer
+		*/
+		virtual ResidualLayer& getResidualLayer96();
+
+		/**
+		* Retrieves the read-only packed 96 kHz residuals
+		*
+		* @return Reference to the 96 kHz residual layer
+		*/
+		virtual const ResidualLayer& getResidualLayer96() const;
+
+		/****************
+		* Sample counts
 		*
 		*/
 
@@ -615,7 +765,7 @@ namespace dlc
 		* Retrieves SampleCount48 for the frame represented by the DLCAudioData element
 		*
 		* @return SampleCount48 (the number of 48 kHz samples in the frame)
-		* @throws runtime_error if any 48 kHz sub block is undefined
+		* @throws runtime_error if any 48 kHz sub block is undefined, unless residuals are packed
 		*/
 		virtual uint32_t getSampleCount48() const;
 
@@ -623,7 +773,7 @@ namespace dlc
 		* Retrieves SampleCount96 for the frame represented by the DLCAudioData element
 		*
 		* @return SampleCount96 (the number of 96 kHz samples in the frame)
-		* @throws runtime_error if any 96 kHz sub block is undefined or if getSampleRate() != FS_96000
+		* @throws runtime_error if any 96 kHz sub block is undefined (unless residuals are packed) or if getSampleRate() != FS_96000
 		*/
 		virtual uint32_t getSampleCount96() const;
 
@@ -635,6 +785,9 @@ namespace dlc
 		std::vector<PredRegion> predRegions96_;
 		std::vector<ResidualSubBlock*> subBlocks48_;
 		std::vector<ResidualSubBlock*> subBlocks96_;
+		bool packedResiduals_;
+		ResidualLayer residualLayer48_;
+		ResidualLayer residualLayer96_;
 	};
 
 } // namespace dlc
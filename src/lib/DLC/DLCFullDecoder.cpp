@@ -28,6 +28,7 @@
  *======================================================================*/
 
 #include "DLC/DLCFullDecoder.h"
+#include "DLC/DLCInterpolator.h"
 #include <algorithm>
 #include <stdexcept>
 
@@ -39,6 +40,266 @@ namespace dlc
 		int32_t c_[32];
 	};
 
+	// Converts lattice prediction coefficients of a region to direct form coefficients
+	//
+	static void LatticeToDirectForm(const PredRegion &iRegion, _TempCoeffs &oCoeffs)
+	{
+		int32_t aCoeffsTemp[32];
+
+		oCoeffs.c_[0] = 1048576;
+
+		for (int32_t j = 1; j <= iRegion.getOrder(); j++)
+		{
+			int32_t kCoeff_nj = iRegion.getKCoeff()[j];
+
+			kCoeff_nj -= 512;
+			kCoeff_nj <<= 11;
+
+			oCoeffs.c_[j] = 0;
+
+			for (int32_t k = 1; k <= j; k++)
+			{
+				int64_t accum64 = static_cast<int64_t>(kCoeff_nj) * oCoeffs.c_[j - k];
+				aCoeffsTemp[k] = oCoeffs.c_[k] + static_cast<int32_t>(accum64 >> 20);
+			}
+
+			for (int32_t k = 1; k <= j; k++)
+			{
+				oCoeffs.c_[k] = aCoeffsTemp[k];
+			}
+		}
+	}
+
+	// Applies inverse prediction filters, in place, to the residuals held in ioSamples. Each region
+	// covers getRegionLength() sub blocks of iSubBlockSize samples.
+	//
+	static void InversePredict(int32_t *ioSamples
+		, int32_t iStride
+		, uint32_t iSampleCount
+		, uint32_t iSubBlockSize
+		, uint2_t iNumRegions
+		, const PredRegion * const iRegions[]
+		, const _TempCoeffs iCoeffs[])
+	{
+		int32_t buffer[64] = { 0 };
+
+		int32_t index1 = 0;
+
+		int32_t *curSample = ioSamples;
+
+		uint32_t remaining = iSampleCount;
+
+		for (uint2_t i = 0; i < iNumRegions; i++)
+		{
+			const PredRegion &pr = *iRegions[i];
+			const int32_t *coeffs = iCoeffs[i].c_;
+			uint32_t regionSize = pr.getRegionLength() * iSubBlockSize;
+
+			if (regionSize > remaining)
+			{
+				throw std::runtime_error("Predictor regions exceed the coded signal size.");
+			}
+
+			remaining -= regionSize;
+
+			for (uint32_t k = 0; k < regionSize; k++)
+			{
+				int32_t index2 = index1;
+				int64_t accum64 = 0;
+
+				for (int32_t p = 1; p <= pr.getOrder(); p++)
+				{
+					accum64 -= (static_cast<int64_t>(buffer[index2]) *
+						static_cast<int64_t>(coeffs[p]));
+
+					index2--;
+					index2 &= 63;
+				}
+
+				int32_t output = static_cast<int32_t>(accum64 >> 20);
+				output += *curSample;
+
+				index1++;
+				index1 &= 63;
+				buffer[index1] = output;
+
+				*curSample = output;
+				curSample += iStride;
+			}
+		}
+	}
+
+	// Lockstep form of InversePredict(), on Lanes channels whose samples are interleaved in ioSamples
+	// (iSampleCount rows of Lanes samples). Lanes past their last predictor region pass their residuals
+	// through, as do lanes without regions, by using all-zero coefficients.
+	//
+	template<uint32_t Lanes>
+	static void InversePredictLanes(int32_t *ioSamples
+		, uint32_t iSampleCount
+		, uint32_t iSubBlockSize
+		, const uint2_t iNumRegions[Lanes]
+		, const PredRegion * const iRegions[Lanes][UINT2_MAX + 1]
+		, const _TempCoeffs iCoeffs[Lanes][UINT2_MAX + 1])
+	{
+		int32_t history[64][Lanes] = { { 0 } };
+		int32_t coeffs[33][Lanes];
+
+		int32_t index1 = 0;
+
+		uint32_t numSubBlocks = iSampleCount / iSubBlockSize;
+
+		// Region of each lane covering the current sub block, and sub blocks left in it
+		uint32_t region[Lanes];
+		uint32_t blocksLeft[Lanes];
+
+		for (uint32_t l = 0; l < Lanes; l++)
+		{
+			uint32_t regionBlocks = 0;
+
+			for (uint2_t n = 0; n < iNumRegions[l]; n++)
+			{
+				regionBlocks += iRegions[l][n]->getRegionLength();
+			}
+
+			if (regionBlocks > numSubBlocks)
+			{
+				throw std::runtime_error("Predictor regions exceed the coded signal size.");
+			}
+
+			region[l] = 0;
+			blocksLeft[l] = 0;
+
+			while (region[l] < iNumRegions[l] && (blocksLeft[l] = iRegions[l][region[l]]->getRegionLength()) == 0)
+			{
+				region[l]++;
+			}
+		}
+
+		int32_t *curRow = ioSamples;
+
+		for (uint32_t b = 0; b < numSubBlocks; b++)
+		{
+			// Set up the coefficients of each lane for the sub block
+			int32_t maxOrder = 0;
+
+			for (uint32_t l = 0; l < Lanes; l++)
+			{
+				int32_t order = 0;
+
+				if (region[l] < iNumRegions[l])
+				{
+					order = iRegions[l][region[l]]->getOrder();
+				}
+
+				for (int32_t p = 1; p <= 32; p++)
+				{
+					coeffs[p][l] = (p <= order) ? iCoeffs[l][region[l]].c_[p] : 0;
+				}
+
+				maxOrder = std::max(maxOrder, order);
+			}
+
+			for (uint32_t k = 0; k < iSubBlockSize; k++)
+			{
+				int64_t accum64[Lanes] = { 0 };
+
+				int32_t index2 = index1;
+
+				for (int32_t p = 1; p <= maxOrder; p++)
+				{
+					const int32_t *h = history[index2];
+					const int32_t *c = coeffs[p];
+
+					for (uint32_t l = 0; l < Lanes; l++)
+					{
+						accum64[l] -= static_cast<int64_t>(h[l]) * static_cast<int64_t>(c[l]);
+					}
+
+					index2--;
+					index2 &= 63;
+				}
+
+				index1++;
+				index1 &= 63;
+
+				for (uint32_t l = 0; l < Lanes; l++)
+				{
+					int32_t output = static_cast<int32_t>(accum64[l] >> 20) + curRow[l];
+
+					history[index1][l] = output;
+					curRow[l] = output;
+				}
+
+				curRow += Lanes;
+			}
+
+			// Advance to the next region of lanes that have exhausted the current one
+			for (uint32_t l = 0; l < Lanes; l++)
+			{
+				if (region[l] < iNumRegions[l] && --blocksLeft[l] == 0)
+				{
+					region[l]++;
+
+					while (region[l] < iNumRegions[l] && (blocksLeft[l] = iRegions[l][region[l]]->getRegionLength()) == 0)
+					{
+						region[l]++;
+					}
+				}
+			}
+		}
+	}
+
+	// Lockstep upsampling of Lanes interleaved channels of 48 kHz samples (iSampleCount48 rows) to 96 kHz,
+	// adding the 96 kHz layer held in ioSamples96 (2 * iSampleCount48 rows), in place.
+	//
+	template<uint32_t Lanes>
+	static void UpsampleLanes(const int32_t *iSamples48, int32_t *ioSamples96, uint32_t iSampleCount48)
+	{
+		int32_t history[64][Lanes] = { { 0 } };
+
+		int32_t index1 = 0;
+
+		for (uint32_t t = 0; t < iSampleCount48; t++)
+		{
+			const int32_t *row48 = iSamples48 + t * Lanes;
+			int32_t *even96 = ioSamples96 + 2 * t * Lanes;
+			int32_t *odd96 = even96 + Lanes;
+
+			for (uint32_t l = 0; l < Lanes; l++)
+			{
+				history[index1][l] = row48[l];
+			}
+
+			const int32_t *delayed = history[(index1 - 8) & 63];
+
+			int64_t accum64[Lanes] = { 0 };
+
+			int32_t index2 = index1;
+
+			for (int32_t i = 1; i < 33; i += 2)
+			{
+				const int32_t *h = history[index2];
+
+				for (uint32_t l = 0; l < Lanes; l++)
+				{
+					accum64[l] += static_cast<int64_t>(h[l]) * InterpolatorFilterCoeffs[i];
+				}
+
+				index2--;
+				index2 &= 63;
+			}
+
+			for (uint32_t l = 0; l < Lanes; l++)
+			{
+				even96[l] = delayed[l] + even96[l];
+				odd96[l] = static_cast<int32_t>(accum64[l] >> 15) + odd96[l];
+			}
+
+			index1++;
+			index1 &= 63;
+		}
+	}
+
 	// *** See ST 2098-2 for a description of the algorithm.
 	//
 	void FullDecoder::decode(int32_t * oSamples
@@ -46,17 +307,11 @@ namespace dlc
 		, SampleRate iSampleRateCode
 		, const AudioData& iDLCData)
 	{
-		// Flag is the decoding is in "decoding 96k iDLCData into 48k output" mode
-		// Default to false.
-		bool isDecoding96kTo48kOutput = false;
-
 		if (oSamples == NULL || iSampleCount == 0)
 		{
 			throw std::invalid_argument("No samples provided.");
 		}
 
-		SampleRate dlcSampleRate = iDLCData.getSampleRate();
-
 		// Set decoding based on client's desired output sample rate, iSampleRateCode
 		switch (iSampleRateCode)
 		{
@@ -66,17 +321,10 @@ namespace dlc
 				throw std::invalid_argument("Output sample buffer size does not match coded signal size");
 			}
 
-			// If iDLCData contains 96k, set isDecoding96kTo48kOutput to enable decoding
-			// 96k to 48k output only
-			if (dlcSampleRate == eSampleRate_96000)
-			{
-				isDecoding96kTo48kOutput = true;
-			}
-
 			break;
 
 		case eSampleRate_96000:
-			if (dlcSampleRate != eSampleRate_96000)
+			if (iDLCData.getSampleRate() != eSampleRate_96000)
 			{
 				throw std::invalid_argument("Cannot decode to 96 kHz from 48 kHz coded signal.");
 			}
@@ -89,17 +337,23 @@ namespace dlc
 			break;
 		}
 
-		// The samples vector is used to hold intermediary results during the decoding process.
-		//
-		int32_t stride48 = 1;
+		bool isDecodingTo96kOutput = (iSampleRateCode == eSampleRate_96000);
 
-		// In particular, in the case of decoding to full 96 kHz output samples, the 48 kHz base 
-		// layer samples are stored every second sample (stride = 2)
-		if ((iSampleRateCode == eSampleRate_96000) && !isDecoding96kTo48kOutput)
+		// Packed residuals are decoded in place, without extraction
+		if (iDLCData.hasPackedResiduals())
 		{
-			stride48 = 2;
+			decodeResiduals(oSamples, iSampleCount, iSampleRateCode, iDLCData
+				, iDLCData.getResidualLayer48().getSubBlockSize()
+				, iDLCData.getResidualLayer48().getResiduals()
+				, isDecodingTo96kOutput ? iDLCData.getResidualLayer96().getResiduals() : NULL);
+
+			return;
 		}
 
+		// In the case of decoding to full 96 kHz output samples, the 48 kHz base 
+		// layer samples are stored every second sample (stride = 2)
+		int32_t stride48 = isDecodingTo96kOutput ? 2 : 1;
+
 		// *** extract 48 kHz layer residuals
 		//
 		int32_t* curSample = oSamples;
@@ -145,104 +399,13 @@ namespace dlc
 			}
 		}  // End of "for (uint8_t i = 0; i < iDLCData.getNumDLCSubBlocks(); i++)"
 
-		// 48 kHz Lattice Prediction Coefficients to Direct Form Coefficients
-
-		std::vector<_TempCoeffs> aCoeffs48(iDLCData.getNumPredRegions48());
-
-		for (uint2_t n = 0; n < iDLCData.getNumPredRegions48(); n++)
-		{
-			int32_t aCoeffsTemp[32];
-
-			aCoeffs48[n].c_[0] = 1048576;
-
-			const PredRegion &pr = iDLCData.getPredRegion48(n);
-
-			for (int32_t j = 1; j <= pr.getOrder(); j++)
-			{
-				int32_t kCoeff48_nj = pr.getKCoeff()[j];
-
-				kCoeff48_nj -= 512;
-				kCoeff48_nj <<= 11;
-
-				aCoeffs48[n].c_[j] = 0;
-
-				for (int32_t k = 1; k <= j; k++)
-				{
-					int64_t accum64 = static_cast<int64_t>(kCoeff48_nj) * aCoeffs48[n].c_[j - k];
-					aCoeffsTemp[k] = aCoeffs48[n].c_[k] + static_cast<int32_t>(accum64 >> 20);
-				}
-
-				for (int32_t k = 1; k <= j; k++)
-				{
-					aCoeffs48[n].c_[k] = aCoeffsTemp[k];
-				}
-			}
-		}  // End of "for (uint2_t n = 0; n < iDLCData.getNumPredRegions48(); n++)"
-
-		// apply filters to 48 KHz residuals
-
-		curSample = oSamples;
-
-		int32_t buffer[64] = { 0 };
-
-		int32_t index1 = 0;
-
-		uint8_t curBlock = 0;
-
-		// Inverse prediction processing only when number of predictor region is greater than 0.
-		// oSamples already contain residual samples, which are PCM samples when no prediction.
-		if (iDLCData.getNumPredRegions48() > 0)
-		{
-			for (uint2_t i = 0; i < iDLCData.getNumPredRegions48(); i++)
-			{
-				const PredRegion &pr = iDLCData.getPredRegion48(i);
-
-				for (uint4_t j = 0; j < pr.getRegionLength(); j++)
-				{
-					const ResidualSubBlock *rsb = iDLCData.getDLCSubBlock48(curBlock);
-
-					if (rsb == NULL)
-					{
-						throw std::runtime_error("At least one 48 kHz DLC Subblock is undefined.");
-					}
-
-					for (uint32_t k = 0; k < rsb->getSize(); k++)
-					{
-						int32_t index2 = index1;
-						int64_t accum64 = 0;
-
-						for (int32_t p = 1; p <= pr.getOrder(); p++)
-						{
-							accum64 -= (static_cast<int64_t>(buffer[index2]) *
-								static_cast<int64_t>(aCoeffs48[i].c_[p]));
-
-							index2--;
-							index2 &= 63;
-						}
-
-						int32_t output = static_cast<int32_t>(accum64 >> 20);
-						output += *curSample;
-
-						index1++;
-						index1 &= 63;
-						buffer[index1] = output;
-
-						*curSample = output;
-						curSample += stride48;
-					}
-				}
-			}
-		}  // End of "if (iDLCData.getNumPredRegions48() > 0)"
-
-		// *** handle 96 kHz layer
+		// *** extract 96 kHz layer residuals
 		//
-		if (dlcSampleRate == eSampleRate_96000 && !isDecoding96kTo48kOutput)
+		if (isDecodingTo96kOutput)
 		{
-			// 96 kHz layer residuals
-
-			std::vector<int32_t> residuals96(iSampleCount, 0);
+			residuals96_.assign(iSampleCount, 0);
 
-			std::vector<int32_t>::iterator curResidual96 = residuals96.begin();
+			std::vector<int32_t>::iterator curResidual96 = residuals96_.begin();
 
 			for (uint8_t i = 0; i < iDLCData.getNumDLCSubBlocks(); i++)
 			{
@@ -276,142 +439,313 @@ namespace dlc
 					}
 				}
 			}  // End of "for (uint8_t i = 0; i < iDLCData.getNumDLCSubBlocks(); i++)"
+		}
 
-			// 96 kHz Lattice Prediction Coefficients to Direct Form Coefficients
+		// Sub block sizes are uniform across the element (ST 2098-2)
+		uint32_t subBlockSize48 = iDLCData.getDLCSubBlock48(0)->getSize();
+		uint32_t subBlockSize96 = isDecodingTo96kOutput ? iDLCData.getDLCSubBlock96(0)->getSize() : 0;
 
-			std::vector<_TempCoeffs> aCoeffs96(iDLCData.getNumPredRegions96());
+		reconstruct(oSamples, iSampleCount, isDecodingTo96kOutput, iDLCData, subBlockSize48, subBlockSize96);
+	}
 
-			for (uint2_t n = 0; n < iDLCData.getNumPredRegions96(); n++)
+	// *** See ST 2098-2 for a description of the algorithm.
+	//
+	void FullDecoder::decodeResiduals(int32_t * oSamples
+		, uint32_t iSampleCount
+		, SampleRate iSampleRateCode
+		, const AudioData& iPredictionData
+		, uint32_t iSubBlockSize48
+		, const int32_t * iResiduals48
+		, const int32_t * iResiduals96)
+	{
+		if (oSamples == NULL || iSampleCount == 0 || iResiduals48 == NULL)
+		{
+			throw std::invalid_argument("No samples provided.");
+		}
+
+		uint32_t sampleCount48 = iPredictionData.getNumDLCSubBlocks() * iSubBlockSize48;
+
+		bool isDecodingTo96kOutput = (iSampleRateCode == eSampleRate_96000);
+
+		if (isDecodingTo96kOutput)
+		{
+			if (iPredictionData.getSampleRate() != eSampleRate_96000 || iResiduals96 == NULL)
 			{
-				int32_t aCoeffsTemp[32];
+				throw std::invalid_argument("Cannot decode to 96 kHz from 48 kHz coded signal.");
+			}
 
-				aCoeffs96[n].c_[0] = 1048576;
+			if (2 * sampleCount48 != iSampleCount)
+			{
+				throw std::invalid_argument("Output sample buffer size does not match coded signal size");
+			}
+		}
+		else if (sampleCount48 != iSampleCount)
+		{
+			throw std::invalid_argument("Output sample buffer size does not match coded signal size");
+		}
 
-				const PredRegion &pr = iDLCData.getPredRegion48(n);
+		// *** place 48 kHz layer residuals
+		//
+		if (isDecodingTo96kOutput)
+		{
+			for (uint32_t i = 0; i < sampleCount48; i++)
+			{
+				oSamples[2 * i] = iResiduals48[i];
+			}
 
-				for (int32_t j = 1; j <= pr.getOrder(); j++)
-				{
-					int32_t kCoeff96_nj = pr.getKCoeff()[j];
+			residuals96_.assign(iResiduals96, iResiduals96 + iSampleCount);
+		}
+		else
+		{
+			std::copy(iResiduals48, iResiduals48 + sampleCount48, oSamples);
+		}
 
-					kCoeff96_nj -= 512;
-					kCoeff96_nj <<= 11;
+		reconstruct(oSamples, iSampleCount, isDecodingTo96kOutput, iPredictionData, iSubBlockSize48, 2 * iSubBlockSize48);
+	}
 
-					aCoeffs96[n].c_[j] = 0;
+	// Inverse prediction, upsampling and shift stages common to decode() and decodeResiduals().
+	// On entry, oSamples holds the 48 kHz residuals (every second sample when decoding to 96 kHz)
+	// and residuals96_ holds the 96 kHz residuals when decoding to 96 kHz.
+	//
+	void FullDecoder::reconstruct(int32_t * oSamples
+		, uint32_t iSampleCount
+		, bool iDecodeTo96k
+		, const AudioData& iDLCData
+		, uint32_t iSubBlockSize48
+		, uint32_t iSubBlockSize96)
+	{
+		int32_t stride48 = iDecodeTo96k ? 2 : 1;
 
-					for (int32_t k = 1; k <= j; k++)
-					{
-						int64_t accum64 = static_cast<int64_t>(kCoeff96_nj) * aCoeffs96[n].c_[j - k];
-						aCoeffsTemp[k] = aCoeffs96[n].c_[k] + static_cast<int32_t>(accum64 >> 20);
-					}
+		const PredRegion *regions[UINT2_MAX + 1];
+		_TempCoeffs aCoeffs[UINT2_MAX + 1];
 
-					for (int32_t k = 1; k <= j; k++)
-					{
-						aCoeffs96[n].c_[k] = aCoeffsTemp[k];
-					}
-				}
-			}  // End of "for (uint2_t n = 0; n < iDLCData.getNumPredRegions96(); n++)"
+		// 48 kHz Lattice Prediction Coefficients to Direct Form Coefficients, then
+		// apply filters to 48 KHz residuals.
+		// Inverse prediction processing only when number of predictor region is greater than 0.
+		// oSamples already contain residual samples, which are PCM samples when no prediction.
+
+		for (uint2_t n = 0; n < iDLCData.getNumPredRegions48(); n++)
+		{
+			regions[n] = &iDLCData.getPredRegion48(n);
+			LatticeToDirectForm(*regions[n], aCoeffs[n]);
+		}
+
+		InversePredict(oSamples, stride48, iSampleCount / stride48, iSubBlockSize48
+			, iDLCData.getNumPredRegions48(), regions, aCoeffs);
+
+		// *** handle 96 kHz layer
+		//
+		if (iDecodeTo96k)
+		{
+			// 96 kHz Lattice Prediction Coefficients to Direct Form Coefficients
+			// Note: coefficients are derived from the 48 kHz regions, as in the reference
+			// implementation.
+
+			for (uint2_t n = 0; n < iDLCData.getNumPredRegions96(); n++)
+			{
+				LatticeToDirectForm(iDLCData.getPredRegion48(n), aCoeffs[n]);
+				regions[n] = &iDLCData.getPredRegion96(n);
+			}
 
 			// apply filters to 96 KHz residuals
 
-			curResidual96 = residuals96.begin();
+			InversePredict(residuals96_.data(), 1, iSampleCount, iSubBlockSize96
+				, iDLCData.getNumPredRegions96(), regions, aCoeffs);
 
-			std::fill(buffer, (buffer + 64), 0);
+			// upsample 48 kHz samples to 96 kHz and add 96 Hz residuals. The 48 kHz samples are
+			// gathered into a linear buffer, behind kDLCInterpHistory zeros, since the output
+			// overwrites them.
 
-			index1 = 0;
+			uint32_t sampleCount48 = iSampleCount / 2;
 
-			curBlock = 0;
+			samples48_.resize(kDLCInterpHistory + sampleCount48);
+			std::fill(samples48_.begin(), samples48_.begin() + kDLCInterpHistory, 0);
 
-			// Inverse prediction processing only when number of predictor region is greater than 0.
-			// residuals96 already contain residual samples, which are PCM samples when no prediction.
-			if (iDLCData.getNumPredRegions96() > 0)
+			for (uint32_t t = 0; t < sampleCount48; t++)
 			{
-				for (uint2_t i = 0; i < iDLCData.getNumPredRegions96(); i++)
-				{
-					const PredRegion &pr = iDLCData.getPredRegion96(i);
+				samples48_[kDLCInterpHistory + t] = oSamples[2 * t];
+			}
 
-					for (uint8_t j = 0; j < pr.getRegionLength(); j++)
-					{
-						const ResidualSubBlock *rsb = iDLCData.getDLCSubBlock96(curBlock);
+			Interpolate48kTo96k(samples48_.data() + kDLCInterpHistory, sampleCount48, oSamples);
+
+			const int32_t *curResidual96 = residuals96_.data();
+
+			for (int32_t *curSample = oSamples; curSample < oSamples + iSampleCount; curSample++)
+			{
+				*curSample += *(curResidual96++);
+			}
 
-						if (rsb == NULL)
-						{
-							throw std::runtime_error("At least one 96 kHz DLC Subblock is undefined.");
-						}
+		}  // End of "if (iDecodeTo96k)"
 
-						for (uint16_t k = 0; k < rsb->getSize(); k++)
-						{
-							int32_t index2 = index1;
-							int64_t accum64 = 0;
+		// shift bits
 
-							for (int32_t p = 1; p <= pr.getOrder(); p++)
-							{
-								accum64 -= (static_cast<int64_t>(buffer[index2]) *
-									static_cast<int64_t>(aCoeffs96[i].c_[p]));
+		for (int32_t *curSample = oSamples; curSample < oSamples + iSampleCount; curSample++)
+		{
+			*curSample <<= iDLCData.getShiftBits();
+		}
+	}
 
-								index2--;
-								index2 &= 63;
-							}
+	template<uint32_t Lanes>
+	void FullDecoder::decodeLanes(const ResidualChannel * iChannels
+		, uint32_t iChannelCount
+		, uint32_t iSampleCount48
+		, bool iDecodeTo96k
+		, uint32_t iSubBlockSize48)
+	{
+		uint2_t numRegions[Lanes];
+		const PredRegion *regions[Lanes][UINT2_MAX + 1];
+		_TempCoeffs aCoeffs[Lanes][UINT2_MAX + 1];
 
-							int32_t output = static_cast<int32_t>(accum64 >> 20);
-							output += *curResidual96;
+		// Interleave 48 kHz residuals. Unused lanes decode silence.
+		lanes48_.assign(iSampleCount48 * Lanes, 0);
 
-							index1++;
-							index1 &= 63;
-							buffer[index1] = output;
+		for (uint32_t l = 0; l < Lanes; l++)
+		{
+			numRegions[l] = 0;
 
-							*curResidual96++ = output;
-						}
-					}
-				}
-			}  // End of "for (uint2_t n = 0; n < iDLCData.getNumPredRegions96(); n++)"
+			if (l >= iChannelCount)
+			{
+				continue;
+			}
+
+			const AudioData &predictionData = *iChannels[l].predictionData_;
+			const int32_t *curResidual = iChannels[l].residuals48_;
+
+			for (uint32_t t = 0; t < iSampleCount48; t++)
+			{
+				lanes48_[t * Lanes + l] = *curResidual++;
+			}
+
+			numRegions[l] = predictionData.getNumPredRegions48();
 
-			// upsample 48 kHz samples to 96 kHz and add 96 Hz residuals
+			for (uint2_t n = 0; n < numRegions[l]; n++)
+			{
+				regions[l][n] = &predictionData.getPredRegion48(n);
+				LatticeToDirectForm(*regions[l][n], aCoeffs[l][n]);
+			}
+		}
 
-			std::fill(buffer, (buffer + 64), 0);
+		InversePredictLanes<Lanes>(lanes48_.data(), iSampleCount48, iSubBlockSize48, numRegions, regions, aCoeffs);
 
-			index1 = 0;
+		const int32_t *decoded = lanes48_.data();
+		uint32_t decodedCount = iSampleCount48;
 
-			curSample = oSamples;
+		if (iDecodeTo96k)
+		{
+			uint32_t sampleCount96 = 2 * iSampleCount48;
 
-			curResidual96 = residuals96.begin();
+			lanes96_.assign(sampleCount96 * Lanes, 0);
 
-			while (curSample < oSamples + iSampleCount)
+			for (uint32_t l = 0; l < Lanes; l++)
 			{
-				buffer[index1] = *curSample;
+				numRegions[l] = 0;
 
-				int32_t index2 = index1;
-				index2 -= 8;
-				index2 &= 63;
+				if (l >= iChannelCount)
+				{
+					continue;
+				}
 
-				*(curSample++) = buffer[index2] + *(curResidual96++);
+				const AudioData &predictionData = *iChannels[l].predictionData_;
+				const int32_t *curResidual = iChannels[l].residuals96_;
 
-				index2 = index1;
+				for (uint32_t t = 0; t < sampleCount96; t++)
+				{
+					lanes96_[t * Lanes + l] = *curResidual++;
+				}
 
-				int64_t accum64 = 0;
+				// As in reconstruct(), coefficients are derived from the 48 kHz regions
+				numRegions[l] = predictionData.getNumPredRegions96();
 
-				for (int32_t i = 1; i < 33; i += 2)
+				for (uint2_t n = 0; n < numRegions[l]; n++)
 				{
-					accum64 += (static_cast<int64_t>(buffer[index2]) * InterpolatorFilterCoeffs[i]);
-					index2--;
-					index2 &= 63;
+					LatticeToDirectForm(predictionData.getPredRegion48(n), aCoeffs[l][n]);
+					regions[l][n] = &predictionData.getPredRegion96(n);
 				}
+			}
 
-				*(curSample++) = static_cast<int32_t>(accum64 >> 15) + *(curResidual96++);
+			InversePredictLanes<Lanes>(lanes96_.data(), sampleCount96, 2 * iSubBlockSize48, numRegions, regions, aCoeffs);
 
-				index1++;
-				index1 &= 63;
-			}  // End of "while (curSample < oSamples + iSampleCount)"
+			UpsampleLanes<Lanes>(lanes48_.data(), lanes96_.data(), iSampleCount48);
+
+			decoded = lanes96_.data();
+			decodedCount = sampleCount96;
+		}
 
-		}  // End of "if (dlcSampleRate == eSampleRate_96000 && !isDecoding96kTo48kOutput)"
+		// De-interleave and shift bits
 
-		// shift bits
+		for (uint32_t l = 0; l < iChannelCount; l++)
+		{
+			int32_t *curSample = iChannels[l].samples_;
+			uint5_t shiftBits = iChannels[l].predictionData_->getShiftBits();
+
+			for (uint32_t t = 0; t < decodedCount; t++)
+			{
+				*curSample++ = decoded[t * Lanes + l] << shiftBits;
+			}
+		}
+	}
 
-		for (curSample = oSamples; curSample < oSamples + iSampleCount; curSample++)
+	void FullDecoder::decodeResidualsBatch(const ResidualChannel * iChannels
+		, uint32_t iChannelCount
+		, uint32_t iSampleCount
+		, SampleRate iSampleRateCode
+		, uint32_t iSubBlockSize48)
+	{
+		if (iChannels == NULL || iChannelCount == 0 || iSampleCount == 0 || iSubBlockSize48 == 0)
 		{
-			*curSample <<= iDLCData.getShiftBits();
+			throw std::invalid_argument("No samples provided.");
 		}
 
-		return;
+		bool isDecodingTo96kOutput = (iSampleRateCode == eSampleRate_96000);
+
+		uint32_t sampleCount48 = isDecodingTo96kOutput ? iSampleCount / 2 : iSampleCount;
+
+		for (uint32_t i = 0; i < iChannelCount; i++)
+		{
+			const ResidualChannel &channel = iChannels[i];
+
+			if (channel.samples_ == NULL || channel.predictionData_ == NULL || channel.residuals48_ == NULL)
+			{
+				throw std::invalid_argument("No samples provided.");
+			}
+
+			if (isDecodingTo96kOutput
+				&& (channel.predictionData_->getSampleRate() != eSampleRate_96000 || channel.residuals96_ == NULL))
+			{
+				throw std::invalid_argument("Cannot decode to 96 kHz from 48 kHz coded signal.");
+			}
+
+			if (channel.predictionData_->getNumDLCSubBlocks() * iSubBlockSize48 != sampleCount48
+				|| (isDecodingTo96kOutput && 2 * sampleCount48 != iSampleCount))
+			{
+				throw std::invalid_argument("Output sample buffer size does not match coded signal size");
+			}
+		}
+
+		// Widest groups first, then a final (padded) group of 4 lanes
+		while (iChannelCount > 0)
+		{
+			uint32_t groupSize = 0;
+
+			if (iChannelCount >= 16)
+			{
+				groupSize = 16;
+				decodeLanes<16>(iChannels, groupSize, sampleCount48, isDecodingTo96kOutput, iSubBlockSize48);
+			}
+			else if (iChannelCount >= 8)
+			{
+				groupSize = 8;
+				decodeLanes<8>(iChannels, groupSize, sampleCount48, isDecodingTo96kOutput, iSubBlockSize48);
+			}
+			else
+			{
+				groupSize = std::min(iChannelCount, static_cast<uint32_t>(4));
+				decodeLanes<4>(iChannels, groupSize, sampleCount48, isDecodingTo96kOutput, iSubBlockSize48);
+			}
+
+			iChannels += groupSize;
+			iChannelCount -= groupSize;
+		}
 	}
 
 	FullDecoder::StatusCode FullDecoder::decode_noexcept(int32_t * oSamples
@@ -431,4 +765,43 @@ namespace dlc
 		return StatusCode_OK;
 	}
 
-} // namespace dlc
\ No newline at end of file
+	FullDecoder::StatusCode FullDecoder::decodeResiduals_noexcept(int32_t * oSamples
+		, uint32_t iSampleCount
+		, SampleRate iSampleRateCode
+		, const AudioData& iPredictionData
+		, uint32_t iSubBlockSize48
+		, const int32_t * iResiduals48
+		, const int32_t * iResiduals96)
+	{
+		try
+		{
+			this->decodeResiduals(oSamples, iSampleCount, iSampleRateCode, iPredictionData
+				, iSubBlockSize48, iResiduals48, iResiduals96);
+		}
+		catch (...)
+		{
+			return StatusCode_FATAL_ERROR;
+		}
+
+		return StatusCode_OK;
+	}
+
+	FullDecoder::StatusCode FullDecoder::decodeResidualsBatch_noexcept(const ResidualChannel * iChannels
+		, uint32_t iChannelCount
+		, uint32_t iSampleCount
+		, SampleRate iSampleRateCode
+		, uint32_t iSubBlockSize48)
+	{
+		try
+		{
+			this->decodeResidualsBatch(iChannels, iChannelCount, iSampleCount, iSampleRateCode, iSubBlockSize48);
+		}
+		catch (...)
+		{
+			return StatusCode_FATAL_ERROR;
+		}
+
+		return StatusCode_OK;
+	}
+
+} // namespace dlc
@@ -31,6 +31,7 @@
 #define DLC_FULLDECODER_H
 
 #include "DLCCodec.h"
+#include <vector>
 
 namespace dlc
 {
@@ -67,6 +68,119 @@ namespace dlc
 			, uint32_t iSampleCount
 			, SampleRate iSampleRateCode
 			, const AudioData& iDLCData);
+
+        /**
+        * Decodes residuals that have already been entropy decoded, e.g. directly from an IAB bitstream,
+        * bypassing the ResidualSubBlock instances of an AudioData.
+        *
+        * @param[out] oSamples Decoded samples, iSampleCount long
+        * @param[in] iSampleCount Number of samples to decode
+        * @param[in] iSampleRateCode Output sample rate
+        * @param[in] iPredictionData Provides the sample rate, shift bits, number of sub blocks and predictor
+        *            regions. Its sub blocks are not accessed.
+        * @param[in] iSubBlockSize48 Size of each 48 kHz sub block. 96 kHz sub blocks are twice as long.
+        * @param[in] iResiduals48 48 kHz layer residuals, in sub block order
+        * @param[in] iResiduals96 96 kHz layer residuals, in sub block order. Only required when
+        *            iSampleRateCode is eSampleRate_96000.
+        * @throws std::invalid_argument if sampleRateCode is not supported
+        *                               if sampleCount is not supported
+        * @throws std::runtime_error if there is any inconsistency in predictionData
+        */
+        void decodeResiduals(int32_t * oSamples
+			, uint32_t iSampleCount
+			, SampleRate iSampleRateCode
+			, const AudioData& iPredictionData
+			, uint32_t iSubBlockSize48
+			, const int32_t * iResiduals48
+			, const int32_t * iResiduals96);
+
+        /**
+        * Identical semantics to decodeResiduals(), but catches all exceptions and returns an error code instead.
+        *
+        * @return Status following the decoding operation
+        */
+        StatusCode decodeResiduals_noexcept(int32_t * oSamples
+			, uint32_t iSampleCount
+			, SampleRate iSampleRateCode
+			, const AudioData& iPredictionData
+			, uint32_t iSubBlockSize48
+			, const int32_t * iResiduals48
+			, const int32_t * iResiduals96);
+
+        /**
+        * One channel of a decodeResidualsBatch() call
+        */
+        struct ResidualChannel
+        {
+            int32_t * samples_;                     /**< Decoded samples, iSampleCount long */
+            const AudioData * predictionData_;      /**< As iPredictionData of decodeResiduals() */
+            const int32_t * residuals48_;           /**< 48 kHz layer residuals, in sub block order */
+            const int32_t * residuals96_;           /**< 96 kHz layer residuals. Only required when decoding to 96 kHz. */
+        };
+
+        /**
+        * Maximum number of channels decoded in lockstep by decodeResidualsBatch()
+        */
+        static const uint32_t kMaxBatchLanes = 16;
+
+        /**
+        * Decodes several channels of entropy decoded residuals, with the same semantics as decodeResiduals()
+        * applied to each channel in turn.
+        *
+        * The inverse prediction and upsampling recursions are serial in time, but independent across channels.
+        * Channels are therefore decoded in groups of up to kMaxBatchLanes, one channel per lane, with all lanes
+        * advancing in lockstep through sample-interleaved working buffers.
+        *
+        * All channels must share the sample count, output sample rate and sub block size.
+        *
+        * @throws std::invalid_argument if sampleRateCode is not supported for any channel
+        *                               if sampleCount is not supported
+        * @throws std::runtime_error if there is any inconsistency in the prediction data of any channel
+        */
+        void decodeResidualsBatch(const ResidualChannel * iChannels
+			, uint32_t iChannelCount
+			, uint32_t iSampleCount
+			, SampleRate iSampleRateCode
+			, uint32_t iSubBlockSize48);
+
+        /**
+        * Identical semantics to decodeResidualsBatch(), but catches all exceptions and returns an error code instead.
+        *
+        * @return Status following the decoding operation
+        */
+        StatusCode decodeResidualsBatch_noexcept(const ResidualChannel * iChannels
+			, uint32_t iChannelCount
+			, uint32_t iSampleCount
+			, SampleRate iSampleRateCode
+			, uint32_t iSubBlockSize48);
+
+    private:
+
+        // Decodes a group of iChannelCount <= Lanes channels, see decodeResidualsBatch()
+        template<uint32_t Lanes>
+        void decodeLanes(const ResidualChannel * iChannels
+			, uint32_t iChannelCount
+			, uint32_t iSampleCount48
+			, bool iDecodeTo96k
+			, uint32_t iSubBlockSize48);
+
+        // Inverse prediction, upsampling and shift stages shared by decode() and decodeResiduals()
+        void reconstruct(int32_t * oSamples
+			, uint32_t iSampleCount
+			, bool iDecodeTo96k
+			, const AudioData& iDLCData
+			, uint32_t iSubBlockSize48
+			, uint32_t iSubBlockSize96);
+
+        // Working buffer for the 96 kHz layer, reused across calls
+        std::vector<int32_t> residuals96_;
+
+        // Linear 48 kHz input buffer of the 96 kHz interpolator, reused across calls
+        std::vector<int32_t> samples48_;
+
+        // Sample-interleaved working buffers of decodeResidualsBatch(), reused across calls
+        std::vector<int32_t> lanes48_;
+        std::vector<int32_t> lanes96_;
     };
 
 } // namespace dlc
@@ -0,0 +1,99 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include "DLC/DLCInterpolator.h"
+
+namespace dlc
+{
+	// Odd polyphase branch of InterpolatorFilterCoeffs, tap j applies to 48 kHz sample (t - j).
+	// Built from InterpolatorFilterCoeffs at static initialization so the two cannot diverge.
+	struct OddPhaseCoeffs
+	{
+		OddPhaseCoeffs()
+		{
+			for (uint32_t j = 0; j < kDLCInterpPhaseTaps; j++)
+			{
+				coeffs_[j] = static_cast<int32_t>(InterpolatorFilterCoeffs[2 * j + 1]);
+			}
+		}
+
+		int32_t coeffs_[kDLCInterpPhaseTaps];
+	};
+
+	static const OddPhaseCoeffs kOddPhaseCoeffs;
+
+	// Number of consecutive outputs computed together. The inner loops run over independent
+	// outputs with contiguous loads so that the compiler can map them onto vector registers.
+	static const uint32_t kInterpLanes = 8;
+
+	void Interpolate48kTo96k(const int32_t * iSamples48, uint32_t iSampleCount48, int32_t * oSamples96)
+	{
+		uint32_t t = 0;
+
+		for (; t + kInterpLanes <= iSampleCount48; t += kInterpLanes)
+		{
+			int64_t accum64[kInterpLanes] = { 0 };
+
+			for (uint32_t j = 0; j < kDLCInterpPhaseTaps; j++)
+			{
+				const int32_t *x = iSamples48 + t - j;
+				const int64_t c = kOddPhaseCoeffs.coeffs_[j];
+
+				for (uint32_t l = 0; l < kInterpLanes; l++)
+				{
+					accum64[l] += static_cast<int64_t>(x[l]) * c;
+				}
+			}
+
+			const int32_t *delayed = iSamples48 + t - kDLCInterpPhaseDelay;
+			int32_t *out = oSamples96 + 2 * t;
+
+			for (uint32_t l = 0; l < kInterpLanes; l++)
+			{
+				out[2 * l] = delayed[l];
+				out[2 * l + 1] = static_cast<int32_t>(accum64[l] >> 15);
+			}
+		}
+
+		for (; t < iSampleCount48; t++)
+		{
+			const int32_t *x = iSamples48 + t;
+			int64_t accum64 = 0;
+
+			for (uint32_t j = 0; j < kDLCInterpPhaseTaps; j++)
+			{
+				accum64 += static_cast<int64_t>(*(x - j)) * kOddPhaseCoeffs.coeffs_[j];
+			}
+
+			oSamples96[2 * t] = *(x - kDLCInterpPhaseDelay);
+			oSamples96[2 * t + 1] = static_cast<int32_t>(accum64 >> 15);
+		}
+	}
+
+} // namespace dlc
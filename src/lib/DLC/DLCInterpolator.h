@@ -0,0 +1,61 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#ifndef DLC_INTERPOLATOR_H
+#define DLC_INTERPOLATOR_H
+
+#include "DLCCodec.h"
+
+namespace dlc
+{
+
+	// Number of taps of each polyphase branch of the interpolation filter. The even branch reduces
+	// to the centre tap, i.e. a delay of kDLCInterpPhaseDelay 48 kHz samples, the odd branch holds
+	// the odd-indexed InterpolatorFilterCoeffs.
+	static const uint32_t kDLCInterpPhaseTaps = (kDLCInterpFiltOrder + 1) >> 1;
+	static const uint32_t kDLCInterpPhaseDelay = kDLCInterpFiltGrpDelay >> 1;
+
+	// Number of leading history samples required in front of the input of Interpolate48kTo96k()
+	static const uint32_t kDLCInterpHistory = kDLCInterpPhaseTaps - 1;
+
+	/**
+	* Upsamples 48 kHz samples to 96 kHz with the interpolation filter of ST 2098-2, Section B.9.
+	*
+	* The input is a linear buffer: iSamples48[-kDLCInterpHistory .. -1] must hold the preceding
+	* samples (zeros at the start of a frame). Output is bit-exact with the direct-form filter.
+	*
+	* @param[in] iSamples48 48 kHz samples
+	* @param[in] iSampleCount48 Number of 48 kHz samples
+	* @param[out] oSamples96 2 * iSampleCount48 96 kHz samples. Must not overlap iSamples48.
+	*/
+	void Interpolate48kTo96k(const int32_t * iSamples48, uint32_t iSampleCount48, int32_t * oSamples96);
+
+} // namespace dlc
+
+#endif // #ifndef DLC_INTERPOLATOR_H
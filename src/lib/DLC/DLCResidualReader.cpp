@@ -0,0 +1,221 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include "DLC/DLCResidualReader.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace dlc
+{
+	// Number of leading zero bits of a non-zero 64-bit value
+	static inline uint32_t CountLeadingZeros64(uint64_t iVal)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<uint32_t>(__builtin_clzll(iVal));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, iVal);
+		return 63 - static_cast<uint32_t>(index);
+#else
+		uint32_t count = 0;
+
+		while (!(iVal & 0x8000000000000000ULL))
+		{
+			iVal <<= 1;
+			count++;
+		}
+
+		return count;
+#endif
+	}
+
+	ResidualReader::ResidualReader(const uint8_t *iData, uint32_t iSize)
+	{
+		cur_ = iData;
+		end_ = iData + iSize;
+		cache_ = 0;
+		cacheBits_ = 0;
+	}
+
+	void ResidualReader::refill()
+	{
+		while (cacheBits_ <= 56 && cur_ < end_)
+		{
+			cache_ |= static_cast<uint64_t>(*cur_++) << (56 - cacheBits_);
+			cacheBits_ += 8;
+		}
+	}
+
+	bool ResidualReader::readBits(uint32_t &oVal, uint8_t iNumBits)
+	{
+		if (iNumBits == 0)
+		{
+			oVal = 0;
+			return true;
+		}
+
+		if (cacheBits_ < iNumBits)
+		{
+			refill();
+
+			if (cacheBits_ < iNumBits)
+			{
+				return false;
+			}
+		}
+
+		oVal = static_cast<uint32_t>(cache_ >> (64 - iNumBits));
+		cache_ <<= iNumBits;
+		cacheBits_ -= iNumBits;
+
+		return true;
+	}
+
+	bool ResidualReader::readUnary(int32_t &oCount)
+	{
+		oCount = 0;
+
+		for (;;)
+		{
+			if (cacheBits_ == 0)
+			{
+				refill();
+
+				if (cacheBits_ == 0)
+				{
+					return false;
+				}
+			}
+
+			// Bits past cacheBits_ are zero, so the count of leading ones stops at cacheBits_ at most.
+			// The inverted cache is only zero for a full cache of ones.
+			uint64_t inverted = ~cache_;
+			uint32_t ones = (inverted != 0) ? CountLeadingZeros64(inverted) : 64;
+
+			if (ones < cacheBits_)
+			{
+				oCount += static_cast<int32_t>(ones);
+
+				// Consume the ones and the terminating zero
+				cache_ <<= ones;
+				cache_ <<= 1;
+				cacheBits_ -= ones + 1;
+
+				return true;
+			}
+
+			// All cached bits are ones, continue with the next bytes
+			oCount += static_cast<int32_t>(cacheBits_);
+			cache_ = 0;
+			cacheBits_ = 0;
+		}
+	}
+
+	bool ResidualReader::readPCMResiduals(int32_t *oResiduals, uint32_t iCount, uint5_t iBitDepth)
+	{
+		if (iBitDepth == 0)
+		{
+			for (uint32_t i = 0; i < iCount; i++)
+			{
+				oResiduals[i] = 0;
+			}
+
+			return true;
+		}
+
+		for (uint32_t i = 0; i < iCount; i++)
+		{
+			uint32_t magnitude = 0;
+			uint32_t sign = 0;
+
+			if (!readBits(magnitude, iBitDepth))
+			{
+				return false;
+			}
+
+			int32_t residualValue = static_cast<int32_t>(magnitude);
+
+			// Sign is only present for non-zero residuals, 1 == negative
+			if (residualValue != 0)
+			{
+				if (!readBits(sign, 1))
+				{
+					return false;
+				}
+
+				if (sign)
+				{
+					residualValue *= -1;
+				}
+			}
+
+			oResiduals[i] = residualValue;
+		}
+
+		return true;
+	}
+
+	bool ResidualReader::readRiceResiduals(int32_t *oResiduals, uint32_t iCount, uint5_t iRiceRemBits)
+	{
+		for (uint32_t i = 0; i < iCount; i++)
+		{
+			int32_t quotient = 0;
+			uint32_t remainder = 0;
+			uint32_t sign = 0;
+
+			if (!readUnary(quotient) || !readBits(remainder, iRiceRemBits))
+			{
+				return false;
+			}
+
+			int32_t residualValue = (quotient << iRiceRemBits) + static_cast<int32_t>(remainder);
+
+			// Sign is only present for non-zero residuals, 1 == negative
+			if ((remainder != 0) || (quotient > 0))
+			{
+				if (!readBits(sign, 1))
+				{
+					return false;
+				}
+
+				if (sign)
+				{
+					residualValue = -residualValue;
+				}
+			}
+
+			oResiduals[i] = residualValue;
+		}
+
+		return true;
+	}
+
+} // namespace dlc
@@ -0,0 +1,102 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#ifndef DLC_RESIDUALREADER_H
+#define DLC_RESIDUALREADER_H
+
+#include "DLCAudioData.h"
+
+namespace dlc
+{
+
+    /**
+    * Reads the fields of an IAB AudioDataDLC payload from memory, most significant bit first.
+    *
+    * Bits are served from a 64-bit cache refilled a byte at a time, so that Rice/Golomb unary
+    * prefixes are counted with a single count-leading-zeros per cache load rather than bit by bit.
+    * Decoded residuals are identical to those of the bit-serial reader in IABAudioDataDLC.
+    */
+    class ResidualReader
+    {
+    public:
+
+        /**
+        * @param[in] iData Payload bytes. Must remain valid for the lifetime of the reader.
+        * @param[in] iSize Number of payload bytes
+        */
+        ResidualReader(const uint8_t *iData, uint32_t iSize);
+
+        /**
+        * Reads an unsigned field.
+        *
+        * @param[out] oVal Value of the field
+        * @param[in] iNumBits Width of the field, in the range [0, 32]
+        * @return false if the payload holds fewer than iNumBits bits
+        */
+        bool readBits(uint32_t &oVal, uint8_t iNumBits);
+
+        /**
+        * Reads the residuals of a PCM coded sub block (Residual48/Residual96 and sign fields).
+        *
+        * @param[out] oResiduals Signed residuals, iCount long
+        * @param[in] iCount Number of residuals in the sub block
+        * @param[in] iBitDepth IAB BitDepth of the sub block
+        * @return false if the payload ends before the sub block
+        */
+        bool readPCMResiduals(int32_t *oResiduals, uint32_t iCount, uint5_t iBitDepth);
+
+        /**
+        * Reads the residuals of a Rice/Golomb coded sub block (unary bits, Residual48/Residual96 and sign fields).
+        *
+        * @param[out] oResiduals Signed residuals, iCount long
+        * @param[in] iCount Number of residuals in the sub block
+        * @param[in] iRiceRemBits IAB RiceRemBits of the sub block
+        * @return false if the payload ends before the sub block
+        */
+        bool readRiceResiduals(int32_t *oResiduals, uint32_t iCount, uint5_t iRiceRemBits);
+
+    private:
+
+        // Tops up the cache with whole bytes, to at least 57 bits unless the payload is exhausted
+        void refill();
+
+        // Counts the unary (one) bits preceding the next zero bit, and consumes them and the zero bit
+        bool readUnary(int32_t &oCount);
+
+        const uint8_t *cur_;
+        const uint8_t *end_;
+
+        // Unread bits, left-aligned. Bits below the cacheBits_ most significant ones are zero.
+        uint64_t cache_;
+        uint32_t cacheBits_;
+    };
+
+} // namespace dlc
+
+#endif // #ifndef DLC_RESIDUALREADER_H
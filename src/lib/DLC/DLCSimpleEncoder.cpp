@@ -28,12 +28,376 @@
  *======================================================================*/
 
 #include "DLC/DLCSimpleEncoder.h"
+#include "DLC/DLCInterpolator.h"
 #include <algorithm>
 #include <stdexcept>
 #include <cstdlib>
+#include <cmath>
+#include <vector>
 
 namespace dlc
 {
+	// Number of 96k LPF outputs computed together in lpfFilter96k()
+	static const int32_t kLPFLanes = 8;
+
+	// Maximum predictor order searched, per effort level
+	static const int32_t kMaxPredOrderFast = 16;
+	static const int32_t kMaxPredOrderThorough = UINT5_MAX;
+
+	// Bit costs of the fixed width fields of a residual sub block (CodeType, BitDepth or RiceRemBits),
+	// of a predictor region (RegionLength, Order) and of each KCoeff of a region
+	static const uint64_t kSubBlockHeadBits = 1 + 5;
+	static const uint64_t kPredRegionHeadBits = 4 + 5;
+	static const uint64_t kKCoeffBits = 10;
+
+	// Residual magnitudes at or above this limit are not coded, so that the decoder's 32-bit
+	// reconstruction cannot overflow
+	static const int64_t kMaxResidualMagnitude = static_cast<int64_t>(1) << 30;
+
+	// Returns the number of bits needed to represent iValue
+	static uint5_t BitLength(uint32_t iValue)
+	{
+		uint5_t bitLength = 0;
+
+		while (iValue > 0)
+		{
+			iValue >>= 1;
+			bitLength++;
+		}
+
+		return bitLength;
+	}
+
+	// Computes the bit depth required to represent the maximum magnitude of iResiduals.
+	// The bit length of the maximum magnitude is that of the OR of all magnitudes.
+	static uint5_t ComputePCMBitDepth(const int32_t * iResiduals, uint32_t iCount)
+	{
+		uint32_t magnitudeBits = 0;
+
+		for (uint32_t j = 0; j < iCount; j++)
+		{
+			magnitudeBits |= static_cast<uint32_t>(abs(iResiduals[j]));
+		}
+
+		return BitLength(magnitudeBits);
+	}
+
+	// Coding of a residual sub block, and its bit cost excluding the sub block head
+	struct SubBlockCoding
+	{
+		CodeType codeType_;
+		uint5_t codingBits_;
+		uint64_t bits_;
+	};
+
+	// Chooses PCM or Rice/Golomb coding of a sub block, whichever is smaller.
+	// The Rice parameter is estimated from the mean residual magnitude, with an estimated cost that is
+	// an upper bound of the exact cost. With iExact, the parameters around the estimate are costed exactly.
+	static SubBlockCoding ChooseSubBlockCoding(const int32_t * iResiduals, uint32_t iCount, bool iExact)
+	{
+		uint64_t magnitudeSum = 0;
+		uint32_t magnitudeBits = 0;
+		uint32_t nonZeroCount = 0;
+
+		for (uint32_t j = 0; j < iCount; j++)
+		{
+			uint32_t magnitude = static_cast<uint32_t>(abs(iResiduals[j]));
+			magnitudeSum += magnitude;
+			magnitudeBits |= magnitude;
+			nonZeroCount += (magnitude != 0) ? 1 : 0;
+		}
+
+		uint5_t bitDepth = BitLength(magnitudeBits);
+
+		SubBlockCoding coding;
+		coding.codeType_ = eCodeType_PCM_CODE_TYPE;
+		coding.codingBits_ = bitDepth;
+		coding.bits_ = (bitDepth > 0) ? static_cast<uint64_t>(iCount) * bitDepth + nonZeroCount : 0;
+
+		if (bitDepth == 0)
+		{
+			return coding;
+		}
+
+		// Rice parameter k with 2^k <= mean magnitude < 2^(k + 1)
+		uint5_t riceRemBits = 0;
+
+		while ((riceRemBits + 1 < bitDepth) && ((static_cast<uint64_t>(iCount) << (riceRemBits + 1)) <= magnitudeSum))
+		{
+			riceRemBits++;
+		}
+
+		// Unary, terminating zero, remainder and sign bits. (sum >> k) bounds the sum of the quotients.
+		uint64_t riceBits = static_cast<uint64_t>(iCount) * (riceRemBits + 1) + (magnitudeSum >> riceRemBits) + nonZeroCount;
+
+		if (iExact)
+		{
+			uint5_t candidates[3] = { static_cast<uint5_t>(riceRemBits > 0 ? riceRemBits - 1 : 0), riceRemBits, static_cast<uint5_t>(riceRemBits + 1) };
+			uint64_t quotientSums[3] = { 0, 0, 0 };
+
+			for (uint32_t j = 0; j < iCount; j++)
+			{
+				uint32_t magnitude = static_cast<uint32_t>(abs(iResiduals[j]));
+
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					quotientSums[c] += magnitude >> candidates[c];
+				}
+			}
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				uint64_t candidateBits = static_cast<uint64_t>(iCount) * (candidates[c] + 1) + quotientSums[c] + nonZeroCount;
+
+				if (candidateBits < riceBits)
+				{
+					riceBits = candidateBits;
+					riceRemBits = candidates[c];
+				}
+			}
+		}
+
+		if (riceBits < coding.bits_)
+		{
+			coding.codeType_ = eCodeType_RICE_CODE_TYPE;
+			coding.codingBits_ = riceRemBits;
+			coding.bits_ = riceBits;
+		}
+
+		return coding;
+	}
+
+	// Bit cost of coding iSubBlockCount sub blocks of residuals, including sub block heads
+	static uint64_t ResidualsBitCost(const int32_t * iResiduals, uint32_t iSubBlockCount, uint32_t iSubBlockSize, bool iExact)
+	{
+		uint64_t bits = 0;
+
+		for (uint32_t i = 0; i < iSubBlockCount; i++)
+		{
+			bits += kSubBlockHeadBits + ChooseSubBlockCoding(iResiduals + i * iSubBlockSize, iSubBlockSize, iExact).bits_;
+		}
+
+		return bits;
+	}
+
+	// Quantized lattice predictor of a region, and its direct form coefficients (Q20) as derived by the decoder
+	struct LatticePredictor
+	{
+		uint5_t order_;
+		uint10_t kCoeff_[32];
+		int32_t aCoeff_[32];
+	};
+
+	// Computes the autocorrelation oR[0..iMaxLag] of iSamples
+	static void Autocorrelate(const int32_t * iSamples, uint32_t iCount, int32_t iMaxLag, double * oR)
+	{
+		for (int32_t lag = 0; lag <= iMaxLag; lag++)
+		{
+			double sum = 0.0;
+
+			for (uint32_t j = static_cast<uint32_t>(lag); j < iCount; j++)
+			{
+				sum += static_cast<double>(iSamples[j]) * iSamples[j - lag];
+			}
+
+			oR[lag] = sum;
+		}
+	}
+
+	// Levinson-Durbin recursion on the autocorrelation iR. Sets the reflection coefficients oK[1..order]
+	// and prediction error energies oError[0..order]. Returns the order reached, at most iMaxOrder.
+	static int32_t LevinsonDurbin(const double * iR, int32_t iMaxOrder, double * oK, double * oError)
+	{
+		double a[32] = { 0.0 };
+		double aTemp[32];
+
+		oError[0] = iR[0];
+
+		if (iR[0] <= 0.0)
+		{
+			return 0;
+		}
+
+		for (int32_t j = 1; j <= iMaxOrder; j++)
+		{
+			double accumulator = iR[j];
+
+			for (int32_t i = 1; i < j; i++)
+			{
+				accumulator += a[i] * iR[j - i];
+			}
+
+			double k = -accumulator / oError[j - 1];
+
+			if (!(k > -1.0 && k < 1.0))
+			{
+				return j - 1;
+			}
+
+			for (int32_t i = 1; i < j; i++)
+			{
+				aTemp[i] = a[i] + k * a[j - i];
+			}
+
+			for (int32_t i = 1; i < j; i++)
+			{
+				a[i] = aTemp[i];
+			}
+
+			a[j] = k;
+			oK[j] = k;
+			oError[j] = oError[j - 1] * (1.0 - k * k);
+		}
+
+		return iMaxOrder;
+	}
+
+	// Quantizes reflection coefficients iK[1..iOrder] to KCoeff values, and derives direct form
+	// coefficients with the decoder's fixed-point arithmetic. Returns false if the coefficients
+	// overflow that arithmetic.
+	static bool QuantizePredictor(const double * iK, uint5_t iOrder, LatticePredictor &oPredictor)
+	{
+		int32_t aCoeffsTemp[32];
+
+		oPredictor.order_ = iOrder;
+		std::fill(oPredictor.kCoeff_, oPredictor.kCoeff_ + 32, 0);
+		oPredictor.aCoeff_[0] = 1048576;
+
+		for (int32_t j = 1; j <= iOrder; j++)
+		{
+			int32_t kCoeff = static_cast<int32_t>(std::floor(iK[j] * 512.0 + 0.5)) + 512;
+			kCoeff = std::min(std::max(kCoeff, 0), UINT10_MAX);
+			oPredictor.kCoeff_[j] = static_cast<uint10_t>(kCoeff);
+
+			int32_t kCoeff_nj = (kCoeff - 512) << 11;
+
+			oPredictor.aCoeff_[j] = 0;
+
+			for (int32_t k = 1; k <= j; k++)
+			{
+				int64_t accum64 = static_cast<int64_t>(kCoeff_nj) * oPredictor.aCoeff_[j - k];
+				int64_t coeff = oPredictor.aCoeff_[k] + (accum64 >> 20);
+
+				if (coeff >= kMaxResidualMagnitude || coeff <= -kMaxResidualMagnitude)
+				{
+					return false;
+				}
+
+				aCoeffsTemp[k] = static_cast<int32_t>(coeff);
+			}
+
+			for (int32_t k = 1; k <= j; k++)
+			{
+				oPredictor.aCoeff_[k] = aCoeffsTemp[k];
+			}
+		}
+
+		return true;
+	}
+
+	// Computes the residuals of iSamples[iStart, iEnd) that the decoder's inverse prediction restores,
+	// using the samples before iStart as history. Returns false if a residual is out of coding range.
+	static bool PredictResiduals(const int32_t * iSamples, uint32_t iStart, uint32_t iEnd
+		, const LatticePredictor &iPredictor, int32_t * oResiduals)
+	{
+		const int32_t *aCoeffs = iPredictor.aCoeff_;
+		int32_t order = iPredictor.order_;
+
+		for (uint32_t n = iStart; n < iEnd; n++)
+		{
+			int64_t accum64 = 0;
+			int32_t available = std::min(order, static_cast<int32_t>(n));
+
+			for (int32_t p = 1; p <= available; p++)
+			{
+				accum64 -= static_cast<int64_t>(iSamples[n - p]) * aCoeffs[p];
+			}
+
+			int64_t residual = static_cast<int64_t>(iSamples[n]) - (accum64 >> 20);
+
+			if (residual >= kMaxResidualMagnitude || residual <= -kMaxResidualMagnitude)
+			{
+				return false;
+			}
+
+			oResiduals[n - iStart] = static_cast<int32_t>(residual);
+		}
+
+		return true;
+	}
+
+	// Best predictor of a region, its residuals and bit cost including the region head
+	struct RegionChoice
+	{
+		LatticePredictor predictor_;
+		uint64_t bits_;
+	};
+
+	// Chooses the predictor of the region of sub blocks [iFirst, iLast) of iSamples.
+	// The order is picked by estimating the cost of each order from the prediction error energy. With iExact,
+	// orders around the estimate are costed exactly on their residuals.
+	static void ChooseRegionPredictor(const int32_t * iSamples, uint32_t iFirst, uint32_t iLast
+		, uint32_t iSubBlockSize, int32_t iMaxOrder, bool iExact, RegionChoice &oChoice)
+	{
+		uint32_t start = iFirst * iSubBlockSize;
+		uint32_t end = iLast * iSubBlockSize;
+		uint32_t count = end - start;
+		int32_t residuals[kDLCMaxFrameSize48k];
+
+		double r[32];
+		double k[32];
+		double error[32];
+
+		int32_t maxOrder = std::min(iMaxOrder, static_cast<int32_t>(count) - 1);
+		Autocorrelate(iSamples + start, count, maxOrder, r);
+		maxOrder = LevinsonDurbin(r, maxOrder, k, error);
+
+		// Estimated bits relative to no prediction: 0.5 * log2(error ratio) per sample, plus coefficients
+		int32_t estimatedOrder = 0;
+		double estimatedBits = 0.0;
+
+		for (int32_t p = 1; p <= maxOrder; p++)
+		{
+			double bits = 0.5 * count * std::log(error[p] / error[0]) / std::log(2.0) + static_cast<double>(kKCoeffBits * p);
+
+			if (error[p] > 0.0 && bits < estimatedBits)
+			{
+				estimatedBits = bits;
+				estimatedOrder = p;
+			}
+		}
+
+		int32_t candidates[3] = { estimatedOrder, estimatedOrder / 2, std::min(estimatedOrder + estimatedOrder / 2, maxOrder) };
+		int32_t candidateCount = iExact ? 3 : 1;
+
+		// Order 0: residuals are the samples
+		oChoice.predictor_.order_ = 0;
+		oChoice.predictor_.aCoeff_[0] = 1048576;
+		std::fill(oChoice.predictor_.kCoeff_, oChoice.predictor_.kCoeff_ + 32, 0);
+		oChoice.bits_ = kPredRegionHeadBits + ResidualsBitCost(iSamples + start, iLast - iFirst, iSubBlockSize, iExact);
+
+		for (int32_t c = 0; c < candidateCount; c++)
+		{
+			LatticePredictor predictor;
+
+			if (candidates[c] <= 0 || (c > 0 && candidates[c] == candidates[0])
+				|| !QuantizePredictor(k, static_cast<uint5_t>(candidates[c]), predictor)
+				|| !PredictResiduals(iSamples, start, end, predictor, residuals))
+			{
+				continue;
+			}
+
+			uint64_t bits = kPredRegionHeadBits + kKCoeffBits * predictor.order_
+				+ ResidualsBitCost(residuals, iLast - iFirst, iSubBlockSize, iExact);
+
+			if (bits < oChoice.bits_)
+			{
+				oChoice.predictor_ = predictor;
+				oChoice.bits_ = bits;
+			}
+		}
+	}
+
 	// Constructor
 	SimpleEncoder::SimpleEncoder()
 	{
@@ -42,6 +406,8 @@ namespace dlc
 		numDLCSubBlocks_ = 10;
 		subBlockSize_ = 200;
 
+		effort_ = eEffort_Minimal;
+
 		// Initialize lpfDelayline_ to 0
 		std::fill(lpfDelayline_, (lpfDelayline_ + kDLCMaxFrameSize96k + kDLCLPF96kFiltOrder), 0);
 
@@ -196,6 +562,16 @@ namespace dlc
 	}
 
 
+	void SimpleEncoder::setEffort(Effort iEffort)
+	{
+		effort_ = iEffort;
+	}
+
+	SimpleEncoder::Effort SimpleEncoder::getEffort() const
+	{
+		return effort_;
+	}
+
 	/**
 	* See Minimal DLC Encoder at ST 2098-2 for a description of the algorithm.
 	*/
@@ -230,7 +606,7 @@ namespace dlc
 
 		oDLCData.setSampleRate(iSampleRateCode);
 
-		// predictors are not used 
+		// predictors are not used, unless set by predict48k() at higher effort levels
 		oDLCData.setNumPredRegions48(0);
 
 		oDLCData.setNumPredRegions96(0);
@@ -288,78 +664,184 @@ namespace dlc
 			}
 		}
 
-		// fille the PCM residual sub blocks with the input PCM samples
-		int32_t subBlockSample = 0;
+		// fill the packed residual layers
+		oDLCData.initPackedResiduals(subBlockSize48k);
+
+		ResidualLayer &layer48 = oDLCData.getResidualLayer48();
+		ResidualLayer &layer96 = oDLCData.getResidualLayer96();
+
+		if (effort_ != eEffort_Minimal)
+		{
+			// 48k (or base band of 96k) prediction. The 96k extension band is coded without prediction.
+			predict48k(inputSample48k, subBlockSize48k, oDLCData, layer48.getResiduals());
+			codeResidualLayer(layer48);
+
+			if (iSampleRateCode == eSampleRate_96000)
+			{
+				std::copy(inputSample96k, inputSample96k + frameSize_, layer96.getResiduals());
+				codeResidualLayer(layer96);
+			}
+
+			return;
+		}
 
+		// PCM residual layers with the input PCM samples
 		for (uint32_t i = 0; i < numDLCSubBlocks_; i++)
 		{
 			// DLC sub block residual coding for 48k (or base band of 96k)
-			oDLCData.initDLCSubBlock48(i, eCodeType_PCM_CODE_TYPE, subBlockSize48k);
+			uint8_t blockIndex = static_cast<uint8_t>(i);
+			int32_t *residuals = layer48.getResiduals() + i * subBlockSize48k;
 
-			PCMResidualsSubBlock *b = static_cast<PCMResidualsSubBlock*>(oDLCData.getDLCSubBlock48(i));
+			layer48.setCodeType(blockIndex, eCodeType_PCM_CODE_TYPE);
+			std::copy(inputSample48k + i * subBlockSize48k, inputSample48k + (i + 1) * subBlockSize48k, residuals);
+			layer48.setCodingBits(blockIndex, ComputePCMBitDepth(residuals, subBlockSize48k));
+			// ** End of 48k or baseband 48k coding
 
-			if (b == NULL)
+			// DLC sub block residual coding for 96k extension band 
+			if (iSampleRateCode == eSampleRate_96000)
 			{
-				throw std::runtime_error("At least one 48k DLC Subblock is undefined.");
+				residuals = layer96.getResiduals() + i * subBlockSize_;
+
+				layer96.setCodeType(blockIndex, eCodeType_PCM_CODE_TYPE);
+				std::copy(inputSample96k + i * subBlockSize_, inputSample96k + (i + 1) * subBlockSize_, residuals);
+				layer96.setCodingBits(blockIndex, ComputePCMBitDepth(residuals, subBlockSize_));
+				// ** End of 96k extension band coding
 			}
+		}
+	}
 
-			int32_t max = 0; ///< Keeps track of the maximum sample value in the subblock
-			uint5_t shiftBits = oDLCData.getShiftBits();
+	void SimpleEncoder::predict48k(const int32_t * iSamples, uint32_t iSubBlockSize, AudioData& oDLCData, int32_t * oResiduals)
+	{
+		uint32_t numSubBlocks = numDLCSubBlocks_;
+		uint32_t maxRegionLength = std::min(numSubBlocks, static_cast<uint32_t>(UINT4_MAX));
 
-			for (uint32_t j = 0; j < subBlockSize48k; j++)
-			{
-				subBlockSample = inputSample48k[i * subBlockSize48k + j];
-				b->getResiduals()[j] = subBlockSample;
-				max = std::max(abs(subBlockSample), max);
-			}
+		// Chosen regions, as [regionStarts[n], regionStarts[n + 1]) sub block ranges
+		uint32_t regionStarts[UINT2_MAX + 1] = { 0 };
+		LatticePredictor predictors[UINT2_MAX];
+		uint32_t numRegions = 0;
 
-			// computes the bit depth required to represent the maximum sample value
-			uint5_t requiredBitDepth = 0;
+		if (effort_ == eEffort_Fast)
+		{
+			// A single region, from the start of the frame, if it is estimated to reduce the payload
+			RegionChoice choice;
+			ChooseRegionPredictor(iSamples, 0, maxRegionLength, iSubBlockSize, kMaxPredOrderFast, false, choice);
 
-			while (max > 0)
+			if (choice.predictor_.order_ > 0)
 			{
-				max >>= 1;
-				requiredBitDepth++;
+				predictors[0] = choice.predictor_;
+				regionStarts[1] = maxRegionLength;
+				numRegions = 1;
 			}
+		}
+		else
+		{
+			// Regions are coded independently, given the samples preceding them. Cost each sub block range
+			// as a region, then pick the cheapest split into at most UINT2_MAX regions followed by an
+			// unpredicted tail.
+			const uint64_t kNoCost = ~static_cast<uint64_t>(0);
+			uint32_t numRanges = numSubBlocks + 1;
 
-			b->setBitDepth(requiredBitDepth);
-			// ** End of 48k or baseband 48k coding
+			std::vector<RegionChoice> choices(numRanges * numRanges);
+			std::vector<uint64_t> tailBits(numRanges, 0);
 
-			// DLC sub block residual coding for 96k extension band 
-			if (iSampleRateCode == eSampleRate_96000)
+			for (uint32_t first = 0; first < numSubBlocks; first++)
 			{
-				oDLCData.initDLCSubBlock96(i, eCodeType_PCM_CODE_TYPE, subBlockSize_);
+				tailBits[first] = ResidualsBitCost(iSamples + first * iSubBlockSize, numSubBlocks - first, iSubBlockSize, true);
 
-				b = static_cast<PCMResidualsSubBlock*>(oDLCData.getDLCSubBlock96(i));
-
-				if (b == NULL)
+				for (uint32_t last = first + 1; last <= std::min(numSubBlocks, first + maxRegionLength); last++)
 				{
-					throw std::runtime_error("At least one 96k DLC Subblock is undefined.");
+					ChooseRegionPredictor(iSamples, first, last, iSubBlockSize, kMaxPredOrderThorough, true, choices[first * numRanges + last]);
 				}
+			}
 
-				max = 0; ///< Keeps track of the maximum sample value in the subblock
-				shiftBits = oDLCData.getShiftBits();
+			// bestBits[r][s]: cheapest coding of sub blocks [0, s) with r regions, reached from sub block bestFrom[r][s]
+			std::vector<uint64_t> bestBits((UINT2_MAX + 1) * numRanges, kNoCost);
+			std::vector<uint32_t> bestFrom((UINT2_MAX + 1) * numRanges, 0);
+			bestBits[0] = 0;
 
-				for (uint32_t j = 0; j < subBlockSize_; j++)
+			for (uint32_t r = 0; r < UINT2_MAX; r++)
+			{
+				for (uint32_t first = 0; first < numSubBlocks; first++)
 				{
-					subBlockSample = inputSample96k[i * subBlockSize_ + j];
-					b->getResiduals()[j] = subBlockSample;
-					max = std::max(abs(subBlockSample), max);
+					uint64_t bits = bestBits[r * numRanges + first];
+
+					if (bits == kNoCost)
+					{
+						continue;
+					}
+
+					for (uint32_t last = first + 1; last <= std::min(numSubBlocks, first + maxRegionLength); last++)
+					{
+						uint64_t candidateBits = bits + choices[first * numRanges + last].bits_;
+
+						if (candidateBits < bestBits[(r + 1) * numRanges + last])
+						{
+							bestBits[(r + 1) * numRanges + last] = candidateBits;
+							bestFrom[(r + 1) * numRanges + last] = first;
+						}
+					}
 				}
+			}
 
-				// computes the bit depth required to represent the maximum sample value
-				requiredBitDepth = 0;
+			uint64_t minBits = kNoCost;
+			uint32_t regionsEnd = 0;
 
-				while (max > 0)
+			for (uint32_t r = 0; r <= UINT2_MAX; r++)
+			{
+				for (uint32_t last = 0; last <= numSubBlocks; last++)
 				{
-					max >>= 1;
-					requiredBitDepth++;
+					uint64_t bits = bestBits[r * numRanges + last];
+
+					if (bits != kNoCost && bits + tailBits[last] < minBits)
+					{
+						minBits = bits + tailBits[last];
+						numRegions = r;
+						regionsEnd = last;
+					}
 				}
+			}
 
-				b->setBitDepth(requiredBitDepth);
-				// ** End of 96k extension band coding
+			// Trace the regions back from the end of the last one
+			regionStarts[numRegions] = regionsEnd;
+
+			for (uint32_t r = numRegions; r > 0; r--)
+			{
+				regionStarts[r - 1] = bestFrom[r * numRanges + regionStarts[r]];
+				predictors[r - 1] = choices[regionStarts[r - 1] * numRanges + regionStarts[r]].predictor_;
 			}
 		}
+
+		oDLCData.setNumPredRegions48(static_cast<uint2_t>(numRegions));
+
+		for (uint32_t n = 0; n < numRegions; n++)
+		{
+			PredRegion &region = oDLCData.getPredRegion48(static_cast<uint2_t>(n));
+			region.setRegionLength(static_cast<uint4_t>(regionStarts[n + 1] - regionStarts[n]));
+			region.setOrder(predictors[n].order_);
+			region.setKCoeff(predictors[n].kCoeff_);
+
+			// Succeeded when the region was chosen
+			PredictResiduals(iSamples, regionStarts[n] * iSubBlockSize, regionStarts[n + 1] * iSubBlockSize
+				, predictors[n], oResiduals + regionStarts[n] * iSubBlockSize);
+		}
+
+		// Samples past the last region are not predicted
+		std::copy(iSamples + regionStarts[numRegions] * iSubBlockSize, iSamples + numSubBlocks * iSubBlockSize
+			, oResiduals + regionStarts[numRegions] * iSubBlockSize);
+	}
+
+	void SimpleEncoder::codeResidualLayer(ResidualLayer& ioLayer)
+	{
+		uint32_t subBlockSize = ioLayer.getSubBlockSize();
+
+		for (uint8_t i = 0; i < ioLayer.getNumSubBlocks(); i++)
+		{
+			SubBlockCoding coding = ChooseSubBlockCoding(ioLayer.getResiduals() + i * subBlockSize, subBlockSize
+				, effort_ == eEffort_Thorough);
+
+			ioLayer.setCodeType(i, coding.codeType_);
+			ioLayer.setCodingBits(i, coding.codingBits_);
+		}
 	}
 
 	SimpleEncoder::StatusCode SimpleEncoder::encode_noexcept(const int32_t * iSamples
@@ -404,10 +886,35 @@ namespace dlc
 			lpfDelayline_[frameSize_ - i - 1] = iSamples[i];
 		}
 
-		// Filter a frame/block (frameSize_) of samples
-		// 64-bit accumulator
+		// Filter a frame/block (frameSize_) of samples, kLPFLanes outputs at a time.
+		// Output i reads lpfDelayline_ from (frameSize_ - 1 - i), so the lanes of a block read
+		// adjacent taps and the inner loop vectorizes. Lane l holds output (i + kLPFLanes - 1 - l).
+		// 64-bit accumulators, bit exact with the one output at a time loop below.
+		i = 0;
+		for (; i + kLPFLanes <= static_cast<int32_t>(frameSize_); i += kLPFLanes)
+		{
+			const int32_t *taps = lpfDelayline_ + (frameSize_ - i - kLPFLanes);
+			int64_t accumulators[kLPFLanes] = { 0 };
+
+			for (uint32_t tap = 0; tap < (kDLCLPF96kFiltOrder + 1); tap++)
+			{
+				const int64_t coeff = LowPassFilterCoeffs[tap];
+
+				for (int32_t l = 0; l < kLPFLanes; l++)
+				{
+					accumulators[l] += coeff * taps[tap + l];
+				}
+			}
+
+			for (int32_t l = 0; l < kLPFLanes; l++)
+			{
+				oSamples[i + kLPFLanes - 1 - l] = static_cast<int32_t>(accumulators[l] >> kDLCLPFCoeffIntBitLength);
+			}
+		}
+
+		// Remaining samples, for frame sizes that are not a multiple of kLPFLanes
 		int64_t accumulator = 0;
-		for (i = 0; i < static_cast<int32_t>(frameSize_); i++)
+		for (; i < static_cast<int32_t>(frameSize_); i++)
 		{
 			accumulator = 0;
 			for (k = 0; k < (kDLCLPF96kFiltOrder + 1); k++)
@@ -489,43 +996,19 @@ namespace dlc
 	// Upsampling 48k samples back to 96k (for dev test only)
 	SimpleEncoder::StatusCode SimpleEncoder::upSampling48kTo96k(int32_t * iSamples, int32_t * oSamples)
 	{
-		int32_t buffer[64] = { 0 };
-		int32_t index1 = 0;
-		int32_t index2 = 0;
-		int64_t accum64 = 0;
-		int32_t i, k, n;
-
 		if (iSamples == NULL || oSamples == NULL)
 		{
 			return StatusCode_FATAL_ERROR;
 		}
 
-		// Upsample 48 kHz samples to 96 kHz
-		// Code below is a direct implementation as specified in ST2098-2, Section B.9
+		// Upsample 48 kHz samples to 96 kHz, as specified in ST2098-2, Section B.9. The filter
+		// starts from zero history for each frame.
 		//
-		index1 = 0;
+		int32_t samples48[kDLCInterpHistory + kDLCMaxFrameSize48k] = { 0 };
 
-		for (n = 0, k = 0; n < static_cast<int32_t>(frameSize_); n += 2, k++)
-		{
-			buffer[index1] = iSamples[k];
-			index2 = index1;
-			index2 -= 8;
-			index2 &= 63;
-			oSamples[n] = buffer[index2];
+		std::copy(iSamples, iSamples + frameSize_ / 2, samples48 + kDLCInterpHistory);
 
-			index2 = index1;
-			accum64 = 0;
-			for (i = 1; i < 33; i += 2)
-			{
-				accum64 += (static_cast<int64_t>(buffer[index2]) * InterpolatorFilterCoeffs[i]);
-				index2--;
-				index2 &= 63;
-			}
-			oSamples[n + 1] = static_cast<int32_t>(accum64 >> 15);
-
-			index1++;
-			index1 &= 63;
-		}
+		Interpolate48kTo96k(samples48 + kDLCInterpHistory, frameSize_ / 2, oSamples);
 
 		return StatusCode_OK;
 	}
@@ -36,8 +36,10 @@ namespace dlc
 {
 
     /**
-    * Implements a simple DLC encoder that supports only 48 kHz samples, uses no predictors, and uses only PCM residuals.
-    * Supports the frame rates specified in ST 2098-2.
+    * Implements a simple DLC encoder. Supports the sample rates and frame rates specified in ST 2098-2.
+    *
+    * At the default effort level, the encoder uses no predictors and only PCM residuals. Higher effort levels
+    * add 48 kHz lattice predictors and Rice/Golomb residuals for smaller DLC payloads.
     */
     class SimpleEncoder : public Encoder
     {
@@ -55,9 +57,25 @@ namespace dlc
             StatusCode_FATAL_ERROR	/**< Unrecoverable error occurred. */
         };
 
+		/**
+		* Encoding effort levels. Higher levels produce smaller DLC payloads, at the cost of encoding time.
+		*/
+		enum Effort
+		{
+			eEffort_Minimal,	/**< PCM residuals, no predictors, as the Minimal DLC Encoder of ST 2098-2. Default. */
+			eEffort_Fast,		/**< One predictor region, with order and residual coding estimated from signal statistics. */
+			eEffort_Thorough	/**< Searches predictor region splits, orders and Rice parameters on exact bit costs. */
+		};
+
 		// Set up per sample rate & frame rate
 		StatusCode setup(SampleRate iSampleRate, FrameRate iFrameRate);
 
+		// Sets the encoding effort level, applied from the next call to encode()
+		void setEffort(Effort iEffort);
+
+		// Gets the encoding effort level
+		Effort getEffort() const;
+
 		/**
 		* Note that this DLC encoder implementation minimally compress PCM data using a method as
 		* "minimum width signed magnitude PCM" as specified in Annex B.11 of ST2098-2 specification.
@@ -109,6 +127,13 @@ namespace dlc
 		// Delay 96k sample by "LowPassFilterCoeffs + upsampling" filter group delay of 80 samples
 		StatusCode delayPCM96k(const int32_t * iSamples, uint32_t iSampleCount, int32_t * oSamples);
 
+		// Selects predictor regions for the 48k (or 96k base band) samples, and fills oDLCData's
+		// 48k predictor regions and oResiduals with the corresponding residuals.
+		void predict48k(const int32_t * iSamples, uint32_t iSubBlockSize, AudioData& oDLCData, int32_t * oResiduals);
+
+		// Chooses PCM or Rice/Golomb coding of each sub block of oLayer, from the residuals it holds
+		void codeResidualLayer(ResidualLayer& ioLayer);
+
 		// *** Variables
 
 		// Frame size in PCM samples
@@ -120,6 +145,9 @@ namespace dlc
 		// DLC sub-blocks size, in PCM samples
 		uint32_t subBlockSize_;
 
+		// Encoding effort level
+		Effort effort_;
+
 		// Delay buffer (interger) for accounting delays from LowPassFilterCoeffs and upsampling
 		// 64 + 16 = 80.
 		uint32_t delayBuffer96k_[kDLCTotal96kFiltGrpDelay];
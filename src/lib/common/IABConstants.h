@@ -120,6 +120,14 @@ namespace ImmersiveAudioBitstream
      *
      */
 	static const uint32_t kIABMaxFrameSampleCount = 4004;
+
+    /**
+     * Maximum number of bytes buffered by the IABParser push (Feed) interface. This bounds
+     * the size of a single IA bitstream frame (preamble + IA subframe) that can be assembled
+     * from fed data. Larger declared frame lengths are treated as loss of sync.
+     *
+     */
+    static const uint32_t kIABMaxFeedBufferSize = 16 * 1024 * 1024;
     
     /**
      * Highest positive value for 32-bit signed integer (= 2^31 - 1), casted to float
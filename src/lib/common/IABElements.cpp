@@ -27,6 +27,7 @@
     SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *======================================================================*/
 
+#include <algorithm>
 #include <set>
 
 /* Implementation of IABElements class functions functions */
@@ -36,6 +37,7 @@
 #include "IABUtilities.h"
 #include "commonstream/bitstream/BitStreamIOHelpers.h"
 #include "commonstream/utils/opbacksbuf.h"
+#include "commonstream/utils/PCMUtilities.h"
 
 // To support validation and event handler
 #include "IABValidatorAPI.h"
@@ -215,6 +217,15 @@ namespace ImmersiveAudioBitstream
         delete iInstance;
     }
 
+    // Decode DLC elements of a frame to planar samples
+    iabError IABAudioDataDLCInterface::DecodeAllDLC(const IABFrameInterface& iFrame
+        , const std::set<IABAudioDataIDType>& iAudioDataIDs
+        , IABDLCFrameSamples& oSamples
+        , IABSampleRateType iDecodeSampleRate)
+    {
+        return IABAudioDataDLC::DecodeAllDLC(iFrame, iAudioDataIDs, oSamples, iDecodeSampleRate);
+    }
+
 	// Create IABAudioDataPCM instance
 	IABAudioDataPCMInterface* IABAudioDataPCMInterface::Create(IABFrameRateType iFrameRateCode
 		, IABSampleRateType iSampleRate
@@ -229,6 +240,115 @@ namespace ImmersiveAudioBitstream
         delete iInstance;
     }
 
+	// ****************************************************************************
+	// IABPackingBuffer class implementation
+	// ****************************************************************************
+
+	// Number of bytes taken by a Plex(8) coded field holding iValue
+	static uint32_t GetPlex8FieldWidth(IABElementSizeType iValue)
+	{
+		if (iValue < 0xFF)
+		{
+			return 1;														// 8-bit value
+		}
+		else if (iValue < 0xFFFF)
+		{
+			return 3;														// 1 escape byte, 16-bit value
+		}
+		else
+		{
+			return 7;														// 3 escape bytes, 32-bit value
+		}
+	}
+
+	// Constructor implementation
+	IABPackingBuffer::IABPackingBuffer(std::vector<char> &ioBytes) :
+		bytes_(ioBytes),
+		writer_(ioBytes)
+	{
+	}
+
+	// IABPackingBuffer::GetWriter() implementation
+	PackingWriter& IABPackingBuffer::GetWriter()
+	{
+		return writer_;
+	}
+
+	// IABPackingBuffer::GetPosition() implementation
+	size_t IABPackingBuffer::GetPosition()
+	{
+		writer_.align();													// Move accumulated bytes to the buffer
+		return bytes_.size();
+	}
+
+	// IABPackingBuffer::BeginElement() implementation
+	IABPackingBuffer::ElementMark IABPackingBuffer::BeginElement(IABElementIDType iElementID, IABElementSizeType iSizeHint)
+	{
+		ElementMark mark;
+
+		mark.elementPosition_ = GetPosition();								// Elements start byte aligned
+
+		// Calling method for writing Plex encoded field.
+		write(writer_, Plex<8>(static_cast<uint32_t>(iElementID)));
+
+		// Reserve the size field, to be back-patched by EndElement()
+		mark.sizeFieldPosition_ = GetPosition();
+		mark.sizeFieldWidth_ = GetPlex8FieldWidth(iSizeHint);
+		bytes_.resize(bytes_.size() + mark.sizeFieldWidth_);
+
+		return mark;
+	}
+
+	// IABPackingBuffer::EndElement() implementation
+	IABElementSizeType IABPackingBuffer::EndElement(const ElementMark &iMark)
+	{
+		writer_.align();													// Align to byte
+
+		size_t payloadPosition = iMark.sizeFieldPosition_ + iMark.sizeFieldWidth_;
+		IABElementSizeType payloadSize = static_cast<IABElementSizeType>(bytes_.size() - payloadPosition);
+		uint32_t sizeFieldWidth = GetPlex8FieldWidth(payloadSize);
+
+		// Resize the reserved field if the hint was wrong. This is the only case where the payload moves.
+		if (sizeFieldWidth > iMark.sizeFieldWidth_)
+		{
+			bytes_.insert(bytes_.begin() + payloadPosition, sizeFieldWidth - iMark.sizeFieldWidth_, 0);
+		}
+		else if (sizeFieldWidth < iMark.sizeFieldWidth_)
+		{
+			bytes_.erase(bytes_.begin() + (iMark.sizeFieldPosition_ + sizeFieldWidth), bytes_.begin() + payloadPosition);
+		}
+
+		// Plex(8) escape bytes, followed by the value in 8, 16 or 32 bits
+		uint32_t escapeByteCount = sizeFieldWidth / 2;
+
+		for (uint32_t i = 0; i < escapeByteCount; i++)
+		{
+			bytes_[iMark.sizeFieldPosition_ + i] = static_cast<char>(0xFF);
+		}
+
+		PatchField(iMark.sizeFieldPosition_ + escapeByteCount, static_cast<uint32_t>(payloadSize), sizeFieldWidth - escapeByteCount);
+
+		return payloadSize;
+	}
+
+	// IABPackingBuffer::DiscardElement() implementation
+	void IABPackingBuffer::DiscardElement(const ElementMark &iMark)
+	{
+		writer_.align();													// Flush any partial byte before discarding it
+		bytes_.resize(iMark.elementPosition_);
+	}
+
+	// IABPackingBuffer::PatchField() implementation
+	void IABPackingBuffer::PatchField(size_t iPosition, uint32_t iValue, uint32_t iNumBytes)
+	{
+		writer_.align();													// The field may still be held by the writer
+
+		for (uint32_t i = 0; i < iNumBytes; i++)
+		{
+			bytes_[iPosition + i] = static_cast<char>((iValue >> (8 * (iNumBytes - 1 - i))) & 0xFF);
+		}
+	}
+
 	// ****************************************************************************
 	// IABContainerSubFrame class implementation
 	// ****************************************************************************
@@ -237,9 +357,7 @@ namespace ImmersiveAudioBitstream
 	IABContainerSubFrame::IABContainerSubFrame(IABContainerSubFrameTagType iSubFrameTag) :
 		subframeTag_(iSubFrameTag),
 		subframeLength_(0),
-		subframePayload_(nullptr),
-		containerHeadWriter_(containerHeadBuffer_),
-		containerHeadBuffer_(std::stringstream::in | std::stringstream::out | std::stringstream::binary)
+		subframePayload_(nullptr)
 	{
 	}
 
@@ -265,35 +383,57 @@ namespace ImmersiveAudioBitstream
 		return kIABNoError;
 	}
 
+	// IABContainerSubFrame::Serialize() implementation
+	iabError IABContainerSubFrame::Serialize(std::ostream &outStream)
+	{
+		std::vector<char> packedBytes;
+		IABPackingBuffer packingBuffer(packedBytes);
+
+		iabError errorCode = SerializeToBuffer(packingBuffer);
+
+		if (errorCode != kIABNoError)
+		{
+			return errorCode;
+		}
+
+		// Output ...
+		outStream.write(packedBytes.data(), packedBytes.size());
+
+		return kIABNoError;
+	}
+
 	// ****************************************************************************
 	// IABIASubFrame class implementation
 	// ****************************************************************************
 
 	// Constructor implementation
 	IABIASubFrame::IABIASubFrame() :
-		IABContainerSubFrame(kIABContainerSubFrameTag_IAFrame)
+		IABContainerSubFrame(kIABContainerSubFrameTag_IAFrame),
+		lengthFieldPosition_(0)
 	{
 	}
 
-	// IABIASubFrame::Serialize() implementation
-	iabError IABIASubFrame::Serialize(std::ostream &outStream)
+	// IABIASubFrame::SerializeToBuffer() implementation
+	iabError IABIASubFrame::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
-		// Set up writer and buffer
-		containerHeadWriter_.align();										// reset writer byte alignment
-		containerHeadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		containerHeadBuffer_.clear();
+		PackingWriter &containerHeadWriter = ioBuffer.GetWriter();
+		containerHeadWriter.align();
 
 		// Writing tag and length
-		containerHeadWriter_.write(static_cast<uint8_t>(subframeTag_), 8);						// Pack IAFrame tag
-		containerHeadWriter_.write(static_cast<uint32_t>(subframeLength_), 32);					// Pack IAFrame length (assuming length has been properly updated!)
+		containerHeadWriter.write(static_cast<uint8_t>(subframeTag_), 8);						// Pack IAFrame tag
+		lengthFieldPosition_ = ioBuffer.GetPosition();
+		containerHeadWriter.write(static_cast<uint32_t>(subframeLength_), 32);					// Pack IAFrame length (back-patched by UpdateSubframeLength() if not yet known)
 
 		// Not packing IAFrame payload (Value), as this is used by IABFrame as a wrapper only.
-		// 
-		// Output ...
-		outStream << containerHeadBuffer_.rdbuf();
 
-		// Clear stream contents after output
-		containerHeadBuffer_.str("");
+		return kIABNoError;
+	}
+
+	// IABIASubFrame::UpdateSubframeLength() implementation
+	iabError IABIASubFrame::UpdateSubframeLength(IABPackingBuffer &ioBuffer, IABSubframeLengthType iSubframeLength)
+	{
+		subframeLength_ = iSubframeLength;
+		ioBuffer.PatchField(lengthFieldPosition_, static_cast<uint32_t>(subframeLength_), 4);
 
 		return kIABNoError;
 	}
@@ -389,37 +529,27 @@ namespace ImmersiveAudioBitstream
 		return kIABNoError;
 	}
 
-	// IABPreamble::Serialize() implementation
-	iabError IABPreamble::Serialize(std::ostream &outStream)
+	// IABPreamble::SerializeToBuffer() implementation
+	iabError IABPreamble::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
-		// Set up writer and buffer
-		containerHeadWriter_.align();										// reset writer byte alignment
-		containerHeadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		containerHeadBuffer_.clear();
+		// report error for a missing payload, before writing anything
+		if ((subframePayload_ == nullptr) && (subframeLength_ != 0))
+		{
+			return kIABGeneralError;
+		}
+
+		PackingWriter &containerHeadWriter = ioBuffer.GetWriter();
+		containerHeadWriter.align();
 
 		// Writing tag and length
-		containerHeadWriter_.write(static_cast<uint8_t>(subframeTag_), 8);						// Pack IAFrame tag
-		containerHeadWriter_.write(static_cast<uint32_t>(subframeLength_), 32);					// Pack IAFrame length (assuming length has been properly updated!)
+		containerHeadWriter.write(static_cast<uint8_t>(subframeTag_), 8);						// Pack IAFrame tag
+		containerHeadWriter.write(static_cast<uint32_t>(subframeLength_), 32);					// Pack IAFrame length (assuming length has been properly updated!)
 
-																								// pack payload if the following are satisfied
+		// pack payload if present
 		if ((subframePayload_ != nullptr) && (subframeLength_ != 0))
 		{
-			containerHeadWriter_.write(static_cast<const uint8_t*>(subframePayload_), subframeLength_);
-		}
-		else if ((subframePayload_ == nullptr) && (subframeLength_ != 0))	// report error for this combination
-		{
-			// Clear stream contents after output
-			containerHeadBuffer_.str("");
-
-			return kIABGeneralError;
+			containerHeadWriter.write(static_cast<const uint8_t*>(subframePayload_), subframeLength_);
 		}
-		else;
-
-		// Output ...
-		outStream << containerHeadBuffer_.rdbuf();
-
-		// Clear stream contents after output
-		containerHeadBuffer_.str("");
 
 		return kIABNoError;
 	}
@@ -514,11 +644,8 @@ namespace ImmersiveAudioBitstream
 		elementID_(iElementID),
 		elementSize_(0),
 		packingEnable_(1),
-		elementHeadWriter_(elementHeadBuffer_),
-		elementHeadBuffer_(std::stringstream::in | std::stringstream::out | std::stringstream::binary),
-		elementPayloadWriter_(elementPayloadBuffer_),
-		elementPayloadBuffer_(std::stringstream::in | std::stringstream::out | std::stringstream::binary),
-		elementReader_(nullptr)
+		elementReader_(nullptr),
+		skippedElementIDsInParsing_(nullptr)
 	{
 	}
 
@@ -566,12 +693,21 @@ namespace ImmersiveAudioBitstream
 		return (packingEnable_ != 0);
 	}
 
-	// IABElement::SerializeHead() implementation
-	iabError IABElement::SerializeHead()
+	// IABElement::Serialize() implementation
+	iabError IABElement::Serialize(std::ostream &outStream)
 	{
-		// Calling method for writing Plex encoded fields.
-		write(elementHeadWriter_, Plex<8>(elementID_));
-		write(elementHeadWriter_, Plex<8>(static_cast<uint32_t>(elementSize_)));
+		std::vector<char> packedBytes;
+		IABPackingBuffer packingBuffer(packedBytes);
+
+		iabError errorCode = SerializeToBuffer(packingBuffer);
+
+		if (errorCode != kIABNoError)
+		{
+			return errorCode;
+		}
+
+		// Output packed element, with all of its sub-elements, in one write
+		outStream.write(packedBytes.data(), packedBytes.size());
 
 		return kIABNoError;
 	}
@@ -648,6 +784,19 @@ namespace ImmersiveAudioBitstream
     }
 
 
+	// IABElement::SetSkippedElementIDsInParsing() implementation
+	void IABElement::SetSkippedElementIDsInParsing(const std::set<IABElementIDType>* iElementIDs)
+	{
+		skippedElementIDsInParsing_ = iElementIDs;
+	}
+
+	// IABElement::IsSkippedInParsing() implementation
+	bool IABElement::IsSkippedInParsing(IABElementIDType iElementID) const
+	{
+		return (nullptr != skippedElementIDsInParsing_) &&
+			(skippedElementIDsInParsing_->find(iElementID) != skippedElementIDsInParsing_->end());
+	}
+
 	// IABElement::PeekNextElementID() implementation
 	iabError IABElement::PeekNextElementID(StreamReader& streamReader, uint32_t &oElementID)
 	{
@@ -690,6 +839,7 @@ namespace ImmersiveAudioBitstream
 
 		packedSubElementCount_ = 0;				// To match number of element in frameSubElements_ that is packing enabled
 		failOnVersionError_ = true;
+		deSerializeSkipsDLC96kLayer_ = false;
 	}
 
 	IABFrame::IABFrame(std::istream* inputStream) :
@@ -707,6 +857,7 @@ namespace ImmersiveAudioBitstream
 
 		packedSubElementCount_ = 0;
 		failOnVersionError_ = true;
+		deSerializeSkipsDLC96kLayer_ = false;
 
 		// Instantiate elementReader_ on inputStream
 		if (inputStream && inputStream->good())
@@ -1472,6 +1623,12 @@ namespace ImmersiveAudioBitstream
 
 	// IABFrame::Serialize() implementation
 	iabError IABFrame::Serialize(std::ostream &outStream)
+	{
+		return IABElement::Serialize(outStream);
+	}
+
+	// IABFrame::SerializeToBuffer() implementation
+	iabError IABFrame::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// TODO: Error code for each write() should be checked.
 		// It is not, yet.
@@ -1492,20 +1649,26 @@ namespace ImmersiveAudioBitstream
 		// return err;
 		// *****************
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
-
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
-		elementPayloadWriter_.write(version_, 8);
-		elementPayloadWriter_.write(static_cast<uint8_t>(sampleRate_), 2);
-		elementPayloadWriter_.write(static_cast<uint8_t>(bitDepth_), 2);
-		elementPayloadWriter_.write(static_cast<uint8_t>(frameRate_), 4);
+		// Serialize preamble, as the first subframe of IABitstreamFrame
+		aPreamble_.SerializeToBuffer(ioBuffer);
+
+		// Serialize/Wrapping IABFrame, the wrapper for the 2nd subframe of IABitstreamFrame.
+		// Its length is back-patched once the frame element has been serialized.
+		containerSubframeWrapper_.SerializeToBuffer(ioBuffer);
+		size_t subframeValuePosition = ioBuffer.GetPosition();
+
+		// The frame element forms the "Value" of IA subframe
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
+
+		// Writing data fields
+		payloadWriter.write(version_, 8);
+		payloadWriter.write(static_cast<uint8_t>(sampleRate_), 2);
+		payloadWriter.write(static_cast<uint8_t>(bitDepth_), 2);
+		payloadWriter.write(static_cast<uint8_t>(frameRate_), 4);
 		// Calling method for writing Plex encoded field.
-		write(elementPayloadWriter_, Plex<8>(maxRendered_));
+		write(payloadWriter, Plex<8>(maxRendered_));
 
 		// Prepare to pack IABFrame sub elements, but is overall sub element packing disabled?
 		if (AreSubElementsEnabledForPacking())
@@ -1519,55 +1682,25 @@ namespace ImmersiveAudioBitstream
 			packedSubElementCount_ = 0;
 		}
 
-		elementPayloadWriter_.align();										// Alignment to byte
-		write(elementPayloadWriter_, Plex<8>(packedSubElementCount_));		// Note to use packedSubElementCount_
+		payloadWriter.align();												// Alignment to byte
+		write(payloadWriter, Plex<8>(packedSubElementCount_));				// Note to use packedSubElementCount_
 
 		// Pack sub elements, only when it is not disabled
 		if (AreSubElementsEnabledForPacking())
 		{
 			// Serialize all sub-elements, in sequence
-			// Append to end of IABFrame's "elementPayloadBuffer_"
+			// Serialized in place, following the sub-element count
 			for (IABElementCountType i = 0; i < subElementCount_; i++)
 			{
-				// Temp StringStream to hold packed output from sub-elements (TODO: optimization?)
-				std::stringstream subElementPayload(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
-				frameSubElements_[i]->Serialize(subElementPayload);
-				const std::string payLoad = subElementPayload.str();
-				uint32_t length = static_cast<uint32_t>(payLoad.size());
-				elementPayloadWriter_.write((uint8_t*)payLoad.data(), length);
+				frameSubElements_[i]->SerializeToBuffer(ioBuffer);
 			}
 		}
 
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
-
-		// Serialize frame head
-		SerializeHead();
-
-		// Update packedPayloadLength to wrapper subframe length
-		packedPayloadLength += static_cast<IABElementSizeType>(elementHeadBuffer_.tellp());
-
-		// Set length for containerSubframeWrapper_
-		containerSubframeWrapper_.SetSubframeLength(static_cast<IABSubframeLengthType>(packedPayloadLength));
-
-		// Serialize preamble, as the first subframe of IABitstreamFrame
-		aPreamble_.Serialize(outStream);
-
-		// Serialize/Wrapping IABFrame, the wrapper for the 2nd subframe of IABitstreamFrame
-		containerSubframeWrapper_.Serialize(outStream);
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
-		// The combination of following forms the "Value" of IA subframe
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
-
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
-
-		// Are we done? (TBD)
+		// Back-patch length of containerSubframeWrapper_, covering frame element head and payload
+		containerSubframeWrapper_.UpdateSubframeLength(ioBuffer, static_cast<IABSubframeLengthType>(ioBuffer.GetPosition() - subframeValuePosition));
 
 		return kIABNoError;
 	}
@@ -1582,6 +1715,33 @@ namespace ImmersiveAudioBitstream
 		return failOnVersionError_;
 	}
 
+	// IABFrame::SetDeSerializeSkippedElementIDs() implementation
+	void IABFrame::SetDeSerializeSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs)
+	{
+		deSerializeSkippedElementIDs_ = iElementIDs;
+
+		// Only look up the skip list during parsing when it is in use
+		SetSkippedElementIDsInParsing(deSerializeSkippedElementIDs_.empty() ? nullptr : &deSerializeSkippedElementIDs_);
+	}
+
+	// IABFrame::GetDeSerializeSkippedElementIDs() implementation
+	void IABFrame::GetDeSerializeSkippedElementIDs(std::set<IABElementIDType> &oElementIDs) const
+	{
+		oElementIDs = deSerializeSkippedElementIDs_;
+	}
+
+	// IABFrame::SetDeSerializeSkipsDLC96kLayer() implementation
+	void IABFrame::SetDeSerializeSkipsDLC96kLayer(bool iSkip96kLayer)
+	{
+		deSerializeSkipsDLC96kLayer_ = iSkip96kLayer;
+	}
+
+	// IABFrame::GetDeSerializeSkipsDLC96kLayer() implementation
+	bool IABFrame::GetDeSerializeSkipsDLC96kLayer() const
+	{
+		return deSerializeSkipsDLC96kLayer_;
+	}
+
 	// IABFrame::DeSerialize() implementation
 	iabError IABFrame::DeSerialize()
 	{
@@ -1770,6 +1930,20 @@ namespace ImmersiveAudioBitstream
 
 		elementID = static_cast<IABElementIDType>(parsedElementIDField);
 
+		// Allowed frame sub-elements that the client has chosen to skip are bypassed using their
+		// element size, without being materialized. They are not counted as unallowed/undefined.
+		if (IsSkippedInParsing(elementID) &&
+			((elementID == kIABElementID_BedDefinition) ||
+			(elementID == kIABElementID_ObjectDefinition) ||
+			(elementID == kIABElementID_AudioDataDLC) ||
+			(elementID == kIABElementID_AuthoringToolInfo) ||
+			(elementID == kIABElementID_UserData) ||
+			(elementID == kIABElementID_AudioDataPCM)))
+		{
+			numSkippedFrameSubElementsInParsing_++;
+			return SkipDeSerializeCurrentElement(*elementReader_);
+		}
+
 		IABElement* frameSubElement = nullptr;
         
         switch (elementID)
@@ -1791,6 +1965,8 @@ namespace ImmersiveAudioBitstream
 				{
 					return kIABDataFieldInvalidDLC;
 				}
+
+				dynamic_cast<IABAudioDataDLC*>(frameSubElement)->SetDeSerializeSkips96kLayer(deSerializeSkipsDLC96kLayer_);
                 break;
                 
             case kIABElementID_AuthoringToolInfo:
@@ -1835,6 +2011,7 @@ namespace ImmersiveAudioBitstream
 		// Parse sub-element
         iabError returnCode = kIABNoError;
         
+        frameSubElement->SetSkippedElementIDsInParsing(skippedElementIDsInParsing_);
         returnCode = frameSubElement->DeSerialize(*elementReader_);
         
         if (returnCode != kIABNoError)
@@ -1959,14 +2136,14 @@ namespace ImmersiveAudioBitstream
     }
 
 	// IABChannel::Serialize() implementation
-	iabError IABChannel::Serialize(StreamWriter& streamWriter)
+	iabError IABChannel::Serialize(PackingWriter& streamWriter)
 	{
 		// The payload stream writer for parent BedDefinition element is passed in.
 		// Individual channel instances are packed into the payload buffer/ostream of  
 		// BedDefinition element, without alignment manipulation
 		// ! Do not change alignment when writing individual IAB channels
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields (These are written into the payload of the parent element)
 		write(streamWriter, Plex<4>(channelID_));
 		write(streamWriter, Plex<8>(audioDataID_));
 
@@ -2710,8 +2887,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABBedDefinition::Serialize() implementation
-	iabError IABBedDefinition::Serialize(std::ostream &outStream)
+	// IABBedDefinition::SerializeToBuffer() implementation
+	iabError IABBedDefinition::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -2724,71 +2901,50 @@ namespace ImmersiveAudioBitstream
 			UpdatePackingEnabledSubElementCount();
 		}
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields
 		// Calling method for writing Plex encoded field.
-		write(elementPayloadWriter_, Plex<8>(metadataID_));
+		write(payloadWriter, Plex<8>(metadataID_));
 
-		elementPayloadWriter_.write(conditionalBed_, 1);
+		payloadWriter.write(conditionalBed_, 1);
 		if (conditionalBed_ == 1)
 		{
-			elementPayloadWriter_.write(static_cast<uint8_t>(bedUseCase_), 8);
+			payloadWriter.write(static_cast<uint8_t>(bedUseCase_), 8);
 		}
 
-		write(elementPayloadWriter_, Plex<4>(channelCount_));
+		write(payloadWriter, Plex<4>(channelCount_));
 
 		// Serialize all bed channels, in sequence, into payload writer
 		for (IABChannelCountType i = 0; i < channelCount_; i++)
 		{
-			bedChannels_[i]->Serialize(elementPayloadWriter_);
+			bedChannels_[i]->Serialize(payloadWriter);
 		}
 
-		elementPayloadWriter_.write(reserved_, 10);							// Reserved field, after all channels
-		elementPayloadWriter_.align();										// Align to byte
+		payloadWriter.write(reserved_, 10);							// Reserved field, after all channels
+		payloadWriter.align();										// Align to byte
 
-		elementPayloadWriter_.write(static_cast<uint8_t>(audioDescription_.audioDescription_), 8);
+		payloadWriter.write(static_cast<uint8_t>(audioDescription_.audioDescription_), 8);
 
 		if (audioDescription_.audioDescription_ & 0x80)
 		{
             // Write audio description text to bitstream as a null terminated string (i.e. character sequence)
             // writeStringAppendNull() will add a null byte after the last character of the string.
-            writeStringAppendNull(elementPayloadWriter_, audioDescription_.audioDescriptionText_);
+            writeStringAppendNull(payloadWriter, audioDescription_.audioDescriptionText_);
 		}
 
-		write(elementPayloadWriter_, Plex<8>(packedSubElementCount_));		// Note to write packedSubElementCount_ instead of subElementCount_
+		write(payloadWriter, Plex<8>(packedSubElementCount_));		// Note to write packedSubElementCount_ instead of subElementCount_
 		// Serialize all sub-elements, in sequence
-		// Append to end of IABBedDefinition's "elementPayloadBuffer_"
+		// Serialized in place, following the sub-element count
 		for (IABElementCountType i = 0; i < subElementCount_; i++)			// Still loop through all subElementCount_ of sub elements
 		{
-			// Temp StringStream to hold packed output from sub-elements (TODO: optimization?)
-			std::stringstream subElementPayload(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
-			bedSubElements_[i]->Serialize(subElementPayload);
-			const std::string payLoad = subElementPayload.str();
-			uint32_t length = static_cast<uint32_t>(payLoad.size());
-			elementPayloadWriter_.write((uint8_t*)payLoad.data(), length);
+			bedSubElements_[i]->SerializeToBuffer(ioBuffer);
 		}
 
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
-
-		// Serialize frame head
-		SerializeHead();
-
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
-
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
@@ -2959,6 +3115,14 @@ namespace ImmersiveAudioBitstream
 
 		elementID = static_cast<IABElementIDType>(parsedElementIDField);
 
+		// Allowed bed sub-elements that the client has chosen to skip are bypassed using their element size
+		if (IsSkippedInParsing(elementID) &&
+			((elementID == kIABElementID_BedDefinition) || (elementID == kIABElementID_BedRemap)))
+		{
+			numSkippedBedSubElementsInParsing_++;
+			return SkipDeSerializeCurrentElement(streamReader);
+		}
+
 		IABElement* bedDefinitionSubElement = nullptr;
 
 		switch (elementID)
@@ -2980,7 +3144,7 @@ namespace ImmersiveAudioBitstream
 			case kIABElementID_AudioDataDLC:
 			case kIABElementID_AudioDataPCM:
 			case kIABElementID_IAFrame:
-				SkipDeSerializeCurrentElement(*elementReader_);
+				SkipDeSerializeCurrentElement(streamReader);
 				numSkippedBedSubElementsInParsing_++;
 				numUnallowedBedSubElements_++;
 				return kIABNoError;										// Exit, as bedDefinitionSubElement == nullptr for this case
@@ -2988,7 +3152,7 @@ namespace ImmersiveAudioBitstream
 			// Undefined/Unknown type as IAB BedDefinition sub-element
 			// Total number of unallowed element IDs for the bed is tracked in numUndefinedBedSubElements_.
 			default:
-				SkipDeSerializeCurrentElement(*elementReader_);
+				SkipDeSerializeCurrentElement(streamReader);
 				numSkippedBedSubElementsInParsing_++;
 				numUndefinedBedSubElements_++;
 				return kIABNoError;										// Exit, as bedDefinitionSubElement == nullptr for default case
@@ -3003,6 +3167,7 @@ namespace ImmersiveAudioBitstream
 		// Parse sub-element
 		iabError returnCode = kIABNoError;
 
+		bedDefinitionSubElement->SetSkippedElementIDsInParsing(skippedElementIDsInParsing_);
 		returnCode = bedDefinitionSubElement->DeSerialize(streamReader);
 
 		if (returnCode != kIABNoError)
@@ -3626,7 +3791,7 @@ namespace ImmersiveAudioBitstream
 	}
 
 	// IABBedRemapSubBlock::Serialize() implementation
-	iabError IABBedRemapSubBlock::Serialize(StreamWriter& streamWriter)
+	iabError IABBedRemapSubBlock::Serialize(PackingWriter& streamWriter)
 	{
 		iabError returnCode = kIABNoError;
 
@@ -3635,7 +3800,7 @@ namespace ImmersiveAudioBitstream
 		// IABBedRemap element, without alignment manipulation
 		// ! Do not change alignment when writing individual remap sub blocks.
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields (These are written into the payload of the parent element)
 		streamWriter.write(remapInfoExists_, 1);
 
 		if (remapInfoExists_ == 1)
@@ -3647,7 +3812,7 @@ namespace ImmersiveAudioBitstream
 	}
 
 	// IABBedRemapSubBlock::SerializeSubBlock() implementation
-	iabError IABBedRemapSubBlock::SerializeSubBlock(StreamWriter& streamWriter)
+	iabError IABBedRemapSubBlock::SerializeSubBlock(PackingWriter& streamWriter)
 	{
 		iabError returnCode = kIABNoError;
 
@@ -3656,7 +3821,7 @@ namespace ImmersiveAudioBitstream
 		// IABBedRemap element, without alignment manipulation
 		// ! Do not change alignment when writing individual remap sub blocks.
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields (These are written into the payload of the parent element)
 
 		// For first remap sub block, remapInfoExists_ is always 1 by specification. (This flag is not in bitstream.)
 
@@ -4146,8 +4311,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABBedRemap::Serialize() implementation
-	iabError IABBedRemap::Serialize(std::ostream &outStream)
+	// IABBedRemap::SerializeToBuffer() implementation
+	iabError IABBedRemap::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -4155,59 +4320,44 @@ namespace ImmersiveAudioBitstream
 			return kIABNoError;
 		}
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields
 		// Calling method for writing Plex encoded field.
-		write(elementPayloadWriter_, Plex<8>(metadataID_));
-		elementPayloadWriter_.write(static_cast<uint8_t>(remapUseCase_), 8);
-		write(elementPayloadWriter_, Plex<4>(sourceChannels_));
-		write(elementPayloadWriter_, Plex<4>(destinationChannels_));
+		write(payloadWriter, Plex<8>(metadataID_));
+		payloadWriter.write(static_cast<uint8_t>(remapUseCase_), 8);
+		write(payloadWriter, Plex<4>(sourceChannels_));
+		write(payloadWriter, Plex<4>(destinationChannels_));
 
 		// Stop writing if any is 0
 		if ((sourceChannels_ == 0) || (destinationChannels_ == 0) || (numRemapSubBlocks_ == 0))
 		{
+			ioBuffer.DiscardElement(elementMark);
 			return kIABBadArgumentsError;
 		}
 
 		// Serialize all remap sub blocks, in sequence, into payload writer
 
 		// First block, skip "panInfoExists_" and always write panning parameters
-		bedRemapSubBlocks_[0]->SerializeSubBlock(elementPayloadWriter_);
+		bedRemapSubBlocks_[0]->SerializeSubBlock(payloadWriter);
 
 		for (uint8_t i = 1; i < numRemapSubBlocks_; i++)
 		{
-			bedRemapSubBlocks_[i]->Serialize(elementPayloadWriter_);
+			bedRemapSubBlocks_[i]->Serialize(payloadWriter);
 		}
 
 		// Align to byte after writing remap sub blocks
-		elementPayloadWriter_.align();										// Align to byte
+		payloadWriter.align();										// Align to byte
 
 		// Write "Reserved" which is hard set to "0" per specification (v4.34 of Dec 15, 2017), using Plex(8)
 		// (This is a strange one, to write a hard coded "0" with Plex(8). Will send questo reflector.)
 		// !! To be followed up
-		write(elementPayloadWriter_, Plex<8>(0));
-
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
+		write(payloadWriter, Plex<8>(0));
 
-		// Serialize frame head
-		SerializeHead();
-
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
-
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
@@ -4624,7 +4774,7 @@ namespace ImmersiveAudioBitstream
     }
 
 	// IABObjectSubBlock::Serialize() implementation
-	iabError IABObjectSubBlock::Serialize(StreamWriter& streamWriter)
+	iabError IABObjectSubBlock::Serialize(PackingWriter& streamWriter)
 	{
 		iabError returnCode = kIABNoError;
 
@@ -4633,7 +4783,7 @@ namespace ImmersiveAudioBitstream
 		// ObjectDefinition element, without alignment manipulation
 		// ! Do not change alignment when writing individual sub blocks.
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields (These are written into the payload of the parent element)
 		streamWriter.write(panInfoExists_, 1);
 
 		if (panInfoExists_ == 1)
@@ -4645,14 +4795,14 @@ namespace ImmersiveAudioBitstream
 	}
 
 	// IABObjectSubBlock::SerializeSubBlock() implementation
-	iabError IABObjectSubBlock::SerializeSubBlock(StreamWriter& streamWriter)
+	iabError IABObjectSubBlock::SerializeSubBlock(PackingWriter& streamWriter)
 	{
 		// The payload stream writer for parent ObjectDefinition element is passed in.
 		// Individual sub-clock instances are packed into the payload buffer/ostream of  
 		// ObjectDefinition element, without alignment manipulation
 		// ! Do not change alignment when writing individual sub blocks.
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields (These are written into the payload of the parent element)
 
 		// For first pan sub block, panInfoExists_ is always 1 by specification. It is not in bitstream.
 		// Writing object panning parameters specified for the block.
@@ -5872,8 +6022,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABObjectDefinition::Serialize() implementation
-	iabError IABObjectDefinition::Serialize(std::ostream &outStream)
+	// IABObjectDefinition::SerializeToBuffer() implementation
+	iabError IABObjectDefinition::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -5886,80 +6036,59 @@ namespace ImmersiveAudioBitstream
 			UpdatePackingEnabledSubElementCount();
 		}
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields
 		// Calling method for writing Plex encoded field.
-		write(elementPayloadWriter_, Plex<8>(metadataID_));
-		write(elementPayloadWriter_, Plex<8>(audioDataID_));
+		write(payloadWriter, Plex<8>(metadataID_));
+		write(payloadWriter, Plex<8>(audioDataID_));
 
-		elementPayloadWriter_.write(conditionalObject_, 1);
+		payloadWriter.write(conditionalObject_, 1);
 		if (conditionalObject_ == 1)
 		{
-			elementPayloadWriter_.write(reserved1_, 1);						// A reserved 1-bit fired, always = 1
-			elementPayloadWriter_.write(static_cast<uint8_t>(objectUseCase_), 8);
+			payloadWriter.write(reserved1_, 1);						// A reserved 1-bit fired, always = 1
+			payloadWriter.write(static_cast<uint8_t>(objectUseCase_), 8);
 		}
 
-		elementPayloadWriter_.write(reserved2_, 1);							// A reserved 1-bit fired, always = 0
+		payloadWriter.write(reserved2_, 1);							// A reserved 1-bit fired, always = 0
 
 		// numPanSubBlocks_ is not in the stream, but is determined by frame rate, per spec
 
 		// Serialize all object pan sub blocks, in sequence, into payload writer
 
 		// First block, skip "panInfoExists_" and always write panning parameters
-		objectPanSubBlocks_[0]->SerializeSubBlock(elementPayloadWriter_);
+		objectPanSubBlocks_[0]->SerializeSubBlock(payloadWriter);
 
 		// For remaining sub-blocks, call serialization that packs the "panInfoExists_" at beginning
 		for (uint8_t i = 1; i < numPanSubBlocks_; i++)
 		{
-			objectPanSubBlocks_[i]->Serialize(elementPayloadWriter_);
+			objectPanSubBlocks_[i]->Serialize(payloadWriter);
 		}
 
-		elementPayloadWriter_.align();										// Align to byte
+		payloadWriter.align();										// Align to byte
 
-		elementPayloadWriter_.write(static_cast<uint8_t>(audioDescription_.audioDescription_), 8);
+		payloadWriter.write(static_cast<uint8_t>(audioDescription_.audioDescription_), 8);
 
 		if (audioDescription_.audioDescription_ & 0x80)
 		{
             // Write audio description text to bitstream as a null terminated string (i.e. character sequence)
             // writeStringAppendNull() will add a null byte after the last character of the string.
-            writeStringAppendNull(elementPayloadWriter_, audioDescription_.audioDescriptionText_);
+            writeStringAppendNull(payloadWriter, audioDescription_.audioDescriptionText_);
 		}
 
-		write(elementPayloadWriter_, Plex<8>(packedSubElementCount_));		// Note to write packedSubElementCount_ instead of subElementCount_
+		write(payloadWriter, Plex<8>(packedSubElementCount_));		// Note to write packedSubElementCount_ instead of subElementCount_
 		// Serialize all sub-elements, in sequence
-		// Append to end of IABObjectDefinition's "elementPayloadBuffer_"
+		// Serialized in place, following the sub-element count
 		for (IABElementCountType i = 0; i < subElementCount_; i++)			// Still loop through all subElementCount_ of sub elements
 		{
-			// Temp StringStream to hold packed output from sub-elements (TODO: optimization?)
-			std::stringstream subElementPayload(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
-			objectSubElements_[i]->Serialize(subElementPayload);
-			const std::string payLoad = subElementPayload.str();
-			uint32_t length = static_cast<uint32_t>(payLoad.size());
-			elementPayloadWriter_.write((uint8_t*)payLoad.data(), length);
+			objectSubElements_[i]->SerializeToBuffer(ioBuffer);
 		}
 
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
-
-		// Serialize frame head
-		SerializeHead();
-
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
-
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
@@ -6139,6 +6268,14 @@ namespace ImmersiveAudioBitstream
 
 		elementID = static_cast<IABElementIDType>(parsedElementIDField);
 
+		// Allowed object sub-elements that the client has chosen to skip are bypassed using their element size
+		if (IsSkippedInParsing(elementID) &&
+			((elementID == kIABElementID_ObjectDefinition) || (elementID == kIABElementID_ObjectZoneDefinition19)))
+		{
+			numSkippedObjectSubElementsInParsing_++;
+			return SkipDeSerializeCurrentElement(streamReader);
+		}
+
 		IABElement* objectDefinitionSubElement = nullptr;
 
 		switch (elementID)
@@ -6160,7 +6297,7 @@ namespace ImmersiveAudioBitstream
 			case kIABElementID_AudioDataDLC:
 			case kIABElementID_AudioDataPCM:
 			case kIABElementID_IAFrame:
-				SkipDeSerializeCurrentElement(*elementReader_);
+				SkipDeSerializeCurrentElement(streamReader);
 				numSkippedObjectSubElementsInParsing_++;
 				numUnallowedObjectSubElements_++;
 				return kIABNoError;										// Exit, as objectDefinitionSubElement == nullptr for this case
@@ -6168,7 +6305,7 @@ namespace ImmersiveAudioBitstream
 			// Undefined/Unknown type as IAB ObjectDefinition sub-element
 			// Total number of unallowed element IDs for the object is tracked in numUndefinedObjectSubElements_.
 			default:
-				SkipDeSerializeCurrentElement(*elementReader_);
+				SkipDeSerializeCurrentElement(streamReader);
 				numSkippedObjectSubElementsInParsing_++;
 				numUndefinedObjectSubElements_++;
 				return kIABNoError;										// Exit, as objectDefinitionSubElement == nullptr for default case
@@ -6183,6 +6320,7 @@ namespace ImmersiveAudioBitstream
 		// Parse sub-element
 		iabError returnCode = kIABNoError;
 
+		objectDefinitionSubElement->SetSkippedElementIDsInParsing(skippedElementIDsInParsing_);
 		returnCode = objectDefinitionSubElement->DeSerialize(streamReader);
 
 		if (returnCode != kIABNoError)
@@ -6668,7 +6806,7 @@ namespace ImmersiveAudioBitstream
 	}
 
 	// IABZone19SubBlock::Serialize() implementation
-	iabError IABZone19SubBlock::Serialize(StreamWriter& streamWriter)
+	iabError IABZone19SubBlock::Serialize(PackingWriter& streamWriter)
 	{
 		iabError returnCode = kIABNoError;
 
@@ -6677,7 +6815,7 @@ namespace ImmersiveAudioBitstream
 		// IABObjectZoneDefinition19 element, without alignment manipulation
 		// ! Do not change alignment when writing individual sub blocks.
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields (These are written into the payload of the parent element)
 		streamWriter.write(zone19Gain_.objectZone19InfoExists_, 1);
 
 		if (zone19Gain_.objectZone19InfoExists_ == 1)
@@ -6689,9 +6827,9 @@ namespace ImmersiveAudioBitstream
 	}
 
 	// IABZone19SubBlock::SerializeSubBlock() implementation
-	iabError IABZone19SubBlock::SerializeSubBlock(StreamWriter& streamWriter)
+	iabError IABZone19SubBlock::SerializeSubBlock(PackingWriter& streamWriter)
 	{
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields (These are written into the payload of the parent element)
 
 		// For first zone19 sub block, zone19Gain_.objectZone19InfoExists_ is always 1 by specification. 
 		// It is not in bitstream.
@@ -6944,8 +7082,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABObjectZoneDefinition19::Serialize() implementation
-	iabError IABObjectZoneDefinition19::Serialize(std::ostream &outStream)
+	// IABObjectZoneDefinition19::SerializeToBuffer() implementation
+	iabError IABObjectZoneDefinition19::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -6953,46 +7091,30 @@ namespace ImmersiveAudioBitstream
 			return kIABNoError;
 		}
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
 		// numZone19SubBlocks_ is not in the stream, but is determined by frame rate, per spec
 
 		// Serialize all zone19 sub blocks, in sequence, into payload writer
 		// First block, call "SerializeSubBlock()" directly
-		zone19SubBlocks_[0]->SerializeSubBlock(elementPayloadWriter_);
+		zone19SubBlocks_[0]->SerializeSubBlock(payloadWriter);
 
 		// For remaining zone19 sub-blocks, call "Serialize()"
 		for (uint8_t i = 1; i < numZone19SubBlocks_; i++)
 		{
-			zone19SubBlocks_[i]->Serialize(elementPayloadWriter_);
+			zone19SubBlocks_[i]->Serialize(payloadWriter);
 		}
 
 		// Current specificaion v4.34 does not require alingment post Zone19?
 		// Strongly suggest to add alignment to 25CSS group
 		// I am adding alignment in anticipation, as not having it would
 		// mean that DLC element may not be byte aligned, causing issues!
-		elementPayloadWriter_.align();										// Align to byte
-
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
-
-		// Serialize frame head
-		SerializeHead();
+		payloadWriter.align();										// Align to byte
 
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
-
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
@@ -7196,8 +7318,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABAuthoringToolInfo::Serialize() implementation
-	iabError IABAuthoringToolInfo::Serialize(std::ostream &outStream)
+	// IABAuthoringToolInfo::SerializeToBuffer() implementation
+	iabError IABAuthoringToolInfo::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -7205,32 +7327,16 @@ namespace ImmersiveAudioBitstream
 			return kIABNoError;
 		}
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
         // Write authoring tool info to bitstream as a null terminated string (i.e. character sequence)
         // writeStringAppendNull() will add a null byte after the last character of the string.
-        writeStringAppendNull(elementPayloadWriter_, authoringToolURI_);
-
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
-
-		// Serialize frame head
-		SerializeHead();
-
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
+        writeStringAppendNull(payloadWriter, authoringToolURI_);
 
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
@@ -7386,8 +7492,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABUserData::Serialize() implementation
-	iabError IABUserData::Serialize(std::ostream &outStream)
+	// IABUserData::SerializeToBuffer() implementation
+	iabError IABUserData::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -7395,35 +7501,19 @@ namespace ImmersiveAudioBitstream
 			return kIABNoError;
 		}
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
 		// Write user ID
-		elementPayloadWriter_.write(&userID_[0], 16);						// 16 bytes
+		payloadWriter.write(&userID_[0], 16);						// 16 bytes
 
 		// Expect size of user data block does not exceed 32-bit range
 		uint32_t userDataSize = static_cast<uint32_t>(userDataBytes_.size());
-		elementPayloadWriter_.write(&userDataBytes_[0], userDataSize);		// write user data
+		payloadWriter.write(&userDataBytes_[0], userDataSize);		// write user data
 
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
-
-		// Serialize frame head
-		SerializeHead();
-
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
-
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
@@ -7537,6 +7627,8 @@ namespace ImmersiveAudioBitstream
 		frameRateCode_ = iFrameRateCode;
 		DLCSampleRate_ = dlc::eSampleRate_48000;
 		decodedPCM_ = nullptr;
+		deSerializeSkips96kLayer_ = false;
+		is96kLayerSkipped_ = false;
 
 		// Set frame sample count per specification
 		sampleCount_ = GetIABNumFrameSamples(iFrameRateCode, kIABSampleRate_48000Hz);
@@ -7567,6 +7659,8 @@ namespace ImmersiveAudioBitstream
 		DLCSize_ = 0;
 		frameRateCode_ = iFrameRateCode;
 		decodedPCM_ = nullptr;
+		deSerializeSkips96kLayer_ = false;
+		is96kLayerSkipped_ = false;
 		
 		// Set frame sample count per specification
 		sampleCount_ = GetIABNumFrameSamples(iFrameRateCode, iSampleRate);
@@ -7687,6 +7781,52 @@ namespace ImmersiveAudioBitstream
 			return kIABPackerDLCError;
 		}
 
+		// audioData_ now holds the complete element contents
+		is96kLayerSkipped_ = false;
+
+		return kIABNoError;
+	}
+
+	// IABAudioDataDLC::GetDLCEncodeEffort() implementation
+	void IABAudioDataDLC::GetDLCEncodeEffort(IABDLCEncodeEffortType &oEncodeEffort) const
+	{
+		switch (dlcSimpleEncoder_.getEffort())
+		{
+		case dlc::SimpleEncoder::eEffort_Fast:
+			oEncodeEffort = kIABDLCEncodeEffort_Fast;
+			break;
+
+		case dlc::SimpleEncoder::eEffort_Thorough:
+			oEncodeEffort = kIABDLCEncodeEffort_Thorough;
+			break;
+
+		default:
+			oEncodeEffort = kIABDLCEncodeEffort_Minimal;
+			break;
+		}
+	}
+
+	// IABAudioDataDLC::SetDLCEncodeEffort() implementation
+	iabError IABAudioDataDLC::SetDLCEncodeEffort(IABDLCEncodeEffortType iEncodeEffort)
+	{
+		switch (iEncodeEffort)
+		{
+		case kIABDLCEncodeEffort_Minimal:
+			dlcSimpleEncoder_.setEffort(dlc::SimpleEncoder::eEffort_Minimal);
+			break;
+
+		case kIABDLCEncodeEffort_Fast:
+			dlcSimpleEncoder_.setEffort(dlc::SimpleEncoder::eEffort_Fast);
+			break;
+
+		case kIABDLCEncodeEffort_Thorough:
+			dlcSimpleEncoder_.setEffort(dlc::SimpleEncoder::eEffort_Thorough);
+			break;
+
+		default:
+			return kIABBadArgumentsError;
+		}
+
 		return kIABNoError;
 	}
 
@@ -7711,8 +7851,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABAudioDataDLC::Serialize() implementation
-	iabError IABAudioDataDLC::Serialize(std::ostream &outStream)
+	// IABAudioDataDLC::SerializeToBuffer() implementation
+	iabError IABAudioDataDLC::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -7720,102 +7860,57 @@ namespace ImmersiveAudioBitstream
 			return kIABNoError;
 		}
 
-		// uint32_t dlcOstreamPosition = 0;
-		// uint32_t packedDLCSizeInBytes = 0;
-		// dlcOstreamPosition = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
+		// The 96k layer of the parsed element was not read, re-serialize the payload as read
+		if (is96kLayerSkipped_)
+		{
+			return SerializeParsedPayload(ioBuffer);
+		}
 
-		// since DLCSize can only be determined AFTER packing DLC payload, another internal 
-		// bitstream writer is needed, to accommodate another instance of non-sequential
-		// packing requirement.
-		std::stringstream	dlcHeadBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
-		StreamWriter		dlcHeadWriter(dlcHeadBuffer);
-		// Both writer and buffer are in init state.
-        // TODO: Review XCode analyzer warning
-		write(dlcHeadWriter, Plex<8>(audioDataID_));						// AudioDataID, identifying this DLC element
+		// Residuals are held in packed form, following encoding or parsing
+		if (!audioData_.hasPackedResiduals())
+		{
+			return kIABPackerDLCError;
+		}
 
-		// "DLCSize_" is to be determined by "payload" size, to be determined and written below.
-		// (in the case of DLC element, it is actually "DLC payload" size".
-		// The element payload is the sum of DLC payload size and DLC head size.
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		write(payloadWriter, Plex<8>(audioDataID_));						// AudioDataID, identifying this DLC element
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// "DLCSize_" is the DLC payload size, that can only be determined AFTER packing DLC payload.
+		// Reserve it here, to be back-patched below.
+		// The element payload is the sum of DLC payload size and DLC head size.
+		size_t dlcSizePosition = ioBuffer.GetPosition();
+		payloadWriter.write(static_cast<uint16_t>(0), 16);
+
+		// Writing data fields
 		// Calling method for writing Plex encoded field.
-		elementPayloadWriter_.write(audioData_.getSampleRate(), 2);
-		elementPayloadWriter_.write(audioData_.getShiftBits(), 5);
+		payloadWriter.write(audioData_.getSampleRate(), 2);
+		payloadWriter.write(audioData_.getShiftBits(), 5);
 
 		// Prediction Region for 48 kHz
-		elementPayloadWriter_.write(audioData_.getNumPredRegions48(), 2);
+		payloadWriter.write(audioData_.getNumPredRegions48(), 2);
 
-		// 19/10/2017: getNumPredRegions48 probably == 0, for now.
+		// Non-zero when the element was encoded above the minimal encoding effort, or parsed
 		for (uint8_t n = 0; n < audioData_.getNumPredRegions48(); n++)
 		{
-			elementPayloadWriter_.write(audioData_.getPredRegion48(n).getRegionLength(), 4);
-			elementPayloadWriter_.write(audioData_.getPredRegion48(n).getOrder(), 5);
+			payloadWriter.write(audioData_.getPredRegion48(n).getRegionLength(), 4);
+			payloadWriter.write(audioData_.getPredRegion48(n).getOrder(), 5);
 
 			for (uint8_t m = 1; m <= audioData_.getPredRegion48(n).getOrder(); m++)				// Changed on Dec 11, 2017 (Currently following C indexing, but spec says "m = 1; m <= order; m++". TODO: Need confirming with Pierre.)
 			{
-				elementPayloadWriter_.write(audioData_.getPredRegion48(n).getKCoeff()[m], 10);
+				payloadWriter.write(audioData_.getPredRegion48(n).getKCoeff()[m], 10);
 			}
 		}
 
 		// Coded residual samples for 48kHz
-		// dlcNumDLCSubBlocks = audioData_.getNumDLCSubBlocks();
+		iabError errorCode = SerializeResiduals(payloadWriter, audioData_.getResidualLayer48());
 
-		for (uint8_t n = 0; n < audioData_.getNumDLCSubBlocks(); n++)
+		if (errorCode != kIABNoError)
 		{
-			elementPayloadWriter_.write(audioData_.getDLCSubBlock48(n)->getCodeType(), 1);
-
-			// If encoded as PCM
-			if (audioData_.getDLCSubBlock48(n)->getCodeType() == dlc::eCodeType_PCM_CODE_TYPE)
-			{
-				dlc::PCMResidualsSubBlock* pcmResidualsSubBlock = dynamic_cast<dlc::PCMResidualsSubBlock*>(audioData_.getDLCSubBlock48(n));
-
-				uint5_t residualBitDepth = pcmResidualsSubBlock->getBitDepth();
-				elementPayloadWriter_.write(residualBitDepth, 5);
-
-				if (residualBitDepth != 0)
-				{
-					uint32_t subBlockSize = pcmResidualsSubBlock->getSize();					// Get residual block size
-					int32_t* pResiduals = pcmResidualsSubBlock->getResiduals();					// Get pointer to beginning of residual samples
-					int32_t residualValue = 0;													// Residual value, as-is retrieved
-					uint32_t residualMagnitude = 0;												// Stores residual magnitude
-					uint1_t residualSign = 0;													// 1-bit sign, 0 == postive, 1 == negative
-
-					for (uint32_t i = 0; i < subBlockSize; i++)
-					{
-						residualValue = *pResiduals++;
-						if (residualValue >= 0)
-						{
-							residualMagnitude = static_cast<uint32_t>(residualValue);
-							residualSign = 0;
-						}
-						else
-						{
-							residualMagnitude = static_cast<uint32_t>(-residualValue);
-							residualSign = 1;
-						}
-
-						elementPayloadWriter_.write(residualMagnitude, residualBitDepth);		// Write the residual magnitude
-						if (residualValue != 0)
-						{
-							elementPayloadWriter_.write(residualSign, 1);						// Only write sign if residual value is not 0
-						}
-
-					}
-				}
-			}
-			// If encoded using Rice/Golomb entropy compression
-			else
-			{
-				// TODO: not implemented for version 1
-				return kIABNotImplementedError;
-			}
+			ioBuffer.DiscardElement(elementMark);
+			return errorCode;
 		}
 
 		// Further to write encoded data for the upper spectral part of 96kHz
@@ -7824,109 +7919,128 @@ namespace ImmersiveAudioBitstream
 		if (audioData_.getSampleRate() == dlc::eSampleRate_96000)
 		{
 			// Prediction Region for 96 kHz
-			elementPayloadWriter_.write(audioData_.getNumPredRegions96(), 2);
+			payloadWriter.write(audioData_.getNumPredRegions96(), 2);
 
 			// 19/10/2017: getNumPredRegions96 probably == 0, for now.
 			for (uint8_t n = 0; n < audioData_.getNumPredRegions96(); n++)
 			{
-				elementPayloadWriter_.write(audioData_.getPredRegion96(n).getRegionLength(), 4);
-				elementPayloadWriter_.write(audioData_.getPredRegion96(n).getOrder(), 5);
+				payloadWriter.write(audioData_.getPredRegion96(n).getRegionLength(), 4);
+				payloadWriter.write(audioData_.getPredRegion96(n).getOrder(), 5);
 
 				for (uint8_t m = 1; m <= audioData_.getPredRegion96(n).getOrder(); m++)				// Changed on Dec 11, 2017 (Currently following C indexing, but spec says "m = 1; m <= order; m++". TODO: Need confirming with Pierre.)
 				{
-					elementPayloadWriter_.write(audioData_.getPredRegion96(n).getKCoeff()[m], 10);
+					payloadWriter.write(audioData_.getPredRegion96(n).getKCoeff()[m], 10);
 				}
 			}
 
 			// Coded residual samples for 96kHz
-			for (uint8_t n = 0; n < audioData_.getNumDLCSubBlocks(); n++)
+			errorCode = SerializeResiduals(payloadWriter, audioData_.getResidualLayer96());
+
+			if (errorCode != kIABNoError)
 			{
-				elementPayloadWriter_.write(audioData_.getDLCSubBlock96(n)->getCodeType(), 1);
+				ioBuffer.DiscardElement(elementMark);
+				return errorCode;
+			}
+		}
 
-				// If encoded as PCM
-				if (audioData_.getDLCSubBlock96(n)->getCodeType() == dlc::eCodeType_PCM_CODE_TYPE)
-				{
-					dlc::PCMResidualsSubBlock* pcmResidualsSubBlock = dynamic_cast<dlc::PCMResidualsSubBlock*>(audioData_.getDLCSubBlock96(n));
+		payloadWriter.align();																// Align to byte
 
-					uint5_t residualBitDepth = pcmResidualsSubBlock->getBitDepth();
-					elementPayloadWriter_.write(residualBitDepth, 5);
+		// Now ready to retrieve and back-patch DLCSize_.
+		DLCSize_ = static_cast<uint16_t>(ioBuffer.GetPosition() - (dlcSizePosition + 2));
+		ioBuffer.PatchField(dlcSizePosition, DLCSize_, 2);
 
-					if (residualBitDepth != 0)
-					{
-						uint32_t subBlockSize = pcmResidualsSubBlock->getSize();					// Get residual block size
-						int32_t* pResiduals = pcmResidualsSubBlock->getResiduals();					// Get pointer to beginning of residual samples
-						int32_t residualValue = 0;													// Residual value, as-is retrieved
-						uint32_t residualMagnitude = 0;												// Stores residual magnitude
-						uint1_t residualSign = 0;													// 1-bit sign, 0 == postive, 1 == negative
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
-						for (uint32_t i = 0; i < subBlockSize; i++)
-						{
-							residualValue = *pResiduals++;
-							if (residualValue >= 0)
-							{
-								residualMagnitude = static_cast<uint32_t>(residualValue);
-								residualSign = 0;
-							}
-							else
-							{
-								residualMagnitude = static_cast<uint32_t>(-residualValue);
-								residualSign = 1;
-							}
+		return kIABNoError;
+	}
 
-							elementPayloadWriter_.write(residualMagnitude, residualBitDepth);		// Write the residual magnitude
-							if (residualValue != 0)
-							{
-								elementPayloadWriter_.write(residualSign, 1);						// Only write sign if residual value is not 0
-							}
+	// IABAudioDataDLC::SerializeResiduals() implementation
+	iabError IABAudioDataDLC::SerializeResiduals(PackingWriter& streamWriter, const dlc::ResidualLayer &iLayer)
+	{
+		uint32_t subBlockSize = iLayer.getSubBlockSize();								// Get residual block size
+		const int32_t* pResiduals = iLayer.getResiduals();								// Residuals are in sub block order
 
-						}
+		for (uint8_t n = 0; n < iLayer.getNumSubBlocks(); n++, pResiduals += subBlockSize)
+		{
+			streamWriter.write(iLayer.getCodeType(n), 1);
+
+			// If encoded using Rice/Golomb entropy compression
+			if (iLayer.getCodeType(n) != dlc::eCodeType_PCM_CODE_TYPE)
+			{
+				uint5_t riceRemBits = iLayer.getCodingBits(n);
+				streamWriter.write(riceRemBits, 5);
+
+				uint32_t remainderMask = (static_cast<uint32_t>(1) << riceRemBits) - 1;
+
+				for (uint32_t i = 0; i < subBlockSize; i++)
+				{
+					int32_t residualValue = pResiduals[i];									// Residual value, as-is retrieved
+					uint32_t residualMagnitude = static_cast<uint32_t>(residualValue >= 0 ? residualValue : -residualValue);
+					uint32_t quotient = residualMagnitude >> riceRemBits;
+
+					// Unary coded quotient: quotient 1s, terminated by a 0
+					streamWriter.writeUnary(quotient);
+
+					if (riceRemBits > 0)
+					{
+						streamWriter.write(residualMagnitude & remainderMask, riceRemBits);	// Write the remainder
+					}
+
+					if (residualValue != 0)
+					{
+						streamWriter.write(residualValue < 0 ? 1 : 0, 1);			// Only write sign if residual value is not 0
 					}
 				}
-				// If encoded using Rice/Golomb entropy compression
-				else
+
+				continue;
+			}
+
+			// Encoded as PCM
+			uint5_t residualBitDepth = iLayer.getCodingBits(n);
+			streamWriter.write(residualBitDepth, 5);
+
+			if (residualBitDepth == 0)
+			{
+				continue;
+			}
+
+			for (uint32_t i = 0; i < subBlockSize; i++)
+			{
+				int32_t residualValue = pResiduals[i];									// Residual value, as-is retrieved
+				uint32_t residualMagnitude = static_cast<uint32_t>(residualValue >= 0 ? residualValue : -residualValue);
+
+				streamWriter.write(residualMagnitude, residualBitDepth);		// Write the residual magnitude
+				if (residualValue != 0)
 				{
-					// TODO: not implemented for version 1
-					return kIABNotImplementedError;
+					streamWriter.write(residualValue < 0 ? 1 : 0, 1);			// Only write sign if residual value is not 0
 				}
 			}
 		}
 
-		elementPayloadWriter_.align();														// Align to byte
-
-		// Now ready to retrieve and set DLCSize_.
-		DLCSize_ = static_cast<uint16_t>(elementPayloadBuffer_.tellp());
-		dlcHeadWriter.write(DLCSize_, 16);
-
-		// Retrieve DLC head length, part of Element payload length
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(dlcHeadBuffer.tellp());
-		// Add element payload buffer length
-		packedPayloadLength += static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		// The sum is the element payload length
-		SetElementSize(packedPayloadLength);
+		return kIABNoError;
+	}
 
-		// Serialize frame head
-		SerializeHead();
+	// IABAudioDataDLC::SerializeParsedPayload() implementation
+	iabError IABAudioDataDLC::SerializeParsedPayload(IABPackingBuffer &ioBuffer)
+	{
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
-		// Output elementHeadBuffer_ first,
-		// followed then by dlcHeadBuffer
-		// and finally followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << dlcHeadBuffer.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
+		write(payloadWriter, Plex<8>(audioDataID_));						// AudioDataID, identifying this DLC element
+		payloadWriter.write(DLCSize_, 16);									// DLCSize, as parsed
+		payloadWriter.write(dlcPayload_.data(), DLCSize_);
 
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Element payload length is the sum of DLC head and DLC payload sizes
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
 
-	// IABAudioDataDLC::DecodeDLCToMonoPCMInternal() implementation
-	iabError IABAudioDataDLC::DecodeDLCToMonoPCMInternal(uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate)
+	// IABAudioDataDLC::CheckDecodeParameters() implementation
+	iabError IABAudioDataDLC::CheckDecodeParameters(uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate) const
 	{
-		dlc::FullDecoder::StatusCode decoderErrorCode = dlc::FullDecoder::StatusCode_OK;
-
 		// Check requested sampling rate
 		if ((iDecodeSampleRate != kIABSampleRate_96000Hz)
 			&& (iDecodeSampleRate != kIABSampleRate_48000Hz))
@@ -7934,9 +8048,9 @@ namespace ImmersiveAudioBitstream
 			return kIABParserDLCDecodingError;
 		}
 
-		// Can't decode to 96k from a 48k DLC element
+		// Can't decode to 96k from a 48k DLC element, or from one parsed without its 96k layer
 		if ((iDecodeSampleRate == kIABSampleRate_96000Hz)
-			&& (DLCSampleRate_ != dlc::eSampleRate_96000))
+			&& ((DLCSampleRate_ != dlc::eSampleRate_96000) || is96kLayerSkipped_))
 		{
 			return kIABParserDLCDecodingError;
 		}
@@ -7967,11 +8081,40 @@ namespace ImmersiveAudioBitstream
 			return kIABArgumentIncorrectDLCSampleCount;
 		}
 
+		return kIABNoError;
+	}
+
+	// IABAudioDataDLC::PrepareDecodedSampleBuffer() implementation
+	iabError IABAudioDataDLC::PrepareDecodedSampleBuffer(uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate)
+	{
+		iabError errorCode = CheckDecodeParameters(iSampleCount, iDecodeSampleRate);
+
+		if (errorCode != kIABNoError)
+		{
+			return errorCode;
+		}
+
 		// Allocate memory to hold decoded PCM samples, if not already
 		if (!decodedPCM_)
 		{
 			// Allocate
-			decodedPCM_ = new int32_t[dlcNumPCMSamples];
+			decodedPCM_ = new int32_t[iSampleCount];
+		}
+
+		return kIABNoError;
+	}
+
+	// IABAudioDataDLC::DecodeDLCToMonoPCMInternal() implementation
+	iabError IABAudioDataDLC::DecodeDLCToMonoPCMInternal(uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate)
+	{
+		dlc::FullDecoder::StatusCode decoderErrorCode = dlc::FullDecoder::StatusCode_OK;
+		uint32_t dlcNumPCMSamples = iSampleCount;
+
+		iabError errorCode = PrepareDecodedSampleBuffer(iSampleCount, iDecodeSampleRate);
+
+		if (errorCode != kIABNoError)
+		{
+			return errorCode;
 		}
 
 		// decode to decodedPCM_
@@ -7997,6 +8140,296 @@ namespace ImmersiveAudioBitstream
 		return kIABNoError;
 	}
 
+	// IABAudioDataDLC::DecodeDLCToMonoPCMInternal() implementation (group of elements)
+	iabError IABAudioDataDLC::DecodeDLCToMonoPCMInternal(IABAudioDataDLC* const* iElements
+		, uint32_t iElementCount
+		, uint32_t iSampleCount
+		, IABSampleRateType iDecodeSampleRate)
+	{
+		if (iElements == nullptr)
+		{
+			return kIABBadArgumentsError;
+		}
+
+		dlc::SampleRate decodeSampleRate = (iDecodeSampleRate == kIABSampleRate_96000Hz) ? dlc::eSampleRate_96000 : dlc::eSampleRate_48000;
+		dlc::FullDecoder::ResidualChannel channels[dlc::FullDecoder::kMaxBatchLanes];
+		iabError returnCode = kIABNoError;
+
+		uint32_t i = 0;
+
+		while (i < iElementCount)
+		{
+			// Collect up to kMaxBatchLanes parsed elements with the first one's sub block size.
+			// Any other element is decoded on its own.
+			uint32_t channelCount = 0;
+			IABAudioDataDLC* batchDecoderOwner = nullptr;
+
+			for (; i < iElementCount && channelCount < dlc::FullDecoder::kMaxBatchLanes; i++)
+			{
+				IABAudioDataDLC* element = iElements[i];
+				iabError errorCode = kIABNoError;
+
+				if (element == nullptr)
+				{
+					returnCode = kIABBadArgumentsError;
+					continue;
+				}
+
+				if (!element->audioData_.hasPackedResiduals()
+					|| (batchDecoderOwner && element->dlcBlockLength_ != batchDecoderOwner->dlcBlockLength_))
+				{
+					errorCode = element->DecodeDLCToMonoPCMInternal(iSampleCount, iDecodeSampleRate);
+				}
+				else if ((errorCode = element->PrepareDecodedSampleBuffer(iSampleCount, iDecodeSampleRate)) == kIABNoError)
+				{
+					if (!batchDecoderOwner)
+					{
+						batchDecoderOwner = element;
+					}
+
+					channels[channelCount].samples_ = element->decodedPCM_;
+					channels[channelCount].predictionData_ = &element->audioData_;
+					channels[channelCount].residuals48_ = element->audioData_.getResidualLayer48().getResiduals();
+					channels[channelCount].residuals96_ = element->audioData_.getResidualLayer96().getResiduals();
+					channelCount++;
+				}
+
+				if (errorCode != kIABNoError)
+				{
+					returnCode = errorCode;
+				}
+			}
+
+			if (channelCount > 0)
+			{
+				// Working buffers of the first element's decoder are used for the whole batch
+				if (batchDecoderOwner->dlcFullDecoder_.decodeResidualsBatch_noexcept(channels, channelCount, iSampleCount
+					, decodeSampleRate, batchDecoderOwner->dlcBlockLength_) != dlc::FullDecoder::StatusCode_OK)
+				{
+					returnCode = kIABParserDLCDecodingError;
+				}
+			}
+		}
+
+		return returnCode;
+	}
+
+	// IABDLCFrameSamples::GetSamples() implementation
+	const IABSampleType* IABDLCFrameSamples::GetSamples(IABAudioDataIDType iAudioDataID) const
+	{
+		for (size_t n = 0; n < audioDataIDs_.size(); n++)
+		{
+			if (audioDataIDs_[n] == iAudioDataID)
+			{
+				return samples_.data() + n * sampleCount_;
+			}
+		}
+
+		return nullptr;
+	}
+
+	// IABAudioDataDLC::DecodeAllDLC() implementation
+	iabError IABAudioDataDLC::DecodeAllDLC(const IABFrameInterface& iFrame
+		, const std::set<IABAudioDataIDType>& iAudioDataIDs
+		, IABDLCFrameSamples& oSamples
+		, IABSampleRateType iDecodeSampleRate)
+	{
+		IABSampleRateType frameSampleRate;
+		IABFrameRateType frameRate;
+
+		iFrame.GetSampleRate(frameSampleRate);
+		iFrame.GetFrameRate(frameRate);
+
+		oSamples.samples_.clear();
+		oSamples.audioDataIDs_.clear();
+		oSamples.sampleCount_ = 0;
+
+		if (((iDecodeSampleRate != kIABSampleRate_48000Hz) && (iDecodeSampleRate != kIABSampleRate_96000Hz))
+			|| ((iDecodeSampleRate == kIABSampleRate_96000Hz) && (frameSampleRate != kIABSampleRate_96000Hz)))
+		{
+			return kIABBadArgumentsError;
+		}
+
+		uint32_t sampleCount = GetIABNumFrameSamples(frameRate, iDecodeSampleRate);
+
+		if (sampleCount == 0)
+		{
+			return kIABBadArgumentsError;
+		}
+
+		// Collect the requested DLC elements of the frame, one plane each
+		std::vector<IABElement*> frameSubElements;
+		std::vector<IABAudioDataDLC*> elements;
+
+		iFrame.GetSubElements(frameSubElements);
+
+		for (std::vector<IABElement*>::const_iterator iter = frameSubElements.begin(); iter != frameSubElements.end(); iter++)
+		{
+			IABAudioDataDLC* element = dynamic_cast<IABAudioDataDLC*>(*iter);
+
+			if (element && (iAudioDataIDs.count(element->audioDataID_) != 0))
+			{
+				elements.push_back(element);
+			}
+		}
+
+		oSamples.sampleCount_ = sampleCount;
+		oSamples.samples_.assign(elements.size() * sampleCount, 0.0f);
+		oSamples.audioDataIDs_.resize(elements.size());
+
+		for (uint32_t n = 0; n < elements.size(); n++)
+		{
+			elements[n]->GetAudioDataID(oSamples.audioDataIDs_[n]);
+		}
+
+		// Decoding order: parsed elements grouped by block length so that batches are full, followed by
+		// elements without packed residuals, which are decoded one at a time
+		std::vector<uint32_t> order(elements.size());
+
+		for (uint32_t n = 0; n < elements.size(); n++)
+		{
+			order[n] = n;
+		}
+
+		std::stable_sort(order.begin(), order.end(), [&elements](uint32_t a, uint32_t b)
+		{
+			uint32_t keyA = elements[a]->audioData_.hasPackedResiduals() ? elements[a]->dlcBlockLength_ : UINT32_MAX;
+			uint32_t keyB = elements[b]->audioData_.hasPackedResiduals() ? elements[b]->dlcBlockLength_ : UINT32_MAX;
+
+			return keyA < keyB;
+		});
+
+		static const uint32_t kBatchSize = dlc::FullDecoder::kMaxBatchLanes;
+
+		dlc::SampleRate decodeSampleRate = (iDecodeSampleRate == kIABSampleRate_96000Hz) ? dlc::eSampleRate_96000 : dlc::eSampleRate_48000;
+		dlc::FullDecoder::ResidualChannel channels[kBatchSize];
+		uint32_t batchPlanes[kBatchSize];
+		bool batchDecoded[kBatchSize];
+		iabError returnCode = kIABNoError;
+
+		// Planes converted from successfully decoded elements
+		std::vector<bool> planeDecoded(elements.size(), false);
+
+		// Each batch is decoded to batchSamples_ and converted to its planes while still in cache
+		oSamples.batchSamples_.resize(kBatchSize * sampleCount);
+
+		uint32_t i = 0;
+
+		while (i < order.size())
+		{
+			uint32_t batchCount = 0;
+			uint32_t channelCount = 0;
+			IABAudioDataDLC* batchDecoderOwner = nullptr;
+
+			for (; i < order.size() && batchCount < kBatchSize; i++)
+			{
+				IABAudioDataDLC* element = elements[order[i]];
+				int32_t* batchSamples = oSamples.batchSamples_.data() + batchCount * sampleCount;
+
+				if (element->audioData_.hasPackedResiduals() && batchDecoderOwner
+					&& element->dlcBlockLength_ != batchDecoderOwner->dlcBlockLength_)
+				{
+					// Start a new batch at each block length change
+					break;
+				}
+
+				iabError errorCode = element->CheckDecodeParameters(sampleCount, iDecodeSampleRate);
+
+				if (errorCode != kIABNoError)
+				{
+					returnCode = errorCode;
+					continue;
+				}
+
+				batchPlanes[batchCount] = order[i];
+				batchDecoded[batchCount] = true;
+
+				if (element->audioData_.hasPackedResiduals())
+				{
+					if (!batchDecoderOwner)
+					{
+						batchDecoderOwner = element;
+					}
+
+					channels[channelCount].samples_ = batchSamples;
+					channels[channelCount].predictionData_ = &element->audioData_;
+					channels[channelCount].residuals48_ = element->audioData_.getResidualLayer48().getResiduals();
+					channels[channelCount].residuals96_ = element->audioData_.getResidualLayer96().getResiduals();
+					channelCount++;
+				}
+				else if (element->dlcFullDecoder_.decode_noexcept(batchSamples, sampleCount, decodeSampleRate
+					, element->audioData_) != dlc::FullDecoder::StatusCode_OK)
+				{
+					batchDecoded[batchCount] = false;
+					returnCode = kIABParserDLCDecodingError;
+				}
+
+				batchCount++;
+			}
+
+			// Packed elements take the first channelCount batch slots, in order
+			if (channelCount > 0)
+			{
+				// Working buffers of the first element's decoder are used for the whole batch
+				if (batchDecoderOwner->dlcFullDecoder_.decodeResidualsBatch_noexcept(channels, channelCount, sampleCount
+					, decodeSampleRate, batchDecoderOwner->dlcBlockLength_) != dlc::FullDecoder::StatusCode_OK)
+				{
+					std::fill(batchDecoded, batchDecoded + channelCount, false);
+					returnCode = kIABParserDLCDecodingError;
+				}
+			}
+
+			// Convert to IABSampleType, scaled to 32-bit signed integer range as the renderer does
+			float scaleFactor = kInt32BitMaxValue;
+
+			for (uint32_t b = 0; b < batchCount; b++)
+			{
+				if (!batchDecoded[b])
+				{
+					continue;
+				}
+
+				const int32_t *decodedSample = oSamples.batchSamples_.data() + b * sampleCount;
+				IABSampleType *convertedSample = oSamples.samples_.data() + batchPlanes[b] * sampleCount;
+
+				for (uint32_t j = 0; j < sampleCount; j++)
+				{
+					convertedSample[j] = static_cast<IABSampleType>(decodedSample[j] / scaleFactor);
+				}
+
+				planeDecoded[batchPlanes[b]] = true;
+			}
+		}
+
+		// Drop planes of elements that failed to decode, keeping the others in place
+		if (kIABNoError != returnCode)
+		{
+			uint32_t keptPlanes = 0;
+
+			for (uint32_t n = 0; n < elements.size(); n++)
+			{
+				if (!planeDecoded[n])
+				{
+					continue;
+				}
+
+				if (keptPlanes != n)
+				{
+					std::copy(oSamples.samples_.begin() + n * sampleCount, oSamples.samples_.begin() + (n + 1) * sampleCount
+						, oSamples.samples_.begin() + keptPlanes * sampleCount);
+					oSamples.audioDataIDs_[keptPlanes] = oSamples.audioDataIDs_[n];
+				}
+
+				keptPlanes++;
+			}
+
+			oSamples.samples_.resize(keptPlanes * sampleCount);
+			oSamples.audioDataIDs_.resize(keptPlanes);
+		}
+
+		return returnCode;
+	}
+
 	// IABAudioDataDLC::DecodeDLCToMonoPCM() implementation
 	iabError IABAudioDataDLC::DecodeDLCToMonoPCM(int32_t* oSamples, uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate)
 	{
@@ -8047,7 +8480,6 @@ namespace ImmersiveAudioBitstream
  
         Plex<8> plex8Field = 0;
         uint16_t fixedLengthFieldMax16 = 0;
-        uint8_t fixedLengthFieldMax8 = 0;
         
         // Read audio data ID
         if (CMNSTRM_OK != read(streamReader, plex8Field))
@@ -8065,17 +8497,34 @@ namespace ImmersiveAudioBitstream
 
         DLCSize_ = fixedLengthFieldMax16;
 
+        if (DLCSize_ == 0)
+        {
+            return kIABParserIABDLCError;
+        }
+
+        // Read the whole DLC payload, and decode its fields from memory.
+        // This lets the Rice/Golomb residuals be decoded from a bit cache rather than bit by bit.
+        dlcPayload_.resize(DLCSize_);
+
+        if (CMNSTRM_OK != streamReader.read(dlcPayload_.data(), DLCSize_))
+        {
+            return kIABParserIABDLCError;
+        }
+
+        dlc::ResidualReader payloadReader(dlcPayload_.data(), DLCSize_);
+        uint32_t payloadField = 0;
+
         // Read sample rate
-        if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 2))
+        if (!payloadReader.readBits(payloadField, 2))
         {
             return kIABParserIABDLCError;
         }
 
-        if (0 == fixedLengthFieldMax8)
+        if (0 == payloadField)
         {
             DLCSampleRate_ = dlc::eSampleRate_48000;
         }
-        else if (1 == fixedLengthFieldMax8)
+        else if (1 == payloadField)
         {
             DLCSampleRate_ = dlc::eSampleRate_96000;
         }
@@ -8090,425 +8539,77 @@ namespace ImmersiveAudioBitstream
 		{
 			return kIABParserIABDLCError;
 		}
-
-        uint8_t shiftBits = 0;
         
         // Read 5-bit shift bit field
-        if (CMNSTRM_OK != streamReader.read(shiftBits, 5))
+        if (!payloadReader.readBits(payloadField, 5))
         {
             return kIABParserIABDLCError;
         }
         
         // Set DLC audio shift bits
-        audioData_.setShiftBits(shiftBits);
+        audioData_.setShiftBits(static_cast<uint5_t>(payloadField));
        
         // ********************************
         // 48KHz predictor information
         // ********************************
-        
-        // Read 2-bit number of prediction regions for 48K
-        if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 2))
-        {
-            return kIABParserIABDLCError;
-        }
 
-        dlcNumPredRegions48_ = static_cast<uint2_t>(fixedLengthFieldMax8);
-        
-        // Set DLC audio number of prediction regions
-        audioData_.setNumPredRegions48(dlcNumPredRegions48_);
-        
-        uint10_t predCoeffs[32] = {0}; // maximum 32 coefficients
-        
-        for (uint32_t n = 0; n < static_cast<uint32_t>(dlcNumPredRegions48_); n++)
+        if (kIABNoError != DeSerializePredRegions(payloadReader, dlc::eSampleRate_48000))
         {
-            // Read 4-bit region length
-            if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 4))
-            {
-                return kIABParserIABDLCError;
-            }
-            
-            // Set region length
-            audioData_.getPredRegion48(n).setRegionLength(fixedLengthFieldMax8);
-            
-            // Read 5-bit region order
-            if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 5))
-            {
-                return kIABParserIABDLCError;
-            }
-            
-            // Set region order
-            audioData_.getPredRegion48(n).setOrder(fixedLengthFieldMax8);
-            
-            for (uint8_t m = 1; m <= fixedLengthFieldMax8; m++)
-            {
-                // Read 10-bit coefficient
-                if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax16, 10))
-                {
-                    return kIABParserIABDLCError;
-                }
-
-                predCoeffs[m] = fixedLengthFieldMax16;
-            }
-            
-            // Set coefficients
-            audioData_.getPredRegion48(n).setKCoeff(&predCoeffs[0]);
-            
+            return kIABParserIABDLCError;
         }
 
         // ********************************
         // 48KHz residuals
         // ********************************
-                
-        for (uint8_t n = 0; n < audioData_.getNumDLCSubBlocks(); n++)
-        {
-            // Read 1-bit code type
-            if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-            {
-                return kIABParserIABDLCError;
-            }
-            
-            // If encoded as PCM
-            if (fixedLengthFieldMax8 == dlc::eCodeType_PCM_CODE_TYPE)
-            {
-                // Initialise residual block to PCM type
-                audioData_.initDLCSubBlock48(n, dlc::eCodeType_PCM_CODE_TYPE, dlcBlockLength_);
-
-                dlc::PCMResidualsSubBlock* pcmResidualsSubBlock = dynamic_cast<dlc::PCMResidualsSubBlock*>(audioData_.getDLCSubBlock48(n));
-                
-                // Read 5-bit bit depth
-                uint8_t bitDepth = 0;
-                if (CMNSTRM_OK != streamReader.read(bitDepth, 5))
-                {
-                    return kIABParserIABDLCError;
-                }
 
-                // Set bit depth
-                pcmResidualsSubBlock->setBitDepth(bitDepth);
-                
-                uint32_t subBlockSize = pcmResidualsSubBlock->getSize();					// Get residual block size
-                int32_t* pResiduals = pcmResidualsSubBlock->getResiduals();					// Get pointer to beginning of residual samples
-                int32_t residualValue = 0;													// Residual value, as-is retrieved
-                uint8_t residualSign = 0;													// 1-bit sign, 0 == postive, 1 == negative
-                
-                for (uint32_t i = 0; i < subBlockSize; i++)
-                {
-					if (bitDepth == 0)
-					{
-						residualValue = 0;
-					}
-					else
-                    {
-                        // Read residual
-                        if (CMNSTRM_OK != streamReader.read(residualValue, bitDepth))
-                        {
-                            return kIABParserIABDLCError;
-                        }
-                        
-                        if (residualValue != 0)
-                        {
-                            // Read sign bit
-                            if (CMNSTRM_OK != streamReader.read(residualSign, 1))
-                            {
-                                return kIABParserIABDLCError;
-                            }
-
-                            if (1 == residualSign)
-                            {
-                                // invert value
-                                residualValue *= -1;
-                            }
-                        }
-                    }
-
-                    *pResiduals++ = residualValue;
-                }
-            }
-            // If encoded using Rice/Golomb entropy compression
-            else
-            {
-                // Initialise residual block to Rice type
-                audioData_.initDLCSubBlock48(n, dlc::eCodeType_RICE_CODE_TYPE, dlcBlockLength_);
-
-                dlc::RiceResidualsSubBlock* riceResidualsSubBlock = dynamic_cast<dlc::RiceResidualsSubBlock*>(audioData_.getDLCSubBlock48(n));
-                
-                // Read 5-bit rice remainder length
-                uint8_t riceRemBits = 0;
-                if (CMNSTRM_OK != streamReader.read(riceRemBits, 5))
-                {
-                    return kIABParserIABDLCError;
-                }
-                
-                // Set remainder bits
-                riceResidualsSubBlock->setRiceRemBits(riceRemBits);
-                
-                uint32_t subBlockSize = riceResidualsSubBlock->getSize();					// Get residual block size
-                dlc::RiceResidual* pResiduals = riceResidualsSubBlock->getResiduals();		// Get pointer to beginning of residual samples
-                
-                for (uint32_t i = 0; i < subBlockSize; i++)
-                {
-                    int32_t remainder = 0;                          // Residual value, as-is retrieved
-                    char residualSign = 1;							// 1-bit sign, 0 == postive (maps to 1 for DLC lib), 1 == negative (maps to -1 for DLC lib)
-                    int32_t quotient = 0;
-                    
-                    if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-                    {
-                        return kIABParserIABDLCError;
-                    }
+        // Residuals are decoded in packed form, into storage kept from previous frames
+        audioData_.initPackedResiduals(dlcBlockLength_);
 
-                    while (1 == fixedLengthFieldMax8)
-                    {
-                        quotient++;
-                        if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-                        {
-                            return kIABParserIABDLCError;
-                        }
-                    }
+        if (kIABNoError != DeSerializeResiduals(payloadReader, audioData_.getResidualLayer48()))
+        {
+            return kIABParserIABDLCError;
+        }
 
-					if (riceRemBits == 0)
-					{
-						remainder = 0;
-					}
-					else
-                    {
-                        // Read rice remainder
-                        if (CMNSTRM_OK != streamReader.read(remainder, riceRemBits))
-                        {
-                            return kIABParserIABDLCError;
-                        }
-                    }
-                    
-                    if ((remainder != 0) || (quotient > 0))
-                    {
-                        // Read sign bit, 0 maps to +1, 1 maps to -1
-                        if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-                        {
-                            return kIABParserIABDLCError;
-                        }
+        // The 96k layer follows the 48k layer, up to the end of the payload already read.
+        // Skipping it only requires not decoding it.
+        is96kLayerSkipped_ = (DLCSampleRate_ == dlc::eSampleRate_96000) && deSerializeSkips96kLayer_;
 
-                        if (1 == fixedLengthFieldMax8)
-                        {
-                            residualSign = -1;
-                        }
-                    }
-                    
-                    // save residual
-                    pResiduals->setQuotient(quotient);
-                    pResiduals->setSign(residualSign);
-                    pResiduals++->setRemainder(remainder);
-                }
-            }
+        if (is96kLayerSkipped_)
+        {
+            audioData_.getResidualLayer96().resize(0, 0);
         }
         
-        // ********************************
-        // 96KHz predictor information
-        // ********************************
-        
-        if (DLCSampleRate_ == dlc::eSampleRate_96000)
+        if (DLCSampleRate_ == dlc::eSampleRate_96000 && !is96kLayerSkipped_)
         {
-            // Read 2-bit number of prediction regions for 96K
-            if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 2))
-            {
-                return kIABParserIABDLCError;
-            }
+            // ********************************
+            // 96KHz predictor information
+            // ********************************
 
-            dlcNumPredRegions96_ = static_cast<uint2_t>(fixedLengthFieldMax8);
-            
-            // Set DLC audio number of prediction regions for 96KHz
-            audioData_.setNumPredRegions96(dlcNumPredRegions96_);
-            
-            for (uint32_t n = 0; n < static_cast<uint32_t>(dlcNumPredRegions96_); n++)
+            if (kIABNoError != DeSerializePredRegions(payloadReader, dlc::eSampleRate_96000))
             {
-                // Read 4-bit region length
-                if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 4))
-                {
-                    return kIABParserIABDLCError;
-                }
-                
-                // Set region length
-                audioData_.getPredRegion96(n).setRegionLength(fixedLengthFieldMax8);
-                
-                // Read 5-bit region order
-                if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 5))
-                {
-                    return kIABParserIABDLCError;
-                }
-                
-                // Set region order
-                audioData_.getPredRegion96(n).setOrder(fixedLengthFieldMax8);
-                
-                for (uint8_t m = 1; m <= fixedLengthFieldMax8; m++)
-                {
-                    // Read 10-bit coefficient
-                    if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax16, 10))
-                    {
-                        return kIABParserIABDLCError;
-                    }
-
-                    predCoeffs[m] = fixedLengthFieldMax16;
-                }
-                
-                // Set coefficients
-                audioData_.getPredRegion96(n).setKCoeff(&predCoeffs[0]);
-                
+                return kIABParserIABDLCError;
             }
             
             // ********************************
             // 96KHz residuals
             // ********************************
-            
-            for (uint8_t n = 0; n < audioData_.getNumDLCSubBlocks(); n++)
-            {
-                // Read 1-bit code type
-                if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-                {
-                    return kIABParserIABDLCError;
-                }
-                
-                // If encoded as PCM
-                if (fixedLengthFieldMax8 == dlc::eCodeType_PCM_CODE_TYPE)
-                {
-                    // Initialise residual block to PCM type
-                    audioData_.initDLCSubBlock96(n, dlc::eCodeType_PCM_CODE_TYPE, (dlcBlockLength_ * 2));
-
-                    dlc::PCMResidualsSubBlock* pcmResidualsSubBlock = dynamic_cast<dlc::PCMResidualsSubBlock*>(audioData_.getDLCSubBlock96(n));
-                    
-                    // Read 5-bit bit depth
-                    uint8_t bitDepth = 0;
-                    if (CMNSTRM_OK != streamReader.read(bitDepth, 5))
-                    {
-                        return kIABParserIABDLCError;
-                    }
-                    
-                    // Set bit depth
-                    pcmResidualsSubBlock->setBitDepth(bitDepth);
-                    
-                    uint32_t subBlockSize = pcmResidualsSubBlock->getSize();					// Get residual block size
-                    int32_t* pResiduals = pcmResidualsSubBlock->getResiduals();					// Get pointer to beginning of residual samples
-                    int32_t residualValue = 0;													// Residual value, as-is retrieved
-                    uint8_t residualSign = 0;													// 1-bit sign, 0 == postive, 1 == negative
-                    
-                    for (uint32_t i = 0; i < subBlockSize; i++)
-                    {
-
-						if (bitDepth == 0)
-						{
-							residualValue = 0;
-						}
-						else
-						{
-							// Read residual
-							if (CMNSTRM_OK != streamReader.read(residualValue, bitDepth))
-                            {
-                                return kIABParserIABDLCError;
-                            }
-
-							if (residualValue != 0)
-							{
-								// Read sign bit
-								if (CMNSTRM_OK != streamReader.read(residualSign, 1))
-                                {
-                                    return kIABParserIABDLCError;
-                                }
-
-                                if (1 == residualSign)
-								{
-									// invert value
-									residualValue *= -1;
-								}
-							}
-						}
-
-                        *pResiduals++ = residualValue;
-                    }
-                }
-                // If encoded using Rice/Golomb entropy compression
-                else
-                {
-                    // Note that this block of 96KHz code has not beed tested since there is no 96KHz bitstream available
-                    // Initialise residual block to Rice type
-                    audioData_.initDLCSubBlock96(n, dlc::eCodeType_RICE_CODE_TYPE, (dlcBlockLength_ * 2));
-                    
-                    dlc::RiceResidualsSubBlock* riceResidualsSubBlock = dynamic_cast<dlc::RiceResidualsSubBlock*>(audioData_.getDLCSubBlock96(n));
-                    
-                    // Read 5-bit rice remainder length
-                    uint8_t riceRemBits = 0;
-                    if (CMNSTRM_OK != streamReader.read(riceRemBits, 5))
-                    {
-                        return kIABParserIABDLCError;
-                    }
-                    
-                    // Set remainder bits
-                    riceResidualsSubBlock->setRiceRemBits(riceRemBits);
-                    
-                    uint32_t subBlockSize = riceResidualsSubBlock->getSize();					// Get residual block size
-                    dlc::RiceResidual* pResiduals = riceResidualsSubBlock->getResiduals();		// Get pointer to beginning of residual samples
-                    
-                    for (uint32_t i = 0; i < subBlockSize; i++)
-                    {
-                        int32_t remainder = 0;                          // Residual value, as-is retrieved
-                        char residualSign = 1;							// 1-bit sign, 0 == postive (maps to 1 for DLC lib), 1 == negative (maps to -1 for DLC lib)
-                        int32_t quotient = 0;
-                        
-                        if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-                        {
-                            return kIABParserIABDLCError;
-                        }
 
-                        while (1 == fixedLengthFieldMax8)
-                        {
-                            quotient++;
-                            if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-                            {
-                                return kIABParserIABDLCError;
-                            }
-                        }
-                        
-						if (riceRemBits == 0)
-						{
-							remainder = 0;
-						}
-						else
-                        {
-                            // Read rice remainder
-                            if (CMNSTRM_OK != streamReader.read(remainder, riceRemBits))
-                            {
-                                return kIABParserIABDLCError;
-                            }
-                        }
-                        
-                        if ((remainder != 0) || (quotient > 0))
-                        {
-                            // Read sign bit, 0 maps to +1, 1 maps to -1
-                            if (CMNSTRM_OK != streamReader.read(fixedLengthFieldMax8, 1))
-                            {
-                                return kIABParserIABDLCError;
-                            }
-
-                            if (1 == fixedLengthFieldMax8)
-                            {
-                                residualSign = -1;
-                            }
-                        }
-                        
-                        // save residual
-                        pResiduals->setQuotient(quotient);
-                        pResiduals->setSign(residualSign);
-                        pResiduals++->setRemainder(remainder);
-                    }
-                }
+            if (kIABNoError != DeSerializeResiduals(payloadReader, audioData_.getResidualLayer96()))
+            {
+                return kIABParserIABDLCError;
             }
         }   // 96KHz
-        
-        if (CMNSTRM_OK == streamReader.align())   // byte alignment
-        {
-            return kIABNoError;
-        }
-		else
-		{
-			return kIABParserIABDLCError;
-		}
+
+        // Payload is byte aligned by construction, as read above
+        return kIABNoError;
 	}
     
+	// IABAudioDataDLC::SetDeSerializeSkips96kLayer() implementation
+	void IABAudioDataDLC::SetDeSerializeSkips96kLayer(bool iSkip96kLayer)
+	{
+		deSerializeSkips96kLayer_ = iSkip96kLayer;
+	}
+
     iabError IABAudioDataDLC::SetupDLCSubblock()
     {
         audioData_.setSampleRate(DLCSampleRate_);
@@ -8571,6 +8672,121 @@ namespace ImmersiveAudioBitstream
         return kIABNoError;
     }
 
+    iabError IABAudioDataDLC::DeSerializePredRegions(dlc::ResidualReader& payloadReader, dlc::SampleRate iLayer)
+    {
+        uint32_t payloadField = 0;
+
+        // Read 2-bit number of prediction regions
+        if (!payloadReader.readBits(payloadField, 2))
+        {
+            return kIABParserIABDLCError;
+        }
+
+        uint2_t numPredRegions = static_cast<uint2_t>(payloadField);
+
+        // Set DLC audio number of prediction regions
+        if (iLayer == dlc::eSampleRate_48000)
+        {
+            dlcNumPredRegions48_ = numPredRegions;
+            audioData_.setNumPredRegions48(numPredRegions);
+        }
+        else
+        {
+            dlcNumPredRegions96_ = numPredRegions;
+            audioData_.setNumPredRegions96(numPredRegions);
+        }
+        
+        uint10_t predCoeffs[32] = {0}; // maximum 32 coefficients
+        
+        for (uint2_t n = 0; n < numPredRegions; n++)
+        {
+            dlc::PredRegion &predRegion = (iLayer == dlc::eSampleRate_48000) ? audioData_.getPredRegion48(n) : audioData_.getPredRegion96(n);
+
+            // Read 4-bit region length
+            if (!payloadReader.readBits(payloadField, 4))
+            {
+                return kIABParserIABDLCError;
+            }
+            
+            // Set region length
+            predRegion.setRegionLength(static_cast<uint4_t>(payloadField));
+            
+            // Read 5-bit region order
+            if (!payloadReader.readBits(payloadField, 5))
+            {
+                return kIABParserIABDLCError;
+            }
+            
+            // Set region order
+            uint5_t order = static_cast<uint5_t>(payloadField);
+            predRegion.setOrder(order);
+            
+            for (uint8_t m = 1; m <= order; m++)
+            {
+                // Read 10-bit coefficient
+                if (!payloadReader.readBits(payloadField, 10))
+                {
+                    return kIABParserIABDLCError;
+                }
+
+                predCoeffs[m] = static_cast<uint10_t>(payloadField);
+            }
+            
+            // Set coefficients
+            predRegion.setKCoeff(&predCoeffs[0]);
+        }
+
+        return kIABNoError;
+    }
+
+    iabError IABAudioDataDLC::DeSerializeResiduals(dlc::ResidualReader& payloadReader, dlc::ResidualLayer &oLayer)
+    {
+        uint32_t payloadField = 0;
+        uint32_t subBlockSize = oLayer.getSubBlockSize();
+        int32_t* pResiduals = oLayer.getResiduals();								// Residuals are stored in sub block order
+
+        for (uint8_t n = 0; n < oLayer.getNumSubBlocks(); n++)
+        {
+            // Read 1-bit code type
+            if (!payloadReader.readBits(payloadField, 1))
+            {
+                return kIABParserIABDLCError;
+            }
+
+            dlc::CodeType codeType = (payloadField == dlc::eCodeType_PCM_CODE_TYPE) ? dlc::eCodeType_PCM_CODE_TYPE : dlc::eCodeType_RICE_CODE_TYPE;
+            oLayer.setCodeType(n, codeType);
+
+            // Read 5-bit bit depth (PCM) or rice remainder length (Rice/Golomb)
+            if (!payloadReader.readBits(payloadField, 5))
+            {
+                return kIABParserIABDLCError;
+            }
+
+            uint5_t codingBits = static_cast<uint5_t>(payloadField);
+            oLayer.setCodingBits(n, codingBits);
+
+            bool isRead = false;
+
+            if (codeType == dlc::eCodeType_PCM_CODE_TYPE)
+            {
+                isRead = payloadReader.readPCMResiduals(pResiduals, subBlockSize, codingBits);
+            }
+            else
+            {
+                isRead = payloadReader.readRiceResiduals(pResiduals, subBlockSize, codingBits);
+            }
+
+            if (!isRead)
+            {
+                return kIABParserIABDLCError;
+            }
+
+            pResiduals += subBlockSize;
+        }
+
+        return kIABNoError;
+    }
+
     // IABAudioDataDLC::Validate() implementation
    bool IABAudioDataDLC::Validate(IABEventHandler &iEvenHandler, ValidationIssue &iValidationIssue) const
     {
@@ -8784,35 +9000,16 @@ namespace ImmersiveAudioBitstream
 		}
 
 		// Packing PCM samples to sequence of bytes
-		// Little endian format
-		const int32_t* packSourceSample = iSamples;
-		uint8_t *packDestination = pcmBytes_;
+		// Little endian format, upper 3 or 2 bytes of each sample
+		char *packDestination = reinterpret_cast<char*>(pcmBytes_);
 
-		// Clear pcmBytes_ buffer packing PCM samples into it
-		memset(pcmBytes_, 0, totalByteCount_);
-
-		// 24-bit packing
 		if (bitDepthCode_ == kIABBitDepth_24Bit)
 		{
-			for (uint32_t i = 0; i < iSampleCount; i++)
-			{
-				*(packDestination++) = (*packSourceSample >> 8) & 0x000000FF;			// 1st: LSB of 24-bit sample
-				*(packDestination++) = (*packSourceSample >> 16) & 0x000000FF;			// mid byte of 24-bit sample
-				*(packDestination++) = (*packSourceSample >> 24) & 0x000000FF;			// last: MSB of 24-bit sample
-
-				packSourceSample++;														// Next PCM sample
-			}
+			CommonStream::Int32ToPCM24_LE(packDestination, iSamples, iSampleCount, 3);
 		}
 		else if (bitDepthCode_ == kIABBitDepth_16Bit)
 		{
-			// 16-bit
-			for (uint32_t i = 0; i < iSampleCount; i++)
-			{
-				*(packDestination++) = (*packSourceSample >> 16) & 0x000000FF;			// 1st: LSB of 16-bit sample
-				*(packDestination++) = (*packSourceSample >> 24) & 0x000000FF;			// last: MSB of 16-bit sample
-
-				packSourceSample++;														// Next PCM sample
-			}
+			CommonStream::Int32ToPCM16_LE(packDestination, iSamples, iSampleCount, 2);
 		}
 		else
 		{
@@ -8837,38 +9034,21 @@ namespace ImmersiveAudioBitstream
 			unpackedPCM_ = new int32_t[sampleCount_];
         }
         // Unpacking little-endian byte sequence back to PCM samples
-        uint8_t *unpackByteSource = pcmBytes_;
-        int32_t* unpackedSampleDestination = unpackedPCM_;
+        const char *unpackByteSource = reinterpret_cast<const char*>(pcmBytes_);
 
-        // 24-bit unpacking
         if (bitDepthCode_ == kIABBitDepth_24Bit)
         {
-            for (uint32_t i = 0; i < iSampleCount; i++)
-            {
-                *unpackedSampleDestination = *(unpackByteSource++) << 8;					// 1st: save LSB of 24-bit sample
-                *unpackedSampleDestination |= *(unpackByteSource++) << 16;					// OR (|) the mid byte of 24-bit sample
-                *unpackedSampleDestination |= *(unpackByteSource++) << 24;					// OR (|) the MSB of 24-bit sample
-
-                unpackedSampleDestination++;												// Increment pointer for next output PCM sample
-            }
+            CommonStream::PCM24_LEToInt32(unpackedPCM_, unpackByteSource, iSampleCount);
         }
         else if (bitDepthCode_ == kIABBitDepth_16Bit)
         {
-            // 16-bit
-            for (uint32_t i = 0; i < iSampleCount; i++)
-            {
-                *unpackedSampleDestination = *(unpackByteSource++) << 16;					// 1st: save LSB of 16-bit sample
-                *unpackedSampleDestination |= *(unpackByteSource++) << 24;					// OR (|) the MSB of 16-bit sample
-
-                unpackedSampleDestination++;												// Increment pointer for next output PCM sample
-            }
+            CommonStream::PCM16_LEToInt32(unpackedPCM_, unpackByteSource, iSampleCount);
         }
         else
         {
             return kIABParserPCMUnpackingError;
         }
 
-
 		return kIABNoError;
 	}
 
@@ -8900,6 +9080,40 @@ namespace ImmersiveAudioBitstream
 		return kIABNoError;
 	}
 
+	// IABAudioDataPCM::UnpackPCMToFloatSamples() implementation
+	iabError IABAudioDataPCM::UnpackPCMToFloatSamples(IABSampleType* oSamples, uint32_t iSampleCount) const
+	{
+		// Check input parameter
+		if (oSamples == nullptr)
+		{
+			return kIABBadArgumentsError;
+		}
+
+		// Check frame sample count (ie frame size) against setup, per ST2098-2
+		if (iSampleCount != sampleCount_)
+		{
+			return kIABArgumentIncorrectPCMSampleCount;
+		}
+
+		// Unpack little-endian bytes straight to samples in the renderer float range
+		const char *unpackByteSource = reinterpret_cast<const char*>(pcmBytes_);
+
+		if (bitDepthCode_ == kIABBitDepth_24Bit)
+		{
+			CommonStream::PCM24_LEToFloat(oSamples, unpackByteSource, iSampleCount);
+		}
+		else if (bitDepthCode_ == kIABBitDepth_16Bit)
+		{
+			CommonStream::PCM16_LEToFloat(oSamples, unpackByteSource, iSampleCount);
+		}
+		else
+		{
+			return kIABParserPCMUnpackingError;
+		}
+
+		return kIABNoError;
+	}
+
 	// IABAudioDataPCM::GetUnpackedSampleBuffer() implementation
 	int32_t* IABAudioDataPCM::GetUnpackedSampleBuffer()
 	{
@@ -8927,8 +9141,8 @@ namespace ImmersiveAudioBitstream
 		return IABElement::IsIncludedForPacking();
 	}
 
-	// IABAudioDataPCM::Serialize() implementation
-	iabError IABAudioDataPCM::Serialize(std::ostream &outStream)
+	// IABAudioDataPCM::SerializeToBuffer() implementation
+	iabError IABAudioDataPCM::SerializeToBuffer(IABPackingBuffer &ioBuffer)
 	{
 		// Check if "this" element is included in packing. If not, simply return with no further processing
 		if (!IsIncludedForPacking())
@@ -8936,38 +9150,22 @@ namespace ImmersiveAudioBitstream
 			return kIABNoError;
 		}
 
-		// Set up payload writer and buffer
-		elementPayloadWriter_.align();										// reset writer byte alignment
-		elementPayloadBuffer_.seekp(0, std::ios::beg);						// reset internal payload buffer
-		elementPayloadBuffer_.clear();
-		elementHeadBuffer_.seekp(0, std::ios::beg);
-		elementHeadBuffer_.clear();
+		// Write element ID and reserve element size, back-patched once the payload is written
+		IABPackingBuffer::ElementMark elementMark = ioBuffer.BeginElement(elementID_, elementSize_);
+		PackingWriter &payloadWriter = ioBuffer.GetWriter();
 
-		// Writing data fields (These are currently written into internal "elementPayloadBuffer_")
+		// Writing data fields
 		// Calling method for writing Plex encoded field.
-		write(elementPayloadWriter_, Plex<8>(audioDataID_));
+		write(payloadWriter, Plex<8>(audioDataID_));
 
 		// Write PCM sample bytes, total number of bytes to pack = totalByteCount_
 		// These are already arranged in little endian order during packing
-		elementPayloadWriter_.write(pcmBytes_, totalByteCount_);			// totalByteCount_ bytes
-
-		elementPayloadWriter_.align();										// Align to byte
-
-		// Get buffer length as payload, and set element size
-		IABElementSizeType packedPayloadLength = 0;
-		packedPayloadLength = static_cast<IABElementSizeType>(elementPayloadBuffer_.tellp());
-		SetElementSize(packedPayloadLength);
+		payloadWriter.write(pcmBytes_, totalByteCount_);			// totalByteCount_ bytes
 
-		// Serialize frame head
-		SerializeHead();
+		payloadWriter.align();										// Align to byte
 
-		// Output elementHeadBuffer_ first, followed by elementPayloadBuffer_
-		outStream << elementHeadBuffer_.rdbuf();
-		outStream << elementPayloadBuffer_.rdbuf();
-
-		// Clear stream contents after packing
-		elementHeadBuffer_.str("");
-		elementPayloadBuffer_.str("");
+		// Back-patch element size with payload length, and set element size
+		SetElementSize(ioBuffer.EndElement(elementMark));
 
 		return kIABNoError;
 	}
@@ -9009,10 +9207,7 @@ namespace ImmersiveAudioBitstream
 			return kIABParserIABPCMError;
 		}
 
-		// Clear pcmBytes_ buffer parsing bytes into it
-		memset(pcmBytes_, 0, totalByteCount_);
-
-		// Read PCM sample data bytes
+		// Read PCM sample data bytes. The payload is byte aligned and read as a single run of bytes.
 		if (CMNSTRM_OK != streamReader.read(pcmBytes_, totalByteCount_))
         {
 			return kIABParserIABPCMError;
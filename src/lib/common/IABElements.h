@@ -39,6 +39,9 @@
 #ifndef __IABELEMENTS_H__
 #define	__IABELEMENTS_H__
 
+#include <set>
+#include <vector>
+
 // IAB library headers
 #include "IABDataTypes.h"
 #include "IABElementsAPI.h"
@@ -49,10 +52,12 @@
 #include "commonstream/stream/StreamTypes.h"
 #include "commonstream/bitstream/BitStreamWriterT.h"
 #include "commonstream/bitstream/BitStreamReaderT.h"
+#include "commonstream/bitstream/BitStreamWriterVector.h"
 
 // DLC codec lib headers
 #include "DLC/DLCAudioData.h"
 #include "DLC/DLCSimpleEncoder.h"
+#include "DLC/DLCResidualReader.h"
 #include "DLC/DLCFullDecoder.h"
 
 //using namespace CMNSTRM;
@@ -65,6 +70,67 @@ namespace ImmersiveAudioBitstream
 	typedef BitStreamWriterT<std::ostream> StreamWriter;
 	typedef BitStreamReaderT<std::istream> StreamReader;
 
+	// Bit stream writer appending to a memory buffer, used for packing elements
+	typedef BitStreamWriterT<std::vector<char> > PackingWriter;
+
+	/**
+	* @brief IABPackingBuffer class.
+	*
+	* Contiguous output buffer that an IABitstreamFrame, with all of its elements and sub-elements,
+	* is serialized into in a single pass. Each element writes its ID, reserves its Plex(8) coded
+	* size field and writes its payload in place, behind the size field. The size field is back-patched
+	* once the payload is complete, so no element is packed into an intermediate buffer first.
+	*
+	* The width reserved for a size field is predicted from a hint, typically the size of the element
+	* when it was last packed or parsed. The payload is only moved when the prediction was wrong.
+	*
+	* Bytes are appended to a caller owned vector, through a PackingWriter. Clearing the vector between frames keeps its
+	* allocation, so repeated packing into the same vector does not reallocate.
+	*
+	*/
+	class IABPackingBuffer
+	{
+	public:
+
+		// Position of an element in the buffer, recorded when the element is begun
+		struct ElementMark
+		{
+			size_t elementPosition_;				// Position of the element ID
+			size_t sizeFieldPosition_;				// Position of the reserved element size field
+			uint32_t sizeFieldWidth_;				// Width, in bytes, of the reserved element size field
+		};
+
+		// Constructor, appending to ioBytes
+		IABPackingBuffer(std::vector<char> &ioBytes);
+
+		// Get the bit stream writer appending to the buffer
+		PackingWriter& GetWriter();
+
+		// Get the number of bytes in the buffer. The writer must be byte aligned.
+		size_t GetPosition();
+
+		// Begin an element: align, write the Plex(8) element ID and reserve a size field wide enough for iSizeHint
+		ElementMark BeginElement(IABElementIDType iElementID, IABElementSizeType iSizeHint);
+
+		// End the element begun at iMark: align and back-patch its size field. Returns the element payload size.
+		IABElementSizeType EndElement(const ElementMark &iMark);
+
+		// Discard the element begun at iMark and all bytes written after it
+		void DiscardElement(const ElementMark &iMark);
+
+		// Back-patch a fixed size field of iNumBytes bytes (1 to 4) at iPosition, most significant byte first
+		void PatchField(size_t iPosition, uint32_t iValue, uint32_t iNumBytes);
+
+	private:
+
+		// Not copyable, as the writer is not
+		IABPackingBuffer(const IABPackingBuffer&);
+		IABPackingBuffer& operator=(const IABPackingBuffer&);
+
+		std::vector<char>	&bytes_;
+		PackingWriter		writer_;
+	};
+
 	/*****************************************************************************
 	*
 	* Defining classes for container/subframe structures, according to
@@ -107,8 +173,11 @@ namespace ImmersiveAudioBitstream
 		iabError SetSubframeLength(IABSubframeLengthType iSubframeLength);
 
 		// Processing method Serilize() to a buffer: packing subframe
+		iabError Serialize(std::ostream &outStream);
+
+		// Serialize subframe into packing buffer
 		// Must be implemented by child class
-		virtual iabError Serialize(std::ostream &outStream) = 0;
+		virtual iabError SerializeToBuffer(IABPackingBuffer &ioBuffer) = 0;
 
 		// Parser base class deserialize function.
 		// Must be implemented by child class
@@ -129,11 +198,6 @@ namespace ImmersiveAudioBitstream
 		// SubFrame payload
 		uint8_t* subframePayload_;									// pointer to "subframeLength_" number of bytes. 
 																	// (Not currently used. TBD: May be used in future for holding Preamble payload.)
-
-		// ************
-		// For packing, stream writer and working buffer for container subframe tag & length
-		StreamWriter		containerHeadWriter_;
-		std::stringstream	containerHeadBuffer_;
 	};
 
 	/**
@@ -155,11 +219,19 @@ namespace ImmersiveAudioBitstream
 		// Destructor
 		~IABIASubFrame() {}
 
-		// Processing method Serilize() to a buffer: packing tag and length
-		iabError Serialize(std::ostream &outStream);
+		// Serialize subframe into packing buffer: packing tag and length
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
+
+		// Set subframe length and back-patch it into the length field last serialized into ioBuffer
+		iabError UpdateSubframeLength(IABPackingBuffer &ioBuffer, IABSubframeLengthType iSubframeLength);
 
 		// Processing method deserilize() from a buffer: parsing tag, length and payload
 		iabError DeSerialize(StreamReader& streamReader);
+
+	private:
+
+		// Position of the length field in the packing buffer, recorded by SerializeToBuffer()
+		size_t lengthFieldPosition_;
 	};
 
 	/**
@@ -184,8 +256,8 @@ namespace ImmersiveAudioBitstream
 		// Set preamble payload (!Note: transfer ownership of underlying payload buffer)
 		iabError SetPreamblePayload(uint8_t* iPreamblePayload, IABSubframeLengthType iLength);
 
-		// Processing method Serilize() to a buffer: packing tag, length and optionally value (depending on presence)
-		iabError Serialize(std::ostream &outStream);
+		// Serialize subframe into packing buffer: packing tag, length and optionally value (depending on presence)
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// Processing method deserilize() from a buffer: parsing tag, length and value/payload
 		iabError DeSerialize(StreamReader& streamReader);
@@ -228,8 +300,11 @@ namespace ImmersiveAudioBitstream
 		bool IsIncludedForPacking();
 
 		// Processing method Serilize() to a buffer: packing an element
-		// Must be properly implemented by child class
-		virtual iabError Serialize(std::ostream &outStream) { return kIABNotImplementedError; }
+		iabError Serialize(std::ostream &outStream);
+
+		// Serialize element into packing buffer, appending to its contents. Sub-elements are serialized into the same buffer.
+		// Implemented by each element class
+		virtual iabError SerializeToBuffer(IABPackingBuffer &ioBuffer) = 0;
 
 		// Processing method DeSerilize() from a buffer: parsing an element
 		// Must be properly implemented by child class
@@ -238,20 +313,14 @@ namespace ImmersiveAudioBitstream
         // Validate element against specified IAB constraint sets.
         virtual bool Validate(IABEventHandler &iEvenHandler, ValidationIssue &iValidationIssue) const { return false; }
 
+		// Set element types to be skipped when parsing sub-elements of this element. Set by parent before DeSerialize().
+		// The set is not owned and must remain valid while the element is being parsed. nullptr: parse all sub-elements.
+		void SetSkippedElementIDsInParsing(const std::set<IABElementIDType>* iElementIDs);
+
 	protected:
 
         // Protected functions
 
-		/**
-		* Serialize element ID and size only, into elementHeadBuffer_. The buffer can be accessed
-		* and retrieved by all derived classes of all element types.
-		* This is typically called after writing element payload, and as a result, the element size
-		* becomes known. Caller need to set element size before serializing updated element
-		* head into elementHeadBuffer_.
-		*
-		*/
-		iabError SerializeHead();
-
 		/**
 		* Deserialize element ID and size only... (To be expanded)
 		*
@@ -267,6 +336,9 @@ namespace ImmersiveAudioBitstream
 		// Peek next sub-element ID
 		iabError PeekNextElementID(StreamReader& streamReader, uint32_t &oElementID);
 
+		// Interrogate if sub-elements of type iElementID are to be skipped in parsing
+		bool IsSkippedInParsing(IABElementIDType iElementID) const;
+
 		// Protected variables
 
         // Element identifier (32 bits).
@@ -279,18 +351,12 @@ namespace ImmersiveAudioBitstream
 		// Packing enable flag - is this element included (enabled) in IAB packing?
 		int32_t packingEnable_;					// default: 1, packing enabled
 
-		// ************
-		// For packing, stream writer and working buffer for elementID_ and elementSize_
-		StreamWriter		elementHeadWriter_;
-		std::stringstream	elementHeadBuffer_;
-
-		// stream writer and working buffer for element payload
-		StreamWriter		elementPayloadWriter_;
-		std::stringstream	elementPayloadBuffer_;
-
 		// ************
 		// For parsing, stream reader
 		StreamReader*		elementReader_;				// stream reader for parsing
+
+		// Element types skipped (not materialized) in parsing, propagated from the frame. Not owned.
+		const std::set<IABElementIDType>* skippedElementIDsInParsing_;
 	};
 
     /**
@@ -375,6 +441,9 @@ namespace ImmersiveAudioBitstream
         // This is the only Serialize() that is exposed to users
 		iabError Serialize(std::ostream &outStream);
 
+		// Serialize IABitstreamFrame (preamble, IA subframe and IAB frame element) into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
+
         // Processing method DeSerilize() from a buffer: parsing a frame
         // This is the only DeSerialize() that is exposed to users
         iabError DeSerialize();
@@ -386,6 +455,18 @@ namespace ImmersiveAudioBitstream
 		// Get the failOnVersionError setting
 		virtual bool GetDeSerializeFailsOnVersionError() const;
 
+		// Set element types to be skipped during DeSerialization
+		void SetDeSerializeSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs);
+
+		// Get element types to be skipped during DeSerialization
+		void GetDeSerializeSkippedElementIDs(std::set<IABElementIDType> &oElementIDs) const;
+
+		// Set whether the 96kHz layer of DLC sub-elements is skipped during DeSerialization
+		void SetDeSerializeSkipsDLC96kLayer(bool iSkip96kLayer);
+
+		// Get whether the 96kHz layer of DLC sub-elements is skipped during DeSerialization
+		bool GetDeSerializeSkipsDLC96kLayer() const;
+
 		// Get number of known but unallowed frame sub-elements parsed
 		uint32_t GetNumUnallowedSubElements() const;
 
@@ -467,6 +548,13 @@ namespace ImmersiveAudioBitstream
 		// version is detected. When false the library will attempt to continue
 		// DeSerialization of invalid bitstreams
 		bool failOnVersionError_;
+
+		// Element types that are bypassed using their element size during DeSerialization,
+		// instead of being materialized. Applies to all levels (frame, bed and object sub-elements).
+		std::set<IABElementIDType> deSerializeSkippedElementIDs_;
+
+		// When true, DLC sub-elements are parsed without their 96kHz layer
+		bool deSerializeSkipsDLC96kLayer_;
 	};
 
     /**
@@ -517,7 +605,7 @@ namespace ImmersiveAudioBitstream
         iabError SetDecorCoef(IABDecorCoeff const& iDecorCoef);
 
 		// Serialize an IAB Channel to buffer.
-		iabError Serialize(StreamWriter& streamWriter);
+		iabError Serialize(PackingWriter& streamWriter);
 
 		// DeSerialize an IAB Channel from buffer.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -626,8 +714,8 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the bed definition element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB bed definition element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB bed definition element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB bed definition element from buffer.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -753,10 +841,10 @@ namespace ImmersiveAudioBitstream
 		void GetRemapDestinationNumber(uint16_t &oDestinationNumber) const;
 
 		// Serialize IAB bed remap sub block to buffer. This is called to serialize all remap sub-blocks except the first block in a bed remap.
-		iabError Serialize(StreamWriter& streamWriter);
+		iabError Serialize(PackingWriter& streamWriter);
 
 		// Specicial serialization for first block. This is called directly to serialize first remap sub-block of a bed remap element.
-		iabError SerializeSubBlock(StreamWriter& streamWriter);
+		iabError SerializeSubBlock(PackingWriter& streamWriter);
 
 		// Deserialize IAB bed remap sub block from buffer. This is called to deserialize all remap sub-blocks except the first.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -845,8 +933,8 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the bed remap element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB bed remap element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB bed remap element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB bed remap element from buffer.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -939,10 +1027,10 @@ namespace ImmersiveAudioBitstream
         iabError SetDecorCoef(IABDecorCoeff const& iDecorCoef);
 
 		// Serialize IAB object sub block to buffer. This is called to serialize all pan sub-blocks except the first block in a frame.
-		iabError Serialize(StreamWriter& streamWriter);
+		iabError Serialize(PackingWriter& streamWriter);
 
 		// Specicial serialization for first block. This is called directly to serialize first pan sub-block of a frame, for object definition.
-		iabError SerializeSubBlock(StreamWriter& streamWriter);
+		iabError SerializeSubBlock(PackingWriter& streamWriter);
 
 		// DeSerialize IAB object sub block from buffer. This is called to deserialize all pan sub-blocks except the first block in a frame.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -1070,8 +1158,8 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the object definition element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB object definition element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB object definition element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB object definition element from buffer.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -1182,10 +1270,10 @@ namespace ImmersiveAudioBitstream
 		iabError SetObjectZoneGains19(IABObjectZoneGain19 const& iObjectZoneGains19);
 
 		// Serialize IAB zone19 sub block to buffer. This is called to serialize all zone19 sub-blocks except the first block in a frame.
-		iabError Serialize(StreamWriter& streamWriter);
+		iabError Serialize(PackingWriter& streamWriter);
 
 		// Specicial serialization for first block. This is called directly to serialize first zone19 sub-block of a frame, for IABObjectZoneDefinition19.
-		iabError SerializeSubBlock(StreamWriter& streamWriter);
+		iabError SerializeSubBlock(PackingWriter& streamWriter);
 
 		// DeSerialize IAB zone19 sub block from buffer. This is called to deserialize all zone19 sub-blocks except the first block in a frame.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -1239,8 +1327,8 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the zone19 element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB object definition element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB object definition element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB object zone 19 definition element from buffer.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -1293,8 +1381,8 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the authoringtoolinfo element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB PCM data audio element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB PCM data audio element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB PCM audio data element to buffer.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -1353,8 +1441,8 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the user data element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB PCM data audio element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB PCM data audio element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB PCM audio data element to buffer.
 		iabError DeSerialize(StreamReader& streamReader);
@@ -1412,6 +1500,12 @@ namespace ImmersiveAudioBitstream
 		// Encode a block of 24-bit PCM samples (as 3 MSBs of 32-bit int32_t), of "iSampleCount" # of samples
 		iabError EncodeMonoPCMToDLC(const int32_t* iSamples, uint32_t iSampleCount);
 
+		// Get DLC encoding effort level
+		void GetDLCEncodeEffort(IABDLCEncodeEffortType &oEncodeEffort) const;
+
+		// Set DLC encoding effort level
+		iabError SetDLCEncodeEffort(IABDLCEncodeEffortType iEncodeEffort);
+
 		// Decode a block of 24-bit PCM samples (as 3 MSBs of 32-bit int32_t), of "iSampleCount" # of samples
 		iabError DecodeDLCToMonoPCM(int32_t* oSamples, uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate);
 
@@ -1419,6 +1513,24 @@ namespace ImmersiveAudioBitstream
 		// and store decoded integer PCM sample in DLC element internal buffer
 		iabError DecodeDLCToMonoPCMInternal(uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate);
 
+		// Decode a group of DLC elements, as DecodeDLCToMonoPCMInternal() does for each of them.
+		// Parsed elements are decoded several at a time by the lockstep batch decoder.
+		// Returns the last error encountered, if any, after decoding all elements.
+		static iabError DecodeDLCToMonoPCMInternal(IABAudioDataDLC* const* iElements
+			, uint32_t iElementCount
+			, uint32_t iSampleCount
+			, IABSampleRateType iDecodeSampleRate);
+
+		// Decode the DLC elements of iFrame with an audio data ID in iAudioDataIDs into oSamples, at
+		// iDecodeSampleRate (kIABSampleRate_96000Hz requires a 96k frame). Elements are grouped by block
+		// length and decoded in batches of dlc::FullDecoder::kMaxBatchLanes, each batch converted to
+		// IABSampleType while still in cache. Elements that fail to decode get no plane.
+		// Returns the last error encountered, if any. Implements IABAudioDataDLCInterface::DecodeAllDLC().
+		static iabError DecodeAllDLC(const IABFrameInterface& iFrame
+			, const std::set<IABAudioDataIDType>& iAudioDataIDs
+			, IABDLCFrameSamples& oSamples
+			, IABSampleRateType iDecodeSampleRate);
+
 		// Returns a pointer to internal integer buffer holding decoded PCM samples.
 		int32_t* GetDecodedSampleBuffer();
 
@@ -1431,11 +1543,15 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the DLC element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB DLC audio data element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB DLC audio data element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB DLC audio data element to buffer.
 		iabError DeSerialize(StreamReader& streamReader);
+
+		// Set whether DeSerialize() skips the 96kHz layer of a 96k DLC element.
+		// An element parsed without its 96kHz layer can only be decoded to 48kHz.
+		void SetDeSerializeSkips96kLayer(bool iSkip96kLayer);
         
         // Validate contents against SMPTE IAB Specification
         bool Validate(IABEventHandler &iEvenHandler, ValidationIssue &iValidationIssue) const;
@@ -1444,7 +1560,7 @@ namespace ImmersiveAudioBitstream
 
 		/**
 		* Encoder instance used to encode PCM into dlc:AudioData
-		* (The simple encoder supports PCM wrapping only)
+		* (PCM wrapping only, unless a higher encoding effort level is set)
 		*
 		*/
 		dlc::SimpleEncoder dlcSimpleEncoder_;
@@ -1551,6 +1667,34 @@ namespace ImmersiveAudioBitstream
 
         // Setup DLC subblocks parameters
         iabError SetupDLCSubblock();
+
+		// Check decoding parameters against the element
+		iabError CheckDecodeParameters(uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate) const;
+
+		// Check decoding parameters and allocate decodedPCM_, ahead of decoding
+		iabError PrepareDecodedSampleBuffer(uint32_t iSampleCount, IABSampleRateType iDecodeSampleRate);
+
+		// DLC payload bytes, as read by DeSerialize()
+		std::vector<uint8_t> dlcPayload_;
+
+		// When true, DeSerialize() stops after the 48kHz layer of a 96k DLC element
+		bool deSerializeSkips96kLayer_;
+
+		// True if the 96kHz layer was skipped by the last DeSerialize().
+		// The element is then re-serialized from dlcPayload_.
+		bool is96kLayerSkipped_;
+
+		// Serialize the element from dlcPayload_, as read by DeSerialize()
+		iabError SerializeParsedPayload(IABPackingBuffer &ioBuffer);
+
+		// Read the predictor regions of one layer (48k or 96k) into audioData_
+		iabError DeSerializePredRegions(dlc::ResidualReader& payloadReader, dlc::SampleRate iLayer);
+
+		// Read the coded residuals of one layer (48k or 96k) into oLayer
+		iabError DeSerializeResiduals(dlc::ResidualReader& payloadReader, dlc::ResidualLayer &oLayer);
+
+		// Write the coded residuals of one layer (48k or 96k) to streamWriter
+		iabError SerializeResiduals(PackingWriter& streamWriter, const dlc::ResidualLayer &iLayer);
    };
 
     /**
@@ -1601,6 +1745,10 @@ namespace ImmersiveAudioBitstream
 		// and store unpacked integer PCM samples in PCM element internal buffer
 		iabError UnpackPCMToMonoSamplesInternal(uint32_t iSampleCount);
 
+		// Unpack a block of 24-/16-bit PCM samples, of "iSampleCount" # of samples, to float samples
+		// in the renderer range (32-bit integer range scaled to +/- 1.0)
+		iabError UnpackPCMToFloatSamples(IABSampleType* oSamples, uint32_t iSampleCount) const;
+
 		// Returns a pointer to internal integer buffer holding unpacked PCM samples.
 		int32_t* GetUnpackedSampleBuffer();
 
@@ -1613,8 +1761,8 @@ namespace ImmersiveAudioBitstream
 		// Interrogate if the PCM element is included for packing
 		bool IsIncludedForPacking();
 
-		// Serialize IAB PCM data audio element to buffer.
-		iabError Serialize(std::ostream &outStream);
+		// Serialize IAB PCM data audio element into packing buffer.
+		iabError SerializeToBuffer(IABPackingBuffer &ioBuffer);
 
 		// DeSerialize IAB PCM audio data element to buffer.
 		iabError DeSerialize(StreamReader& streamReader);
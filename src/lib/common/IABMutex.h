@@ -0,0 +1,120 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+/**
+ * IABMutex.h
+ *
+ * @file
+ */
+
+#ifndef __IABMUTEX_H__
+#define	__IABMUTEX_H__
+
+#if __linux__ || __APPLE__
+
+#include <assert.h>
+#include <pthread.h>
+
+namespace SMPTE
+{
+    namespace ImmersiveAudioBitstream
+    {
+        
+        /**
+         *  Representations of the Mutex and Condition variable classes
+         * for use by multi threaded IAB renderer and parser entities.
+         *
+         */
+        class IABMutex
+        {
+            
+        public:
+            
+            // Wrapper for pthread_cond_t
+            class IABCondition
+            {
+            public:
+                IABCondition()
+                {
+                    int retval = pthread_cond_init(&condVar_, NULL);
+                    assert(retval == 0);
+                }
+                ~IABCondition()
+                {
+                    int retval = pthread_cond_destroy(&condVar_);
+                    assert(retval == 0);
+                }
+                void signal()
+                {
+                    int retval = pthread_cond_signal(&condVar_);
+                    assert(retval == 0);
+                }
+                void broadcast()
+                {
+                    int retval = pthread_cond_broadcast(&condVar_);
+                    assert(retval == 0);
+                }
+                void wait(IABMutex& mutex)
+                {
+                    int retval = pthread_cond_wait(&condVar_, &mutex.mutex_);
+                    assert(retval == 0);
+                }
+            private:
+                pthread_cond_t condVar_;
+            };
+            
+            IABMutex()
+            {
+                int retval = pthread_mutex_init(&mutex_, NULL);
+                assert(retval == 0);
+            }
+            ~IABMutex()
+            {
+                int retval = pthread_mutex_destroy(&mutex_);
+                assert(retval == 0);
+            }
+            void lock()
+            {
+                int retval = pthread_mutex_lock(&mutex_);
+                assert(retval == 0);
+            }
+            void unlock()
+            {
+                int retval = pthread_mutex_unlock(&mutex_);
+                assert(retval == 0);
+            }
+        private:
+            pthread_mutex_t mutex_;
+        };
+    }
+}
+
+#endif // __linux__ || __APPLE__
+
+#endif // __IABMUTEX_H__
@@ -712,26 +712,30 @@ namespace CommonStream
             }
 #endif // #ifdef CMNSTRM_USE_CHECK_SUM
 
-            uint8_t *buf = oVal;
-            uint8_t *end = oVal + iNumBytes;
-
-            while (buf != end)
+            // Byte aligned, the bytes read are the values. Otherwise shift the run into place.
+            if (bitBufferFill_ != 0 || bitBuffer_ != 0)
             {
-                uint8_t tmp = *buf;
+                uint8_t *buf = oVal;
+                uint8_t *end = oVal + iNumBytes;
 
-                *buf = (tmp >> bitBufferFill_) | bitBuffer_;
+                while (buf != end)
+                {
+                    uint8_t tmp = *buf;
 
-                bitBuffer_ = tmp << (8 - bitBufferFill_);
+                    *buf = (tmp >> bitBufferFill_) | bitBuffer_;
 
-#ifdef CMNSTRM_USE_CHECK_SUM
-                if (CRC_ && CRC_->useCRC())
-                {
-                    CRC_->accumulate((uint32_t)*buf, 8);
+                    bitBuffer_ = tmp << (8 - bitBufferFill_);
+
+                    buf++;
                 }
-#endif // #ifdef CMNSTRM_USE_CHECK_SUM
+            }
 
-                buf++;
+#ifdef CMNSTRM_USE_CHECK_SUM
+            if (CRC_ && CRC_->useCRC())
+            {
+                CRC_->accumulate(static_cast<const uint8_t*>(oVal), iNumBytes);
             }
+#endif // #ifdef CMNSTRM_USE_CHECK_SUM
 
             return status();
 
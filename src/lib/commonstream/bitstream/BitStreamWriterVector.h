@@ -0,0 +1,265 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+/**
+ * BitStreamWriterT specialization writing to a growable memory buffer.
+ *
+ * @file
+ */
+
+#ifndef COMMON_STREAM_SRC_BITSTREAM_BITSTREAMWRITERVECTOR_H_
+#define COMMON_STREAM_SRC_BITSTREAM_BITSTREAMWRITERVECTOR_H_
+
+#include <vector>
+
+#include "commonstream/utils/Namespace.h"
+#include "commonstream/bitstream/BitStreamWriterT.h"
+
+namespace CommonStream
+{
+
+    /**
+     * Bit stream writer appending to a caller owned std::vector<char>.
+     *
+     * Offers the write methods of the generic writer, so that the BitStreamIOHelpers apply, but
+     * collects bits in a 64-bit accumulator and moves them to the vector 32 bits at a time. Byte runs
+     * written while byte aligned are appended in one insert. Writing to memory only fails on
+     * allocation failure (std::bad_alloc), so the per write stream state checks of the generic
+     * writer are not needed, and the write path is inline.
+     *
+     * Complete bytes may still be held in the accumulator after a write. align() pads to a byte
+     * boundary and moves all of them to the vector, after which the vector holds everything written
+     * and may be modified by the caller (e.g. to back-patch a field) before writing continues.
+     *
+     * Hash and CRC generators are not supported.
+     */
+    template<>
+    class BitStreamWriterT<std::vector<char> >
+    {
+    public:
+
+        explicit BitStreamWriterT(std::vector<char> &iBuffer)
+        :
+        buffer_(&iBuffer),
+        accumulator_(0),
+        accumulatorBits_(0),
+        startSize_(iBuffer.size())
+        {
+        }
+
+        ReturnCode write(bool iVal)
+        {
+            write_unchecked(iVal ? 1 : 0, 1);
+            return CMNSTRM_OK;
+        }
+
+        ReturnCode write(uint8_t iVal, uint8_t iNumBits)  { return write_checked(iVal, iNumBits, 8); }
+        ReturnCode write(uint16_t iVal, uint8_t iNumBits) { return write_checked(iVal, iNumBits, 16); }
+        ReturnCode write(uint32_t iVal, uint8_t iNumBits) { return write_checked(iVal, iNumBits, 32); }
+        ReturnCode write(uint64_t iVal, uint8_t iNumBits);
+
+        ReturnCode write(int8_t iVal, uint8_t iNumBits)   { return write_checked(static_cast<uint32_t>(iVal), iNumBits, 8); }
+        ReturnCode write(int16_t iVal, uint8_t iNumBits)  { return write_checked(static_cast<uint32_t>(iVal), iNumBits, 16); }
+        ReturnCode write(int32_t iVal, uint8_t iNumBits)  { return write_checked(static_cast<uint32_t>(iVal), iNumBits, 32); }
+        ReturnCode write(int64_t iVal, uint8_t iNumBits)  { return write(static_cast<uint64_t>(iVal), iNumBits); }
+
+        ReturnCode write(uint8_t iVal)  { return write(iVal, 8); }
+        ReturnCode write(uint16_t iVal) { return write(iVal, 16); }
+        ReturnCode write(uint32_t iVal) { return write(iVal, 32); }
+        ReturnCode write(uint64_t iVal) { return write(iVal, 64); }
+
+        ReturnCode write(char iVal)     { return write(static_cast<uint8_t>(iVal), 8); }
+
+        ReturnCode write(int8_t iVal)   { return write(iVal, 8); }
+        ReturnCode write(int16_t iVal)  { return write(iVal, 16); }
+        ReturnCode write(int32_t iVal)  { return write(iVal, 32); }
+        ReturnCode write(int64_t iVal)  { return write(iVal, 64); }
+
+        ReturnCode write(const uint8_t *iVal, uint32_t iNumBytes);
+        ReturnCode writeAligned(const uint8_t *iVal, uint32_t iNumBytes);
+
+        // Write iCount 1 bits, terminated by a 0 bit (unary code of iCount, as in Rice codes)
+        ReturnCode writeUnary(uint32_t iCount);
+
+        // Pad with 0 bits to the next byte boundary, and move all accumulated bytes to the buffer
+        ReturnCode align();
+        ReturnCode flush() { return align(); }
+
+        // Number of bits written, including 0 bits written by align()
+        BitCount_t getBitCount(void) const
+        {
+            return static_cast<BitCount_t>(buffer_->size() - startSize_) * CHAR_BIT + accumulatorBits_;
+        }
+
+        bool good(void) const { return true; }
+        ReturnCode status(void) const { return CMNSTRM_OK; }
+
+        operator bool () const
+        {
+            return good();
+        }
+
+    private:
+
+        // Not copyable, a copy would duplicate the accumulated bits
+        BitStreamWriterT(const BitStreamWriterT<std::vector<char> > &bs2);
+        BitStreamWriterT &operator=(const BitStreamWriterT<std::vector<char> > &bs2);
+
+        ReturnCode write_checked(uint32_t iVal, uint8_t iNumBits, uint8_t iMaxNumBits)
+        {
+            if (iNumBits > iMaxNumBits)
+            {
+                return CMNSTRM_PARAMS_BAD;
+            }
+
+            if (iNumBits > 0)
+            {
+                write_unchecked(iVal, iNumBits);
+            }
+
+            return CMNSTRM_OK;
+        }
+
+        // Append 1 to 32 bits. Once the accumulator holds 32 bits or more, the oldest 32 bits are moved to the buffer.
+        void write_unchecked(uint32_t iVal, uint8_t iNumBits)
+        {
+            accumulator_ = (accumulator_ << iNumBits) | (iVal & (0xFFFFFFFFu >> (32 - iNumBits)));
+            accumulatorBits_ += iNumBits;
+
+            if (accumulatorBits_ >= 32)
+            {
+                accumulatorBits_ -= 32;
+                uint32_t word = static_cast<uint32_t>(accumulator_ >> accumulatorBits_);
+
+                size_t position = buffer_->size();
+                buffer_->resize(position + 4);
+                char *out = &(*buffer_)[position];
+                out[0] = static_cast<char>(word >> 24);
+                out[1] = static_cast<char>(word >> 16);
+                out[2] = static_cast<char>(word >> 8);
+                out[3] = static_cast<char>(word);
+            }
+        }
+
+        // Move complete bytes from the accumulator to the buffer
+        void drain()
+        {
+            while (accumulatorBits_ >= 8)
+            {
+                accumulatorBits_ -= 8;
+                buffer_->push_back(static_cast<char>(accumulator_ >> accumulatorBits_));
+            }
+        }
+
+        std::vector<char>   *buffer_;
+
+        // Bits not yet moved to buffer_, in the lowest accumulatorBits_ (< 32) bits, oldest first
+        uint64_t            accumulator_;
+        uint32_t            accumulatorBits_;
+
+        // Size of buffer_ at construction, for getBitCount()
+        size_t              startSize_;
+    };
+
+    inline ReturnCode BitStreamWriterT<std::vector<char> >::write(uint64_t iVal, uint8_t iNumBits)
+    {
+        if (iNumBits > 64)
+        {
+            return CMNSTRM_PARAMS_BAD;
+        }
+
+        if (iNumBits > 32)
+        {
+            write_unchecked(static_cast<uint32_t>(iVal >> 32), iNumBits - 32);
+            iNumBits = 32;
+        }
+
+        if (iNumBits > 0)
+        {
+            write_unchecked(static_cast<uint32_t>(iVal), iNumBits);
+        }
+
+        return CMNSTRM_OK;
+    }
+
+    inline ReturnCode BitStreamWriterT<std::vector<char> >::write(const uint8_t *iVal, uint32_t iNumBytes)
+    {
+        if ((accumulatorBits_ % 8) == 0)
+        {
+            // Byte aligned, bytes can be appended as they are
+            drain();
+            buffer_->insert(buffer_->end(), reinterpret_cast<const char*>(iVal), reinterpret_cast<const char*>(iVal) + iNumBytes);
+            return CMNSTRM_OK;
+        }
+
+        for (uint32_t i = 0; i < iNumBytes; i++)
+        {
+            write_unchecked(iVal[i], 8);
+        }
+
+        return CMNSTRM_OK;
+    }
+
+    inline ReturnCode BitStreamWriterT<std::vector<char> >::writeAligned(const uint8_t *iVal, uint32_t iNumBytes)
+    {
+        align();
+
+        return write(iVal, iNumBytes);
+    }
+
+    inline ReturnCode BitStreamWriterT<std::vector<char> >::writeUnary(uint32_t iCount)
+    {
+        for (; iCount >= 32; iCount -= 32)
+        {
+            write_unchecked(0xFFFFFFFFu, 32);
+        }
+
+        // Remaining 1s, followed by the terminating 0
+        write_unchecked(((static_cast<uint32_t>(1) << iCount) - 1) << 1, static_cast<uint8_t>(iCount + 1));
+
+        return CMNSTRM_OK;
+    }
+
+    inline ReturnCode BitStreamWriterT<std::vector<char> >::align()
+    {
+        uint32_t fillBits = (8 - (accumulatorBits_ % 8)) % 8;
+
+        if (fillBits > 0)
+        {
+            write_unchecked(0, static_cast<uint8_t>(fillBits));
+        }
+
+        drain();
+
+        return CMNSTRM_OK;
+    }
+
+}  // namespace CommonStream
+
+#endif // COMMON_STREAM_SRC_BITSTREAM_BITSTREAMWRITERVECTOR_H_
@@ -38,6 +38,37 @@
 namespace CommonStream
 {
 
+    namespace
+    {
+        // The register holds the message so far (augmented form) reduced modulo the
+        // CCITT polynomial P = 0x11021. Entry table_[k][v] is v * x^(8 * (k + 2)) mod P,
+        // so whole bytes can be folded into the register without a per-bit loop.
+        struct CRC16Tables
+        {
+            CRC16Tables()
+            {
+                for (uint32_t v = 0; v < 256; v++)
+                {
+                    uint16_t reg = static_cast<uint16_t>(v << 8);
+
+                    for (uint32_t k = 0; k < 8; k++)
+                    {
+                        for (uint32_t i = 0; i < 8; i++)
+                        {
+                            reg = static_cast<uint16_t>((reg << 1) ^ ((reg & 0x8000) ? 0x1021 : 0));
+                        }
+
+                        table_[k][v] = reg;
+                    }
+                }
+            }
+
+            uint16_t table_[8][256];
+        };
+
+        const CRC16Tables kCRC16Tables;
+    }
+
     CRC16Generator::CRC16Generator()
     {
         state_ = eCRCState_Stopped;
@@ -92,29 +123,42 @@ namespace CommonStream
             return true;
         }
 
-        bool high_bit = false;
-
-        iBits = iBits << (32 - iBitCount);
+        uint8_t tailBitCount = iBitCount & 7;
 
-        for(int i = iBitCount - 1; i >= 0; i--)
+        for (int shift = iBitCount - 8; shift >= tailBitCount; shift -= 8)
         {
+            accumulateByte(static_cast<uint8_t>(iBits >> shift));
+        }
 
-            high_bit = ((register_ >> 15) != 0);
+        accumulateBits(iBits, tailBitCount);
 
-            register_ = (register_ << 1) | ((iBits >> 31) & 1);
+        return true;
+    }
 
-            iBits = iBits << 1;
+    bool CRC16Generator::accumulate(uint64_t iBits, uint8_t iBitCount)
+    {
+        if (state_ == eCRCState_Stopped)
+        {
+            return false;
+        }
+        else if (state_ == eCRCState_Paused)
+        {
+            return true;
+        }
 
-            if (high_bit)
-            {
-                register_ = register_ ^ 0x1021;
-            }
+        uint8_t tailBitCount = iBitCount & 7;
+
+        for (int shift = iBitCount - 8; shift >= tailBitCount; shift -= 8)
+        {
+            accumulateByte(static_cast<uint8_t>(iBits >> shift));
         }
 
+        accumulateBits(static_cast<uint32_t>(iBits), tailBitCount);
+
         return true;
     }
 
-    bool CRC16Generator::accumulate(uint64_t iBits, uint8_t iBitCount)
+    bool CRC16Generator::accumulate(const uint8_t *iBytes, uint32_t iByteCount)
     {
         if (state_ == eCRCState_Stopped)
         {
@@ -125,26 +169,53 @@ namespace CommonStream
             return true;
         }
 
-        bool high_bit = false;
+        const uint16_t (*table)[256] = kCRC16Tables.table_;
+        uint32_t reg = register_;
+
+        // Slicing-by-8: the register and 8 input bytes are folded per iteration
+        while (iByteCount >= 8)
+        {
+            reg = table[7][reg >> 8] ^ table[6][reg & 0xFF]
+                ^ table[5][iBytes[0]] ^ table[4][iBytes[1]]
+                ^ table[3][iBytes[2]] ^ table[2][iBytes[3]]
+                ^ table[1][iBytes[4]] ^ table[0][iBytes[5]]
+                ^ (static_cast<uint32_t>(iBytes[6]) << 8) ^ iBytes[7];
+
+            iBytes += 8;
+            iByteCount -= 8;
+        }
+
+        register_ = static_cast<uint16_t>(reg);
+
+        while (iByteCount-- > 0)
+        {
+            accumulateByte(*(iBytes++));
+        }
 
-        iBits = iBits << (64 - iBitCount);
+        return true;
+    }
+
+    void CRC16Generator::accumulateByte(uint8_t iByte)
+    {
+        register_ = static_cast<uint16_t>(kCRC16Tables.table_[0][register_ >> 8] ^ (register_ << 8) ^ iByte);
+    }
+
+    void CRC16Generator::accumulateBits(uint32_t iBits, uint8_t iBitCount)
+    {
+        bool high_bit = false;
 
         for(int i = iBitCount - 1; i >= 0; i--)
         {
 
             high_bit = ((register_ >> 15) != 0);
 
-            register_ = (register_ << 1) | ((iBits >> 63) & 1);
-
-            iBits = iBits << 1;
+            register_ = (register_ << 1) | ((iBits >> i) & 1);
 
             if (high_bit)
             {
                 register_ = register_ ^ 0x1021;
             }
         }
-
-        return true;
     }
 
     bool CRC16Generator::stop()
@@ -63,12 +63,19 @@ namespace CommonStream
 
         virtual bool accumulate(uint32_t iBits, uint8_t iBitCount);
         virtual bool accumulate(uint64_t iBits, uint8_t iBitCount);
+        virtual bool accumulate(const uint8_t *iBytes, uint32_t iByteCount);
 
         virtual uint32_t getCRCRegisterSize(void);
         virtual bool getCRCRegister(uint8_t *oCRC);
 
     private:
 
+        // Table driven update of the register with one whole byte
+        void accumulateByte(uint8_t iByte);
+
+        // Bit serial update of the register, used for sub-byte tails only
+        void accumulateBits(uint32_t iBits, uint8_t iBitCount);
+
         uint16_t    register_;
         ECRCState   state_;
     };
@@ -150,6 +150,16 @@ namespace CommonStream
         virtual bool accumulate(uint32_t iBits, uint8_t iBitCount) = 0;
         virtual bool accumulate(uint64_t iBits, uint8_t iBitCount) = 0;
 
+        /**
+         * @brief Adds a run of whole bytes to the CRC algorithm.
+         *
+         * @param iBytes data to be CRCed, most significant bit of each byte first.
+         * @param iByteCount number of bytes stored in iBytes
+         * @return true if CRC is properly added.
+         *
+         */
+        virtual bool accumulate(const uint8_t *iBytes, uint32_t iByteCount) = 0;
+
         /**
          * @brief Size in bytes of final CRC.
          *
@@ -0,0 +1,335 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include "commonstream/utils/MappedFile.h"
+
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CommonStream
+{
+
+    MappedFile::MappedFile()
+    {
+        data_ = NULL;
+        size_ = 0;
+        isOpen_ = false;
+
+#ifdef _WIN32
+        fileHandle_ = INVALID_HANDLE_VALUE;
+        mappingHandle_ = NULL;
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    ReturnCode MappedFile::open(const std::string &iPath)
+    {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(iPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+        if ( file == INVALID_HANDLE_VALUE )
+        {
+            return CMNSTRM_IO_FAIL;
+        }
+
+        LARGE_INTEGER fileSize;
+
+        if ( !GetFileSizeEx(file, &fileSize)
+            || (static_cast<uint64_t>(fileSize.QuadPart) > std::numeric_limits<size_t>::max()) )
+        {
+            CloseHandle(file);
+            return CMNSTRM_IO_FAIL;
+        }
+
+        fileHandle_ = file;
+        size_ = static_cast<ByteCount_t>(fileSize.QuadPart);
+
+        // An empty file cannot be mapped, but is a valid (empty) input
+        if ( size_ > 0 )
+        {
+            mappingHandle_ = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+            if ( mappingHandle_ )
+            {
+                data_ = static_cast<const char*>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+            }
+
+            if ( !data_ )
+            {
+                close();
+                return CMNSTRM_IO_FAIL;
+            }
+        }
+#else
+        int fd = ::open(iPath.c_str(), O_RDONLY);
+
+        if ( fd < 0 )
+        {
+            return CMNSTRM_IO_FAIL;
+        }
+
+        struct stat fileStat;
+
+        if ( (fstat(fd, &fileStat) != 0) || !S_ISREG(fileStat.st_mode)
+            || (static_cast<uint64_t>(fileStat.st_size) > std::numeric_limits<size_t>::max()) )
+        {
+            ::close(fd);
+            return CMNSTRM_IO_FAIL;
+        }
+
+        size_ = static_cast<ByteCount_t>(fileStat.st_size);
+
+        // An empty file cannot be mapped, but is a valid (empty) input
+        if ( size_ > 0 )
+        {
+            void *addr = mmap(NULL, static_cast<size_t>(size_), PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if ( addr == MAP_FAILED )
+            {
+                ::close(fd);
+                size_ = 0;
+                return CMNSTRM_IO_FAIL;
+            }
+
+            data_ = static_cast<const char*>(addr);
+        }
+
+        // The mapping holds its own reference to the file
+        ::close(fd);
+#endif
+
+        isOpen_ = true;
+
+        return CMNSTRM_OK;
+    }
+
+    void MappedFile::close()
+    {
+#ifdef _WIN32
+        if ( data_ )
+        {
+            UnmapViewOfFile(data_);
+        }
+
+        if ( mappingHandle_ )
+        {
+            CloseHandle(mappingHandle_);
+            mappingHandle_ = NULL;
+        }
+
+        if ( fileHandle_ != INVALID_HANDLE_VALUE )
+        {
+            CloseHandle(fileHandle_);
+            fileHandle_ = INVALID_HANDLE_VALUE;
+        }
+#else
+        if ( data_ )
+        {
+            munmap(const_cast<char*>(data_), static_cast<size_t>(size_));
+        }
+#endif
+
+        data_ = NULL;
+        size_ = 0;
+        isOpen_ = false;
+    }
+
+    bool MappedFile::is_open() const
+    {
+        return isOpen_;
+    }
+
+    const char *MappedFile::data() const
+    {
+        return data_;
+    }
+
+    ByteCount_t MappedFile::size() const
+    {
+        return size_;
+    }
+
+    void MappedFile::adviseSequential()
+    {
+#ifndef _WIN32
+        // Windows equivalent is FILE_FLAG_SEQUENTIAL_SCAN, set on open
+        if ( data_ )
+        {
+            madvise(const_cast<char*>(data_), static_cast<size_t>(size_), MADV_SEQUENTIAL);
+        }
+#endif
+    }
+
+    void MappedFile::release(ByteCount_t iOffset, ByteCount_t iLength)
+    {
+#ifndef _WIN32
+        // Windows trims clean file-backed pages from the working set on its own
+        if ( !data_ || (iOffset >= size_) )
+        {
+            return;
+        }
+
+        if ( iLength > size_ - iOffset )
+        {
+            iLength = size_ - iOffset;
+        }
+
+        // madvise() operates on whole pages. The mapping itself is page aligned.
+        ByteCount_t pageSize = static_cast<ByteCount_t>(sysconf(_SC_PAGESIZE));
+        ByteCount_t start = (iOffset + pageSize - 1) / pageSize * pageSize;
+        ByteCount_t end = (iOffset + iLength) / pageSize * pageSize;
+
+        if ( end > start )
+        {
+            madvise(const_cast<char*>(data_) + start, static_cast<size_t>(end - start), MADV_DONTNEED);
+        }
+#else
+        (void)iOffset;
+        (void)iLength;
+#endif
+    }
+
+    void MappedFile::prefetch(ByteCount_t iOffset, ByteCount_t iLength)
+    {
+#ifndef _WIN32
+        // Windows reads ahead on its own for files opened with FILE_FLAG_SEQUENTIAL_SCAN
+        if ( !data_ || (iOffset >= size_) )
+        {
+            return;
+        }
+
+        if ( iLength > size_ - iOffset )
+        {
+            iLength = size_ - iOffset;
+        }
+
+        // madvise() operates on whole pages, round the range out to page boundaries
+        ByteCount_t pageSize = static_cast<ByteCount_t>(sysconf(_SC_PAGESIZE));
+        ByteCount_t start = iOffset / pageSize * pageSize;
+        ByteCount_t end = iOffset + iLength;
+
+        if ( end > start )
+        {
+            madvise(const_cast<char*>(data_) + start, static_cast<size_t>(end - start), MADV_WILLNEED);
+        }
+#else
+        (void)iOffset;
+        (void)iLength;
+#endif
+    }
+
+    MappedIStream::MappedIStream() : std::istream(NULL)
+    {
+        buf_ = NULL;
+        released_ = 0;
+    }
+
+    MappedIStream::~MappedIStream()
+    {
+        close();
+    }
+
+    ReturnCode MappedIStream::open(const std::string &iPath)
+    {
+        close();
+
+        ReturnCode rc = file_.open(iPath);
+
+        if ( rc )
+        {
+            return rc;
+        }
+
+        file_.adviseSequential();
+
+        // IStreamBufWrapper only reads from the buffer
+        buf_ = new IStreamBufWrapper<char>(const_cast<char*>(file_.data()), static_cast<std::streamsize>(file_.size()));
+        rdbuf(buf_);
+
+        return CMNSTRM_OK;
+    }
+
+    void MappedIStream::close()
+    {
+        // Detaching the buffer leaves the stream in bad state until re-opened
+        rdbuf(NULL);
+        delete buf_;
+        buf_ = NULL;
+        released_ = 0;
+
+        file_.close();
+    }
+
+    bool MappedIStream::is_open() const
+    {
+        return file_.is_open();
+    }
+
+    const char *MappedIStream::data() const
+    {
+        return file_.data();
+    }
+
+    ByteCount_t MappedIStream::size() const
+    {
+        return file_.size();
+    }
+
+    void MappedIStream::releaseConsumed()
+    {
+        if ( !buf_ )
+        {
+            return;
+        }
+
+        // Query the buffer directly, tellg() fails once eof is set
+        std::streamoff position = buf_->pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+
+        if ( (position > 0) && (static_cast<ByteCount_t>(position) >= released_ + kReleaseChunkSize) )
+        {
+            file_.release(released_, static_cast<ByteCount_t>(position) - released_);
+            released_ = static_cast<ByteCount_t>(position) / kReleaseChunkSize * kReleaseChunkSize;
+        }
+    }
+
+}  // namespace CommonStream
@@ -0,0 +1,129 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#ifndef COMMON_STREAM_SRC_UTILS_MAPPEDFILE_H_
+#define COMMON_STREAM_SRC_UTILS_MAPPEDFILE_H_
+
+#include <istream>
+#include <string>
+
+#include "commonstream/utils/Namespace.h"
+#include "commonstream/utils/rawbuf.h"
+#include "commonstream/stream/StreamDefines.h"
+
+namespace CommonStream
+{
+
+    /**
+     *
+     * Read-only memory mapping of a whole file.
+     *
+     * Pages are loaded on first access and can be dropped again with release(), so that
+     * resident memory follows the region being read rather than the file size.
+     *
+     */
+    class MappedFile
+    {
+    public:
+
+        MappedFile();
+        ~MappedFile();
+
+        ReturnCode open(const std::string &iPath);
+        void close();
+        bool is_open() const;
+
+        const char *data() const;
+        ByteCount_t size() const;
+
+        /// Hints the OS that the mapping is read front to back (aggressive read-ahead).
+        void adviseSequential();
+
+        /// Drops resident pages fully contained in [iOffset, iOffset + iLength). Data is re-read
+        /// from the file if accessed again.
+        void release(ByteCount_t iOffset, ByteCount_t iLength);
+
+        /// Hints the OS that [iOffset, iOffset + iLength) will be accessed soon, so that pages are
+        /// read in ahead of the first access.
+        void prefetch(ByteCount_t iOffset, ByteCount_t iLength);
+
+    private:
+
+        MappedFile(const MappedFile&);
+        MappedFile &operator=(const MappedFile&);
+
+        const char      *data_;
+        ByteCount_t      size_;
+        bool             isOpen_;
+
+#ifdef _WIN32
+        void            *fileHandle_;
+        void            *mappingHandle_;
+#endif
+    };
+
+    /**
+     *
+     * std::istream over a MappedFile. Reads and seeks operate directly on the mapped pages,
+     * without an intermediate file buffer.
+     *
+     */
+    class MappedIStream : public std::istream
+    {
+    public:
+
+        MappedIStream();
+        ~MappedIStream();
+
+        ReturnCode open(const std::string &iPath);
+        void close();
+        bool is_open() const;
+
+        const char *data() const;
+        ByteCount_t size() const;
+
+        /// Drops mapped pages that lie before the current read position. Pages are released
+        /// in chunks of kReleaseChunkSize to limit the number of system calls.
+        void releaseConsumed();
+
+        static const ByteCount_t kReleaseChunkSize = 16 * 1024 * 1024;
+
+    private:
+
+        MappedIStream(const MappedIStream&);
+        MappedIStream &operator=(const MappedIStream&);
+
+        MappedFile               file_;
+        IStreamBufWrapper<char> *buf_;
+        ByteCount_t              released_;
+    };
+
+}  // namespace CommonStream
+
+#endif // COMMON_STREAM_SRC_UTILS_MAPPEDFILE_H_
@@ -39,6 +39,22 @@
 
 #define KNoError 0
 
+#include <string.h>
+
+// SIMD paths of the float to PCM kernels. Both are part of the baseline instruction set of their targets.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CMNSTRM_PCM_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CMNSTRM_PCM_NEON
+#endif
+
+// Native little-endian samples can be stored as whole words
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+#define CMNSTRM_PCM_LITTLE_ENDIAN
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -368,6 +384,615 @@ namespace CommonStream
 
     }
 
+    /**
+     * Converts float samples to 32-bit native integer samples. Samples are scaled
+     * by 2147483647, rounded to nearest (halves away from zero) and clipped
+     * to the 32-bit integer range.
+     *
+     * @param pDest Pointer to a buffer of pCount int samples.
+     * @param pSrc Pointer to a buffer of pCount float samples.
+     * @param pCount Number of samples to convert.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int FloatToInt32(int *pDest, const float *pSrc, unsigned int pCount)
+    {
+        unsigned int i = 0;
+
+#if defined(CMNSTRM_PCM_SSE2)
+        const __m128 lScale = _mm_set1_ps(2147483647.0f);
+        const __m128 lHalf = _mm_set1_ps(0.5f);
+        const __m128 lSignMask = _mm_castsi128_ps(_mm_set1_epi32((int) 0x80000000));
+        const __m128 lLimit = _mm_set1_ps(2147483648.0f);
+
+        for(; i + 4 <= pCount; i += 4)
+        {
+            __m128 lSample = _mm_mul_ps(_mm_loadu_ps(pSrc + i), lScale);
+            lSample = _mm_add_ps(lSample, _mm_or_ps(_mm_and_ps(lSample, lSignMask), lHalf));
+
+            // Out of range samples convert to 0x80000000, flip the positive ones to 0x7FFFFFFF
+            __m128i lInt = _mm_cvttps_epi32(lSample);
+            lInt = _mm_xor_si128(lInt, _mm_castps_si128(_mm_cmpge_ps(lSample, lLimit)));
+
+            _mm_storeu_si128((__m128i *) (pDest + i), lInt);
+        }
+#elif defined(CMNSTRM_PCM_NEON)
+        const float32x4_t lScale = vdupq_n_f32(2147483647.0f);
+        const float32x4_t lPlusHalf = vdupq_n_f32(0.5f);
+        const float32x4_t lMinusHalf = vdupq_n_f32(-0.5f);
+        const float32x4_t lZero = vdupq_n_f32(0.0f);
+
+        for(; i + 4 <= pCount; i += 4)
+        {
+            float32x4_t lSample = vmulq_f32(vld1q_f32(pSrc + i), lScale);
+            lSample = vaddq_f32(lSample, vbslq_f32(vcltq_f32(lSample, lZero), lMinusHalf, lPlusHalf));
+
+            // Saturating conversion
+            vst1q_s32(pDest + i, vcvtq_s32_f32(lSample));
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            float lSample = pSrc[i] * 2147483647.0f;
+
+            lSample += (lSample >= 0.0f) ? 0.5f : -0.5f;
+
+            if (lSample >= 2147483648.0f)
+            {
+                pDest[i] = 0x7FFFFFFF;
+            }
+            else if (lSample >= -2147483648.0f)
+            {
+                pDest[i] = (int) lSample;
+            }
+            else
+            {
+                pDest[i] = -0x7FFFFFFF - 1;
+            }
+        }
+
+        return KNoError;
+    }
+
+    /**
+     * Seeds the state used by FloatToInt32Dithered.
+     *
+     * @param pDitherState Pointer to 4 words of dither state.
+     * @param pSeed Seed. The same seed reproduces the same dither.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE void InitDitherState(unsigned int *pDitherState, unsigned int pSeed)
+    {
+        unsigned int i = 0;
+
+        for(i = 0; i < 4; i++)
+        {
+            unsigned int lState = pSeed + 0x9E3779B9u * (i + 1);
+
+            lState ^= lState >> 16;
+            lState *= 0x85EBCA6Bu;
+            lState ^= lState >> 13;
+
+            // xorshift state must not be 0
+            pDitherState[i] = lState ? lState : 1;
+        }
+    }
+
+#if defined(CMNSTRM_PCM_SSE2)
+    // Next xorshift32 value of 4 generators
+    CMNSTRM_INLINE __m128i XorShift32x4(__m128i pState)
+    {
+        pState = _mm_xor_si128(pState, _mm_slli_epi32(pState, 13));
+        pState = _mm_xor_si128(pState, _mm_srli_epi32(pState, 17));
+        return _mm_xor_si128(pState, _mm_slli_epi32(pState, 5));
+    }
+#elif defined(CMNSTRM_PCM_NEON)
+    // Next xorshift32 value of 4 generators
+    CMNSTRM_INLINE uint32x4_t XorShift32x4(uint32x4_t pState)
+    {
+        pState = veorq_u32(pState, vshlq_n_u32(pState, 13));
+        pState = veorq_u32(pState, vshrq_n_u32(pState, 17));
+        return veorq_u32(pState, vshlq_n_u32(pState, 5));
+    }
+#endif
+
+    /**
+     * Converts float samples to pBitDepth-bit integer samples with TPDF dither,
+     * left justified in 32-bit native integers. Triangular dither of +/- 1 LSB
+     * of the target bit depth is added before rounding, and samples are clipped
+     * to the target range. Samples of the output stay valid input for
+     * Int32ToPCM16_LE and Int32ToPCM24_LE.
+     *
+     * Sample i uses dither generator i % 4, so the result only depends on the seed
+     * and the sample positions, not on the code path taken.
+     *
+     * @param pDest Pointer to a buffer of pCount int samples.
+     * @param pSrc Pointer to a buffer of pCount float samples.
+     * @param pCount Number of samples to convert.
+     * @param pBitDepth Target bit depth, 8 to 24. Other values convert without dither, as FloatToInt32.
+     * @param pDitherState Pointer to 4 words of dither state, seeded by InitDitherState and updated.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int FloatToInt32Dithered(int *pDest, const float *pSrc, unsigned int pCount, unsigned int pBitDepth, unsigned int *pDitherState)
+    {
+        unsigned int i = 0;
+
+        if (pBitDepth < 8 || pBitDepth > 24)
+        {
+            return FloatToInt32(pDest, pSrc, pCount);
+        }
+
+        // Samples are quantized in units of 1 LSB of the target bit depth, then shifted into place
+        const float lScale = (float) (1u << (pBitDepth - 1));
+        const float lMax = lScale - 1.0f;
+        const float lUnit = 1.0f / 16777216.0f;
+        const unsigned int lShift = 32 - pBitDepth;
+
+#if defined(CMNSTRM_PCM_SSE2)
+        const __m128 lScaleV = _mm_set1_ps(lScale);
+        const __m128 lMaxV = _mm_set1_ps(lMax);
+        const __m128 lMinV = _mm_set1_ps(-lScale);
+        const __m128 lUnitV = _mm_set1_ps(lUnit);
+        const __m128 lHalf = _mm_set1_ps(0.5f);
+        const __m128 lSignMask = _mm_castsi128_ps(_mm_set1_epi32((int) 0x80000000));
+        const __m128i lShiftV = _mm_cvtsi32_si128((int) lShift);
+
+        __m128i lState = _mm_loadu_si128((const __m128i *) pDitherState);
+
+        for(; i + 4 <= pCount; i += 4)
+        {
+            __m128 lSample = _mm_mul_ps(_mm_loadu_ps(pSrc + i), lScaleV);
+
+            lState = XorShift32x4(lState);
+            __m128 lDither1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(lState, 8)), lUnitV);
+            lState = XorShift32x4(lState);
+            __m128 lDither2 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(lState, 8)), lUnitV);
+
+            lSample = _mm_add_ps(lSample, _mm_sub_ps(lDither1, lDither2));
+            lSample = _mm_min_ps(_mm_max_ps(lSample, lMinV), lMaxV);
+            lSample = _mm_add_ps(lSample, _mm_or_ps(_mm_and_ps(lSample, lSignMask), lHalf));
+
+            _mm_storeu_si128((__m128i *) (pDest + i), _mm_sll_epi32(_mm_cvttps_epi32(lSample), lShiftV));
+        }
+
+        _mm_storeu_si128((__m128i *) pDitherState, lState);
+#elif defined(CMNSTRM_PCM_NEON)
+        const float32x4_t lScaleV = vdupq_n_f32(lScale);
+        const float32x4_t lMaxV = vdupq_n_f32(lMax);
+        const float32x4_t lMinV = vdupq_n_f32(-lScale);
+        const float32x4_t lUnitV = vdupq_n_f32(lUnit);
+        const float32x4_t lPlusHalf = vdupq_n_f32(0.5f);
+        const float32x4_t lMinusHalf = vdupq_n_f32(-0.5f);
+        const float32x4_t lZero = vdupq_n_f32(0.0f);
+        const int32x4_t lShiftV = vdupq_n_s32((int) lShift);
+
+        uint32x4_t lState = vld1q_u32(pDitherState);
+
+        for(; i + 4 <= pCount; i += 4)
+        {
+            float32x4_t lSample = vmulq_f32(vld1q_f32(pSrc + i), lScaleV);
+
+            lState = XorShift32x4(lState);
+            float32x4_t lDither1 = vmulq_f32(vcvtq_f32_u32(vshrq_n_u32(lState, 8)), lUnitV);
+            lState = XorShift32x4(lState);
+            float32x4_t lDither2 = vmulq_f32(vcvtq_f32_u32(vshrq_n_u32(lState, 8)), lUnitV);
+
+            lSample = vaddq_f32(lSample, vsubq_f32(lDither1, lDither2));
+            lSample = vminq_f32(vmaxq_f32(lSample, lMinV), lMaxV);
+            lSample = vaddq_f32(lSample, vbslq_f32(vcltq_f32(lSample, lZero), lMinusHalf, lPlusHalf));
+
+            vst1q_s32(pDest + i, vshlq_s32(vcvtq_s32_f32(lSample), lShiftV));
+        }
+
+        vst1q_u32(pDitherState, lState);
+#endif
+
+        for(; i < pCount; i++)
+        {
+            unsigned int lState = pDitherState[i & 3];
+
+            lState ^= lState << 13;
+            lState ^= lState >> 17;
+            lState ^= lState << 5;
+            float lDither1 = (float) (lState >> 8) * lUnit;
+
+            lState ^= lState << 13;
+            lState ^= lState >> 17;
+            lState ^= lState << 5;
+            float lDither2 = (float) (lState >> 8) * lUnit;
+
+            pDitherState[i & 3] = lState;
+
+            float lSample = pSrc[i] * lScale;
+            lSample = lSample + (lDither1 - lDither2);
+
+            if (!(lSample >= -lScale))
+            {
+                lSample = -lScale;
+            }
+            else if (lSample > lMax)
+            {
+                lSample = lMax;
+            }
+
+            lSample += (lSample >= 0.0f) ? 0.5f : -0.5f;
+
+            pDest[i] = (int) ((unsigned int) (int) lSample << lShift);
+        }
+
+        return KNoError;
+    }
+
+    /**
+     * Converts 32-bit native integer samples to 16-bit PCM samples, stored in <b>
+     * Little-Endian </b> byte order. The upper 2 bytes of each sample are kept.
+     * Consecutive samples are written pDestStride bytes apart, so that a
+     * channel can be packed straight into an interleaved buffer.
+     *
+     * @param pDest Pointer to the first PCM16 sample in the destination buffer.
+     * @param pSrc Pointer to a buffer of pCount int samples.
+     * @param pCount Number of samples to convert.
+     * @param pDestStride Distance between consecutive samples in pDest, in bytes. 2 when not interleaved.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int Int32ToPCM16_LE(char *pDest, const int *pSrc, unsigned int pCount, unsigned int pDestStride)
+    {
+        unsigned int i = 0;
+
+        unsigned char *lDest = (unsigned char *) pDest;
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_SSE2)
+        if (pDestStride == 2)
+        {
+            for(; i + 8 <= pCount; i += 8)
+            {
+                __m128i lLow = _mm_srai_epi32(_mm_loadu_si128((const __m128i *) (pSrc + i)), 16);
+                __m128i lHigh = _mm_srai_epi32(_mm_loadu_si128((const __m128i *) (pSrc + i + 4)), 16);
+
+                _mm_storeu_si128((__m128i *) lDest, _mm_packs_epi32(lLow, lHigh));
+                lDest += 16;
+            }
+        }
+#elif defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_NEON)
+        if (pDestStride == 2)
+        {
+            for(; i + 8 <= pCount; i += 8)
+            {
+                int16x8_t lPacked = vcombine_s16(vshrn_n_s32(vld1q_s32(pSrc + i), 16), vshrn_n_s32(vld1q_s32(pSrc + i + 4), 16));
+
+                vst1q_s16((int16_t *) lDest, lPacked);
+                lDest += 16;
+            }
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            unsigned int lSample = (unsigned int) pSrc[i];
+
+            lDest[0] = (unsigned char) (lSample >> 16);
+            lDest[1] = (unsigned char) (lSample >> 24);
+
+            lDest += pDestStride;
+        }
+
+        return KNoError;
+    }
+
+    /**
+     * Converts 32-bit native integer samples to 24-bit PCM samples, stored in <b>
+     * Little-Endian </b> byte order. The upper 3 bytes of each sample are kept.
+     * Consecutive samples are written pDestStride bytes apart, so that a
+     * channel can be packed straight into an interleaved buffer.
+     *
+     * @param pDest Pointer to the first PCM24 sample in the destination buffer.
+     * @param pSrc Pointer to a buffer of pCount int samples.
+     * @param pCount Number of samples to convert.
+     * @param pDestStride Distance between consecutive samples in pDest, in bytes. 3 when not interleaved.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int Int32ToPCM24_LE(char *pDest, const int *pSrc, unsigned int pCount, unsigned int pDestStride)
+    {
+        unsigned int i = 0;
+
+        unsigned char *lDest = (unsigned char *) pDest;
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN)
+        if (pDestStride == 3)
+        {
+            // 4 samples fill 3 words
+            for(; i + 4 <= pCount; i += 4)
+            {
+                unsigned int lSample0 = (unsigned int) pSrc[i] >> 8;
+                unsigned int lSample1 = (unsigned int) pSrc[i + 1] >> 8;
+                unsigned int lSample2 = (unsigned int) pSrc[i + 2] >> 8;
+                unsigned int lSample3 = (unsigned int) pSrc[i + 3] >> 8;
+                unsigned int lWords[3];
+
+                lWords[0] = lSample0 | (lSample1 << 24);
+                lWords[1] = (lSample1 >> 8) | (lSample2 << 16);
+                lWords[2] = (lSample2 >> 16) | (lSample3 << 8);
+
+                memcpy(lDest, lWords, sizeof(lWords));
+                lDest += sizeof(lWords);
+            }
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            unsigned int lSample = (unsigned int) pSrc[i];
+
+            lDest[0] = (unsigned char) (lSample >> 8);
+            lDest[1] = (unsigned char) (lSample >> 16);
+            lDest[2] = (unsigned char) (lSample >> 24);
+
+            lDest += pDestStride;
+        }
+
+        return KNoError;
+    }
+
+    /**
+     * Converts 32-bit native integer samples to 32-bit PCM samples, stored in <b>
+     * Little-Endian </b> byte order. Consecutive samples are written pDestStride
+     * bytes apart, so that a channel can be packed straight into an interleaved buffer.
+     *
+     * @param pDest Pointer to the first PCM32 sample in the destination buffer.
+     * @param pSrc Pointer to a buffer of pCount int samples.
+     * @param pCount Number of samples to convert.
+     * @param pDestStride Distance between consecutive samples in pDest, in bytes. 4 when not interleaved.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int Int32ToPCM32_LE(char *pDest, const int *pSrc, unsigned int pCount, unsigned int pDestStride)
+    {
+        unsigned int i = 0;
+
+        unsigned char *lDest = (unsigned char *) pDest;
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN)
+        if (pDestStride == 4)
+        {
+            memcpy(lDest, pSrc, (size_t) pCount * 4);
+            return KNoError;
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            unsigned int lSample = (unsigned int) pSrc[i];
+
+            lDest[0] = (unsigned char) lSample;
+            lDest[1] = (unsigned char) (lSample >> 8);
+            lDest[2] = (unsigned char) (lSample >> 16);
+            lDest[3] = (unsigned char) (lSample >> 24);
+
+            lDest += pDestStride;
+        }
+
+        return KNoError;
+    }
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_SSE2)
+    // Loads 4 little-endian PCM24 samples as 32-bit native integers (3 upper bytes). Reads 16 bytes.
+    CMNSTRM_INLINE __m128i LoadPCM24_LEx4(const unsigned char *pSrc)
+    {
+        __m128i lBytes = _mm_loadu_si128((const __m128i *) pSrc);
+
+        // Samples start at bytes 0, 3, 6 and 9
+        __m128i lSamples01 = _mm_unpacklo_epi32(lBytes, _mm_srli_si128(lBytes, 3));
+        __m128i lSamples23 = _mm_unpacklo_epi32(_mm_srli_si128(lBytes, 6), _mm_srli_si128(lBytes, 9));
+
+        return _mm_slli_epi32(_mm_unpacklo_epi64(lSamples01, lSamples23), 8);
+    }
+#endif
+
+    /**
+     * Converts 16-bit PCM samples, stored in <b> Little-Endian </b> byte order,
+     * to 32-bit native integer samples. Samples are left justified (upper 2 bytes).
+     *
+     * @param pDest Pointer to a buffer of pCount int samples.
+     * @param pSrc Pointer to a buffer of pCount little-endian PCM16 samples.
+     * @param pCount Number of samples to convert.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int PCM16_LEToInt32(int *pDest, const char *pSrc, unsigned int pCount)
+    {
+        unsigned int i = 0;
+
+        const unsigned char *lSrc = (const unsigned char *) pSrc;
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_SSE2)
+        const __m128i lZero = _mm_setzero_si128();
+
+        for(; i + 8 <= pCount; i += 8)
+        {
+            __m128i lSamples = _mm_loadu_si128((const __m128i *) (lSrc + i * 2));
+
+            _mm_storeu_si128((__m128i *) (pDest + i), _mm_unpacklo_epi16(lZero, lSamples));
+            _mm_storeu_si128((__m128i *) (pDest + i + 4), _mm_unpackhi_epi16(lZero, lSamples));
+        }
+#elif defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_NEON)
+        for(; i + 4 <= pCount; i += 4)
+        {
+            vst1q_s32(pDest + i, vshll_n_s16(vld1_s16((const int16_t *) (lSrc + i * 2)), 16));
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            pDest[i] = (int) (((unsigned int) lSrc[i * 2] << 16) | ((unsigned int) lSrc[i * 2 + 1] << 24));
+        }
+
+        return KNoError;
+    }
+
+    /**
+     * Converts 24-bit PCM samples, stored in <b> Little-Endian </b> byte order,
+     * to 32-bit native integer samples. Samples are left justified (upper 3 bytes).
+     *
+     * @param pDest Pointer to a buffer of pCount int samples.
+     * @param pSrc Pointer to a buffer of pCount little-endian PCM24 samples.
+     * @param pCount Number of samples to convert.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int PCM24_LEToInt32(int *pDest, const char *pSrc, unsigned int pCount)
+    {
+        unsigned int i = 0;
+
+        const unsigned char *lSrc = (const unsigned char *) pSrc;
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_SSE2)
+        // 16-byte loads stay within the source buffer
+        for(; i + 6 <= pCount; i += 4)
+        {
+            _mm_storeu_si128((__m128i *) (pDest + i), LoadPCM24_LEx4(lSrc + i * 3));
+        }
+#elif defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_NEON)
+        for(; i + 8 <= pCount; i += 8)
+        {
+            uint8x8x3_t lBytes = vld3_u8(lSrc + i * 3);
+            uint16x8x2_t lSamples = vzipq_u16(vshll_n_u8(lBytes.val[0], 8), vorrq_u16(vmovl_u8(lBytes.val[1]), vshll_n_u8(lBytes.val[2], 8)));
+
+            vst1q_s32(pDest + i, vreinterpretq_s32_u16(lSamples.val[0]));
+            vst1q_s32(pDest + i + 4, vreinterpretq_s32_u16(lSamples.val[1]));
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            pDest[i] = (int) (((unsigned int) lSrc[i * 3] << 8) | ((unsigned int) lSrc[i * 3 + 1] << 16) | ((unsigned int) lSrc[i * 3 + 2] << 24));
+        }
+
+        return KNoError;
+    }
+
+    /**
+     * Converts 16-bit PCM samples, stored in <b> Little-Endian </b> byte order,
+     * to float samples. Samples are left justified to 32 bits and scaled by
+     * 1/2^31, which is the same as dividing by (float) 0x7fffffff.
+     *
+     * @param pDest Pointer to a buffer of pCount float samples.
+     * @param pSrc Pointer to a buffer of pCount little-endian PCM16 samples.
+     * @param pCount Number of samples to convert.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int PCM16_LEToFloat(float *pDest, const char *pSrc, unsigned int pCount)
+    {
+        unsigned int i = 0;
+
+        const unsigned char *lSrc = (const unsigned char *) pSrc;
+        const float lScale = 1.0f / 2147483648.0f;
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_SSE2)
+        const __m128i lZero = _mm_setzero_si128();
+        const __m128 lScaleV = _mm_set1_ps(lScale);
+
+        for(; i + 8 <= pCount; i += 8)
+        {
+            __m128i lSamples = _mm_loadu_si128((const __m128i *) (lSrc + i * 2));
+
+            _mm_storeu_ps(pDest + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lZero, lSamples)), lScaleV));
+            _mm_storeu_ps(pDest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lZero, lSamples)), lScaleV));
+        }
+#elif defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_NEON)
+        const float32x4_t lScaleV = vdupq_n_f32(lScale);
+
+        for(; i + 4 <= pCount; i += 4)
+        {
+            int32x4_t lSamples = vshll_n_s16(vld1_s16((const int16_t *) (lSrc + i * 2)), 16);
+
+            vst1q_f32(pDest + i, vmulq_f32(vcvtq_f32_s32(lSamples), lScaleV));
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            int lSample = (int) (((unsigned int) lSrc[i * 2] << 16) | ((unsigned int) lSrc[i * 2 + 1] << 24));
+
+            pDest[i] = (float) lSample * lScale;
+        }
+
+        return KNoError;
+    }
+
+    /**
+     * Converts 24-bit PCM samples, stored in <b> Little-Endian </b> byte order,
+     * to float samples. Samples are left justified to 32 bits and scaled by
+     * 1/2^31, which is the same as dividing by (float) 0x7fffffff.
+     *
+     * @param pDest Pointer to a buffer of pCount float samples.
+     * @param pSrc Pointer to a buffer of pCount little-endian PCM24 samples.
+     * @param pCount Number of samples to convert.
+     * @return KNoError if no errors occurred.
+     *
+     * @ingroup pcmutilities
+     */
+
+    CMNSTRM_INLINE int PCM24_LEToFloat(float *pDest, const char *pSrc, unsigned int pCount)
+    {
+        unsigned int i = 0;
+
+        const unsigned char *lSrc = (const unsigned char *) pSrc;
+        const float lScale = 1.0f / 2147483648.0f;
+
+#if defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_SSE2)
+        const __m128 lScaleV = _mm_set1_ps(lScale);
+
+        // 16-byte loads stay within the source buffer
+        for(; i + 6 <= pCount; i += 4)
+        {
+            _mm_storeu_ps(pDest + i, _mm_mul_ps(_mm_cvtepi32_ps(LoadPCM24_LEx4(lSrc + i * 3)), lScaleV));
+        }
+#elif defined(CMNSTRM_PCM_LITTLE_ENDIAN) && defined(CMNSTRM_PCM_NEON)
+        const float32x4_t lScaleV = vdupq_n_f32(lScale);
+
+        for(; i + 8 <= pCount; i += 8)
+        {
+            uint8x8x3_t lBytes = vld3_u8(lSrc + i * 3);
+            uint16x8x2_t lSamples = vzipq_u16(vshll_n_u8(lBytes.val[0], 8), vorrq_u16(vmovl_u8(lBytes.val[1]), vshll_n_u8(lBytes.val[2], 8)));
+
+            vst1q_f32(pDest + i, vmulq_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(lSamples.val[0])), lScaleV));
+            vst1q_f32(pDest + i + 4, vmulq_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(lSamples.val[1])), lScaleV));
+        }
+#endif
+
+        for(; i < pCount; i++)
+        {
+            int lSample = (int) (((unsigned int) lSrc[i * 3] << 8) | ((unsigned int) lSrc[i * 3 + 1] << 16) | ((unsigned int) lSrc[i * 3 + 2] << 24));
+
+            pDest[i] = (float) lSample * lScale;
+        }
+
+        return KNoError;
+    }
+
 } // namespace CommonStream
 
 #ifdef __cplusplus
@@ -50,11 +50,51 @@ struct OStreamBufWrapper : public std::basic_streambuf<char_type, std::char_trai
 template <typename char_type>
 struct IStreamBufWrapper : public std::basic_streambuf<char_type, std::char_traits<char_type> >
 {
+    typedef std::basic_streambuf<char_type, std::char_traits<char_type> > base_type;
+    typedef typename base_type::pos_type pos_type;
+    typedef typename base_type::off_type off_type;
+
     IStreamBufWrapper(char_type* buffer, std::streamsize bufferLength)
     {
-        // set the "put" pointer the start of the buffer and record its length.
+        // set the "get" pointer the start of the buffer and record its length.
         this->setg(buffer, buffer, buffer + bufferLength);
     }
+
+protected:
+
+    // Support tellg()/seekg() on the wrapped buffer, so that the buffer can be used in place
+    // by readers that seek, without first copying it into a stringstream.
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in)
+    {
+        if ( !(which & std::ios_base::in) )
+        {
+            return pos_type(off_type(-1));
+        }
+
+        off_type pos = off;
+
+        if ( dir == std::ios_base::cur )
+        {
+            pos += this->gptr() - this->eback();
+        }
+        else if ( dir == std::ios_base::end )
+        {
+            pos += this->egptr() - this->eback();
+        }
+
+        if ( (pos < 0) || (pos > (this->egptr() - this->eback())) )
+        {
+            return pos_type(off_type(-1));
+        }
+
+        this->setg(this->eback(), this->eback() + pos, this->egptr());
+        return pos_type(pos);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in)
+    {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
 };
 
 }  // namespace CommonStream
@@ -34,6 +34,7 @@
  */
 
 #include <assert.h>
+#include <algorithm>
 #include <stack>
 #include <vector>
 #include <stdlib.h>
@@ -43,13 +44,15 @@
 #include "IABUtilities.h"
 #include "packer/IABPacker.h"
 #include "IABVersion.h"
-#include "commonstream/utils/opbacksbuf.h"
 
 #define IAB_PACKERLIB_EMBEDDED_STRFILEVER "IAB Packer Lib Version " IAB_VERSION_STRING
 
 #define IABPackerAPIHighVersion     0
 #define IABPackerAPILowVersion      0
 
+#define     MAX_PACKER_ENCODE_THREADPOOL_SIZE     16			// Maximum DLC encoding threadpool size.
+#define     MIN_PACKER_ENCODE_THREADPOOL_SIZE     1			// Minimum DLC encoding threadpool size.
+
 
 namespace SMPTE
 {
@@ -75,6 +78,17 @@ namespace ImmersiveAudioBitstream
         delete iInstance;
     }
 
+#if __linux__ || __APPLE__
+	// DLC encoder worker thread entry point
+	static void *MTPackerEncodeThreadWorker(void *iParam)
+	{
+		IABPacker* packer = static_cast<IABPacker*> (iParam);
+		packer->EncodeDLCJobs();
+
+		return NULL;
+	}
+#endif // __linux__ || __APPLE__
+
     /****************************************************************************
     *
     * IABPacker
@@ -84,7 +98,7 @@ namespace ImmersiveAudioBitstream
 	// IABPacker constructor implementation
 	IABPacker::IABPacker()
     {
-        iabPackerFrame_ = IABFrameInterface::Create(nullptr);
+        iabPackerFrame_ = new IABFrame();
         maxRendered_ = 0;
 		frameRate_ = kIABFrameRate_24FPS;				// Default: 24 fps
 		sampleRate_ = kIABSampleRate_48000Hz;			// Default: 48 kHz
@@ -92,11 +106,24 @@ namespace ImmersiveAudioBitstream
 
 		currentMetaID_ = 0;
 		currentAudioID_ = 0;
+
+		dlcEncodeEffort_ = kIABDLCEncodeEffort_Minimal;
+		encodeThreadPoolSize_ = MIN_PACKER_ENCODE_THREADPOOL_SIZE;
+
+#if __linux__ || __APPLE__
+		nextDLCEncodeJob_ = 0;
+		pendingDLCEncodeJobs_ = 0;
+		doTerminateEncode_ = false;
+#endif // __linux__ || __APPLE__
 	}
 
 	// IABPacker destructor implementation
 	IABPacker::~IABPacker()
     {
+#if __linux__ || __APPLE__
+		StopDLCEncodeThreads();
+#endif // __linux__ || __APPLE__
+
 		delete iabPackerFrame_;
 		iabPackerFrame_ = nullptr;
     }
@@ -144,13 +171,13 @@ namespace ImmersiveAudioBitstream
 			return errorCode;
 		}
         
-        // Clear packed frame buffer
+        // Clear packed frame buffer. Its allocation is kept, so packing does not reallocate from frame to frame.
         fProgramBuffer_.clear();
 
-		opbacksbuf<std::vector<char> > outStreamBuf(fProgramBuffer_);
-		std::ostream outputStream(&outStreamBuf);
+		// Serialize the frame, with all of its elements, in a single pass directly into fProgramBuffer_
+		IABPackingBuffer packingBuffer(fProgramBuffer_);
 
-		errorCode = iabPackerFrame_->Serialize(outputStream);
+		errorCode = iabPackerFrame_->SerializeToBuffer(packingBuffer);
 
 		return errorCode;
 	}
@@ -568,6 +595,15 @@ namespace ImmersiveAudioBitstream
                 
                 // Set DLC sample rate
                 dlcElement->SetDLCSampleRate(sampleRate_);
+
+                // Set DLC encoding effort
+                iabError errorCode = dlcElement->SetDLCEncodeEffort(dlcEncodeEffort_);
+
+                if (kIABNoError != errorCode)
+                {
+                    delete dlcElement;
+                    return errorCode;
+                }
                 
 				iabPackerFrame_->AddSubElement(dlcElement);
             }
@@ -588,6 +624,9 @@ namespace ImmersiveAudioBitstream
 
         std::map<IABAudioDataIDType, int32_t*>::iterator iter;
         std::vector<IABElement*> ::const_iterator iterFSE;
+
+		// Collect an encoding job for each DLC element of the frame
+		std::vector<DLCEncodeJob> encodeJobs;
         
         for (iterFSE = frameSbElements.begin(); iterFSE != frameSbElements.end(); iterFSE++)
         {
@@ -600,8 +639,8 @@ namespace ImmersiveAudioBitstream
                 iter = iAudioSources.find(audioID);
                 if (iter != iAudioSources.end())
                 {
-                    // encode audio samples and replace encoded samples
-                    dlcElement->EncodeMonoPCMToDLC(iter->second, 2000);
+					DLCEncodeJob job = { dlcElement, iter->second, kIABNoError };
+					encodeJobs.push_back(job);
                 }
                 else
                 {
@@ -609,10 +648,197 @@ namespace ImmersiveAudioBitstream
                 }
             }
         }
+
+		// encode audio samples and replace encoded samples
+		RunDLCEncodeJobs(encodeJobs);
+
+		for (uint32_t i = 0; i < encodeJobs.size(); i++)
+		{
+			if (kIABNoError != encodeJobs[i].errorCode_)
+			{
+				return encodeJobs[i].errorCode_;
+			}
+		}
         
         return kIABNoError;
     }
 
+	// IABPacker::SetDLCEncodeThreadPoolSize() implementation
+	iabError IABPacker::SetDLCEncodeThreadPoolSize(uint32_t iThreadPoolSize)
+	{
+		uint32_t threadPoolSize = std::min(std::max(iThreadPoolSize, static_cast<uint32_t>(MIN_PACKER_ENCODE_THREADPOOL_SIZE))
+			, static_cast<uint32_t>(MAX_PACKER_ENCODE_THREADPOOL_SIZE));
+
+		if (threadPoolSize == encodeThreadPoolSize_)
+		{
+			return kIABNoError;
+		}
+
+#if __linux__ || __APPLE__
+		StopDLCEncodeThreads();
+
+		// The calling thread encodes too, start one worker fewer than the pool size
+		for (uint32_t i = 1; i < threadPoolSize; i++)
+		{
+			pthread_t thread;
+
+			if (0 != pthread_create(&thread, NULL, MTPackerEncodeThreadWorker, this))
+			{
+				StopDLCEncodeThreads();
+				encodeThreadPoolSize_ = MIN_PACKER_ENCODE_THREADPOOL_SIZE;
+				return kIABGeneralError;
+			}
+
+			encodeThreads_.push_back(thread);
+		}
+#endif // __linux__ || __APPLE__
+
+		encodeThreadPoolSize_ = threadPoolSize;
+
+		return kIABNoError;
+	}
+
+	// IABPacker::SetDLCEncodeEffort() implementation
+	iabError IABPacker::SetDLCEncodeEffort(IABDLCEncodeEffortType iEncodeEffort)
+	{
+		// Validate up front, whether or not the frame holds DLC elements yet
+		switch (iEncodeEffort)
+		{
+		case kIABDLCEncodeEffort_Minimal:
+		case kIABDLCEncodeEffort_Fast:
+		case kIABDLCEncodeEffort_Thorough:
+			break;
+
+		default:
+			return kIABBadArgumentsError;
+		}
+
+		std::vector<IABElement*> frameSbElements;
+		iabPackerFrame_->GetSubElements(frameSbElements);
+
+		for (std::vector<IABElement*>::const_iterator iterFSE = frameSbElements.begin(); iterFSE != frameSbElements.end(); iterFSE++)
+		{
+			IABAudioDataDLC* dlcElement = dynamic_cast<IABAudioDataDLC*>(*iterFSE);
+
+			if (dlcElement != nullptr)
+			{
+				iabError errorCode = dlcElement->SetDLCEncodeEffort(iEncodeEffort);
+
+				if (kIABNoError != errorCode)
+				{
+					return errorCode;
+				}
+			}
+		}
+
+		dlcEncodeEffort_ = iEncodeEffort;
+
+		return kIABNoError;
+	}
+
+	// IABPacker::RunDLCEncodeJobs() implementation
+	void IABPacker::RunDLCEncodeJobs(std::vector<DLCEncodeJob> &ioJobs)
+	{
+		uint32_t frameSampleCount = GetIABNumFrameSamples(frameRate_, sampleRate_);
+
+#if __linux__ || __APPLE__
+		if (!encodeThreads_.empty())
+		{
+			// Workers only see the jobs of a frame while it is being encoded
+			encodeMutex_.lock();
+			dlcEncodeJobs_.swap(ioJobs);
+			nextDLCEncodeJob_ = 0;
+			pendingDLCEncodeJobs_ = static_cast<uint32_t>(dlcEncodeJobs_.size());
+			encodeJobsAvailable_.broadcast();
+
+			// Encode alongside the workers, then wait for the jobs they claimed
+			ClaimDLCEncodeJobs();
+
+			while (pendingDLCEncodeJobs_ > 0)
+			{
+				encodeJobsDone_.wait(encodeMutex_);
+			}
+
+			ioJobs.swap(dlcEncodeJobs_);
+			dlcEncodeJobs_.clear();
+			encodeMutex_.unlock();
+			return;
+		}
+#endif // __linux__ || __APPLE__
+
+		for (uint32_t i = 0; i < ioJobs.size(); i++)
+		{
+			DLCEncodeJob &job = ioJobs[i];
+			job.errorCode_ = job.element_->EncodeMonoPCMToDLC(job.samples_, frameSampleCount);
+		}
+	}
+
+#if __linux__ || __APPLE__
+	// IABPacker::ClaimDLCEncodeJobs() implementation
+	void IABPacker::ClaimDLCEncodeJobs()
+	{
+		uint32_t frameSampleCount = GetIABNumFrameSamples(frameRate_, sampleRate_);
+
+		while (nextDLCEncodeJob_ < dlcEncodeJobs_.size())
+		{
+			DLCEncodeJob &job = dlcEncodeJobs_[nextDLCEncodeJob_++];
+
+			// Elements own their encoder state, encode without holding the lock
+			encodeMutex_.unlock();
+			iabError errorCode = job.element_->EncodeMonoPCMToDLC(job.samples_, frameSampleCount);
+			encodeMutex_.lock();
+
+			job.errorCode_ = errorCode;
+
+			if (0 == --pendingDLCEncodeJobs_)
+			{
+				encodeJobsDone_.signal();
+			}
+		}
+	}
+
+	// IABPacker::EncodeDLCJobs() implementation
+	void IABPacker::EncodeDLCJobs()
+	{
+		encodeMutex_.lock();
+
+		while (!doTerminateEncode_)
+		{
+			if (nextDLCEncodeJob_ < dlcEncodeJobs_.size())
+			{
+				ClaimDLCEncodeJobs();
+			}
+			else
+			{
+				encodeJobsAvailable_.wait(encodeMutex_);
+			}
+		}
+
+		encodeMutex_.unlock();
+	}
+
+	// IABPacker::StopDLCEncodeThreads() implementation
+	void IABPacker::StopDLCEncodeThreads()
+	{
+		encodeMutex_.lock();
+		doTerminateEncode_ = true;
+		encodeJobsAvailable_.broadcast();
+		encodeMutex_.unlock();
+
+		for (uint32_t i = 0; i < encodeThreads_.size(); i++)
+		{
+			void* status;
+			if (0 != pthread_join(encodeThreads_[i], &status))
+			{
+				// error
+			}
+		}
+
+		encodeThreads_.clear();
+		doTerminateEncode_ = false;
+	}
+#endif // __linux__ || __APPLE__
+
 	// IABPacker::UpdateObjectMetaData() implementation
 	iabError IABPacker::UpdateObjectMetaData(IABMetadataIDType iObjectID, std::vector<IABObjectPanningParameters> iSubblockPanParameters)
     {
@@ -37,6 +37,13 @@
 #ifndef __IABPACKER_H__
 #define	__IABPACKER_H__
 
+#include <vector>
+
+#if __linux__ || __APPLE__
+#include <pthread.h>
+#include "common/IABMutex.h"
+#endif // __linux__ || __APPLE__
+
 #include "common/IABElements.h"
 #include "IABPackerAPI.h"
 
@@ -100,6 +107,12 @@ namespace ImmersiveAudioBitstream
         
 		// Update audio samples for current IAB frame
 		iabError UpdateAudioSamples(std::map<IABAudioDataIDType, int32_t*> iAudioSources);
+
+		// Set the number of threads encoding DLC elements in UpdateAudioSamples()
+		iabError SetDLCEncodeThreadPoolSize(uint32_t iThreadPoolSize);
+
+		// Set the DLC encoding effort level of current and future DLC elements
+		iabError SetDLCEncodeEffort(IABDLCEncodeEffortType iEncodeEffort);
         
 		// Update pan/position change meta data for an IAB object for current frame
         iabError UpdateObjectMetaData(IABMetadataIDType iObjectID, std::vector<IABObjectPanningParameters> iSubblockPanParameters);
@@ -113,8 +126,35 @@ namespace ImmersiveAudioBitstream
         // Add a UserData element to internal IABFrame (iabPackerFrame_)
         iabError AddUserData(const uint8_t(&iUserID)[16], const std::vector<uint8_t> iUserDataBytes);
         
+#if __linux__ || __APPLE__
+		// Encoder worker thread loop. Claims and encodes DLC jobs of the current frame,
+		// until termination is requested.
+		void EncodeDLCJobs();
+#endif // __linux__ || __APPLE__
+
     private:
 
+		// DLC encoding job of a frame: element, its frame samples and encoding result
+		struct DLCEncodeJob
+		{
+			IABAudioDataDLC* element_;
+			const int32_t* samples_;
+			iabError errorCode_;
+		};
+
+		// Encode all jobs in ioJobs, on the encoder thread pool when one is running.
+		// Job results are returned in ioJobs.
+		void RunDLCEncodeJobs(std::vector<DLCEncodeJob> &ioJobs);
+
+#if __linux__ || __APPLE__
+		// Claims and encodes jobs until none is left to claim. Called with encodeMutex_ locked,
+		// returns with it locked.
+		void ClaimDLCEncodeJobs();
+
+		// Stop and join encoder worker threads
+		void StopDLCEncodeThreads();
+#endif // __linux__ || __APPLE__
+
 		// Create, set up a 5.1 IAB object definiton element, and add it to internal IABFrame (iabPackerFrame_)
 		iabError AddBedDefinition51(IABMetadataIDType iBedID, 
 			const IABBedMappingInfo& iAudioIDs, 
@@ -138,7 +178,7 @@ namespace ImmersiveAudioBitstream
 		bool IsElementInFrame(IABElement* iElement);
 
 		// Pointer to IABFrame instance
-        IABFrameInterface*          iabPackerFrame_;
+        IABFrame*                   iabPackerFrame_;
 		uint8_t                     numSubBlocks_;
 		IABFrameRateType            frameRate_;
         IABSampleRateType           sampleRate_;
@@ -149,6 +189,32 @@ namespace ImmersiveAudioBitstream
 		// Variables for managing meta ID and audio ID pools
 		IABMetadataIDType           currentMetaID_;
 		IABAudioDataIDType          currentAudioID_;
+
+		// DLC encoding effort level of DLC elements
+		IABDLCEncodeEffortType      dlcEncodeEffort_;
+
+		// DLC encoding thread pool size, including the calling thread
+		uint32_t                    encodeThreadPoolSize_;
+
+#if __linux__ || __APPLE__
+		// DLC encoding jobs of the frame being encoded. Access under encodeMutex_.
+		std::vector<DLCEncodeJob>   dlcEncodeJobs_;
+
+		// Next job to be claimed, and jobs not yet completed. Access under encodeMutex_.
+		uint32_t                    nextDLCEncodeJob_;
+		uint32_t                    pendingDLCEncodeJobs_;
+
+		// True when encoder worker threads should exit. Access under encodeMutex_.
+		bool                        doTerminateEncode_;
+
+		// Synchronisation of the above state between worker threads and caller
+		IABMutex                    encodeMutex_;
+		IABMutex::IABCondition      encodeJobsAvailable_;
+		IABMutex::IABCondition      encodeJobsDone_;
+
+		// Encoder worker threads. The calling thread is the remaining member of the pool.
+		std::vector<pthread_t>      encodeThreads_;
+#endif // __linux__ || __APPLE__
 	};
 
 } // namespace ImmersiveAudioBitstream
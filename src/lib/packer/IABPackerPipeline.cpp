@@ -0,0 +1,404 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+
+#if __linux__ || __APPLE__
+
+#include <sys/time.h>
+
+#include "packer/IABPackerPipeline.h"
+#include "IABUtilities.h"
+
+#define     MIN_PIPELINE_FRAMES_IN_FLIGHT     3			// One frame slot per stage.
+
+namespace SMPTE
+{
+namespace ImmersiveAudioBitstream
+{
+	// Wall clock time for stage statistics, in seconds
+	static double GetPipelineTime()
+	{
+		struct timeval tv;
+		gettimeofday(&tv, NULL);
+		return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1000000.0;
+	}
+
+	// Reader thread entry point
+	static void *PipelineReadThreadWorker(void *iParam)
+	{
+		static_cast<IABPackerPipeline*>(iParam)->ReadFrames();
+		return NULL;
+	}
+
+	// Writer thread entry point
+	static void *PipelineWriteThreadWorker(void *iParam)
+	{
+		static_cast<IABPackerPipeline*>(iParam)->WriteFrames();
+		return NULL;
+	}
+
+    /****************************************************************************
+    *
+    * IABPackerPipeline
+    *
+    *****************************************************************************/
+
+    // Create IABPackerPipeline instance
+	IABPackerPipelineInterface* IABPackerPipelineInterface::Create(IABPackerInterface* iPacker, std::ostream* iOutputStream, uint32_t iEncodeThreadPoolSize, uint32_t iMaxFramesInFlight)
+	{
+		if ((NULL == iPacker) || (NULL == iOutputStream))
+		{
+			return NULL;
+		}
+
+		return new IABPackerPipeline(iPacker, iOutputStream, iEncodeThreadPoolSize, iMaxFramesInFlight);
+	}
+
+    // Deletes an IABPackerPipeline instance
+	void IABPackerPipelineInterface::Delete(IABPackerPipelineInterface* iInstance)
+	{
+		delete iInstance;
+	}
+
+	// Constructor
+	IABPackerPipeline::IABPackerPipeline(IABPackerInterface* iPacker, std::ostream* iOutputStream, uint32_t iEncodeThreadPoolSize, uint32_t iMaxFramesInFlight)
+	{
+		packer_ = iPacker;
+		outputStream_ = iOutputStream;
+		source_ = NULL;
+		encodeThreadPoolSize_ = iEncodeThreadPoolSize;
+		frameCount_ = 0;
+		pipelineError_ = kIABNoError;
+		started_ = false;
+		doTerminate_ = false;
+
+		IABPackerPipelineStageStats noStats = { 0, 0, 0.0, 0.0 };
+		readStats_ = noStats;
+		encodeStats_ = noStats;
+		writeStats_ = noStats;
+
+		slots_.resize(iMaxFramesInFlight < MIN_PIPELINE_FRAMES_IN_FLIGHT ? MIN_PIPELINE_FRAMES_IN_FLIGHT : iMaxFramesInFlight);
+	}
+
+	// Destructor
+	IABPackerPipeline::~IABPackerPipeline()
+	{
+		// Stage threads are joined before Run() returns
+	}
+
+	// IABPackerPipeline::Run() implementation
+	iabError IABPackerPipeline::Run(IABPackerPipelineSourceInterface* iSource, const std::vector<IABAudioDataIDType> &iAudioDataIDs, uint32_t iFrameCount)
+	{
+		if (started_ || (NULL == iSource) || (0 == iFrameCount))
+		{
+			return kIABBadArgumentsError;
+		}
+
+		started_ = true;
+		source_ = iSource;
+		frameCount_ = iFrameCount;
+
+		IABFrameInterface* packerFrame = NULL;
+		iabError errorCode = packer_->GetIABFrame(packerFrame);
+
+		if ((kIABNoError != errorCode) || (NULL == packerFrame))
+		{
+			return kIABPackerGeneralError;
+		}
+
+		IABFrameRateType frameRate;
+		IABSampleRateType sampleRate;
+		packerFrame->GetFrameRate(frameRate);
+		packerFrame->GetSampleRate(sampleRate);
+
+		uint32_t frameSampleCount = GetIABNumFrameSamples(frameRate, sampleRate);
+
+		if (0 == frameSampleCount)
+		{
+			return kIABBadArgumentsError;
+		}
+
+		errorCode = packer_->SetDLCEncodeThreadPoolSize(encodeThreadPoolSize_);
+
+		if (kIABNoError != errorCode)
+		{
+			return errorCode;
+		}
+
+		// Sample buffers are allocated once per slot. Maps must not change once threads are created.
+		for (uint32_t i = 0; i < slots_.size(); i++)
+		{
+			PipelineFrameSlot &slot = slots_[i];
+			slot.samples_.assign(iAudioDataIDs.size(), std::vector<int32_t>(frameSampleCount, 0));
+			slot.audioSources_.clear();
+
+			for (uint32_t j = 0; j < iAudioDataIDs.size(); j++)
+			{
+				slot.audioSources_[iAudioDataIDs[j]] = &slot.samples_[j][0];
+			}
+
+			slot.packedLength_ = 0;
+			slot.errorCode_ = kIABNoError;
+			slot.state_ = PipelineFrameSlot::kSlotFree;
+		}
+
+		pthread_t readThread;
+		pthread_t writeThread;
+
+		if (0 != pthread_create(&readThread, NULL, PipelineReadThreadWorker, (void*) this))
+		{
+			return kIABGeneralError;
+		}
+
+		if (0 != pthread_create(&writeThread, NULL, PipelineWriteThreadWorker, (void*) this))
+		{
+			pipelineMutex_.lock();
+			Terminate(kIABGeneralError);
+			pipelineMutex_.unlock();
+
+			pthread_join(readThread, NULL);
+			return kIABGeneralError;
+		}
+
+		EncodeFrames();
+
+		pthread_join(readThread, NULL);
+		pthread_join(writeThread, NULL);
+
+		pipelineMutex_.lock();
+		errorCode = pipelineError_;
+		pipelineMutex_.unlock();
+
+		return errorCode;
+	}
+
+	// IABPackerPipeline::GetStageStats() implementation
+	void IABPackerPipeline::GetStageStats(IABPackerPipelineStageStats &oReadStats, IABPackerPipelineStageStats &oEncodeStats, IABPackerPipelineStageStats &oWriteStats) const
+	{
+		oReadStats = readStats_;
+		oEncodeStats = encodeStats_;
+		oWriteStats = writeStats_;
+	}
+
+	// IABPackerPipeline::ReadFrames() implementation
+	void IABPackerPipeline::ReadFrames()
+	{
+		for (uint32_t frameNumber = 0; frameNumber < frameCount_; frameNumber++)
+		{
+			PipelineFrameSlot &slot = slots_[frameNumber % slots_.size()];
+
+			pipelineMutex_.lock();
+
+			// Wait for the write stage to release the slot
+			double waitStart = GetPipelineTime();
+
+			while (!doTerminate_ && (PipelineFrameSlot::kSlotFree != slot.state_))
+			{
+				slotFree_.wait(pipelineMutex_);
+			}
+
+			readStats_.waitSeconds_ += GetPipelineTime() - waitStart;
+
+			if (doTerminate_)
+			{
+				pipelineMutex_.unlock();
+				return;
+			}
+
+			pipelineMutex_.unlock();
+
+			// Read, concurrently with the encode and write stages
+			double readStart = GetPipelineTime();
+			iabError errorCode = source_->ReadFrameSamples(frameNumber, slot.audioSources_);
+			readStats_.busySeconds_ += GetPipelineTime() - readStart;
+
+			// Hand over to the encode stage, which reports a read error in frame order
+			pipelineMutex_.lock();
+
+			slot.errorCode_ = errorCode;
+			slot.state_ = PipelineFrameSlot::kSlotRead;
+			readStats_.frames_++;
+			readStats_.bytes_ += static_cast<uint64_t>(slot.samples_.size()) * (slot.samples_.empty() ? 0 : slot.samples_[0].size()) * sizeof(int32_t);
+
+			slotRead_.broadcast();
+			pipelineMutex_.unlock();
+
+			if (kIABNoError != errorCode)
+			{
+				return;
+			}
+		}
+	}
+
+	// IABPackerPipeline::EncodeFrames() implementation
+	iabError IABPackerPipeline::EncodeFrames()
+	{
+		for (uint32_t frameNumber = 0; frameNumber < frameCount_; frameNumber++)
+		{
+			PipelineFrameSlot &slot = slots_[frameNumber % slots_.size()];
+
+			pipelineMutex_.lock();
+
+			// Wait for the read stage to fill the slot
+			double waitStart = GetPipelineTime();
+
+			while (!doTerminate_ && (PipelineFrameSlot::kSlotRead != slot.state_))
+			{
+				slotRead_.wait(pipelineMutex_);
+			}
+
+			encodeStats_.waitSeconds_ += GetPipelineTime() - waitStart;
+
+			if (doTerminate_)
+			{
+				iabError errorCode = pipelineError_;
+				pipelineMutex_.unlock();
+				return errorCode;
+			}
+
+			pipelineMutex_.unlock();
+
+			// Update metadata and pack. DLC elements are encoded on the packer's thread pool.
+			double encodeStart = GetPipelineTime();
+			iabError errorCode = slot.errorCode_;
+
+			if (kIABNoError == errorCode)
+			{
+				errorCode = source_->UpdateFrameMetadata(frameNumber, *packer_);
+			}
+
+			if (kIABNoError == errorCode)
+			{
+				errorCode = packer_->UpdateAudioSamples(slot.audioSources_);
+			}
+
+			if (kIABNoError == errorCode)
+			{
+				errorCode = packer_->PackIABFrame();
+			}
+
+			if (kIABNoError == errorCode)
+			{
+				errorCode = packer_->GetPackedBuffer(slot.packedBuffer_, slot.packedLength_);
+			}
+
+			encodeStats_.busySeconds_ += GetPipelineTime() - encodeStart;
+
+			// Hand over to the write stage
+			pipelineMutex_.lock();
+
+			if (kIABNoError != errorCode)
+			{
+				Terminate(errorCode);
+				pipelineMutex_.unlock();
+				return errorCode;
+			}
+
+			slot.state_ = PipelineFrameSlot::kSlotEncoded;
+			encodeStats_.frames_++;
+			encodeStats_.bytes_ += slot.packedLength_;
+
+			slotEncoded_.broadcast();
+			pipelineMutex_.unlock();
+		}
+
+		return kIABNoError;
+	}
+
+	// IABPackerPipeline::WriteFrames() implementation
+	void IABPackerPipeline::WriteFrames()
+	{
+		for (uint32_t frameNumber = 0; frameNumber < frameCount_; frameNumber++)
+		{
+			PipelineFrameSlot &slot = slots_[frameNumber % slots_.size()];
+
+			pipelineMutex_.lock();
+
+			// Wait for the encode stage to pack the slot
+			double waitStart = GetPipelineTime();
+
+			while (!doTerminate_ && (PipelineFrameSlot::kSlotEncoded != slot.state_))
+			{
+				slotEncoded_.wait(pipelineMutex_);
+			}
+
+			writeStats_.waitSeconds_ += GetPipelineTime() - waitStart;
+
+			if (doTerminate_)
+			{
+				pipelineMutex_.unlock();
+				return;
+			}
+
+			pipelineMutex_.unlock();
+
+			// Write, concurrently with the read and encode stages
+			double writeStart = GetPipelineTime();
+			outputStream_->write(&slot.packedBuffer_[0], slot.packedLength_);
+			bool writeOK = outputStream_->good();
+			writeStats_.busySeconds_ += GetPipelineTime() - writeStart;
+
+			// Release the slot to the read stage
+			pipelineMutex_.lock();
+
+			if (!writeOK)
+			{
+				Terminate(kIABSystemIOError);
+				pipelineMutex_.unlock();
+				return;
+			}
+
+			slot.state_ = PipelineFrameSlot::kSlotFree;
+			writeStats_.frames_++;
+			writeStats_.bytes_ += slot.packedLength_;
+
+			slotFree_.broadcast();
+			pipelineMutex_.unlock();
+		}
+	}
+
+	// IABPackerPipeline::Terminate() implementation
+	void IABPackerPipeline::Terminate(iabError iErrorCode)
+	{
+		if (kIABNoError == pipelineError_)
+		{
+			pipelineError_ = iErrorCode;
+		}
+
+		doTerminate_ = true;
+
+		slotFree_.broadcast();
+		slotRead_.broadcast();
+		slotEncoded_.broadcast();
+	}
+
+} // namespace ImmersiveAudioBitstream
+} // namespace SMPTE
+
+#endif // __linux__ || __APPLE__
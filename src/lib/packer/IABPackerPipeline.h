@@ -0,0 +1,146 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+
+/**
+ * Header file for the streaming IAB Packer pipeline implementation.
+ *
+ * @file
+ */
+
+
+#ifndef __IABPACKERPIPELINE_H__
+#define	__IABPACKERPIPELINE_H__
+
+#if __linux__ || __APPLE__
+
+#include <vector>
+#include <pthread.h>
+
+#include "common/IABMutex.h"
+#include "common/IABElements.h"
+#include "IABPackerAPI.h"
+
+namespace SMPTE
+{
+namespace ImmersiveAudioBitstream
+{
+	/**
+	* Frame slot, owned by one pipeline stage at a time. A stage hands the slot to the next
+	* stage by advancing its state under the pipeline mutex.
+	*
+	*/
+	struct PipelineFrameSlot {
+		enum SlotState { kSlotFree, kSlotRead, kSlotEncoded };
+
+		std::vector<std::vector<int32_t> > samples_;			// frame samples, one buffer per audio ID
+		std::map<IABAudioDataIDType, int32_t*> audioSources_;	// audio IDs mapped to samples_ buffers
+		std::vector<char> packedBuffer_;						// packed frame
+		uint32_t packedLength_;									// packed frame length in bytes
+		iabError errorCode_;									// read or encode result
+		SlotState state_;
+	};
+
+    /**
+     *
+     * Streaming IAB Packer pipeline class. Reads frame samples on a reader thread, packs frames
+     * on the calling thread and writes packed frames on a writer thread, in frame order.
+     *
+     */
+    class IABPackerPipeline : public IABPackerPipelineInterface
+    {
+    public:
+
+		// Constructor
+		IABPackerPipeline(IABPackerInterface* iPacker, std::ostream* iOutputStream, uint32_t iEncodeThreadPoolSize, uint32_t iMaxFramesInFlight);
+
+		// Destructor
+		~IABPackerPipeline();
+
+		// Packs frames [0, iFrameCount) through the read, encode and write stages.
+		iabError Run(IABPackerPipelineSourceInterface* iSource, const std::vector<IABAudioDataIDType> &iAudioDataIDs, uint32_t iFrameCount);
+
+		// Gets throughput statistics of each stage.
+		void GetStageStats(IABPackerPipelineStageStats &oReadStats, IABPackerPipelineStageStats &oEncodeStats, IABPackerPipelineStageStats &oWriteStats) const;
+
+		// Reader thread loop. Reads frame samples into free slots, in frame order.
+		void ReadFrames();
+
+		// Writer thread loop. Writes encoded slots to the output stream, in frame order.
+		void WriteFrames();
+
+    private:
+
+		// Encode stage, on the calling thread. Packs read slots, in frame order.
+		iabError EncodeFrames();
+
+		// Request stage threads to exit and wake them. Called with pipelineMutex_ locked.
+		void Terminate(iabError iErrorCode);
+
+		// Packer, output stream and source, owned by the caller
+		IABPackerInterface* packer_;
+		std::ostream* outputStream_;
+		IABPackerPipelineSourceInterface* source_;
+
+		// DLC encode thread pool size, applied to packer_ in Run()
+		uint32_t encodeThreadPoolSize_;
+
+		// Circular buffer of frame slots. Frame i uses slot (i % size).
+		std::vector<PipelineFrameSlot> slots_;
+
+		// Number of frames to pack
+		uint32_t frameCount_;
+
+		// First error of any stage. Access under pipelineMutex_.
+		iabError pipelineError_;
+
+		// True when Run() has been called
+		bool started_;
+
+		// True when stage threads should exit. Access under pipelineMutex_.
+		bool doTerminate_;
+
+		// Per-stage statistics. Each is updated by its own stage only.
+		IABPackerPipelineStageStats readStats_;
+		IABPackerPipelineStageStats encodeStats_;
+		IABPackerPipelineStageStats writeStats_;
+
+		// Synchronisation of slot states between stages
+		IABMutex pipelineMutex_;
+		IABMutex::IABCondition slotFree_;
+		IABMutex::IABCondition slotRead_;
+		IABMutex::IABCondition slotEncoded_;
+    };
+
+} // namespace ImmersiveAudioBitstream
+} // namespace SMPTE
+
+#endif // __linux__ || __APPLE__
+
+#endif // __IABPACKERPIPELINE_H__
@@ -34,15 +34,19 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <fstream>
 #include <stack>
 #include <vector>
 #include <stdlib.h>
+#include <string.h>
 
 #include "IABDataTypes.h"
 #include "common/IABElements.h"
 #include "IABUtilities.h"
 #include "parser/IABParser.h"
 #include "IABVersion.h"
+#include "commonstream/utils/rawbuf.h"
 
 #define IABParserAPIHighVersion     0
 #define IABParserAPILowVersion      0
@@ -94,6 +98,8 @@ namespace ImmersiveAudioBitstream
 		iabParserFrame_ = nullptr;
 		unAllowedFrameSubElementsCount_ = 0;
         failOnBitstreamVersionError_ = true;
+        parseSkipsDLC96kLayer_ = false;
+		frameIndexStreamLength_ = 0;
 	}
 
 	IABParser::IABParser()
@@ -102,6 +108,8 @@ namespace ImmersiveAudioBitstream
 		iabParserFrame_ = nullptr;
 		unAllowedFrameSubElementsCount_ = 0;
         failOnBitstreamVersionError_ = true;
+        parseSkipsDLC96kLayer_ = false;
+		frameIndexStreamLength_ = 0;
 	}
 
 	IABParser::~IABParser()
@@ -111,6 +119,13 @@ namespace ImmersiveAudioBitstream
 		{
 			IABFrameInterface::Delete(iabParserFrame_);
 		}
+
+		// delete any fed frames not released to caller
+		while (!fedFrames_.empty())
+		{
+			IABFrameInterface::Delete(fedFrames_.front());
+			fedFrames_.pop_front();
+		}
 	}
 
     void IABParser::GetAPIVersion(IABAPIVersionType& oVersion)
@@ -147,6 +162,28 @@ namespace ImmersiveAudioBitstream
         return failOnBitstreamVersionError_;
     }
 
+    // Set parseSkippedElementIDs_
+    void IABParser::SetParseSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs)
+    {
+        parseSkippedElementIDs_ = iElementIDs;
+    }
+
+    const std::set<IABElementIDType>& IABParser::GetParseSkippedElementIDs() const
+    {
+        return parseSkippedElementIDs_;
+    }
+
+    // Set parseSkipsDLC96kLayer_
+    void IABParser::SetParseSkipsDLC96kLayer(bool iSkip96kLayer)
+    {
+        parseSkipsDLC96kLayer_ = iSkip96kLayer;
+    }
+
+    bool IABParser::GetParseSkipsDLC96kLayer() const
+    {
+        return parseSkipsDLC96kLayer_;
+    }
+
     // Parse an IAB frame
     iabError IABParser::ParseIABFrame()
     {
@@ -155,30 +192,47 @@ namespace ImmersiveAudioBitstream
 
 		// Create/"new" IABFrameInterface instance for the frame to be parsed in..
 		// (This sequence forces instance to be created at a different address, though less optimised.)
-		iabParserFrame_ = IABFrameInterface::Create(iabStream_);
-
-		if (nullptr == iabParserFrame_)
-		{
-			return kIABMemoryError;
-		}
+		iabError returnCode = DeSerializeFrame(iabStream_, iabParserFrame_);
 
 		// Now delete the old parsed frame object to avoid memory leak if necessary
 		if (nullptr != olderParsedFrame)
 		{
 			IABFrameInterface::Delete(olderParsedFrame);
 		}
-        
+
+        return returnCode;
+    }
+
+    // Create a frame on iInputStream and parse it
+    iabError IABParser::DeSerializeFrame(std::istream* iInputStream, IABFrameInterface*& oIABFrame)
+    {
+		oIABFrame = IABFrameInterface::Create(iInputStream);
+
+		if (nullptr == oIABFrame)
+		{
+			return kIABMemoryError;
+		}
+
         // Pass failOnBitstreamVersion setting on to the frame interface
-        iabParserFrame_->SetDeSerializeFailsOnVersionError(failOnBitstreamVersionError_);
+        oIABFrame->SetDeSerializeFailsOnVersionError(failOnBitstreamVersionError_);
+
+        // Pass element types to skip on to the frame interface
+        if (!parseSkippedElementIDs_.empty())
+        {
+            oIABFrame->SetDeSerializeSkippedElementIDs(parseSkippedElementIDs_);
+        }
+
+        // Pass DLC 96k layer setting on to the frame interface
+        oIABFrame->SetDeSerializeSkipsDLC96kLayer(parseSkipsDLC96kLayer_);
 
 		// Parse        
         iabError returnCode = kIABNoError;
-        returnCode = iabParserFrame_->DeSerialize();
+        returnCode = oIABFrame->DeSerialize();
 
 		// Update total number of unallowed + undefined frame subelements encountered during parsing
 		// Cumulative over frames.
-		unAllowedFrameSubElementsCount_ += iabParserFrame_->GetNumUnallowedSubElements();
-		unAllowedFrameSubElementsCount_ += iabParserFrame_->GetNumUndefinedSubElements();
+		unAllowedFrameSubElementsCount_ += oIABFrame->GetNumUnallowedSubElements();
+		unAllowedFrameSubElementsCount_ += oIABFrame->GetNumUndefinedSubElements();
 
         return returnCode;
     }
@@ -194,21 +248,477 @@ namespace ImmersiveAudioBitstream
 
 		iabError returnCode = kIABNoError;
 
-		iabStream_ = new std::istringstream(std::string(iIABFrameDataBuffer, iBufferSize));
+		// Parse in place from caller's buffer, without copying the frame data
+		CommonStream::IStreamBufWrapper<char> frameDataBuffer(iIABFrameDataBuffer, iBufferSize);
+		std::istream frameDataStream(&frameDataBuffer);
 
-		if (!iabStream_)
-		{
-			return kIABBadArgumentsError;
-		}
+		iabStream_ = &frameDataStream;
 
 		returnCode = ParseIABFrame();
 
-		delete iabStream_;
 		iabStream_ = NULL;
 
 		return returnCode;
 	}
 
+	// Get length of the IA bitstream frame starting at iData
+	iabError IABParser::GetBitstreamFrameLength(const uint8_t* iData, size_t iSize, size_t &oFrameLength)
+	{
+		size_t iaSubFrameStart = 0;
+		uint32_t subframeLength = 0;
+
+		oFrameLength = 0;
+
+		if (iSize < 1)
+		{
+			return kIABParserEndOfStreamReached;
+		}
+
+		// Optional preamble subframe: 8-bit tag, 32-bit length, payload
+		if (static_cast<uint8_t>(kIABContainerSubFrameTag_Preamble) == iData[0])
+		{
+			if (iSize < 5)
+			{
+				return kIABParserEndOfStreamReached;
+			}
+
+			subframeLength = (static_cast<uint32_t>(iData[1]) << 24) | (static_cast<uint32_t>(iData[2]) << 16) |
+				(static_cast<uint32_t>(iData[3]) << 8) | static_cast<uint32_t>(iData[4]);
+
+			// Preamble and IA subframe header must fit in the feed buffer
+			if (subframeLength > kIABMaxFeedBufferSize - 11)
+			{
+				return kIABParserIASubFrameHeaderError;
+			}
+
+			iaSubFrameStart = 5 + static_cast<size_t>(subframeLength);
+		}
+
+		// IA subframe: 8-bit tag, 32-bit length, followed by the IAFrame element
+		if (iSize < iaSubFrameStart + 6)
+		{
+			return kIABParserEndOfStreamReached;
+		}
+
+		if (static_cast<uint8_t>(kIABContainerSubFrameTag_IAFrame) != iData[iaSubFrameStart])
+		{
+			return kIABParserIASubFrameHeaderError;
+		}
+
+		subframeLength = (static_cast<uint32_t>(iData[iaSubFrameStart + 1]) << 24) | (static_cast<uint32_t>(iData[iaSubFrameStart + 2]) << 16) |
+			(static_cast<uint32_t>(iData[iaSubFrameStart + 3]) << 8) | static_cast<uint32_t>(iData[iaSubFrameStart + 4]);
+
+		// IAFrame element ID is Plex(8) coded, occupying a single byte
+		if ((0 == subframeLength) ||
+			(static_cast<uint8_t>(kIABElementID_IAFrame) != iData[iaSubFrameStart + 5]))
+		{
+			return kIABParserIASubFrameHeaderError;
+		}
+
+		oFrameLength = iaSubFrameStart + 5 + static_cast<size_t>(subframeLength);
+
+		if (oFrameLength > kIABMaxFeedBufferSize)
+		{
+			oFrameLength = 0;
+			return kIABParserIASubFrameHeaderError;
+		}
+
+		if (iSize < oFrameLength)
+		{
+			return kIABParserEndOfStreamReached;
+		}
+
+		return kIABNoError;
+	}
+
+	// Push-mode parsing of a chunk of bitstream data
+	iabError IABParser::Feed(const uint8_t* iData, size_t iSize)
+	{
+		if ((NULL == iData) && (iSize > 0))
+		{
+			return kIABBadArgumentsError;
+		}
+
+		iabError feedError = kIABNoError;
+
+		while (iSize > 0)
+		{
+			// Stage as much of the chunk as fits in the bounded feed buffer.
+			// A partial frame never exceeds kIABMaxFeedBufferSize, so there is always room after extraction below.
+			size_t stagedSize = std::min(iSize, static_cast<size_t>(kIABMaxFeedBufferSize) - feedBuffer_.size());
+			feedBuffer_.insert(feedBuffer_.end(), iData, iData + stagedSize);
+			iData += stagedSize;
+			iSize -= stagedSize;
+
+			size_t consumed = 0;
+
+			while (consumed < feedBuffer_.size())
+			{
+				size_t frameLength = 0;
+				iabError errorCode = GetBitstreamFrameLength(&feedBuffer_[consumed], feedBuffer_.size() - consumed, frameLength);
+
+				if (kIABParserEndOfStreamReached == errorCode)
+				{
+					// Partial frame, wait for more data
+					break;
+				}
+				else if (kIABNoError != errorCode)
+				{
+					// Not in sync, discard a byte and look for a frame start again
+					consumed++;
+					continue;
+				}
+
+				// Complete frame available, parse in place from the feed buffer
+				CommonStream::IStreamBufWrapper<char> frameDataBuffer(reinterpret_cast<char*>(&feedBuffer_[consumed]), static_cast<std::streamsize>(frameLength));
+				std::istream frameDataStream(&frameDataBuffer);
+
+				IABFrameInterface* fedFrame = nullptr;
+				errorCode = DeSerializeFrame(&frameDataStream, fedFrame);
+
+				// Frames with a missing preamble, or with a tolerated version error, are parsed in full. Keep them.
+				if ((kIABNoError == errorCode) ||
+					(kIABParserMissingPreambleError == errorCode) ||
+					(kIABParserInvalidVersionNumberError == errorCode && !failOnBitstreamVersionError_))
+				{
+					fedFrames_.push_back(fedFrame);
+				}
+				else if (nullptr != fedFrame)
+				{
+					IABFrameInterface::Delete(fedFrame);
+				}
+
+				if ((kIABNoError != errorCode) && (kIABNoError == feedError))
+				{
+					feedError = errorCode;
+				}
+
+				consumed += frameLength;
+			}
+
+			// Drop consumed bytes, keeping only the remaining partial frame
+			feedBuffer_.erase(feedBuffer_.begin(), feedBuffer_.begin() + consumed);
+		}
+
+		return feedError;
+	}
+
+	uint32_t IABParser::GetFedFrameCount() const
+	{
+		return static_cast<uint32_t>(fedFrames_.size());
+	}
+
+	iabError IABParser::GetFedFrameReleased(IABFrameInterface*& oIABFrame)
+	{
+		if (!fedFrames_.empty())
+		{
+			oIABFrame = fedFrames_.front();
+			fedFrames_.pop_front();
+			return kIABNoError;
+		}
+
+		oIABFrame = nullptr;
+		return kIABParserNoParsedFrameError;
+	}
+
+	// Identifier at start of a sidecar frame index file
+	static const char kIABFrameIndexFileID[8] = { 'I', 'A', 'B', 'F', 'I', 'D', 'X', '1' };
+
+	// Write iNumBytes of iValue to a frame index file, MSB first
+	static void WriteFrameIndexField(std::ostream &oStream, uint64_t iValue, uint32_t iNumBytes)
+	{
+		for (int32_t i = static_cast<int32_t>(iNumBytes) - 1; i >= 0; i--)
+		{
+			oStream.put(static_cast<char>((iValue >> (8 * i)) & 0xFF));
+		}
+	}
+
+	// Read iNumBytes from a frame index file into oValue, MSB first
+	static bool ReadFrameIndexField(std::istream &iStream, uint64_t &oValue, uint32_t iNumBytes)
+	{
+		oValue = 0;
+
+		for (uint32_t i = 0; i < iNumBytes; i++)
+		{
+			std::istream::int_type byte = iStream.get();
+
+			if (std::istream::traits_type::eof() == byte)
+			{
+				return false;
+			}
+
+			oValue = (oValue << 8) | static_cast<uint8_t>(byte);
+		}
+
+		return true;
+	}
+
+	// Get size in bytes of the input stream
+	iabError IABParser::GetInputStreamLength(uint64_t &oLength) const
+	{
+		oLength = 0;
+
+		if (nullptr == iabStream_)
+		{
+			return kIABParserBitstreamReaderNotPresentError;
+		}
+
+		iabStream_->clear();
+		std::streampos currentPosition = iabStream_->tellg();
+		iabStream_->seekg(0, std::ios_base::end);
+		std::streampos endPosition = iabStream_->tellg();
+		iabStream_->seekg(currentPosition);
+
+		if ((currentPosition < 0) || (endPosition < 0))
+		{
+			iabStream_->clear();
+			return kIABParserFrameIndexError;
+		}
+
+		oLength = static_cast<uint64_t>(endPosition);
+		return kIABNoError;
+	}
+
+	// Build an index of the frames in the input stream
+	iabError IABParser::BuildFrameIndex()
+	{
+		uint64_t streamLength = 0;
+		iabError returnCode = GetInputStreamLength(streamLength);
+
+		if (kIABNoError != returnCode)
+		{
+			return returnCode;
+		}
+
+		frameIndex_.clear();
+		frameIndexStreamLength_ = 0;
+
+		uint64_t frameOffset = 0;
+		uint8_t subframeHeader[5];
+
+		// Walk the stream from subframe header to subframe header, skipping over subframe payloads.
+		// Indexing stops at end of stream, at a truncated frame, or at data that is not a subframe header.
+		while (frameOffset < streamLength)
+		{
+			uint64_t frameSize = 0;
+
+			iabStream_->clear();
+			iabStream_->seekg(static_cast<std::streamoff>(frameOffset));
+			iabStream_->read(reinterpret_cast<char*>(subframeHeader), 5);
+
+			if (iabStream_->gcount() != 5)
+			{
+				break;
+			}
+
+			// Optional preamble subframe: 8-bit tag, 32-bit length, payload
+			if (static_cast<uint8_t>(kIABContainerSubFrameTag_Preamble) == subframeHeader[0])
+			{
+				frameSize = 5 + ((static_cast<uint64_t>(subframeHeader[1]) << 24) | (static_cast<uint64_t>(subframeHeader[2]) << 16) |
+					(static_cast<uint64_t>(subframeHeader[3]) << 8) | static_cast<uint64_t>(subframeHeader[4]));
+
+				iabStream_->seekg(static_cast<std::streamoff>(frameOffset + frameSize));
+				iabStream_->read(reinterpret_cast<char*>(subframeHeader), 5);
+
+				if (iabStream_->gcount() != 5)
+				{
+					break;
+				}
+			}
+
+			// IA subframe: 8-bit tag, 32-bit length, IAFrame element
+			if (static_cast<uint8_t>(kIABContainerSubFrameTag_IAFrame) != subframeHeader[0])
+			{
+				break;
+			}
+
+			uint64_t iaSubframeLength = (static_cast<uint64_t>(subframeHeader[1]) << 24) | (static_cast<uint64_t>(subframeHeader[2]) << 16) |
+				(static_cast<uint64_t>(subframeHeader[3]) << 8) | static_cast<uint64_t>(subframeHeader[4]);
+
+			if (0 == iaSubframeLength)
+			{
+				break;
+			}
+
+			frameSize += 5 + iaSubframeLength;
+
+			if ((frameOffset + frameSize > streamLength) || (frameSize > 0xFFFFFFFF))
+			{
+				break;
+			}
+
+			FrameIndexEntry entry;
+			entry.offset_ = frameOffset;
+			entry.size_ = static_cast<uint32_t>(frameSize);
+			frameIndex_.push_back(entry);
+
+			frameOffset += frameSize;
+		}
+
+		iabStream_->clear();
+		iabStream_->seekg(0);
+
+		if (frameIndex_.empty())
+		{
+			return kIABParserFrameIndexError;
+		}
+
+		frameIndexStreamLength_ = streamLength;
+
+		return SeekToFrame(0);
+	}
+
+	// Save frame index to a sidecar file
+	iabError IABParser::SaveFrameIndex(const std::string &iIndexFilePath) const
+	{
+		if (frameIndex_.empty())
+		{
+			return kIABParserFrameIndexError;
+		}
+
+		std::ofstream indexFile(iIndexFilePath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+
+		if (!indexFile.good())
+		{
+			return kIABSystemIOError;
+		}
+
+		// File layout: identifier, 64-bit stream length, 32-bit frame count,
+		// then per frame a 64-bit offset and 32-bit size. All fields MSB first.
+		indexFile.write(kIABFrameIndexFileID, sizeof(kIABFrameIndexFileID));
+		WriteFrameIndexField(indexFile, frameIndexStreamLength_, 8);
+		WriteFrameIndexField(indexFile, frameIndex_.size(), 4);
+
+		for (std::vector<FrameIndexEntry>::const_iterator iter = frameIndex_.begin(); iter != frameIndex_.end(); iter++)
+		{
+			WriteFrameIndexField(indexFile, iter->offset_, 8);
+			WriteFrameIndexField(indexFile, iter->size_, 4);
+		}
+
+		indexFile.close();
+
+		if (indexFile.fail())
+		{
+			return kIABSystemIOError;
+		}
+
+		return kIABNoError;
+	}
+
+	// Load frame index from a sidecar file
+	iabError IABParser::LoadFrameIndex(const std::string &iIndexFilePath)
+	{
+		uint64_t streamLength = 0;
+		iabError returnCode = GetInputStreamLength(streamLength);
+
+		if (kIABNoError != returnCode)
+		{
+			return returnCode;
+		}
+
+		std::ifstream indexFile(iIndexFilePath.c_str(), std::ios::in | std::ios::binary);
+
+		if (!indexFile.good())
+		{
+			return kIABSystemIOError;
+		}
+
+		char fileID[sizeof(kIABFrameIndexFileID)];
+		uint64_t indexedStreamLength = 0;
+		uint64_t frameCount = 0;
+
+		indexFile.read(fileID, sizeof(fileID));
+
+		if ((indexFile.gcount() != sizeof(fileID)) ||
+			(0 != memcmp(fileID, kIABFrameIndexFileID, sizeof(fileID))) ||
+			!ReadFrameIndexField(indexFile, indexedStreamLength, 8) ||
+			!ReadFrameIndexField(indexFile, frameCount, 4))
+		{
+			return kIABParserFrameIndexError;
+		}
+
+		// Reject a stale index, created for a different version of the bitstream
+		if ((indexedStreamLength != streamLength) || (0 == frameCount))
+		{
+			return kIABParserFrameIndexError;
+		}
+
+		std::vector<FrameIndexEntry> frameIndex;
+		frameIndex.reserve(static_cast<size_t>(frameCount));
+
+		for (uint64_t i = 0; i < frameCount; i++)
+		{
+			uint64_t offset = 0;
+			uint64_t size = 0;
+
+			if (!ReadFrameIndexField(indexFile, offset, 8) ||
+				!ReadFrameIndexField(indexFile, size, 4) ||
+				(0 == size) || (offset + size > streamLength))
+			{
+				return kIABParserFrameIndexError;
+			}
+
+			FrameIndexEntry entry;
+			entry.offset_ = offset;
+			entry.size_ = static_cast<uint32_t>(size);
+			frameIndex.push_back(entry);
+		}
+
+		frameIndex_.swap(frameIndex);
+		frameIndexStreamLength_ = streamLength;
+
+		return kIABNoError;
+	}
+
+	uint32_t IABParser::GetIndexedFrameCount() const
+	{
+		return static_cast<uint32_t>(frameIndex_.size());
+	}
+
+	iabError IABParser::GetIndexedFrameLocation(uint32_t iFrameIndex, uint64_t &oOffset, uint32_t &oSize) const
+	{
+		if (iFrameIndex >= frameIndex_.size())
+		{
+			oOffset = 0;
+			oSize = 0;
+			return kIABBadArgumentsError;
+		}
+
+		oOffset = frameIndex_[iFrameIndex].offset_;
+		oSize = frameIndex_[iFrameIndex].size_;
+
+		return kIABNoError;
+	}
+
+	// Position input stream at start of an indexed frame
+	iabError IABParser::SeekToFrame(uint32_t iFrameIndex)
+	{
+		if (nullptr == iabStream_)
+		{
+			return kIABParserBitstreamReaderNotPresentError;
+		}
+
+		if (frameIndex_.empty())
+		{
+			return kIABParserFrameIndexError;
+		}
+
+		if (iFrameIndex >= frameIndex_.size())
+		{
+			return kIABBadArgumentsError;
+		}
+
+		iabStream_->clear();
+		iabStream_->seekg(static_cast<std::streamoff>(frameIndex_[iFrameIndex].offset_));
+
+		if (iabStream_->fail())
+		{
+			return kIABSystemIOError;
+		}
+
+		return kIABNoError;
+	}
+
 	iabError IABParser::GetIABFrame(const IABFrameInterface*& oIABFrame)
     {
         if (nullptr != iabParserFrame_)
@@ -369,6 +879,7 @@ namespace ImmersiveAudioBitstream
         errorCodeMap[kIABParserIABObjectZone19Error] = "IABParser has encountered an error while parsing a IAB object definition zone19.\n";
         errorCodeMap[kIABParserIABAuthoringToolInfoError] = "IABParser has encountered an error while parsing the authoring tool information element.\n";
         errorCodeMap[kIABParserIABUserDataError] = "IABParser has encountered an error while parsing the user data element.\n";
+        errorCodeMap[kIABParserFrameIndexError] = "IABParser has encountered an error while building, loading or using the bitstream frame index.\n";
 
         // ***********************
         // Validation related error
@@ -37,6 +37,9 @@
 #ifndef __IABPARSER_H__
 #define	__IABPARSER_H__
 
+#include <deque>
+#include <vector>
+
 #include "common/IABElements.h"
 #include "IABParserAPI.h"
 
@@ -98,6 +101,34 @@ namespace ImmersiveAudioBitstream
          * @sa IABParserInterface 
          */
         bool GetParseFailsOnVersionError() const;
+
+        /**
+         * Set element types to be skipped by the Parser.
+         *
+         * @sa IABParserInterface
+         */
+        void SetParseSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs);
+
+        /**
+         * Get element types to be skipped by the Parser.
+         *
+         * @sa IABParserInterface
+         */
+        const std::set<IABElementIDType>& GetParseSkippedElementIDs() const;
+
+        /**
+         * Set whether the Parser skips the 96kHz DLC layer.
+         *
+         * @sa IABParserInterface
+         */
+        void SetParseSkipsDLC96kLayer(bool iSkip96kLayer);
+
+        /**
+         * Get whether the Parser skips the 96kHz DLC layer.
+         *
+         * @sa IABParserInterface
+         */
+        bool GetParseSkipsDLC96kLayer() const;
         
 		/** Parse an IABFrame
          *
@@ -113,6 +144,69 @@ namespace ImmersiveAudioBitstream
 		*/
 		iabError ParseIABFrame(char* iIABFrameDataBuffer, uint32_t iBufferSize);
 
+		/** Push-mode parsing: feed a chunk of bitstream data.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		iabError Feed(const uint8_t* iData, size_t iSize);
+
+		/** Gets number of frames parsed by Feed() and not yet retrieved.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		uint32_t GetFedFrameCount() const;
+
+		/** Get, take over and own the oldest frame parsed by Feed().
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		iabError GetFedFrameReleased(IABFrameInterface*& oIABFrame);
+
+		/** Builds an index of the frames in the input stream.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		iabError BuildFrameIndex();
+
+		/** Saves the frame index to a sidecar file.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		iabError SaveFrameIndex(const std::string &iIndexFilePath) const;
+
+		/** Loads the frame index from a sidecar file.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		iabError LoadFrameIndex(const std::string &iIndexFilePath);
+
+		/** Gets number of frames in the frame index.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		uint32_t GetIndexedFrameCount() const;
+
+		/** Gets byte offset and size of an indexed frame.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		iabError GetIndexedFrameLocation(uint32_t iFrameIndex, uint64_t &oOffset, uint32_t &oSize) const;
+
+		/** Positions the input stream at the start of an indexed frame.
+		*
+		* @sa IABParserInterface
+		*
+		*/
+		iabError SeekToFrame(uint32_t iFrameIndex);
+
         /** Gets a constant reference to IABFrameInterface pointer
          *
          * @sa IABParserInterface
@@ -178,7 +272,26 @@ namespace ImmersiveAudioBitstream
         const std::string& getStringForErrorCode(commonErrorCodes iErrorCode);
 
     private:
-        
+
+        // Location of an IA bitstream frame in the input stream
+        struct FrameIndexEntry
+        {
+            uint64_t offset_;       // byte offset of the frame
+            uint32_t size_;         // frame size in bytes, including preamble and IA subframe header
+        };
+
+        // Get size in bytes of the input stream
+        iabError GetInputStreamLength(uint64_t &oLength) const;
+
+        // Create a frame on iInputStream and parse it, applying parser settings.
+        // oIABFrame is set to the created frame, even if parsing returns an error.
+        iabError DeSerializeFrame(std::istream* iInputStream, IABFrameInterface*& oIABFrame);
+
+        // Get the length of the IA bitstream frame (optional preamble + IA subframe) starting at iData.
+        // Returns kIABParserEndOfStreamReached if more data is needed to determine or hold the frame,
+        // and kIABParserIASubFrameHeaderError if iData is not at the start of a frame.
+        static iabError GetBitstreamFrameLength(const uint8_t* iData, size_t iSize, size_t &oFrameLength);
+
         // GetAudioAsset assoicated with the given audio data ID.
         // The function calls DLC decoder to decode the channel into audioSample.
         iabError GetAudioAssetFromDLC(IABAudioDataIDType iAudioDataID, uint32_t iNumSamples, int32_t *oAudioSamples);
@@ -196,6 +309,24 @@ namespace ImmersiveAudioBitstream
         // When true the parser will fail on a bitstream version error
         bool failOnBitstreamVersionError_;
 
+        // Element types to be skipped (not materialized) when parsing frames
+        std::set<IABElementIDType> parseSkippedElementIDs_;
+
+        // When true, the 96kHz layer of DLC elements is skipped when parsing frames
+        bool parseSkipsDLC96kLayer_;
+
+        // Frame index of the input stream, built by BuildFrameIndex() or loaded by LoadFrameIndex()
+        std::vector<FrameIndexEntry> frameIndex_;
+
+        // Size of the input stream that frameIndex_ applies to
+        uint64_t frameIndexStreamLength_;
+
+        // Staging buffer for Feed(), holding at most one partial bitstream frame
+        std::vector<uint8_t> feedBuffer_;
+
+        // Frames parsed by Feed(), waiting to be released to caller
+        std::deque<IABFrameInterface*> fedFrames_;
+
         // mapping from error codes to human-readable strings
         static std::map<commonErrorCodes, std::string> errorCodeMap_;
 	};
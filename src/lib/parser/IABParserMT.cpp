@@ -0,0 +1,347 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#if __linux__ || __APPLE__
+
+#include <algorithm>
+
+#include "parser/IABParserMT.h"
+
+#define     MAX_PARSER_THREADPOOL_SIZE     8			// Maximum parser threadpool size.
+#define     MIN_PARSER_THREADPOOL_SIZE     1			// Minimum parser threadpool size.
+
+namespace SMPTE
+{
+namespace ImmersiveAudioBitstream
+{
+	// Parser worker thread entry point
+	static void *MTParserThreadWorker(void *iParam)
+	{
+		ParserThreadWorkerParam* myThreadParam = static_cast<ParserThreadWorkerParam*> (iParam);
+		myThreadParam->parserMT_->ParseFrames(*myThreadParam);
+
+		return NULL;
+	}
+
+    /****************************************************************************
+    *
+    * IABParserMT
+    *
+    *****************************************************************************/
+
+    // Create IABParserMT instance
+	IABParserMTInterface* IABParserMTInterface::Create(std::istream* iInputStream, uint32_t iThreadPoolSize, uint32_t iMaxFramesInFlight)
+	{
+		if (NULL == iInputStream)
+		{
+			return NULL;
+		}
+
+		return new IABParserMT(iInputStream, iThreadPoolSize, iMaxFramesInFlight);
+	}
+
+    // Deletes an IABParserMT instance
+	void IABParserMTInterface::Delete(IABParserMTInterface* iInstance)
+	{
+		delete iInstance;
+	}
+
+	// Constructor
+	IABParserMT::IABParserMT(std::istream* iInputStream, uint32_t iThreadPoolSize, uint32_t iMaxFramesInFlight)
+	{
+		iabStream_ = iInputStream;
+		nextFrameToParse_ = 0;
+		nextFrameToDeliver_ = 0;
+		failOnBitstreamVersionError_ = true;
+		parseSkipsDLC96kLayer_ = false;
+		unAllowedFrameSubElementsCount_ = 0;
+		started_ = false;
+		doTerminate_ = false;
+
+		if (iThreadPoolSize < MIN_PARSER_THREADPOOL_SIZE)
+		{
+			threadPoolSize_ = MIN_PARSER_THREADPOOL_SIZE;
+		}
+		else if (iThreadPoolSize > MAX_PARSER_THREADPOOL_SIZE)
+		{
+			threadPoolSize_ = MAX_PARSER_THREADPOOL_SIZE;
+		}
+		else
+		{
+			threadPoolSize_ = iThreadPoolSize;
+		}
+
+		// At least one frame in flight per worker thread
+		ParsedFrameSlot emptySlot = { NULL, kIABNoError, 0, false };
+		slots_.resize(std::max(iMaxFramesInFlight, threadPoolSize_), emptySlot);
+	}
+
+	// Destructor
+	IABParserMT::~IABParserMT()
+	{
+		// Stop all running threads
+		jobMutex_.lock();
+		doTerminate_ = true;
+		frameSlotAvailable_.broadcast();
+		jobMutex_.unlock();
+
+		for (uint32_t i = 0; i < threads_.size(); i++)
+		{
+			void* status;
+			if (0 != pthread_join(threads_[i], &status))
+			{
+				// error
+			}
+		}
+
+		for (uint32_t i = 0; i < threadParams_.size(); i++)
+		{
+			delete threadParams_[i].threadParser_;
+		}
+
+		// Delete frames parsed but not delivered
+		for (uint32_t i = 0; i < slots_.size(); i++)
+		{
+			if (slots_[i].frame_)
+			{
+				IABFrameInterface::Delete(slots_[i].frame_);
+			}
+		}
+	}
+
+	void IABParserMT::SetParseFailsOnVersionError(bool iFailOnVersionError)
+	{
+		failOnBitstreamVersionError_ = iFailOnVersionError;
+	}
+
+	void IABParserMT::SetParseSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs)
+	{
+		parseSkippedElementIDs_ = iElementIDs;
+	}
+
+	void IABParserMT::SetParseSkipsDLC96kLayer(bool iSkip96kLayer)
+	{
+		parseSkipsDLC96kLayer_ = iSkip96kLayer;
+	}
+
+	// IABParserMT::Start() implementation
+	iabError IABParserMT::Start(const IABParserInterface &iIndexedParser, uint32_t iStartFrame, uint32_t iFrameCount)
+	{
+		if (started_)
+		{
+			return kIABBadArgumentsError;
+		}
+
+		uint32_t indexedFrameCount = iIndexedParser.GetIndexedFrameCount();
+
+		if (0 == indexedFrameCount)
+		{
+			return kIABParserFrameIndexError;
+		}
+
+		if (iStartFrame >= indexedFrameCount)
+		{
+			return kIABBadArgumentsError;
+		}
+
+		uint32_t endFrame = indexedFrameCount;
+
+		if ((iFrameCount > 0) && (iFrameCount < indexedFrameCount - iStartFrame))
+		{
+			endFrame = iStartFrame + iFrameCount;
+		}
+
+		frames_.resize(endFrame - iStartFrame);
+
+		for (uint32_t i = 0; i < frames_.size(); i++)
+		{
+			iabError errorCode = iIndexedParser.GetIndexedFrameLocation(iStartFrame + i, frames_[i].offset_, frames_[i].size_);
+
+			if (kIABNoError != errorCode)
+			{
+				frames_.clear();
+				return errorCode;
+			}
+		}
+
+		// Each thread parses with its own parser instance. Params must not move once threads are created.
+		threadParams_.resize(threadPoolSize_);
+
+		for (uint32_t i = 0; i < threadPoolSize_; i++)
+		{
+			threadParams_[i].parserMT_ = this;
+			threadParams_[i].threadParser_ = new IABParser();
+			threadParams_[i].threadParser_->SetParseFailsOnVersionError(failOnBitstreamVersionError_);
+			threadParams_[i].threadParser_->SetParseSkippedElementIDs(parseSkippedElementIDs_);
+			threadParams_[i].threadParser_->SetParseSkipsDLC96kLayer(parseSkipsDLC96kLayer_);
+		}
+
+		// Create threadpool
+		for (uint32_t i = 0; i < threadPoolSize_; i++)
+		{
+			pthread_t thread;
+
+			if (0 != pthread_create(&thread, NULL, MTParserThreadWorker, (void*) &threadParams_[i]))
+			{
+				break;
+			}
+
+			threads_.push_back(thread);
+		}
+
+		if (threads_.empty())
+		{
+			return kIABGeneralError;
+		}
+
+		started_ = true;
+
+		return kIABNoError;
+	}
+
+	// IABParserMT::ParseFrames() implementation
+	void IABParserMT::ParseFrames(ParserThreadWorkerParam &iParam)
+	{
+		while (1)
+		{
+			jobMutex_.lock();
+
+			// Wait for a free slot, limiting frames in flight
+			while (!doTerminate_ && (nextFrameToParse_ < frames_.size()) && (nextFrameToParse_ >= nextFrameToDeliver_ + slots_.size()))
+			{
+				frameSlotAvailable_.wait(jobMutex_);
+			}
+
+			if (doTerminate_ || (nextFrameToParse_ >= frames_.size()))
+			{
+				// All frames claimed, or terminating
+				jobMutex_.unlock();
+				return;
+			}
+
+			uint32_t frameNumber = nextFrameToParse_++;
+			uint32_t frameSize = frames_[frameNumber].size_;
+			iabError errorCode = kIABNoError;
+
+			// Read frame data. The input stream is shared, so reading is serialised.
+			iParam.frameBuffer_.resize(frameSize);
+			iabStream_->clear();
+			iabStream_->seekg(static_cast<std::streamoff>(frames_[frameNumber].offset_), std::ios_base::beg);
+			iabStream_->read(&iParam.frameBuffer_[0], frameSize);
+
+			if (static_cast<uint32_t>(iabStream_->gcount()) != frameSize)
+			{
+				// Input stream does not match frame index
+				errorCode = kIABParserFrameIndexError;
+			}
+
+			jobMutex_.unlock();
+
+			// Parse, concurrently with other worker threads
+			IABFrameInterface* parsedFrame = NULL;
+			uint32_t unallowedCount = 0;
+
+			if (kIABNoError == errorCode)
+			{
+				uint32_t unallowedCountBefore = iParam.threadParser_->GetUnallowedFrameSubElementCount();
+				errorCode = iParam.threadParser_->ParseIABFrame(&iParam.frameBuffer_[0], frameSize);
+				unallowedCount = iParam.threadParser_->GetUnallowedFrameSubElementCount() - unallowedCountBefore;
+
+				// Frames with a missing preamble, or with a tolerated version error, are parsed in full. Keep them.
+				if ((kIABNoError == errorCode) ||
+					(kIABParserMissingPreambleError == errorCode) ||
+					(kIABParserInvalidVersionNumberError == errorCode && !failOnBitstreamVersionError_))
+				{
+					iParam.threadParser_->GetIABFrameReleased(parsedFrame);
+				}
+			}
+
+			// Hand over for in order delivery
+			jobMutex_.lock();
+
+			ParsedFrameSlot &slot = slots_[frameNumber % slots_.size()];
+			slot.frame_ = parsedFrame;
+			slot.errorCode_ = errorCode;
+			slot.unallowedCount_ = unallowedCount;
+			slot.ready_ = true;
+
+			frameParsed_.broadcast();
+			jobMutex_.unlock();
+		}
+	}
+
+	// IABParserMT::GetNextIABFrameReleased() implementation
+	iabError IABParserMT::GetNextIABFrameReleased(IABFrameInterface*& oIABFrame)
+	{
+		oIABFrame = NULL;
+
+		if (!started_)
+		{
+			return kIABBadArgumentsError;
+		}
+
+		jobMutex_.lock();
+
+		if (nextFrameToDeliver_ >= frames_.size())
+		{
+			jobMutex_.unlock();
+			return kIABParserEndOfStreamReached;
+		}
+
+		ParsedFrameSlot &slot = slots_[nextFrameToDeliver_ % slots_.size()];
+
+		while (!slot.ready_)
+		{
+			frameParsed_.wait(jobMutex_);
+		}
+
+		oIABFrame = slot.frame_;
+		iabError errorCode = slot.errorCode_;
+		unAllowedFrameSubElementsCount_ += slot.unallowedCount_;
+
+		slot.frame_ = NULL;
+		slot.ready_ = false;
+		nextFrameToDeliver_++;
+
+		// Slot is free for the next frame
+		frameSlotAvailable_.broadcast();
+		jobMutex_.unlock();
+
+		return errorCode;
+	}
+
+	uint32_t IABParserMT::GetUnallowedFrameSubElementCount() const
+	{
+		return unAllowedFrameSubElementsCount_;
+	}
+
+} // namespace ImmersiveAudioBitstream
+} // namespace SMPTE
+
+#endif // __linux__ || __APPLE__
@@ -0,0 +1,167 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+/**
+ * Header file for the multi-threaded IAB Parser implementation.
+ *
+ * @file
+ */
+
+
+#ifndef __IABPARSERMT_H__
+#define	__IABPARSERMT_H__
+
+#if __linux__ || __APPLE__
+
+#include <vector>
+#include <pthread.h>
+
+#include "common/IABMutex.h"
+#include "parser/IABParser.h"
+
+namespace SMPTE
+{
+namespace ImmersiveAudioBitstream
+{
+    class IABParserMT;  // forward declaration
+
+	/**
+	* Struct for passing parameters to parser thread worker function.
+	*
+	*/
+	struct ParserThreadWorkerParam {
+		IABParserMT* parserMT_;				// pointer to the multi-threaded parser
+		IABParser* threadParser_;			// parser instance owned by the thread
+		std::vector<char> frameBuffer_;		// frame data read from the input stream, parsed in place
+	};
+
+	/**
+	* Parse result of a frame, held until delivered in order.
+	*
+	*/
+	struct ParsedFrameSlot {
+		IABFrameInterface* frame_;			// parsed frame, NULL if parsing failed
+		iabError errorCode_;				// parse result
+		uint32_t unallowedCount_;			// unallowed and undefined frame sub-elements in frame
+		bool ready_;						// true when parsing of frame is complete
+	};
+
+    /**
+     *
+     * Multi-threaded IAB Parser class. Parses frames of an indexed IA bitstream on a pool of
+     * worker threads, and delivers them in bitstream order.
+     *
+     */
+    class IABParserMT : public IABParserMTInterface
+    {
+    public:
+
+		// Constructor
+		IABParserMT(std::istream* iInputStream, uint32_t iThreadPoolSize, uint32_t iMaxFramesInFlight);
+
+		// Destructor
+		~IABParserMT();
+
+		// Sets parser behaviour on version error. Applied to worker parsers in Start().
+		void SetParseFailsOnVersionError(bool iFailOnVersionError);
+
+		// Sets element types to skip. Applied to worker parsers in Start().
+		void SetParseSkippedElementIDs(const std::set<IABElementIDType> &iElementIDs);
+
+		// Sets whether the 96kHz DLC layer is skipped. Applied to worker parsers in Start().
+		void SetParseSkipsDLC96kLayer(bool iSkip96kLayer);
+
+		// Starts worker threads on frames [iStartFrame, iStartFrame + iFrameCount) of iIndexedParser's index.
+		iabError Start(const IABParserInterface &iIndexedParser, uint32_t iStartFrame, uint32_t iFrameCount);
+
+		// Gets next frame in bitstream order. Returns parse result of the frame.
+		iabError GetNextIABFrameReleased(IABFrameInterface*& oIABFrame);
+
+		// Gets cumulative unallowed frame sub-element count of delivered frames.
+		uint32_t GetUnallowedFrameSubElementCount() const;
+
+		// Worker thread loop. Claims frames in order, reads and parses them, until all frames
+		// are claimed or termination is requested.
+		void ParseFrames(ParserThreadWorkerParam &iParam);
+
+    private:
+
+		// Frame byte location in the input stream, from the frame index
+		struct FrameLocation
+		{
+			uint64_t offset_;
+			uint32_t size_;
+		};
+
+		// Input stream, shared by worker threads. Access under jobMutex_.
+		std::istream* iabStream_;
+
+		// Frame locations of the frames to parse, in bitstream order
+		std::vector<FrameLocation> frames_;
+
+		// Circular buffer of iMaxFramesInFlight slots. Frame i uses slot (i % size).
+		std::vector<ParsedFrameSlot> slots_;
+
+		// Next frame to be claimed by a worker thread
+		uint32_t nextFrameToParse_;
+
+		// Next frame to be delivered to the caller
+		uint32_t nextFrameToDeliver_;
+
+		// Parser settings, applied to worker parsers
+		bool failOnBitstreamVersionError_;
+		std::set<IABElementIDType> parseSkippedElementIDs_;
+		bool parseSkipsDLC96kLayer_;
+
+		// Cumulative unallowed frame sub-element count of delivered frames
+		uint32_t unAllowedFrameSubElementsCount_;
+
+		// True when worker threads have been started
+		bool started_;
+
+		// True when worker threads should exit
+		bool doTerminate_;
+
+		// Synchronisation of the above state between worker threads and caller
+		IABMutex jobMutex_;
+		IABMutex::IABCondition frameSlotAvailable_;
+		IABMutex::IABCondition frameParsed_;
+
+		// Worker threads and their parameters
+		uint32_t threadPoolSize_;
+		std::vector<pthread_t> threads_;
+		std::vector<ParserThreadWorkerParam> threadParams_;
+    };
+
+} // namespace ImmersiveAudioBitstream
+} // namespace SMPTE
+
+#endif // __linux__ || __APPLE__
+
+#endif // __IABPARSERMT_H__
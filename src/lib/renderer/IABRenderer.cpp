@@ -517,6 +517,44 @@ namespace ImmersiveAudioBitstream
             return kIABNoError;
 		}
 
+		// Decode all DLC elements of the frame up front, in batches, straight to IABSampleType planes
+		IABSampleRateType frameSampleRate;
+		iabFrameToRender_->GetSampleRate(frameSampleRate);
+
+		IABSampleRateType dlcDecodeSampleRate = kIABSampleRate_48000Hz;
+
+		if ((frameSampleRate == kIABSampleRate_96000Hz) && !render96kTo48k_)
+		{
+			dlcDecodeSampleRate = kIABSampleRate_96000Hz;
+		}
+
+		// Only elements referenced by the activated beds and objects are decoded. Alternate beds and
+		// objects for other use cases are skipped.
+		std::set<IABAudioDataIDType> activeAudioDataIDs;
+
+		for (IABElementCountType i = 0; i < subElementCount; i++)
+		{
+			const IABObjectDefinition* objectDefinition = dynamic_cast<const IABObjectDefinition*>(frameSubElements[i]);
+			const IABBedDefinition* bedDefinition = dynamic_cast<const IABBedDefinition*>(frameSubElements[i]);
+
+			if (objectDefinition)
+			{
+				CollectActiveAudioDataIDs(objectDefinition, activeAudioDataIDs);
+			}
+			else if (bedDefinition)
+			{
+				CollectActiveAudioDataIDs(bedDefinition, activeAudioDataIDs);
+			}
+		}
+
+		// Elements that fail to decode get no plane, and are decoded again when referenced, which reports the error
+		IABAudioDataDLC::DecodeAllDLC(*iabFrameToRender_, activeAudioDataIDs, dlcFrameSamples_, dlcDecodeSampleRate);
+
+		if (dlcFrameSamples_.sampleCount_ != numSamplePerRendererOutputChannel_)
+		{
+			dlcFrameSamples_.audioDataIDs_.clear();
+		}
+
 		// *** Render each of the sub-elements as necessary
 		IABElementIDType elementID;
 
@@ -795,8 +833,9 @@ namespace ImmersiveAudioBitstream
             return kIABNoError;
         }
         
-        // Update working audio sample buffer (sampleBufferFloat_) with object audio samples
-        iabReturnCode = UpdateAudioSampleBuffer(audioDataID);
+        // Get object audio samples, decoded in place or into the working audio sample buffer (sampleBufferFloat_)
+        const IABSampleType *assetSamples = NULL;
+        iabReturnCode = UpdateAudioSampleBuffer(audioDataID, assetSamples);
         if (kIABNoError != iabReturnCode)
         {
             // audioData ID not found or no valid sample pointer
@@ -840,7 +879,7 @@ namespace ImmersiveAudioBitstream
         IABRenderedOutputSampleCountType returnedSampleCount = 0;   // Use this to accumulate total samples rendereed
 
 		// Sub block input and output PCM buffer pointers
-		IABSampleType *inputAssetSamples = NULL;
+		const IABSampleType *inputAssetSamples = NULL;
 
         // Render each panblock
         for (uint32_t i = 0; i < numSubBlocks; i++)
@@ -848,7 +887,7 @@ namespace ImmersiveAudioBitstream
 			subBlockSampleCount = subBlockSampleCount_[i];
 
 			// Update PCM input and output buffer pointers per sub block index
-			inputAssetSamples = sampleBufferFloat_ + subBlockSampleStartOffset_[i];
+			inputAssetSamples = assetSamples + subBlockSampleStartOffset_[i];
 
 			for (uint32_t j = 0; j < iOutputChannelCount; j++)
 			{
@@ -881,7 +920,7 @@ namespace ImmersiveAudioBitstream
 	// IABRenderer::RenderIABObjectSubBlock() implementation
     iabError IABRenderer::RenderIABObjectSubBlock(const IABObjectSubBlockInterface& iIABObjectSubBlock
                                                   , IABVBAP::vbapRendererObject  *iVbapObject
-                                                  , IABSampleType *iAssetSamples
+                                                  , const IABSampleType *iAssetSamples
                                                   , IABSampleType **oOutputChannels
                                                   , IABRenderedOutputChannelCountType iOutputChannelCount
                                                   , IABRenderedOutputSampleCountType iOutputSampleBufferCount
@@ -1315,15 +1354,14 @@ namespace ImmersiveAudioBitstream
                 continue;
             }
             
-            // Update working audio sample buffer (sampleBufferFloat_) with bed channel audio samples
-            iabReturnCode = UpdateAudioSampleBuffer(audioDataID);
+            // Get bed channel audio samples, decoded in place or into the working audio sample buffer (sampleBufferFloat_)
+            const IABSampleType *pAssetSamples = NULL;
+            iabReturnCode = UpdateAudioSampleBuffer(audioDataID, pAssetSamples);
             if (kIABNoError != iabReturnCode)
             {
                 // audioData ID not found or no valid sample pointer
                 return iabReturnCode;
             }
-            
-            IABSampleType *pAssetSamples = sampleBufferFloat_;
 
 			iabReturnCode = RenderIABChannel(**iterBedChannel
 				, pAssetSamples
@@ -1408,9 +1446,89 @@ namespace ImmersiveAudioBitstream
 		}
 	}
 
+	// IABRenderer::CollectActiveAudioDataIDs() implementation, for objects
+	void IABRenderer::CollectActiveAudioDataIDs(const IABObjectDefinition* iIABObject, std::set<IABAudioDataIDType> &oAudioDataIDs) const
+	{
+		if (!iIABObject || !IsObjectActivatedForRendering(iIABObject))
+		{
+			return;
+		}
+
+		// An activated sub-object is rendered in place of its parent
+		std::vector<IABElement*> objectSubElements;
+		iIABObject->GetSubElements(objectSubElements);
+
+		for (std::vector<IABElement*>::const_iterator iter = objectSubElements.begin(); iter != objectSubElements.end(); iter++)
+		{
+			const IABObjectDefinition* subObject = dynamic_cast<const IABObjectDefinition*>(*iter);
+
+			if (subObject && IsObjectActivatedForRendering(subObject))
+			{
+				CollectActiveAudioDataIDs(subObject, oAudioDataIDs);
+				return;
+			}
+		}
+
+		IABAudioDataIDType audioDataID = 0;
+		iIABObject->GetAudioDataID(audioDataID);
+
+		if (audioDataID != 0)
+		{
+			oAudioDataIDs.insert(audioDataID);
+		}
+	}
+
+	// IABRenderer::CollectActiveAudioDataIDs() implementation, for beds
+	void IABRenderer::CollectActiveAudioDataIDs(const IABBedDefinition* iIABBed, std::set<IABAudioDataIDType> &oAudioDataIDs) const
+	{
+		if (!iIABBed || !IsBedActivatedForRendering(iIABBed))
+		{
+			return;
+		}
+
+		// An activated sub-bed is rendered in place of its parent. An activated remap uses the parent's
+		// channels as sources, which are collected below.
+		std::vector<IABElement*> bedSubElements;
+		iIABBed->GetSubElements(bedSubElements);
+
+		for (std::vector<IABElement*>::const_iterator iter = bedSubElements.begin(); iter != bedSubElements.end(); iter++)
+		{
+			const IABBedDefinition* subBed = dynamic_cast<const IABBedDefinition*>(*iter);
+			const IABBedRemap* bedRemap = dynamic_cast<const IABBedRemap*>(*iter);
+
+			if (subBed && IsBedActivatedForRendering(subBed))
+			{
+				CollectActiveAudioDataIDs(subBed, oAudioDataIDs);
+				return;
+			}
+			else if (bedRemap && IsBedRemapActivatedForRendering(bedRemap))
+			{
+				break;
+			}
+		}
+
+		std::vector<IABChannel*> bedChannels;
+		iIABBed->GetBedChannels(bedChannels);
+
+		for (std::vector<IABChannel*>::const_iterator iter = bedChannels.begin(); iter != bedChannels.end(); iter++)
+		{
+			IABAudioDataIDType audioDataID = 0;
+
+			if (*iter)
+			{
+				(*iter)->GetAudioDataID(audioDataID);
+			}
+
+			if (audioDataID != 0)
+			{
+				oAudioDataIDs.insert(audioDataID);
+			}
+		}
+	}
+
 	// IABRenderer::RenderIABChannel() implementation
 	iabError IABRenderer::RenderIABChannel(const IABChannelInterface& iIABChannel
-                                           , IABSampleType *iAssetSamples
+                                           , const IABSampleType *iAssetSamples
                                            , IABSampleType **oOutputChannels
                                            , IABRenderedOutputChannelCountType iOutputChannelCount
                                            , IABRenderedOutputSampleCountType iOutputSampleBufferCount
@@ -1432,7 +1550,7 @@ namespace ImmersiveAudioBitstream
         }
 
         IABChannelIDType channelID;
-        IABSampleType *ptrInputSamples = iAssetSamples;
+        const IABSampleType *ptrInputSamples = iAssetSamples;
 
         // Use bed channel ID to find the corresponding config file speaker label
         std::map<IABChannelIDType, IABRendererBedChannelInfo>::const_iterator iterBedChannelMap;
@@ -1559,7 +1677,7 @@ namespace ImmersiveAudioBitstream
 	// IABRenderer::RenderIABChannelAsObject() implementation
 	iabError IABRenderer::RenderIABChannelAsObject(IABChannelIDType iChannelID
                                                    , float iChannelGain
-                                                   , IABSampleType *iAssetSamples
+                                                   , const IABSampleType *iAssetSamples
                                                    , IABSampleType **oOutputChannels
                                                    , IABRenderedOutputChannelCountType iOutputChannelCount
                                                    , IABRenderedOutputSampleCountType iOutputSampleBufferCount
@@ -1703,7 +1821,7 @@ namespace ImmersiveAudioBitstream
 			, 0.0f);
 
 		// Array of pointers for individual source channel samples
-		float **sourceBufferPointers = new float*[sourceChannelCount];
+		const float **sourceBufferPointers = new const float*[sourceChannelCount];
 		IABAudioDataIDType audioDataID = 0;
 
 		// Pre-fetch source channel gains/scale for later use during remap processing
@@ -1748,9 +1866,9 @@ namespace ImmersiveAudioBitstream
 				continue;
 			}
 
-			// Decode source channel audio samples and save to holding buffer to be used as source 
-			// samples by remap processing below.
-			iabReturnCode = UpdateAudioSampleBuffer(audioDataID, sourceBufferPointers[i]);
+			// Decode source channel audio samples to holding buffer, or use the plane decoded by RenderIABFrame(),
+			// as source samples for remap processing below.
+			iabReturnCode = UpdateAudioSampleBuffer(audioDataID, sourceChannelPCMBuffer + i * iOutputSampleBufferCount, sourceBufferPointers[i]);
 			if (kIABNoError != iabReturnCode)
 			{
 				// DLC audio ID not found or no valid sample pointer
@@ -1928,7 +2046,7 @@ namespace ImmersiveAudioBitstream
 						remapScale = remapGain.getIABGain();
 
 						// jth-source channel buffer. Note to shift by n sub-blocks
-						IABSampleType *srcChannelBuffer = sourceBufferPointers[j] + subBlockSampleStartOffset_[n];
+						const IABSampleType *srcChannelBuffer = sourceBufferPointers[j] + subBlockSampleStartOffset_[n];
 
 						// Apply both remap scale and source channel scale for jth source, in tandem 
 						// and accumulate remapped PCM to output
@@ -2008,7 +2126,7 @@ namespace ImmersiveAudioBitstream
 							remapScale = remapGain.getIABGain();
 
 							// jth-source channel buffer. Note to shift by n sub-blocks
-							IABSampleType *srcChannelBuffer = sourceBufferPointers[j] + subBlockSampleStartOffset_[n];
+							const IABSampleType *srcChannelBuffer = sourceBufferPointers[j] + subBlockSampleStartOffset_[n];
 
 							// Comnine both remap scale and source channel scale for jth source, with downmix coeff. 
 							combinedScale *= (remapScale * sourceChannelScales[j]);
@@ -2059,7 +2177,7 @@ namespace ImmersiveAudioBitstream
 						remapScale = remapGain.getIABGain();
 
 						// jth-source channel buffer. Note to shift by n sub-blocks
-						IABSampleType *srcChannelBuffer = sourceBufferPointers[j] + subBlockSampleStartOffset_[n];
+						const IABSampleType *srcChannelBuffer = sourceBufferPointers[j] + subBlockSampleStartOffset_[n];
 
 						// Apply remap scale and source channel scale for jth source, in tandem.
 						// Mapped PCM output to be sent (copied/overwritten) to tempRemappedPCMBuffer
@@ -2149,21 +2267,30 @@ namespace ImmersiveAudioBitstream
     }
     
     // IABRenderer::UpdateAudioSampleBuffer() implementation
-	iabError IABRenderer::UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID, IABSampleType* iOutputSampleBuffer)
+	iabError IABRenderer::UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID, IABSampleType* iWorkingBuffer, const IABSampleType* &oSamples)
     {
 		iabError errorCode = kIABNoError;
+		oSamples = NULL;
 
         if (iAudioDataID == 0)
         {
             return kIABBadArgumentsError;
         }
         
-        if ((sampleBufferInt_ == NULL) || (iOutputSampleBuffer == NULL))
+        if ((sampleBufferInt_ == NULL) || (iWorkingBuffer == NULL))
         {
             // working integer and float buffers have not been instantiated
             return kIABRendererNotInitialisedError;
         }
 
+        // Samples of DLC elements already decoded by RenderIABFrame() are used in place
+        oSamples = dlcFrameSamples_.GetSamples(iAudioDataID);
+
+        if (oSamples)
+        {
+            return kIABNoError;
+        }
+
         std::vector<IABElement*> frameSubElements;
         std::vector<IABElement*>::const_iterator iterFSE;
         IABAudioDataIDType audioDataID;
@@ -2227,15 +2354,16 @@ namespace ImmersiveAudioBitstream
                             return kIABRendererSampleCountMismatchError;
                         }
                         
-                        // Get audio samples
-                        errorCode = pcmElement->UnpackPCMToMonoSamples(sampleBufferInt_, numSamplePerRendererOutputChannel_);
+                        // Get audio samples, unpacked straight to float
+                        errorCode = pcmElement->UnpackPCMToFloatSamples(iWorkingBuffer, numSamplePerRendererOutputChannel_);
                         
                         if (kIABNoError != errorCode)
                         {
                             return errorCode;
                         }
                         
-                        foundAudioElement = true;
+                        sampleUpdated = true;
+                        break;
                     }                    
                 }
             }
@@ -2244,7 +2372,7 @@ namespace ImmersiveAudioBitstream
             {
                 float scaleFactor = kInt32BitMaxValue;  // scale to 32-bit signed integer range
                 int32_t *decodedSample = sampleBufferInt_;
-                IABSampleType *convertedSample = iOutputSampleBuffer;
+                IABSampleType *convertedSample = iWorkingBuffer;
                 
                 for (uint32_t i = 0; i < numSamplePerRendererOutputChannel_; i++)
                 {
@@ -2258,6 +2386,7 @@ namespace ImmersiveAudioBitstream
 
         if (sampleUpdated)
         {
+            oSamples = iWorkingBuffer;
             return kIABNoError;
         }
         else
@@ -2268,9 +2397,9 @@ namespace ImmersiveAudioBitstream
     }
 
 	// IABRenderer::UpdateAudioSampleBuffer() implementation
-	iabError IABRenderer::UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID)
+	iabError IABRenderer::UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID, const IABSampleType* &oSamples)
 	{
-			return UpdateAudioSampleBuffer(iAudioDataID, sampleBufferFloat_);
+			return UpdateAudioSampleBuffer(iAudioDataID, sampleBufferFloat_, oSamples);
 	}
     
     // IABRenderer::ResetVBAPObject() implementation
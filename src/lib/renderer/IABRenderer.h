@@ -139,7 +139,7 @@ namespace ImmersiveAudioBitstream
         // 
         iabError RenderIABObjectSubBlock(const IABObjectSubBlockInterface& iIABObjectSubBlock
                                          , IABVBAP::vbapRendererObject *iVbapObject
-                                         , IABSampleType *iAssetSamples
+                                         , const IABSampleType *iAssetSamples
                                          , IABSampleType **oOutputChannels
                                          , IABRenderedOutputChannelCountType iOutputChannelCount
                                          , IABRenderedOutputSampleCountType iOutputSampleBufferCount
@@ -174,6 +174,12 @@ namespace ImmersiveAudioBitstream
 		//
 		bool IsBedRemapActivatedForRendering(const IABBedRemap* iIABBedRemap) const;
 
+		// Add the audio data IDs rendered for an object, a bed, or the activated sub-element replacing it,
+		// to oAudioDataIDs. Follows the activation logic of RenderIABObject() and RenderIABBed().
+		//
+		void CollectActiveAudioDataIDs(const IABObjectDefinition* iIABObject, std::set<IABAudioDataIDType> &oAudioDataIDs) const;
+		void CollectActiveAudioDataIDs(const IABBedDefinition* iIABBed, std::set<IABAudioDataIDType> &oAudioDataIDs) const;
+
 		// Renders an IAB (Bed) Channel (iIABChannel) into output channels (oOutputChannels).
         // When the speaker associated with the bed channel is present in the target layout
         // the bed channel will be rendered into the output buffer associated with that speaker.
@@ -184,7 +190,7 @@ namespace ImmersiveAudioBitstream
         // pointed to by "oOutputChannel".
         // 
         iabError RenderIABChannel(const IABChannelInterface& iIABChannel
-                                  , IABSampleType *iAssetSamples
+                                  , const IABSampleType *iAssetSamples
                                   , IABSampleType **oOutputChannels
                                   , IABRenderedOutputChannelCountType iOutputChannelCount
                                   , IABRenderedOutputSampleCountType iOutputSampleBufferCount
@@ -197,7 +203,7 @@ namespace ImmersiveAudioBitstream
         //
         iabError RenderIABChannelAsObject(IABChannelIDType iChannelID
                                           , float iChannelGain
-                                          , IABSampleType *iAssetSamples
+                                          , const IABSampleType *iAssetSamples
                                           , IABSampleType **oOutputChannels
                                           , IABRenderedOutputChannelCountType iOutputChannelCount
                                           , IABRenderedOutputSampleCountType iOutputSampleBufferCount
@@ -238,16 +244,15 @@ namespace ImmersiveAudioBitstream
                                          , IABRenderedOutputSampleCountType iOutputSampleBufferCount
                                          , IABRenderedOutputSampleCountType &oRenderedOutputSampleCount);
 
-        // Update iOutputSampleBuffer contents with audio samples of IABAudioDataDLC or IABAudioDataPCM with iAudioDataID.
-        // The PCM samples are converted to floating-point data and stored in buffer iOutputSampleBuffer.
-        iabError UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID, IABSampleType* iOutputSampleBuffer);
+        // Get audio samples of IABAudioDataDLC or IABAudioDataPCM with iAudioDataID, as floating-point data.
+        // oSamples points to the plane decoded by RenderIABFrame() (dlcFrameSamples_) when there is one, used
+        // in place. Otherwise the samples are decoded or unpacked into iWorkingBuffer and oSamples points to it.
+        iabError UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID, IABSampleType* iWorkingBuffer, const IABSampleType* &oSamples);
         
-		// Similar to above, except that PCM samples are saved to sampleBufferFloat_.
-		// Update audio sample buffer contents with samples of the current object/bed channel being rendered.
-		// Samples are obtained using iAudioDataID, then converted to float and stored in the
-		// working float buffer (sampleBufferFloat_). IABRenderer uses this float buffer
-		// to store audio samples of the object/bed channel being rendered.
-		iabError UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID);
+		// Similar to above, except that the working float buffer (sampleBufferFloat_) is used.
+		// IABRenderer uses this buffer to hold audio samples of the object/bed channel being rendered,
+		// when they are not already decoded.
+		iabError UpdateAudioSampleBuffer(IABAudioDataIDType iAudioDataID, const IABSampleType* &oSamples);
 
 		// Reset vbapObject_ to default state
         // This should be called before using it to render a new object
@@ -391,6 +396,11 @@ namespace ImmersiveAudioBitstream
         // and stored in this float buffer which is used for applying VBAP gains.
         IABSampleType                   *sampleBufferFloat_;
 
+        // Decoded samples of the DLC elements rendered in the frame, decoded once at the start of
+        // RenderIABFrame(). Elements without a plane (failed to decode, or frame sample count mismatch)
+        // are decoded on their own by UpdateAudioSampleBuffer(), which reports the error.
+        IABDLCFrameSamples              dlcFrameSamples_;
+
 		// *** Add support for object decorrelation in binary ON/OFF mode.
 		//
 
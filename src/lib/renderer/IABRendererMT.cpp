@@ -139,9 +139,10 @@ void *MTRenderThreadWorker( void *iParam )
 
 			// Capture error, but current unhandled.
 			// (Ming note: how to handle errors from thread worker is left as future improvement.)
-			iabReturnCode = myAssetDecoder->DecodeIABAsset(
-				job.assetDecodeParam_.iIABAudioDLC_
-				, job.assetDecodeParam_.iOutputSampleBuffer
+			iabReturnCode = myAssetDecoder->DecodeIABAssets(
+				job.assetDecodeParam_.iIABAudioDLCGroup_
+				, job.assetDecodeParam_.iOutputSampleBufferGroup_
+				, job.assetDecodeParam_.iDLCGroupCount_
 				);
 		}
 		else if (job.elementType_ == kIABElementID_AudioDataPCM)
@@ -1061,6 +1062,11 @@ namespace ImmersiveAudioBitstream
 		IABElementIDType elementID;
 		uint32_t assetCount = 0;								// Counting number of asset elements and make it does not exceed 128.
 
+		// DLC elements are queued in groups of up to kIABDLCDecodeGroupSize, for batch decoding
+		QueueJobParam dlcJobParameter = jobParameterCarrier_;
+		dlcJobParameter.elementType_ = kIABElementID_AudioDataDLC;
+		dlcJobParameter.assetDecodeParam_.iDLCGroupCount_ = 0;
+
 		// *****  MT critical section  *****
 
 		// lock mutex for adding entries (asset DLC and PCM elements only) to job queue
@@ -1073,14 +1079,13 @@ namespace ImmersiveAudioBitstream
 
 			frameSubElements[i]->GetElementID(elementID);
 
+			IABAudioDataDLC* dlcElement = NULL;
+
 			if (kIABElementID_AudioDataDLC == elementID)
 			{
-				// Indicate DLC element (important)
-				jobParameterCarrier_.elementType_ = kIABElementID_AudioDataDLC;
-
-				// Set up DLC params
-				jobParameterCarrier_.assetDecodeParam_.iIABAudioDLC_ = (dynamic_cast<IABAudioDataDLC*>(frameSubElements[i]));	// DLC to be decoded
-				jobParameterCarrier_.assetDecodeParam_.iIABAudioDLC_->GetAudioDataID(elementAudioDataID);
+				// DLC to be decoded, added to current DLC group below
+				dlcElement = dynamic_cast<IABAudioDataDLC*>(frameSubElements[i]);
+				dlcElement->GetAudioDataID(elementAudioDataID);
 			}
 			else if (kIABElementID_AudioDataPCM == elementID)
 			{
@@ -1104,10 +1109,28 @@ namespace ImmersiveAudioBitstream
 					return kIABRendererAssetNumberExceedsMax;
 				}
 
-				jobParameterCarrier_.assetDecodeParam_.iOutputSampleBuffer = assetSampleBufferPointers_[assetCount];			// Where to output decoded PCM samples
+				if (dlcElement)
+				{
+					AssetDecoderMTWorkerParam &dlcGroup = dlcJobParameter.assetDecodeParam_;
 
-				// Push to job queue
-				renderJobQueue_.push(jobParameterCarrier_);
+					dlcGroup.iIABAudioDLCGroup_[dlcGroup.iDLCGroupCount_] = dlcElement;
+					dlcGroup.iOutputSampleBufferGroup_[dlcGroup.iDLCGroupCount_] = assetSampleBufferPointers_[assetCount];	// Where to output decoded PCM samples
+					dlcGroup.iDLCGroupCount_++;
+
+					// Push to job queue when group is full
+					if (dlcGroup.iDLCGroupCount_ == kIABDLCDecodeGroupSize)
+					{
+						renderJobQueue_.push(dlcJobParameter);
+						dlcGroup.iDLCGroupCount_ = 0;
+					}
+				}
+				else
+				{
+					jobParameterCarrier_.assetDecodeParam_.iOutputSampleBuffer = assetSampleBufferPointers_[assetCount];		// Where to output decoded PCM samples
+
+					// Push to job queue
+					renderJobQueue_.push(jobParameterCarrier_);
+				}
 
 				// Add to map entry (one of threads to decode assets later)
 				frameAudioDataIDToAssetPointerMap_.insert(std::pair<IABAudioDataIDType, IABSampleType*>(elementAudioDataID, assetSampleBufferPointers_[assetCount]));
@@ -1117,6 +1140,12 @@ namespace ImmersiveAudioBitstream
 			}
 		}
 
+		// Push remaining partial DLC group
+		if (dlcJobParameter.assetDecodeParam_.iDLCGroupCount_ > 0)
+		{
+			renderJobQueue_.push(dlcJobParameter);
+		}
+
 		// Get queue size after adding asset entries
 		currentQueueSize = renderJobQueue_.size();
 
@@ -3575,43 +3604,101 @@ namespace ImmersiveAudioBitstream
 		return kIABNoError;
 	}
 
-	// IABAudioAssetDecoder::DecodeIABAsset() implementation (PCM)
-	iabError IABAudioAssetDecoder::DecodeIABAsset(IABAudioDataPCM* iIABAudioPCM, IABSampleType* iOutputSampleBuffer)
+	// IABAudioAssetDecoder::DecodeIABAssets() implementation (DLC group)
+	iabError IABAudioAssetDecoder::DecodeIABAssets(IABAudioDataDLC* const* iIABAudioDLCs, IABSampleType* const* iOutputSampleBuffers, uint32_t iCount)
 	{
-		iabError errorCode = kIABNoError;
+		iabError returnCode = kIABNoError;
 
-		if (iOutputSampleBuffer == NULL)
+		if (iCount > kIABDLCDecodeGroupSize)
 		{
-			return kIABRendererNotInitialisedError;
+			return kIABBadArgumentsError;
 		}
 
-		// Get frame sample count for checking
-		uint32_t sampleCount = iIABAudioPCM->GetPCMSampleCount();
-		if (sampleCount != frameSampleCount_)
+		for (uint32_t i = 0; i < iCount; i++)
 		{
-			return kIABRendererSampleCountMismatchError;
+			if (iOutputSampleBuffers[i] == NULL)
+			{
+				return kIABRendererNotInitialisedError;
+			}
 		}
 
-		// Get audio samples
-		errorCode = iIABAudioPCM->UnpackPCMToMonoSamplesInternal(frameSampleCount_);
+		// Partition elements by decoding sample rate, then decode each partition as a batch
+		IABAudioDataDLC* decodeGroup48k[kIABDLCDecodeGroupSize];
+		IABAudioDataDLC* decodeGroup96k[kIABDLCDecodeGroupSize];
+		uint32_t count48k = 0;
+		uint32_t count96k = 0;
 
-		if (kIABNoError != errorCode)
+		for (uint32_t i = 0; i < iCount; i++)
 		{
-			return errorCode;
+			IABSampleRateType dlcSampleRate;
+			iIABAudioDLCs[i]->GetDLCSampleRate(dlcSampleRate);
+
+			if (dlcSampleRate == kIABSampleRate_96000Hz && !render96kTo48k_)
+			{
+				decodeGroup96k[count96k++] = iIABAudioDLCs[i];
+			}
+			else
+			{
+				// Includes forced 48k decoding from a 96k DLC element
+				decodeGroup48k[count48k++] = iIABAudioDLCs[i];
+			}
+		}
+
+		if (count48k > 0)
+		{
+			returnCode = IABAudioDataDLC::DecodeDLCToMonoPCMInternal(decodeGroup48k, count48k, frameSampleCount_, kIABSampleRate_48000Hz);
+		}
+
+		if (count96k > 0)
+		{
+			iabError errorCode = IABAudioDataDLC::DecodeDLCToMonoPCMInternal(decodeGroup96k, count96k, frameSampleCount_, kIABSampleRate_96000Hz);
+
+			if (kIABNoError != errorCode)
+			{
+				returnCode = errorCode;
+			}
+		}
+
+		if (kIABNoError != returnCode)
+		{
+			return returnCode;
 		}
 
 		float scaleFactor = kInt32BitMaxValue;											// scale to 32-bit signed integer range
-		int32_t *decodedSample = iIABAudioPCM->GetUnpackedSampleBuffer();
-		IABSampleType *convertedSample = iOutputSampleBuffer;
 
-		for (uint32_t i = 0; i < frameSampleCount_; i++)
+		for (uint32_t i = 0; i < iCount; i++)
 		{
-			*convertedSample++ = static_cast<IABSampleType>(*decodedSample++ / scaleFactor);
+			int32_t *decodedSample = iIABAudioDLCs[i]->GetDecodedSampleBuffer();
+			IABSampleType *convertedSample = iOutputSampleBuffers[i];
+
+			for (uint32_t j = 0; j < frameSampleCount_; j++)
+			{
+				*convertedSample++ = static_cast<IABSampleType>(*decodedSample++ / scaleFactor);
+			}
 		}
 
 		return kIABNoError;
 	}
 
+	// IABAudioAssetDecoder::DecodeIABAsset() implementation (PCM)
+	iabError IABAudioAssetDecoder::DecodeIABAsset(IABAudioDataPCM* iIABAudioPCM, IABSampleType* iOutputSampleBuffer)
+	{
+		if (iOutputSampleBuffer == NULL)
+		{
+			return kIABRendererNotInitialisedError;
+		}
+
+		// Get frame sample count for checking
+		uint32_t sampleCount = iIABAudioPCM->GetPCMSampleCount();
+		if (sampleCount != frameSampleCount_)
+		{
+			return kIABRendererSampleCountMismatchError;
+		}
+
+		// Get audio samples, unpacked straight to float
+		return iIABAudioPCM->UnpackPCMToFloatSamples(iOutputSampleBuffer, frameSampleCount_);
+	}
+
 
 } // namespace ImmersiveAudioBitstream
 } // namespace SMPTE
@@ -50,82 +50,9 @@
 #include "IABConfigTables.h"
 #include "renderer/IABObjectZones/IABObjectZones.h"
 #include "renderer/IABDecorrelation/IABDecorrelation.h"
+#include "common/IABMutex.h"
 
 
-namespace SMPTE
-{
-    namespace ImmersiveAudioBitstream
-    {
-        
-        /**
-         *  Representations of the Mutex and Condition variable classes
-         * for use ny multi threaded IAB renderer entities.
-         *
-         */
-        class IABMutex
-        {
-            
-        public:
-            
-            // Wrapper for pthread_cond_t
-            class IABCondition
-            {
-            public:
-                IABCondition()
-                {
-                    int retval = pthread_cond_init(&condVar_, NULL);
-                    assert(retval == 0);
-                }
-                ~IABCondition()
-                {
-                    int retval = pthread_cond_destroy(&condVar_);
-                    assert(retval == 0);
-                }
-                void signal()
-                {
-                    int retval = pthread_cond_signal(&condVar_);
-                    assert(retval == 0);
-                }
-                void broadcast()
-                {
-                    int retval = pthread_cond_broadcast(&condVar_);
-                    assert(retval == 0);
-                }
-                void wait(IABMutex& mutex)
-                {
-                    int retval = pthread_cond_wait(&condVar_, &mutex.mutex_);
-                    assert(retval == 0);
-                }
-            private:
-                pthread_cond_t condVar_;
-            };
-            
-            IABMutex()
-            {
-                int retval = pthread_mutex_init(&mutex_, NULL);
-                assert(retval == 0);
-            }
-            ~IABMutex()
-            {
-                int retval = pthread_mutex_destroy(&mutex_);
-                assert(retval == 0);
-            }
-            void lock()
-            {
-                int retval = pthread_mutex_lock(&mutex_);
-                assert(retval == 0);
-            }
-            void unlock()
-            {
-                int retval = pthread_mutex_unlock(&mutex_);
-                assert(retval == 0);
-            }
-        private:
-            pthread_mutex_t mutex_;
-        };
-    }
-}
-
  // **************************************************************************
  // MT version of gain processor, without internal gain history save/restore
  //
@@ -294,6 +221,12 @@ namespace ImmersiveAudioBitstream
      */
 	static const uint32_t kIABMaxSubblockSampleCount = 501;
 
+	/**
+	* Maximum number of DLC elements carried by a single asset decoding job. Elements of a
+	* job are decoded together by the DLC batch decoder.
+	*/
+	static const uint32_t kIABDLCDecodeGroupSize = 8;
+
 	/**
 	* Check if an ObjectDefinition element is activated (available) for rendering.
 	* Note, "activated" does not necessarily mean "to be rendered". Other conditions
@@ -1050,6 +983,14 @@ namespace ImmersiveAudioBitstream
 		// 
 		iabError DecodeIABAsset(IABAudioDataDLC* iIABAudioDLC, IABSampleType* iOutputSampleBuffer);
 
+		// Decodes a group of IAB DLC elements, each into its own output sample buffer.
+		// Elements sharing the same decoding sample rate are decoded together.
+		// Note: Caller retains ownership to the DLC element objects after decoding.
+		//
+		// Note: Output sample buffers "iOutputSampleBuffers" will be overwritten with decoded samples.
+		// 
+		iabError DecodeIABAssets(IABAudioDataDLC* const* iIABAudioDLCs, IABSampleType* const* iOutputSampleBuffers, uint32_t iCount);
+
 		// Unpack from an IAB PCM element into output PCM samples (ioOutputChannels).
 		// (An overloading method to DLC decoding).
 		// Note: Caller retains ownership to (*iIABAudioPCM) object after unpacking.
@@ -1075,7 +1016,9 @@ namespace ImmersiveAudioBitstream
 	*
 	*/
 	struct AssetDecoderMTWorkerParam {
-		IABAudioDataDLC* iIABAudioDLC_;								// DLC element to be decoded (either this, or PCM below)
+		IABAudioDataDLC* iIABAudioDLCGroup_[kIABDLCDecodeGroupSize];		// DLC elements to be decoded (either these, or PCM below)
+		IABSampleType* iOutputSampleBufferGroup_[kIABDLCDecodeGroupSize];	// output sample buffers, one per DLC element
+		uint32_t iDLCGroupCount_;									// number of DLC elements in group
 		IABAudioDataPCM* iIABAudioPCM_;								// PCM element to be unpacked (either this, or DLC above)
 		IABSampleType* iOutputSampleBuffer;							// output sample buffer
 	};
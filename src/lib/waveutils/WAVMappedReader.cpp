@@ -0,0 +1,318 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include <cstring>
+#include "waveutils/WAVMappedReader.h"
+#include "waveutils/WaveIO.h"
+#include "commonstream/utils/PCMUtilities.h"
+
+// Little-endian field values of the wav header
+static uint32_t ReadLE16(const unsigned char *iBytes)
+{
+	return static_cast<uint32_t>(iBytes[0]) | (static_cast<uint32_t>(iBytes[1]) << 8);
+}
+
+static uint32_t ReadLE32(const unsigned char *iBytes)
+{
+	return ReadLE16(iBytes) | (ReadLE16(iBytes + 2) << 16);
+}
+
+static uint64_t ReadLE64(const unsigned char *iBytes)
+{
+	return static_cast<uint64_t>(ReadLE32(iBytes)) | (static_cast<uint64_t>(ReadLE32(iBytes + 4)) << 32);
+}
+
+// Converts iCount samples of one channel of interleaved little-endian PCM, iStride bytes apart,
+// to left justified 32-bit integer samples
+template<uint32_t BytesPerSample>
+static void UnpackChannel(int32_t *oSamples, const unsigned char *iSrc, uint32_t iStride, uint32_t iCount)
+{
+	for (uint32_t i = 0; i < iCount; i++)
+	{
+		uint32_t nVal = 0;
+
+		for (uint32_t b = 0; b < BytesPerSample; b++)
+		{
+			nVal |= static_cast<uint32_t>(iSrc[b]) << (8 * (4 - BytesPerSample + b));
+		}
+
+		oSamples[i] = static_cast<int32_t>(nVal);
+		iSrc += iStride;
+	}
+}
+
+WAVMappedReader::WAVMappedReader() : prefetchSize_(kDefaultPrefetchSize), channelCount_(0), sampleRate_(0), bytesPerSample_(0),
+	blockAlign_(0), sampleCount_(0), dataOffset_(0), prefetchedEnd_(0), releasedEnd_(0) {
+
+}
+
+WAVMappedReader::~WAVMappedReader() {
+
+	close();
+}
+
+void WAVMappedReader::setPrefetchSize(uint32_t iPrefetchSize) {
+
+	prefetchSize_ = iPrefetchSize;
+}
+
+int WAVMappedReader::open(const std::string &iFileName) {
+
+	close();
+
+	if (file_.open(iFileName) != CMNSTRM_OK)
+	{
+		return 1;
+	}
+
+	if (parseHeader() != 0)
+	{
+		close();
+		return 1;
+	}
+
+	// Samples are read front to back. Prefetch the first block ahead of the first read.
+	file_.adviseSequential();
+	moveCursor(0);
+
+	return 0;
+}
+
+void WAVMappedReader::close() {
+
+	file_.close();
+
+	channelCount_ = 0;
+	sampleRate_ = 0;
+	bytesPerSample_ = 0;
+	blockAlign_ = 0;
+	sampleCount_ = 0;
+	dataOffset_ = 0;
+	prefetchedEnd_ = 0;
+	releasedEnd_ = 0;
+}
+
+const char *WAVMappedReader::getFrames(uint64_t iFirstFrame, uint32_t iFrameCount, uint32_t &oFrameCount) {
+
+	oFrameCount = 0;
+
+	if (!isOpen() || (iFirstFrame >= sampleCount_))
+	{
+		return NULL;
+	}
+
+	oFrameCount = (sampleCount_ - iFirstFrame < iFrameCount) ? static_cast<uint32_t>(sampleCount_ - iFirstFrame) : iFrameCount;
+
+	moveCursor(iFirstFrame + oFrameCount);
+
+	return file_.data() + dataOffset_ + iFirstFrame * blockAlign_;
+}
+
+uint32_t WAVMappedReader::readSamples(uint32_t iChannel, uint64_t iFirstFrame, int32_t *oSamples, uint32_t iSampleCount) {
+
+	if (!isOpen() || (iChannel >= channelCount_) || (oSamples == NULL) || (iFirstFrame >= sampleCount_))
+	{
+		return 0;
+	}
+
+	uint32_t sampleCount = (sampleCount_ - iFirstFrame < iSampleCount) ? static_cast<uint32_t>(sampleCount_ - iFirstFrame) : iSampleCount;
+	const char *src = file_.data() + dataOffset_ + iFirstFrame * blockAlign_ + iChannel * bytesPerSample_;
+
+	// Mono 16- and 24-bit files, as produced for stems, are contiguous and converted with the vector kernels
+	if ((channelCount_ == 1) && (bytesPerSample_ == 2))
+	{
+		CommonStream::PCM16_LEToInt32(oSamples, src, sampleCount);
+	}
+	else if ((channelCount_ == 1) && (bytesPerSample_ == 3))
+	{
+		CommonStream::PCM24_LEToInt32(oSamples, src, sampleCount);
+	}
+	else
+	{
+		const unsigned char *bytes = reinterpret_cast<const unsigned char*>(src);
+
+		switch (bytesPerSample_)
+		{
+		case 2:
+			UnpackChannel<2>(oSamples, bytes, blockAlign_, sampleCount);
+			break;
+		case 3:
+			UnpackChannel<3>(oSamples, bytes, blockAlign_, sampleCount);
+			break;
+		default:
+			UnpackChannel<4>(oSamples, bytes, blockAlign_, sampleCount);
+			break;
+		}
+	}
+
+	moveCursor(iFirstFrame + sampleCount);
+
+	return sampleCount;
+}
+
+int WAVMappedReader::parseHeader() {
+
+	const unsigned char *data = reinterpret_cast<const unsigned char*>(file_.data());
+	uint64_t fileSize = file_.size();
+
+	if ((fileSize < 12) || (memcmp(data + 8, "WAVE", WAV_HEADER_TAG_SIZE) != 0))
+	{
+		return 1;
+	}
+
+	bool isRF64 = (memcmp(data, "RF64", WAV_HEADER_TAG_SIZE) == 0) || (memcmp(data, "BW64", WAV_HEADER_TAG_SIZE) == 0);
+
+	if (!isRF64 && (memcmp(data, "RIFF", WAV_HEADER_TAG_SIZE) != 0))
+	{
+		return 1;
+	}
+
+	uint64_t ds64DataSize = 0;
+	uint32_t formatTag = 0;
+	uint32_t bitsPerSample = 0;
+	bool hasFormat = false;
+	bool hasData = false;
+	uint64_t dataSize = 0;
+	uint64_t offset = 12;
+
+	// Walk the chunks up to the data chunk
+	while (!hasData && (offset + 8 <= fileSize))
+	{
+		const unsigned char *chunk = data + offset;
+		uint64_t chunkSize = ReadLE32(chunk + 4);
+
+		if (memcmp(chunk, "ds64", WAV_HEADER_TAG_SIZE) == 0)
+		{
+			if ((chunkSize < 24) || (offset + 8 + chunkSize > fileSize))
+			{
+				return 1;
+			}
+
+			ds64DataSize = ReadLE64(chunk + 16);
+		}
+		else if (memcmp(chunk, "fmt ", WAV_HEADER_TAG_SIZE) == 0)
+		{
+			if ((chunkSize < WAV_FMT_CHUNKSIZE) || (offset + 8 + chunkSize > fileSize))
+			{
+				return 1;
+			}
+
+			formatTag = ReadLE16(chunk + 8);
+			channelCount_ = ReadLE16(chunk + 10);
+			sampleRate_ = ReadLE32(chunk + 12);
+			blockAlign_ = ReadLE16(chunk + 20);
+			bitsPerSample = ReadLE16(chunk + 22);
+
+			// Sub format of WAVE_FORMAT_EXTENSIBLE, first 2 bytes of the GUID
+			if ((formatTag == WAVE_FORMAT_EXTENSIBLE) && (chunkSize >= 40))
+			{
+				formatTag = ReadLE16(chunk + 32);
+			}
+
+			hasFormat = true;
+		}
+		else if (memcmp(chunk, "data", WAV_HEADER_TAG_SIZE) == 0)
+		{
+			dataOffset_ = offset + 8;
+			dataSize = chunkSize;
+
+			if (isRF64 && (chunkSize == 0xFFFFFFFF))
+			{
+				dataSize = ds64DataSize;
+			}
+			else if (chunkSize == 0)
+			{
+				// Size not yet patched, assume the data runs to the end of the file
+				dataSize = fileSize - dataOffset_;
+			}
+
+			hasData = true;
+		}
+
+		offset += 8 + chunkSize + (chunkSize & 1);
+	}
+
+	if (!hasFormat || !hasData || (formatTag != WAVE_FORMAT_PCM) || (channelCount_ == 0)
+		|| ((bitsPerSample != 16) && (bitsPerSample != 24) && (bitsPerSample != 32))
+		|| (blockAlign_ != channelCount_ * (bitsPerSample / 8)))
+	{
+		return 1;
+	}
+
+	// Truncated file, read what is there
+	if (dataSize > fileSize - dataOffset_)
+	{
+		dataSize = fileSize - dataOffset_;
+	}
+
+	bytesPerSample_ = bitsPerSample / 8;
+	sampleCount_ = dataSize / blockAlign_;
+
+	return 0;
+}
+
+void WAVMappedReader::moveCursor(uint64_t iFrame) {
+
+	if (prefetchSize_ == 0)
+	{
+		return;
+	}
+
+	uint64_t cursor = iFrame * blockAlign_;
+	uint64_t dataSize = sampleCount_ * blockAlign_;
+
+	// Moved back into released pages, start over from the cursor
+	if (cursor < releasedEnd_)
+	{
+		releasedEnd_ = cursor;
+		prefetchedEnd_ = cursor;
+	}
+
+	// Prefetch the next block once less than half of the prefetch distance is left
+	if ((prefetchedEnd_ < dataSize) && (prefetchedEnd_ < cursor + prefetchSize_ / 2))
+	{
+		uint64_t start = (prefetchedEnd_ > cursor) ? prefetchedEnd_ : cursor;
+		uint64_t end = (cursor + prefetchSize_ < dataSize) ? (cursor + prefetchSize_) : dataSize;
+
+		if (end > start)
+		{
+			file_.prefetch(dataOffset_ + start, end - start);
+			prefetchedEnd_ = end;
+		}
+	}
+
+	// Release pages more than the prefetch distance behind the cursor, a block at a time
+	if (cursor >= releasedEnd_ + 2 * static_cast<uint64_t>(prefetchSize_))
+	{
+		uint64_t end = cursor - prefetchSize_;
+
+		file_.release(dataOffset_ + releasedEnd_, end - releasedEnd_);
+		releasedEnd_ = end;
+	}
+}
@@ -0,0 +1,140 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#ifndef WAVMAPPEDREADER_H_
+#define WAVMAPPEDREADER_H_
+
+#include <string>
+#include <stdint.h>
+
+#include "commonstream/utils/MappedFile.h"
+
+/*
+ * Memory mapped PCM wav reader, for ingesting stems into the packer.
+ *
+ * The file is mapped read-only. Sample data can be accessed in place, as views of the interleaved little-endian
+ * samples in the mapping, or converted to 32-bit integer samples on demand. RIFF, RF64 and BW64 files holding
+ * 16-, 24- or 32-bit integer PCM are supported.
+ *
+ * The reader keeps a frame cursor, the end of the frames last accessed. Pages are prefetched ahead of the cursor,
+ * and pages well behind the cursor are released, so that many stems can be read in parallel, frame by frame,
+ * with bounded resident memory and without waiting on page faults.
+ */
+
+class WAVMappedReader {
+
+public:
+
+	// Default distance pages are prefetched ahead of the frame cursor, in bytes
+	static const uint32_t kDefaultPrefetchSize = 1 << 20;
+
+	// Constructor
+
+	WAVMappedReader();
+
+	// Destructor, closes the file
+
+	~WAVMappedReader();
+
+	/**
+	 * Sets the distance pages are prefetched ahead of the frame cursor, in bytes. 0 disables prefetching.
+	 * Pages more than this distance behind the cursor are released.
+	 */
+	void setPrefetchSize(uint32_t iPrefetchSize);
+
+	/**
+	 * Maps a wav file and parses its header.
+	 *
+	 * @param[in] iFileName wav file name.
+	 * @returns 0 if no error, 1 if the file could not be mapped or is not a supported integer PCM wav file.
+	 */
+	int open(const std::string &iFileName);
+
+	// Unmaps the file. Views returned by getFrames() are invalid after this point.
+	void close();
+
+	bool isOpen() const { return file_.is_open(); }
+
+	uint32_t getChannelCount() const { return channelCount_; }
+
+	uint32_t getSampleRate() const { return sampleRate_; }
+
+	uint32_t getBytesPerSample() const { return bytesPerSample_; }
+
+	// Returns number of samples per channel in the file
+	uint64_t getSampleCount() const { return sampleCount_; }
+
+	/**
+	 * Returns a view of up to iFrameCount interleaved sample frames, starting at frame iFirstFrame, in place
+	 * in the mapping. Frames are getChannelCount() * getBytesPerSample() bytes of little-endian PCM.
+	 * Moves the frame cursor to the end of the view.
+	 *
+	 * @param[in] iFirstFrame index of the first frame.
+	 * @param[in] iFrameCount number of frames requested.
+	 * @param[out] oFrameCount number of frames in the view, fewer than requested at the end of the file.
+	 * @returns pointer to the first frame, NULL if iFirstFrame is at or beyond the end of the file.
+	 */
+	const char *getFrames(uint64_t iFirstFrame, uint32_t iFrameCount, uint32_t &oFrameCount);
+
+	/**
+	 * Converts up to iSampleCount samples of one channel, starting at frame iFirstFrame, to 32-bit integer
+	 * samples. Samples are left justified, as WAVFile reads them. Moves the frame cursor past the samples read.
+	 *
+	 * @param[in] iChannel index of the channel.
+	 * @param[in] iFirstFrame index of the first frame.
+	 * @param[out] oSamples buffer of iSampleCount samples.
+	 * @param[in] iSampleCount number of samples requested.
+	 * @returns number of samples read, fewer than requested at the end of the file.
+	 */
+	uint32_t readSamples(uint32_t iChannel, uint64_t iFirstFrame, int32_t *oSamples, uint32_t iSampleCount);
+
+private:
+
+	// Parses the RIFF/RF64/BW64 header in the mapping
+	int parseHeader();
+
+	// Moves the frame cursor to iFrame, prefetching ahead of it and releasing pages behind it
+	void moveCursor(uint64_t iFrame);
+
+	WAVMappedReader(const WAVMappedReader&);
+	WAVMappedReader& operator=(const WAVMappedReader&);
+
+	CommonStream::MappedFile	file_;
+	uint32_t				prefetchSize_;
+	uint32_t				channelCount_;
+	uint32_t				sampleRate_;
+	uint32_t				bytesPerSample_;
+	uint32_t				blockAlign_;
+	uint64_t				sampleCount_;
+	uint64_t				dataOffset_;			// File offset of the first sample
+	uint64_t				prefetchedEnd_;			// Data offset up to which pages have been prefetched
+	uint64_t				releasedEnd_;			// Data offset up to which pages have been released
+};
+
+#endif /* WAVMAPPEDREADER_H_ */
@@ -0,0 +1,318 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include <cstring>
+#include "waveutils/WAVStreamWriter.h"
+#include "commonstream/utils/PCMUtilities.h"
+
+// Alignment of sample buffers, in bytes
+#define WAV_STREAM_BUFFER_ALIGNMENT		(4096)
+
+// Frames packed per pass over the channels of an interleaved file, so that the destination stays in cache
+#define WAV_STREAM_PACK_BLOCK_FRAMES	(256)
+
+// Packs iFrameCount sample frames of channels [iFirstChannel, iFirstChannel + iChannelCount), starting at
+// sample iOffset, to little-endian interleaved PCM. The most significant iBytesPerSample bytes of each sample are kept.
+static void PackSampleFrames(char *oDest, uint32_t iBytesPerSample, const int32_t * const *iChannelSamples, uint32_t iFirstChannel,
+                             uint32_t iChannelCount, uint32_t iOffset, uint32_t iFrameCount)
+{
+	uint32_t blockAlign = iChannelCount * iBytesPerSample;
+	uint32_t blockFrames = (iChannelCount == 1) ? iFrameCount : WAV_STREAM_PACK_BLOCK_FRAMES;
+
+	for (uint32_t i = 0; i < iFrameCount; i += blockFrames)
+	{
+		uint32_t frameCount = (iFrameCount - i < blockFrames) ? (iFrameCount - i) : blockFrames;
+
+		for (uint32_t k = 0; k < iChannelCount; k++)
+		{
+			const int *src = iChannelSamples[iFirstChannel + k] + iOffset + i;
+			char *dest = oDest + static_cast<size_t>(i) * blockAlign + k * iBytesPerSample;
+
+			switch (iBytesPerSample)
+			{
+			case 2:
+				CommonStream::Int32ToPCM16_LE(dest, src, frameCount, blockAlign);
+				break;
+			case 3:
+				CommonStream::Int32ToPCM24_LE(dest, src, frameCount, blockAlign);
+				break;
+			default:
+				CommonStream::Int32ToPCM32_LE(dest, src, frameCount, blockAlign);
+				break;
+			}
+		}
+	}
+}
+
+WAVStreamWriter::WAVStreamWriter() : bufferSize_(kDefaultBufferSize), bytesPerSample_(0), headerUpdateInterval_(0),
+	largeFileFormat_(kLargeFileRF64), sampleCount_(0), lastHeaderUpdate_(0) {
+
+}
+
+WAVStreamWriter::~WAVStreamWriter() {
+
+	close();
+}
+
+void WAVStreamWriter::setBufferSize(uint32_t iBufferSize) {
+
+	bufferSize_ = iBufferSize;
+}
+
+void WAVStreamWriter::setHeaderUpdateInterval(uint64_t iSampleCount) {
+
+	headerUpdateInterval_ = iSampleCount;
+}
+
+void WAVStreamWriter::setLargeFileFormat(LargeFileFormat iFormat) {
+
+	largeFileFormat_ = iFormat;
+}
+
+int WAVStreamWriter::open(const std::vector<std::string> &iFileNames, FileLayout iLayout, uint32_t iChannelCount,
+                          uint32_t iSampleRate, uint32_t iBytesPerSample, const BEXT_data *iBextData) {
+
+	if (isOpen() || (iChannelCount == 0) || (iBytesPerSample < 2) || (iBytesPerSample > 4))
+	{
+		return 1;
+	}
+
+	uint32_t fileCount = (iLayout == kInterleavedFile) ? 1 : iChannelCount;
+	uint32_t channelsPerFile = (iLayout == kInterleavedFile) ? iChannelCount : MONO_CHANNEL;
+
+	// wav header holds channel count and block align in 16-bit fields
+	if ((iFileNames.size() != fileCount) || (channelsPerFile * iBytesPerSample > 0xFFFF))
+	{
+		return 1;
+	}
+
+	bytesPerSample_ = iBytesPerSample;
+	sampleCount_ = 0;
+	lastHeaderUpdate_ = 0;
+
+	// Buffer capacity is a whole number of sample frames. Each buffer starts on an alignment boundary of bufferBlock_.
+	uint32_t blockAlign = channelsPerFile * iBytesPerSample;
+	uint32_t bufferCapacity = (bufferSize_ > blockAlign) ? (bufferSize_ - bufferSize_ % blockAlign) : blockAlign;
+	size_t bufferStride = (static_cast<size_t>(bufferCapacity) + WAV_STREAM_BUFFER_ALIGNMENT - 1) & ~static_cast<size_t>(WAV_STREAM_BUFFER_ALIGNMENT - 1);
+
+	bufferBlock_.resize(bufferStride * fileCount + WAV_STREAM_BUFFER_ALIGNMENT);
+	uintptr_t blockAddress = reinterpret_cast<uintptr_t>(&bufferBlock_[0]);
+	size_t alignOffset = (WAV_STREAM_BUFFER_ALIGNMENT - blockAddress % WAV_STREAM_BUFFER_ALIGNMENT) % WAV_STREAM_BUFFER_ALIGNMENT;
+
+	outputFiles_.resize(fileCount);
+
+	for (uint32_t i = 0; i < fileCount; i++)
+	{
+		OutputFile &outputFile = outputFiles_[i];
+
+		outputFile.firstChannel_ = i * channelsPerFile;
+		outputFile.channelCount_ = channelsPerFile;
+		outputFile.buffer_ = &bufferBlock_[alignOffset + i * bufferStride];
+		outputFile.bufferCapacity_ = bufferCapacity;
+
+		WAVFile *pWav = new WAVFile();
+		outputFile.wav_ = pWav;
+		pWav->pFile = new std::fstream(iFileNames[i].c_str(), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+
+		if (!pWav->pFile->good())
+		{
+			release();
+			return 1;
+		}
+
+#if defined(BROADCAST_WAVE)
+		if (iBextData)
+		{
+			pWav->bext_data = *iBextData;
+		}
+#endif
+
+		pWav->reserve_ds64 = (largeFileFormat_ != kLargeFileNone);
+		pWav->is_BW64 = (largeFileFormat_ == kLargeFileBW64);
+
+		pWav->header.fileSize = (uint32_t) WAV_RIFF_HEADER_CHUNKSIZE;
+		pWav->header.dataChunkSize = 0;
+		pWav->header.fmtChunkSize = WAV_FMT_CHUNKSIZE;
+		pWav->header.wFormatTag = WAVE_FORMAT_PCM;
+		pWav->header.nChannels = channelsPerFile;
+		pWav->header.nSamplePerSec = iSampleRate;
+		pWav->header.nAvgBytesPerSec = iSampleRate * blockAlign;
+		pWav->header.nBlockAlign = blockAlign;
+		pWav->header.nBitsPerSample = iBytesPerSample * 8;
+		pWav->header.cbSize = 0;
+		pWav->header.wValidBitsPerSample = iBytesPerSample * 8;
+		pWav->header.dwChannelMask = 0;
+
+		pWav->writeWavHeader();
+
+		// Header size depends on the chunks written, set sizes of the empty file
+		pWav->setDataSize(0);
+
+		outputFile.dataStart_ = pWav->dataChunkOffset;
+
+		if ((updateHeader(outputFile) != 0) || pWav->pFile->fail())
+		{
+			release();
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int WAVStreamWriter::writeSamples(const int32_t * const *iChannelSamples, uint32_t iSampleCount) {
+
+	if (!isOpen())
+	{
+		return 1;
+	}
+
+	for (std::vector<OutputFile>::iterator iter = outputFiles_.begin(); iter != outputFiles_.end(); iter++)
+	{
+		uint32_t blockAlign = iter->channelCount_ * bytesPerSample_;
+		uint32_t written = 0;
+
+		while (written < iSampleCount)
+		{
+			uint32_t frameCount = (iter->bufferCapacity_ - iter->bufferFill_) / blockAlign;
+
+			if (frameCount == 0)
+			{
+				if (writeBuffer(*iter) != 0)
+				{
+					return 1;
+				}
+
+				continue;
+			}
+
+			if (frameCount > iSampleCount - written)
+			{
+				frameCount = iSampleCount - written;
+			}
+
+			char *dest = iter->buffer_ + iter->bufferFill_;
+
+			PackSampleFrames(dest, bytesPerSample_, iChannelSamples, iter->firstChannel_, iter->channelCount_, written, frameCount);
+
+			iter->bufferFill_ += frameCount * blockAlign;
+			written += frameCount;
+		}
+	}
+
+	sampleCount_ += iSampleCount;
+
+	if ((headerUpdateInterval_ > 0) && (sampleCount_ - lastHeaderUpdate_ >= headerUpdateInterval_))
+	{
+		return flush();
+	}
+
+	return 0;
+}
+
+int WAVStreamWriter::flush() {
+
+	int error = 0;
+
+	for (std::vector<OutputFile>::iterator iter = outputFiles_.begin(); iter != outputFiles_.end(); iter++)
+	{
+		if ((writeBuffer(*iter) != 0) || (updateHeader(*iter) != 0))
+		{
+			error = 1;
+		}
+	}
+
+	lastHeaderUpdate_ = sampleCount_;
+
+	return error;
+}
+
+int WAVStreamWriter::close() {
+
+	if (!isOpen())
+	{
+		return 0;
+	}
+
+	int error = flush();
+
+	for (std::vector<OutputFile>::iterator iter = outputFiles_.begin(); iter != outputFiles_.end(); iter++)
+	{
+		iter->wav_->pFile->close();
+
+		if (iter->wav_->pFile->fail())
+		{
+			error = 1;
+		}
+	}
+
+	release();
+
+	return error;
+}
+
+int WAVStreamWriter::writeBuffer(OutputFile &ioFile) {
+
+	if (ioFile.bufferFill_ > 0)
+	{
+		ioFile.wav_->pFile->write(ioFile.buffer_, ioFile.bufferFill_);
+		ioFile.dataSize_ += ioFile.bufferFill_;
+		ioFile.bufferFill_ = 0;
+	}
+
+	return ioFile.wav_->pFile->fail() ? 1 : 0;
+}
+
+int WAVStreamWriter::updateHeader(OutputFile &ioFile) {
+
+	WAVFile *pWav = ioFile.wav_;
+
+	pWav->setDataSize(ioFile.dataSize_);
+	int error = pWav->updateHeader();
+
+	pWav->pFile->seekp(ioFile.dataStart_ + ioFile.dataSize_, std::ios::beg);
+	pWav->pFile->flush();
+
+	return (error || pWav->pFile->fail()) ? 1 : 0;
+}
+
+void WAVStreamWriter::release() {
+
+	for (std::vector<OutputFile>::iterator iter = outputFiles_.begin(); iter != outputFiles_.end(); iter++)
+	{
+		if (iter->wav_)
+		{
+			delete iter->wav_->pFile;
+			delete iter->wav_;
+		}
+	}
+
+	outputFiles_.clear();
+	bufferBlock_.clear();
+}
@@ -0,0 +1,181 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#ifndef WAVSTREAMWRITER_H_
+#define WAVSTREAMWRITER_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "waveutils/WaveIO.h"
+
+/*
+ * Streaming PCM wav writer for multichannel render output.
+ *
+ * Channels are written either to a single interleaved multichannel file, or to one mono file per channel.
+ * Samples are packed into a reusable buffer per file and written in large blocks. Size fields in the
+ * wav headers are patched when the writer is flushed or closed, and optionally at a fixed sample interval,
+ * rather than on every write.
+ *
+ * By default, files are written as RIFF with space reserved for a ds64 chunk, and switch to RF64 (or BW64)
+ * when they grow beyond 4 GB.
+ */
+
+class WAVStreamWriter {
+
+public:
+
+	enum FileLayout
+	{
+		kInterleavedFile,		// All channels interleaved in a single file
+		kPerChannelFiles		// One mono file per channel, in channel order
+	};
+
+	enum LargeFileFormat
+	{
+		kLargeFileNone,			// RIFF only, writes beyond RIFF size limit fail
+		kLargeFileRF64,			// RIFF, switching to RF64 beyond RIFF size limit
+		kLargeFileBW64			// RIFF, switching to BW64 beyond RIFF size limit
+	};
+
+	// Default size of the sample buffer of each output file, in bytes
+	static const uint32_t kDefaultBufferSize = 1 << 20;
+
+	// Constructor
+
+	WAVStreamWriter();
+
+	// Destructor, closes output files
+
+	~WAVStreamWriter();
+
+	/**
+	 * Sets the size of the sample buffer of each output file, in bytes. Effective from the next open().
+	 * The buffer holds at least one sample frame.
+	 */
+	void setBufferSize(uint32_t iBufferSize);
+
+	/**
+	 * Sets the interval, in samples per channel, at which the output files are flushed and
+	 * their headers patched while writing. 0 (default) patches headers at flush() and close() only.
+	 */
+	void setHeaderUpdateInterval(uint64_t iSampleCount);
+
+	/**
+	 * Sets the format used for files larger than 4 GB. Effective from the next open(). Default: kLargeFileRF64.
+	 * Any format other than kLargeFileNone adds a 36-byte JUNK chunk to the header of RIFF files.
+	 */
+	void setLargeFileFormat(LargeFileFormat iFormat);
+
+	/**
+	 * Creates the output files and writes their headers.
+	 *
+	 * @param[in] iFileNames output file names. One name for kInterleavedFile, one name per channel for kPerChannelFiles.
+	 * @param[in] iLayout output file layout.
+	 * @param[in] iChannelCount number of channels to write.
+	 * @param[in] iSampleRate sample rate, in Hz.
+	 * @param[in] iBytesPerSample PCM sample width in bytes, 2, 3 or 4.
+	 * @param[in] iBextData broadcast extension data written to all files. NULL to write an empty bext chunk.
+	 * @returns 0 if no error, 1 if the parameters are invalid or a file could not be created.
+	 */
+	int open(const std::vector<std::string> &iFileNames,
+	         FileLayout iLayout,
+	         uint32_t iChannelCount,
+	         uint32_t iSampleRate,
+	         uint32_t iBytesPerSample,
+	         const BEXT_data *iBextData = NULL);
+
+	/**
+	 * Writes iSampleCount samples of each channel. iChannelSamples holds one pointer per channel, in channel order.
+	 * Samples are 32-bit integers and the most significant iBytesPerSample bytes are written, as WAVFile does.
+	 *
+	 * @returns 0 if no error, 1 if the writer is not open, a file write failed or a file exceeds the size
+	 * limit of its format.
+	 */
+	int writeSamples(const int32_t * const *iChannelSamples, uint32_t iSampleCount);
+
+	/**
+	 * Writes buffered samples to the output files and patches their headers.
+	 *
+	 * @returns 0 if no error, 1 if a file write failed.
+	 */
+	int flush();
+
+	/**
+	 * Flushes and closes the output files. Has no effect if the writer is not open.
+	 *
+	 * @returns 0 if no error, 1 if a file write failed.
+	 */
+	int close();
+
+	bool isOpen() const { return !outputFiles_.empty(); }
+
+	// Returns number of samples per channel written so far
+	uint64_t getSampleCount() const { return sampleCount_; }
+
+private:
+
+	struct OutputFile
+	{
+		OutputFile() : wav_(NULL), firstChannel_(0), channelCount_(0), buffer_(NULL), bufferCapacity_(0), bufferFill_(0), dataStart_(0), dataSize_(0) {}
+
+		WAVFile			*wav_;
+		uint32_t		firstChannel_;		// Index of first channel written to this file
+		uint32_t		channelCount_;		// Number of interleaved channels in this file
+		char			*buffer_;			// Page aligned sample buffer, in bufferBlock_
+		uint32_t		bufferCapacity_;	// Size of buffer_, a whole number of sample frames
+		uint32_t		bufferFill_;		// Bytes in buffer_ not yet written to file
+		long long		dataStart_;			// File offset of the first sample
+		long long		dataSize_;			// Bytes of samples written to file
+	};
+
+	// Writes the content of the sample buffer of ioFile to file
+	int writeBuffer(OutputFile &ioFile);
+
+	// Patches size fields of the header of ioFile, then returns to the end of its data
+	int updateHeader(OutputFile &ioFile);
+
+	// Deletes output files and buffers, without flushing
+	void release();
+
+	WAVStreamWriter(const WAVStreamWriter&);
+	WAVStreamWriter& operator=(const WAVStreamWriter&);
+
+	std::vector<OutputFile>	outputFiles_;
+	std::vector<char>		bufferBlock_;			// Sample buffers of all output files
+	uint32_t				bufferSize_;			// Requested sample buffer size per file
+	uint32_t				bytesPerSample_;
+	uint64_t				headerUpdateInterval_;
+	LargeFileFormat			largeFileFormat_;
+	uint64_t				sampleCount_;
+	uint64_t				lastHeaderUpdate_;		// Value of sampleCount_ at last header update
+};
+
+#endif /* WAVSTREAMWRITER_H_ */
@@ -35,6 +35,7 @@
 #include <iomanip>
 #include <cstring>
 #include "WaveIO.h"
+#include "commonstream/utils/PCMUtilities.h"
 #include <stdint.h>
 
 // Write a 4-byte integer value to file
@@ -104,34 +105,20 @@ void WAVFile::writeWavHeader() {
 		// WAVE tag
 		pFile->write("WAVE", WAV_HEADER_TAG_SIZE);	
 
-		// JUNK tag
-//		pFile->write("JUNK", WAV_HEADER_TAG_SIZE);
-
-		// junk chunk size = 28
-//		writeIntValue(28);
-//		pFile->write((const char *) &tmpData[0], 28);
-
-#if defined(BROADCAST_WAVE)
-
-		// bext chunk ID
-		pFile->write("bext", WAV_HEADER_TAG_SIZE);
-
-		// bext chunk size
-		writeIntValue(WAV_BEXT_CHUNKSIZE);
-
-		// Init 4 fields of broadcast extension chunk data
-		initBextData();
-
-		// Write broadcast extension chunk data
-		writeBextChunk();
-
-#endif						// if defined(BROADCAST_WAVE)
+		if (reserve_ds64)
+		{
+			// JUNK tag, replaced by ds64 if the file grows beyond RIFF limit
+			pFile->write("JUNK", WAV_HEADER_TAG_SIZE);
 
+			// junk chunk size = 28
+			writeIntValue(WAV_DS64_CHUNKSIZE);
+			pFile->write((const char *) &tmpData[0], WAV_DS64_CHUNKSIZE);
+		}
 	}
 	else
 	{
 		// ckID
-		pFile->write("RF64", WAV_HEADER_TAG_SIZE);
+		pFile->write(is_BW64 ? "BW64" : "RF64", WAV_HEADER_TAG_SIZE);
 
 		// chunksize = -1
 		writeIntValue(-1);
@@ -139,16 +126,35 @@ void WAVFile::writeWavHeader() {
 		// WAVE tag
 		pFile->write("WAVE", WAV_HEADER_TAG_SIZE);	
 
-		// JUNK tag
+		// ds64 tag
 		pFile->write("ds64", WAV_HEADER_TAG_SIZE);
 
 		// ds64 chunk size = 28
-		writeIntValue(28);
+		writeIntValue(WAV_DS64_CHUNKSIZE);
 		writeInt64Value(fileSize);
 		writeInt64Value(dataSize);
-		pFile->write((const char *) &tmpData[0], 12);
+		writeInt64Value((header.nBlockAlign > 0) ? (dataSize / header.nBlockAlign) : 0);
+
+		// table length
+		writeIntValue(0);
 	}
 
+#if defined(BROADCAST_WAVE)
+
+	// bext chunk ID
+	pFile->write("bext", WAV_HEADER_TAG_SIZE);
+
+	// bext chunk size
+	writeIntValue(WAV_BEXT_CHUNKSIZE);
+
+	// Init 4 fields of broadcast extension chunk data
+	initBextData();
+
+	// Write broadcast extension chunk data
+	writeBextChunk();
+
+#endif						// if defined(BROADCAST_WAVE)
+
 	// chunk ID
 	pFile->write("fmt ", WAV_HEADER_TAG_SIZE);	// chunk ID
 
@@ -200,6 +206,9 @@ void WAVFile::writeWavHeader() {
 	// data chunk
 	pFile->write("data", WAV_HEADER_TAG_SIZE);	
 
+	dataChunkSizeOffset = static_cast<long long>(pFile->tellp());
+	dataChunkOffset = dataChunkSizeOffset + 4;
+
 	if (!is_RF64)
 	{
 
@@ -220,7 +229,7 @@ void WAVFile::updateRIFFHeader() {
 		pFile->seekp(WAV_FILE_CHUNKSIZE_OFFSET, std::ios::beg);
 		writeIntValue(header.fileSize);		
 
-		pFile->seekp(WAV_DATA_CHUNKSIZE_OFFSET, std::ios::beg);
+		pFile->seekp(dataChunkSizeOffset, std::ios::beg);
 		writeIntValue(header.dataChunkSize);		
 }
 
@@ -232,6 +241,54 @@ void WAVFile::updateRF64Header() {
 
 		pFile->seekp(WAV_DS64_DATACHUNK_OFFSET, std::ios::beg);
 		writeInt64Value(dataSize);		
+
+		pFile->seekp(WAV_DS64_SAMPLECOUNT_OFFSET, std::ios::beg);
+		writeInt64Value((header.nBlockAlign > 0) ? (dataSize / header.nBlockAlign) : 0);
+}
+
+// set data size and the matching RIFF chunk size (total bytes following the RIFF chunk header)
+void WAVFile::setDataSize(long long iDataSize) {
+
+		dataSize = iDataSize;
+		fileSize = dataChunkOffset - 8 + iDataSize;
+}
+
+// update size fields of RIFF, RF64 or BW64 header
+int WAVFile::updateHeader() {
+
+	if (!is_RF64 && ((fileSize >= WAVEFILE_LIMIT) || (dataSize >= WAVEFILE_LIMIT)))
+	{
+		if (!reserve_ds64)
+		{
+			return 1;
+		}
+
+		// Switch to RF64/BW64: size fields of RIFF header are set to -1, reserved JUNK chunk becomes ds64
+		pFile->seekp(0, std::ios::beg);
+		pFile->write(is_BW64 ? "BW64" : "RF64", WAV_HEADER_TAG_SIZE);
+		writeIntValue(-1);
+
+		pFile->seekp(WAV_DS64_CHUNK_OFFSET, std::ios::beg);
+		pFile->write("ds64", WAV_HEADER_TAG_SIZE);
+
+		pFile->seekp(dataChunkSizeOffset, std::ios::beg);
+		writeIntValue(-1);
+
+		is_RF64 = true;
+	}
+
+	if (is_RF64)
+	{
+		updateRF64Header();
+	}
+	else
+	{
+		header.fileSize = (unsigned int) fileSize;
+		header.dataChunkSize = (unsigned int) dataSize;
+		updateRIFFHeader();
+	}
+
+	return pFile->fail() ? 1 : 0;
 }
 
 // write multi-channel samples to wave file
@@ -239,16 +296,10 @@ int WAVFile::writeSamplesToFile(int numChannels, int *sampleBuffer[], int numSam
 
 	int bytesPerSample;
 	
-	int * ptrCh;
 	char *tempBuf;
 
 	tempBuf = new char[numChannels * numSamples * 4];
 
-	int nVal;
-
-	char *ptrDest = tempBuf;
-	char temp1, temp2, temp3;
-
 	if (header.nBitsPerSample == 24)
 	{
 		bytesPerSample = 3;
@@ -262,31 +313,25 @@ int WAVFile::writeSamplesToFile(int numChannels, int *sampleBuffer[], int numSam
 	}
 
 	// interleave channels
-	for (int j = 0; j < numSamples; j++)	
+	for (int k = 0; k < numChannels; k++)	// channel
 	{
-		for (int k = 0; k < numChannels; k++)	// channel
+		char *ptrDest = tempBuf + k * bytesPerSample;
+		unsigned int stride = numChannels * bytesPerSample;
+
+		if (bytesPerSample == 3)
+		{
+			CommonStream::Int32ToPCM24_LE(ptrDest, sampleBuffer[k], numSamples, stride);
+		}
+		else if (bytesPerSample == 4)
+		{
+			CommonStream::Int32ToPCM32_LE(ptrDest, sampleBuffer[k], numSamples, stride);
+		}
+		else
 		{
-			ptrCh = sampleBuffer[k];
-
-			nVal = *ptrCh++;
-			sampleBuffer[k] = ptrCh;
-
-			temp1 = (nVal >> 24) & 0xFF;
-			temp2 = (nVal >> 16) & 0xFF;
-
-			if (bytesPerSample == 3)
-			{
-				*ptrDest++ = (nVal >> 8) & 0xFF;;
-			}
-			else if (bytesPerSample == 4)
-			{
-				temp3 = (nVal >> 8) & 0xFF;;
-				*ptrDest++ = nVal & 0xFF;;
-				*ptrDest++ = temp3;
-			}
-			*ptrDest++ = temp2;
-			*ptrDest++ = temp1;
+			CommonStream::Int32ToPCM16_LE(ptrDest, sampleBuffer[k], numSamples, stride);
 		}
+
+		sampleBuffer[k] += numSamples;
 	}
 	
 	int nBytes = numChannels * numSamples * bytesPerSample;
@@ -353,8 +398,8 @@ struct wavFileTraits
         bits_ = 0;
         isFloat_ = false;
     }
-    int32_t  audioBegin_;
-    int32_t  audioEnd_;
+    int64_t  audioBegin_;
+    int64_t  audioEnd_;
     uint32_t sampleRate_;
     uint32_t channels_;
     uint32_t bits_;
@@ -398,6 +443,20 @@ typedef struct tagSNDHEAD
     int32_t           chunkSize;
     
 } SNDHEAD; // 8 bytes
+
+#pragma pack(push,2)
+typedef struct tagDS64HEAD
+{
+    int32_t  chunkID;
+    int32_t  chunkSize;
+    
+    uint64_t riffSize;
+    uint64_t dataSize;
+    uint64_t sampleCount;
+    uint32_t tableLength;
+    
+} DS64HEAD; // 36 bytes
+#pragma pack(pop)
 /// \endcond
 
 #define wavhelp_groupID  'FFIR'
@@ -406,6 +465,7 @@ typedef struct tagSNDHEAD
 #define wavhelp_dataID   'atad'
 
 // This is a _very_ simple parser that works best with the standard 44-byte header
+// RF64 and BW64 files are supported, with sizes from the ds64 chunk that must directly follow the file header
 bool ParseBasicWAVHeader(std::fstream& file, wavFileTraits& traits)
 {
     // file must already be opened and good
@@ -429,12 +489,34 @@ bool ParseBasicWAVHeader(std::fstream& file, wavFileTraits& traits)
     
     headsize = file.read(reinterpret_cast<char*>(&iffHead), sizeof(IFFHEAD)).gcount();
     
-    if ( iffHead.group != wavhelp_groupID )
+    // RF64/BW64 IDs are compared as bytes so the check does not depend on multi-character constants
+    bool isRF64 = ( memcmp(&iffHead.group, "RF64", 4) == 0 ) || ( memcmp(&iffHead.group, "BW64", 4) == 0 );
+    
+    if ( iffHead.group != wavhelp_groupID && !isRF64 )
         return 0;
     
     if ( iffHead.riff != wavhelp_riffType )
         return 0;
     
+    // Read 64-bit sizes of RF64/BW64 file, then continue after the ds64 chunk
+    
+    uint64_t ds64DataSize = 0;
+    
+    if ( isRF64 )
+    {
+        DS64HEAD ds64Head;
+        
+        if ( file.read(reinterpret_cast<char*>(&ds64Head), sizeof(DS64HEAD)).gcount() != sizeof(DS64HEAD) )
+            return 0;
+        
+        if ( memcmp(&ds64Head.chunkID, "ds64", 4) != 0 || ds64Head.chunkSize < WAV_DS64_CHUNKSIZE )
+            return 0;
+        
+        ds64DataSize = ds64Head.dataSize;
+        offsettowavehead = chunkheadsize + static_cast<uint32_t>(ds64Head.chunkSize);
+        file.seekg(offsettowavehead + headsize, std::fstream::beg);
+    }
+    
     // Hunt down the wave header
     
     while ( (wavsize = file.read(reinterpret_cast<char*>(&wavHead), chunkheadsize).gcount()) > 0)
@@ -495,19 +577,23 @@ bool ParseBasicWAVHeader(std::fstream& file, wavFileTraits& traits)
     if ( sndHead.chunkID != wavhelp_dataID )
         return 0;
     
-    traits.audioBegin_ = (unsigned int)(headsize+wavsize+sndsize+offsettowavehead + offsettosndhead);
+    traits.audioBegin_ = static_cast<int64_t>(headsize+wavsize+sndsize+offsettowavehead + offsettosndhead);
     
     // Where does the audio data end
     
-    if ( sndHead.chunkSize == 0 )
+    if ( isRF64 && sndHead.chunkSize == -1 )
+    {
+        traits.audioEnd_ = traits.audioBegin_ + static_cast<int64_t>(ds64DataSize);
+    }
+    else if ( sndHead.chunkSize == 0 )
     {
         // Assume there is SOME data based on the file length
         file.seekg(0, std::fstream::end);
-        traits.audioEnd_ = static_cast<int32_t>(file.tellg()) - traits.audioBegin_;
+        traits.audioEnd_ = static_cast<int64_t>(file.tellg());
     }
     else
     {
-        traits.audioEnd_ = traits.audioBegin_ + static_cast<int32_t>(sndHead.chunkSize);
+        traits.audioEnd_ = traits.audioBegin_ + static_cast<uint32_t>(sndHead.chunkSize);
     }
     
     // go to sample 0
@@ -521,16 +607,16 @@ bool ParseBasicWAVHeader(std::fstream& file, wavFileTraits& traits)
     return (traits.audioEnd_-traits.audioBegin_) >= 0 ? true : false;
 }
 
-int WAVFile::readWavHeader() {
+long long WAVFile::readWavHeader() {
 
-    int totalSamplesPerChannel = 0;
+    long long totalSamplesPerChannel = 0;
 
     wavFileTraits traits;
     if (ParseBasicWAVHeader(*pFile, traits))
     {
         if (!traits.isFloat_ && (traits.channels_ == 1) && (traits.bits_ == 24))
         {
-            totalSamplesPerChannel = (traits.audioEnd_ - traits.audioBegin_)/3;
+            totalSamplesPerChannel = static_cast<long long>((traits.audioEnd_ - traits.audioBegin_)/3);
         }
     }
     else
@@ -542,48 +628,6 @@ int WAVFile::readWavHeader() {
     return totalSamplesPerChannel;
 }
 
-void mdaPCM24BEToInt32_LE(int *pDest, char *pSrc, unsigned int pCount) {
-    
-    unsigned int i;
-    
-    unsigned char *lSrc = (unsigned char *) pSrc;
-    
-    for(i = 0; i < pCount; i++)
-    {
-        
-        *pDest  = *(lSrc++) << 8;
-        *pDest |= *(lSrc++) << 16;
-        *pDest |= *(lSrc++) << 24;
-        
-        pDest++;
-        
-    }
-}
-
-static const double div_2147483648_ = 1.0 / 2147483648.0;
-
-static void Int24_To_Float32(void *destinationBuffer,
-                             const void *sourceBuffer,
-                             unsigned int count )
-{
-    unsigned char *src = (unsigned char*)sourceBuffer;
-    float *dest = (float*)destinationBuffer;
-    int temp = 0;
-    
-    while( count-- )
-    {
-        temp = (((unsigned int)src[0]) << 8);
-        temp = temp | (((unsigned int)src[1]) << 16);
-        temp = temp | (((unsigned int)src[2]) << 24);
-        
-        *dest = (float) ((double)temp * div_2147483648_);
-        
-        src += 3;
-        dest += 1;
-    }
-}
-
-
 int WAVFile::readWavSamplesFromFile(int numChannels, float *sampleBuffer, int numSamples)
 {
     int nTotalBytes = numChannels * numSamples * 3;
@@ -599,7 +643,7 @@ int WAVFile::readWavSamplesFromFile(int numChannels, float *sampleBuffer, int nu
     
     int nSamplesRead = ((int) br)/3;
     
-    Int24_To_Float32(sampleBuffer, tempBuf, nSamplesRead);
+    CommonStream::PCM24_LEToFloat(sampleBuffer, tempBuf, nSamplesRead);
     
     delete[] tempBuf;
     
@@ -624,7 +668,7 @@ int WAVFile::readWavSamplesFromFile(int numChannels, int *sampleBuffer, int numS
 
 	int nSamplesRead = ((int) br)/3;
 
-	mdaPCM24BEToInt32_LE(sampleBuffer,tempBuf, nSamplesRead);
+	CommonStream::PCM24_LEToInt32(sampleBuffer, tempBuf, nSamplesRead);
 
 	delete[] tempBuf;
 
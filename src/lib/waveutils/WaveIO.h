@@ -50,8 +50,11 @@
 #define WAV_FMT_CHUNKSIZE			(16)
 #define WAV_BEXT_CHUNKSIZE			(602)
 #define WAV_DATA_CHUNKSIZE_OFFSET	(WAV_RIFF_HEADER_CHUNKSIZE + 4)
+#define WAV_DS64_CHUNK_OFFSET		(12)
+#define WAV_DS64_CHUNKSIZE			(28)
 #define WAV_DS64_FILESIZE_OFFSET	(20)
 #define WAV_DS64_DATACHUNK_OFFSET	(28)
+#define WAV_DS64_SAMPLECOUNT_OFFSET	(36)
 
 #define MONO_CHANNEL				(1)
 #define BITWIDTH_3BYTES				(3)
@@ -79,8 +82,11 @@
 #define WAV_FACT_CHUNKSIZE			(0)
 #define WAV_DATA_CHUNKSIZE_OFFSET	(40)
 //#define WAV_DATA_CHUNKSIZE_OFFSET	(64 + WAV_DS64_SIZE + WAV_FACT_CHUNKSIZE)		// to be updated when additional chunks are supported
+#define WAV_DS64_CHUNK_OFFSET		(12)
+#define WAV_DS64_CHUNKSIZE			(28)
 #define WAV_DS64_FILESIZE_OFFSET	(20)
 #define WAV_DS64_DATACHUNK_OFFSET	(28)
+#define WAV_DS64_SAMPLECOUNT_OFFSET	(36)
 
 #endif								// if defined(BROADCAST_WAVE)
 
@@ -143,6 +149,10 @@ struct BEXT_data {
 
 /*
  * Wav utility class for 48kHz/96kHz, mono 24-bit RIFF/BWF wav file I/O
+ *
+ * Files larger than 4 GB are written as RF64 or BW64, with 64-bit sizes in a ds64 chunk. A RIFF file written with
+ * reserve_ds64 set holds a JUNK chunk in place of the ds64 chunk, and is switched to RF64/BW64 by updateHeader()
+ * once its size no longer fits the RIFF header.
  */
 
 class WAVFile {
@@ -150,8 +160,12 @@ class WAVFile {
 public:
 
 	bool					is_RF64;
+	bool					is_BW64;				// Use BW64 instead of RF64 as file ID of 64-bit files
+	bool					reserve_ds64;			// Reserve space for a ds64 chunk in RIFF files
 	long long				fileSize;
 	long long				dataSize;
+	long long				dataChunkSizeOffset;	// Offset of the data chunk size field, set by writeWavHeader()
+	long long				dataChunkOffset;		// Offset of the first sample, set by writeWavHeader()
 	std::fstream			*pFile;		
 	WAVHeader				header;
 
@@ -161,11 +175,12 @@ public:
 
 	// Constructor
 
-	WAVFile() : is_RF64(false), fileSize(0), dataSize(0), 
+	WAVFile() : is_RF64(false), is_BW64(false), reserve_ds64(false), fileSize(0), dataSize(0),
+		dataChunkSizeOffset(WAV_DATA_CHUNKSIZE_OFFSET), dataChunkOffset(WAV_DATA_CHUNKSIZE_OFFSET + 4), header()
 #if defined(BROADCAST_WAVE)
-		bext_data(),
+		, bext_data()
 #endif
-		header() {
+		{
 
 	};
 
@@ -181,6 +196,13 @@ public:
 	void writeWavHeader();
 	void updateRIFFHeader();
 	void updateRF64Header();
+
+	// Sets dataSize, and fileSize for a header written by writeWavHeader()
+	void setDataSize(long long iDataSize);
+
+	// Updates size fields of the header, switching to RF64/BW64 when sizes exceed the RIFF limit and space for
+	// a ds64 chunk is reserved. Returns 0 if no error, 1 if sizes cannot be represented or the file write failed.
+	int  updateHeader();
 	int  writeSamplesToFile(int numChannels, int *sampleBuffer[], int numSamples);
 	int  writeZeroSamplesToFile(int numChannels, int numSamples);
     
@@ -189,9 +211,11 @@ public:
      * After the wav header has been successfully read, file pointer will be positioned at the first sample of the first channel and
      * the client can use readWavSamplesFromFile() to read samples from file.
      *
-     * Returns total number of samples per channel in the wav file. A return value of <= 0 indicates a file error or the file is not mono, 24-bit.
+     * RIFF, RF64 and BW64 files are supported.
+     * Returns total number of samples per channel in the wav file, 64-bit for RF64/BW64 files beyond 4 GB.
+     * A return value of <= 0 indicates a file error or the file is not mono, 24-bit.
      */     
-	int readWavHeader();
+	long long readWavHeader();
     
     int readWavSamplesFromFile(int numChannels, float *sampleBuffer, int numSamples);
 	int readWavSamplesFromFile(int numChannels, int *sampleBuffer, int numSamples);
@@ -0,0 +1,414 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "DLCDecBenchmarkUtils.h"
+#include "DLC/DLCInterpolator.h"
+#include "common/IABElements.h"
+#include "commonstream/bitstream/BitStreamIOHelpers.h"
+#include "TestConstants.h"
+#include "CPUTime.h"
+
+using namespace SMPTE::ImmersiveAudioBitstream;
+
+// Benchmark asset layout: one 24 fps frame of 10 sub blocks
+static const uint8_t kBenchmarkNumSubBlocks = 10;
+static const uint32_t kBenchmarkSubBlockSize48 = 200;
+static const uint32_t kBenchmarkSampleCount48 = kBenchmarkNumSubBlocks * kBenchmarkSubBlockSize48;
+static const uint8_t kBenchmarkShiftBits = 2;
+
+IABPerformanceDLCBenchmark::IABPerformanceDLCBenchmark()
+{
+}
+
+IABPerformanceDLCBenchmark::~IABPerformanceDLCBenchmark()
+{
+}
+
+void IABPerformanceDLCBenchmark::RunBenchmarks()
+{
+    static const DecodeMode modes[] = { eDecodeMode_48k, eDecodeMode_96k, eDecodeMode_96kTo48k };
+    static const dlc::CodeType codeTypes[] = { dlc::eCodeType_PCM_CODE_TYPE, dlc::eCodeType_RICE_CODE_TYPE };
+    static const uint8_t orders[] = { 0, 1, 2, 4, 8, 16, 24, 31 };
+    static const uint8_t magnitudeBits[] = { 2, 8, 16, 22 };
+    
+    std::vector<BenchmarkCase> cases;
+    
+    // Three sweeps around a reference case of order 8, one region and 12-bit residuals:
+    // predictor order, number of predictor regions and residual magnitude, for each mode and code type
+    for (uint32_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        for (uint32_t c = 0; c < sizeof(codeTypes) / sizeof(codeTypes[0]); c++)
+        {
+            BenchmarkCase benchmarkCase = { modes[m], codeTypes[c], 8, 1, 12 };
+            
+            for (uint32_t o = 0; o < sizeof(orders) / sizeof(orders[0]); o++)
+            {
+                benchmarkCase.order_ = orders[o];
+                cases.push_back(benchmarkCase);
+            }
+            
+            benchmarkCase.order_ = 8;
+            
+            for (uint8_t r = 0; r <= 3; r++)
+            {
+                if (r != 1)
+                {
+                    benchmarkCase.numRegions_ = r;
+                    cases.push_back(benchmarkCase);
+                }
+            }
+            
+            benchmarkCase.numRegions_ = 1;
+            
+            for (uint32_t b = 0; b < sizeof(magnitudeBits) / sizeof(magnitudeBits[0]); b++)
+            {
+                benchmarkCase.magnitudeBits_ = magnitudeBits[b];
+                cases.push_back(benchmarkCase);
+            }
+        }
+    }
+    
+    std::cout << "\nBenchmarking DLC decoding stages over " << cases.size() << " synthesized assets ......" << std::endl;
+    std::cout << "DLCBENCH,mode,code_type,order,regions,magnitude_bits,stage,samples_per_sec,ns_per_sample" << std::endl;
+    
+    for (std::vector<BenchmarkCase>::const_iterator iter = cases.begin(); iter != cases.end(); iter++)
+    {
+        RunBenchmarkCase(*iter);
+    }
+}
+
+void IABPerformanceDLCBenchmark::RunBenchmarkCase(const BenchmarkCase &iCase)
+{
+    dlc::AudioData audioData;
+    dlc::AudioData audioDataNoPred;
+    std::stringstream element(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+    
+    SynthesizeAsset(iCase, audioData, audioDataNoPred, element);
+    
+    bool decodeTo96k = (iCase.mode_ == eDecodeMode_96k);
+    dlc::SampleRate decodeSampleRate = decodeTo96k ? dlc::eSampleRate_96000 : dlc::eSampleRate_48000;
+    uint32_t sampleCount = decodeTo96k ? 2 * kBenchmarkSampleCount48 : kBenchmarkSampleCount48;
+    
+    double entropyTime = MeasureEntropyDecodeTime(element, audioData.getSampleRate(), iCase.mode_ == eDecodeMode_96kTo48k);
+    double decodeTime = MeasureDecodeTime(audioData, decodeSampleRate, sampleCount);
+    double noPredDecodeTime = MeasureDecodeTime(audioDataNoPred, decodeSampleRate, sampleCount);
+    double interpolationTime = decodeTo96k ? MeasureInterpolationTime(kBenchmarkSampleCount48) : 0;
+    
+    // Differences of separately timed loops, clamped so that noise never yields a negative time
+    double synthesisTime = std::max(decodeTime - noPredDecodeTime, 0.0);
+    double shiftTime = std::max(noPredDecodeTime - interpolationTime, 0.0);
+    
+    ReportStage(iCase, "entropy", entropyTime, sampleCount);
+    ReportStage(iCase, "synthesis", synthesisTime, sampleCount);
+    
+    if (decodeTo96k)
+    {
+        ReportStage(iCase, "interpolation", interpolationTime, sampleCount);
+    }
+    
+    ReportStage(iCase, "shift", shiftTime, sampleCount);
+    ReportStage(iCase, "decode", decodeTime, sampleCount);
+}
+
+void IABPerformanceDLCBenchmark::SynthesizeAsset(const BenchmarkCase &iCase
+                                                 , dlc::AudioData &oAudioData
+                                                 , dlc::AudioData &oAudioDataNoPred
+                                                 , std::stringstream &oElement)
+{
+    dlc::SampleRate assetSampleRate = (iCase.mode_ == eDecodeMode_48k) ? dlc::eSampleRate_48000 : dlc::eSampleRate_96000;
+    uint8_t numLayers = (assetSampleRate == dlc::eSampleRate_96000) ? 2 : 1;
+    
+    std::stringstream payloadBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+    StreamWriter payloadWriter(payloadBuffer);
+    
+    dlc::AudioData *audioData[2] = { &oAudioData, &oAudioDataNoPred };
+    
+    for (uint32_t a = 0; a < 2; a++)
+    {
+        audioData[a]->setSampleRate(assetSampleRate);
+        audioData[a]->setShiftBits(kBenchmarkShiftBits);
+        audioData[a]->setNumDLCSubBlocks(kBenchmarkNumSubBlocks);
+        audioData[a]->initPackedResiduals(kBenchmarkSubBlockSize48);
+        audioData[a]->setNumPredRegions48(0);
+        audioData[a]->setNumPredRegions96(0);
+    }
+    
+    payloadWriter.write(static_cast<uint8_t>(assetSampleRate), 2);
+    payloadWriter.write(kBenchmarkShiftBits, 5);
+    
+    // Stable lattice filter: reflection coefficients of alternating sign, decreasing in magnitude
+    dlc::uint10_t kCoeffs[32] = { 0 };
+    
+    for (uint8_t p = 1; p <= iCase.order_; p++)
+    {
+        int32_t reflection = 256 / p;
+        kCoeffs[p] = static_cast<dlc::uint10_t>(512 + ((p % 2) ? reflection : -reflection));
+    }
+    
+    // Region lengths, in sub blocks, covering the frame
+    uint8_t regionLengths[3] = { 0 };
+    
+    for (uint8_t n = 0; n < iCase.numRegions_; n++)
+    {
+        regionLengths[n] = static_cast<uint8_t>(kBenchmarkNumSubBlocks / iCase.numRegions_ + ((n < kBenchmarkNumSubBlocks % iCase.numRegions_) ? 1 : 0));
+    }
+    
+    uint32_t seed = 12345 + iCase.order_ * 31 + iCase.magnitudeBits_;
+    
+    for (uint8_t layer = 0; layer < numLayers; layer++)
+    {
+        // Predictor regions. 96 kHz regions mirror the 48 kHz ones.
+        if (layer == 0)
+        {
+            oAudioData.setNumPredRegions48(iCase.numRegions_);
+        }
+        else
+        {
+            oAudioData.setNumPredRegions96(iCase.numRegions_);
+        }
+        
+        payloadWriter.write(iCase.numRegions_, 2);
+        
+        for (uint8_t n = 0; n < iCase.numRegions_; n++)
+        {
+            dlc::PredRegion &region = (layer == 0) ? oAudioData.getPredRegion48(n) : oAudioData.getPredRegion96(n);
+            region.setRegionLength(regionLengths[n]);
+            region.setOrder(iCase.order_);
+            region.setKCoeff(kCoeffs);
+            
+            payloadWriter.write(regionLengths[n], 4);
+            payloadWriter.write(iCase.order_, 5);
+            
+            for (uint8_t p = 1; p <= iCase.order_; p++)
+            {
+                payloadWriter.write(kCoeffs[p], 10);
+            }
+        }
+        
+        // Residual sub blocks
+        uint8_t codingBits = iCase.magnitudeBits_;
+        
+        if (iCase.codeType_ == dlc::eCodeType_RICE_CODE_TYPE)
+        {
+            codingBits = (codingBits > 0) ? codingBits - 1 : 0;
+        }
+        
+        uint32_t subBlockSize = kBenchmarkSubBlockSize48 * (layer + 1);
+        
+        for (uint32_t a = 0; a < 2; a++)
+        {
+            dlc::ResidualLayer &residualLayer = (layer == 0) ? audioData[a]->getResidualLayer48() : audioData[a]->getResidualLayer96();
+            
+            for (uint8_t n = 0; n < kBenchmarkNumSubBlocks; n++)
+            {
+                residualLayer.setCodeType(n, iCase.codeType_);
+                residualLayer.setCodingBits(n, codingBits);
+            }
+        }
+        
+        int32_t *residuals = (layer == 0) ? oAudioData.getResidualLayer48().getResiduals() : oAudioData.getResidualLayer96().getResiduals();
+        int32_t *residualsNoPred = (layer == 0) ? oAudioDataNoPred.getResidualLayer48().getResiduals() : oAudioDataNoPred.getResidualLayer96().getResiduals();
+        
+        for (uint8_t n = 0; n < kBenchmarkNumSubBlocks; n++)
+        {
+            payloadWriter.write(static_cast<uint8_t>(iCase.codeType_), 1);
+            payloadWriter.write(codingBits, 5);
+            
+            for (uint32_t i = 0; i < subBlockSize; i++)
+            {
+                seed = seed * 1103515245 + 12345;
+                uint32_t magnitude = (seed >> 8) & ((1u << iCase.magnitudeBits_) - 1);
+                bool isNegative = ((seed >> 5) & 1) != 0;
+                
+                if (iCase.codeType_ == dlc::eCodeType_PCM_CODE_TYPE)
+                {
+                    payloadWriter.write(magnitude, codingBits);
+                }
+                else
+                {
+                    for (uint32_t q = 0; q < (magnitude >> codingBits); q++)
+                    {
+                        payloadWriter.write(1, 1);
+                    }
+                    
+                    payloadWriter.write(0, 1);
+                    payloadWriter.write(magnitude & ((1u << codingBits) - 1), codingBits);
+                }
+                
+                if (magnitude != 0)
+                {
+                    payloadWriter.write(isNegative ? 1 : 0, 1);
+                }
+                
+                *residuals = isNegative ? -static_cast<int32_t>(magnitude) : static_cast<int32_t>(magnitude);
+                *(residualsNoPred++) = *(residuals++);
+            }
+        }
+    }
+    
+    payloadWriter.align();
+    
+    std::string payload = payloadBuffer.str();
+    StreamWriter elementWriter(oElement);
+    
+    write(elementWriter, Plex<8>(kIABElementID_AudioDataDLC));
+    write(elementWriter, Plex<8>(static_cast<uint32_t>(1 + 2 + payload.size())));
+    write(elementWriter, Plex<8>(1));
+    elementWriter.write(static_cast<uint16_t>(payload.size()), 16);
+    
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        elementWriter.write(static_cast<uint8_t>(payload[i]), 8);
+    }
+    
+    elementWriter.align();
+}
+
+// Runs iOperation for kDLCBenchmarkCaseTime, split into kDLCBenchmarkRuns timed runs, and returns the average
+// time in ns of one call in the fastest run, ie. the run least disturbed by other activity on the machine.
+template<typename Operation>
+static double MeasureFastestCallTime(Operation iOperation)
+{
+    double fastestCallTime = 0;
+    
+    for (uint32_t run = 0; run < kDLCBenchmarkRuns; run++)
+    {
+        _cpu_time starttime;
+        _cpu_time endtime;
+        double actualTestTime = 0;
+        uint32_t totalCalls = 0;
+        
+        getCPUTime(&starttime);
+        
+        for (totalCalls = 0; actualTestTime < kDLCBenchmarkCaseTime / kDLCBenchmarkRuns; totalCalls++)
+        {
+            if (!iOperation())
+            {
+                return 0;
+            }
+            
+            getCPUTime(&endtime);
+            actualTestTime = diffCPUTime(&endtime, &starttime);
+        }
+        
+        double callTime = actualTestTime / totalCalls;
+        
+        if (run == 0 || callTime < fastestCallTime)
+        {
+            fastestCallTime = callTime;
+        }
+    }
+    
+    return fastestCallTime;
+}
+
+// Measure dlc::FullDecoder::decode() time
+double IABPerformanceDLCBenchmark::MeasureDecodeTime(const dlc::AudioData &iAudioData, dlc::SampleRate iSampleRate, uint32_t iSampleCount)
+{
+    std::vector<int32_t> decodedSamples(iSampleCount);
+    dlc::FullDecoder &decoder = decoder_;
+    
+    return MeasureFastestCallTime([&]()
+    {
+        decoder.decode(&decodedSamples[0], iSampleCount, iSampleRate, iAudioData);
+        return true;
+    });
+}
+
+// Measure IABAudioDataDLC::DeSerialize() time
+double IABPerformanceDLCBenchmark::MeasureEntropyDecodeTime(std::stringstream &iElement, dlc::SampleRate iAssetSampleRate, bool iSkip96kLayer)
+{
+    IABSampleRateType sampleRate = (iAssetSampleRate == dlc::eSampleRate_96000) ? kIABSampleRate_96000Hz : kIABSampleRate_48000Hz;
+    IABAudioDataDLC *element = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(kIABFrameRate_24FPS, sampleRate));
+    
+    if (!element)
+    {
+        return 0;
+    }
+    
+    element->SetDeSerializeSkips96kLayer(iSkip96kLayer);
+    
+    double callTime = MeasureFastestCallTime([&]()
+    {
+        iElement.clear();
+        iElement.seekg(0, std::ios::beg);
+        StreamReader elementReader(iElement);
+        
+        if (element->DeSerialize(elementReader) != kIABNoError)
+        {
+            std::cerr << "!Error: unable to parse synthesized DLC element." << std::endl;
+            return false;
+        }
+        
+        return true;
+    });
+    
+    IABAudioDataDLCInterface::Delete(element);
+    
+    return callTime;
+}
+
+// Measure dlc::Interpolate48kTo96k() time
+double IABPerformanceDLCBenchmark::MeasureInterpolationTime(uint32_t iSampleCount48)
+{
+    std::vector<int32_t> samples48(dlc::kDLCInterpHistory + iSampleCount48, 0);
+    std::vector<int32_t> samples96(2 * iSampleCount48);
+    
+    for (uint32_t i = 0; i < iSampleCount48; i++)
+    {
+        samples48[dlc::kDLCInterpHistory + i] = static_cast<int32_t>(i * 2654435761u) >> 8;
+    }
+    
+    return MeasureFastestCallTime([&]()
+    {
+        dlc::Interpolate48kTo96k(&samples48[dlc::kDLCInterpHistory], iSampleCount48, &samples96[0]);
+        return true;
+    });
+}
+
+void IABPerformanceDLCBenchmark::ReportStage(const BenchmarkCase &iCase, const std::string &iStage, double iTimePerFrame, uint32_t iSampleCount)
+{
+    static const char *modeNames[] = { "48k", "96k", "96kTo48k" };
+    
+    double nsPerSample = iTimePerFrame / iSampleCount;                          // CPUTime class measures in nano seconds
+    double samplesPerSec = (nsPerSample > 0) ? 1e9 / nsPerSample : 0;
+    
+    std::cout << "DLCBENCH," << modeNames[iCase.mode_]
+              << "," << ((iCase.codeType_ == dlc::eCodeType_PCM_CODE_TYPE) ? "pcm" : "rice")
+              << "," << static_cast<uint32_t>(iCase.order_)
+              << "," << static_cast<uint32_t>(iCase.numRegions_)
+              << "," << static_cast<uint32_t>(iCase.magnitudeBits_)
+              << "," << iStage
+              << "," << samplesPerSec
+              << "," << nsPerSample << std::endl;
+}
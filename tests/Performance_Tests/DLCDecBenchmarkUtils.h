@@ -0,0 +1,116 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#ifndef __DLCDECBENCHMARKUTILS_H__
+#define __DLCDECBENCHMARKUTILS_H__
+
+#include <sstream>
+#include <string>
+
+#include "DLC/DLCAudioData.h"
+#include "DLC/DLCFullDecoder.h"
+
+/**
+ * Class to benchmark DLC decoding throughput per decoding stage, over synthesized DLC assets
+ * covering the DLC parameter space.
+ *
+ * Procedure per test case:
+ * 1. Synthesize a 24 fps DLC asset (dlc::AudioData and the equivalent IAB AudioDataDLC element) with the
+ *    requested decoding mode, sub block code type, predictor order, number of predictor regions and
+ *    residual magnitude
+ * 2. Time each decoding stage in a loop for kDLCBenchmarkCaseTime, keeping the fastest of kDLCBenchmarkRuns runs
+ * 3. Report samples/s and ns/sample of each stage as one CSV line, prefixed with "DLCBENCH"
+ *
+ * Stages:
+ *   entropy       - IABAudioDataDLC::DeSerialize() of the element, ie. reading and entropy decoding of residuals
+ *   synthesis     - LPC synthesis, ie. dlc::FullDecoder::decode() time minus that of the same asset without predictors
+ *   interpolation - 48 kHz to 96 kHz interpolation, dlc::Interpolate48kTo96k() (96 kHz decoding only)
+ *   shift         - remaining dlc::FullDecoder::decode() time, ie. residual copy, 96 kHz residual add and bit shift
+ *   decode        - dlc::FullDecoder::decode() as a whole
+ *
+ * Sample counts are output samples of the decoding mode.
+ */
+
+class IABPerformanceDLCBenchmark
+{
+public:
+    IABPerformanceDLCBenchmark();
+    ~IABPerformanceDLCBenchmark();
+    
+    /**
+     * Runs all DLC decoder stage benchmarks and writes the results to std::cout
+     *
+     */
+    void RunBenchmarks();
+    
+private:
+    
+    // DLC decoding modes
+    enum DecodeMode
+    {
+        eDecodeMode_48k = 0,                // 48 kHz asset decoded to 48 kHz
+        eDecodeMode_96k,                    // 96 kHz asset decoded to 96 kHz
+        eDecodeMode_96kTo48k                // 96 kHz asset decoded to 48 kHz, 96 kHz layer skipped by the parser
+    };
+    
+    // Parameters of a synthesized DLC asset
+    struct BenchmarkCase
+    {
+        DecodeMode mode_;
+        dlc::CodeType codeType_;
+        uint8_t order_;                     // Predictor order of each region, in the range [0, 31]
+        uint8_t numRegions_;                // Number of predictor regions per layer, in the range [0, 3]
+        uint8_t magnitudeBits_;             // Residual magnitudes are in the range [0, 2^magnitudeBits_)
+    };
+    
+    // Synthesizes the asset of iCase in oAudioData, and writes the equivalent IAB AudioDataDLC element to oElement.
+    // oAudioDataNoPred holds the same residuals without predictor regions.
+    void SynthesizeAsset(const BenchmarkCase &iCase
+                         , dlc::AudioData &oAudioData
+                         , dlc::AudioData &oAudioDataNoPred
+                         , std::stringstream &oElement);
+    
+    // Runs iCase and reports its stage measurements
+    void RunBenchmarkCase(const BenchmarkCase &iCase);
+    
+    // Measures the time in ns of one dlc::FullDecoder::decode() call
+    double MeasureDecodeTime(const dlc::AudioData &iAudioData, dlc::SampleRate iSampleRate, uint32_t iSampleCount);
+    
+    // Measures the time in ns of one IABAudioDataDLC::DeSerialize() call
+    double MeasureEntropyDecodeTime(std::stringstream &iElement, dlc::SampleRate iAssetSampleRate, bool iSkip96kLayer);
+    
+    // Measures the time in ns of one dlc::Interpolate48kTo96k() call
+    double MeasureInterpolationTime(uint32_t iSampleCount48);
+    
+    // Writes one result line
+    void ReportStage(const BenchmarkCase &iCase, const std::string &iStage, double iTimePerFrame, uint32_t iSampleCount);
+    
+    dlc::FullDecoder decoder_;
+};
+#endif // __DLCDECBENCHMARKUTILS_H__
@@ -30,8 +30,15 @@
 #ifndef __TESTCONSTANTS_H__
 #define __TESTCONSTANTS_H__
 
+#include <stdint.h>
+
 // Target measurement period. The parameter under test will be measured and averaged over this period,
 // currently set to 30 seconds and may be reduced/increased if required.
 static const double kIABTargetTestTime = 30 * 1e9;
 
+// Measurement period of each stage of a DLC benchmark case (in nano seconds), kept short since the
+// DLC benchmark covers many cases. The period is split into kDLCBenchmarkRuns runs, the fastest of which is reported.
+static const double kDLCBenchmarkCaseTime = 0.25 * 1e9;
+static const uint32_t kDLCBenchmarkRuns = 5;
+
 #endif // __TESTCONSTANTS_H__
@@ -33,6 +33,7 @@
 #include "RendererPerformanceUtils.h"
 #include "DecodePerformanceUtils.h"
 #include "DLCDecPerformanceUtils.h"
+#include "DLCDecBenchmarkUtils.h"
 #include "IABMaxComplexityFrame.h"
 
 
@@ -51,9 +52,10 @@ void ShowToolInformation()
            "The measurement is done by running various test cases and calculating a performance rating for each test case.\n"
            "The following rating will be measured:\n"
            "     1. DLC frame decoding rate,\n"
-	       "     2. IAB frame (MCF) parsing rate,\n"
-		   "     3. IAB frame (MCF) rendering rate,\n"
-		   "     4. IAB frame (MCF) decoding (parsing + rendering) rate.\n\n"
+           "     2. DLC decoding throughput per stage, over synthesized assets (CSV lines prefixed with DLCBENCH),\n"
+	       "     3. IAB frame (MCF) parsing rate,\n"
+		   "     4. IAB frame (MCF) rendering rate,\n"
+		   "     5. IAB frame (MCF) decoding (parsing + rendering) rate.\n\n"
            );
 }
 
@@ -67,6 +69,10 @@ int main(int argc, const char * argv[])
     IABPerformanceDLCDecoder testDLCDecoder;
     testDLCDecoder.RunMeasurements();
     
+    // Run DLC decoder stage benchmarks
+    IABPerformanceDLCBenchmark testDLCBenchmark;
+    testDLCBenchmark.RunBenchmarks();
+    
     // Run parser measurements
     IABPerformanceParser testParser;
     testParser.MeasureMaxComplexity();
@@ -232,4 +232,57 @@ namespace
         ASSERT_EQ(600, ad.getSampleCount96());
     }
 
+    TEST(AudioDataTest, PackedResiduals)
+    {
+        dlc::AudioData ad;
+
+        /* default value */
+
+        ASSERT_FALSE(ad.hasPackedResiduals());
+
+        /* packed residuals replace existing sub blocks */
+
+        ad.setSampleRate(dlc::eSampleRate_96000);
+        ad.setNumDLCSubBlocks(4);
+        ad.initDLCSubBlock48(0, dlc::eCodeType_RICE_CODE_TYPE, 100);
+
+        ad.initPackedResiduals(100);
+
+        ASSERT_TRUE(ad.hasPackedResiduals());
+        ASSERT_TRUE(ad.getDLCSubBlock48(0) == NULL);
+
+        ASSERT_EQ(ad.getResidualLayer48().getNumSubBlocks(), 4);
+        ASSERT_EQ(ad.getResidualLayer48().getSubBlockSize(), 100);
+        ASSERT_EQ(ad.getResidualLayer96().getNumSubBlocks(), 4);
+        ASSERT_EQ(ad.getResidualLayer96().getSubBlockSize(), 200);
+
+        ASSERT_EQ(400, ad.getSampleCount48());
+        ASSERT_EQ(800, ad.getSampleCount96());
+
+        ad.getResidualLayer48().setCodeType(3, dlc::eCodeType_RICE_CODE_TYPE);
+        ad.getResidualLayer48().setCodingBits(3, 31);
+
+        ASSERT_EQ(ad.getResidualLayer48().getCodeType(3), dlc::eCodeType_RICE_CODE_TYPE);
+        ASSERT_EQ(ad.getResidualLayer48().getCodingBits(3), 31);
+
+        ASSERT_THROW(ad.getResidualLayer48().setCodingBits(3, 32), std::out_of_range);
+        ASSERT_THROW(ad.getResidualLayer48().setCodeType(4, dlc::eCodeType_PCM_CODE_TYPE), std::out_of_range);
+
+        /* storage is kept when the layers are sized again for a next frame */
+
+        const int32_t *residuals48 = ad.getResidualLayer48().getResiduals();
+
+        ad.setSampleRate(dlc::eSampleRate_48000);
+        ad.initPackedResiduals(100);
+
+        ASSERT_EQ(ad.getResidualLayer48().getResiduals(), residuals48);
+        ASSERT_EQ(ad.getResidualLayer96().getSize(), 0);
+
+        /* initializing a sub block reverts to individual sub blocks */
+
+        ad.initDLCSubBlock48(0, dlc::eCodeType_PCM_CODE_TYPE, 100);
+
+        ASSERT_FALSE(ad.hasPackedResiduals());
+    }
+
 }
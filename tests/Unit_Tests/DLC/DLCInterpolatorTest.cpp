@@ -0,0 +1,102 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include "gtest/gtest.h"
+#include "DLC/DLCInterpolator.h"
+#include <vector>
+
+namespace
+{
+
+    // Direct-form reference of ST 2098-2, Section B.9, over a masked circular buffer
+    void ReferenceInterpolate(const int32_t *iSamples48, uint32_t iSampleCount48, int32_t *oSamples96)
+    {
+        int32_t buffer[64] = { 0 };
+        int32_t index1 = 0;
+
+        for (uint32_t k = 0; k < iSampleCount48; k++)
+        {
+            buffer[index1] = iSamples48[k];
+
+            int32_t index2 = (index1 - 8) & 63;
+            oSamples96[2 * k] = buffer[index2];
+
+            index2 = index1;
+            int64_t accum64 = 0;
+
+            for (int32_t i = 1; i < 33; i += 2)
+            {
+                accum64 += static_cast<int64_t>(buffer[index2]) * dlc::InterpolatorFilterCoeffs[i];
+                index2--;
+                index2 &= 63;
+            }
+
+            oSamples96[2 * k + 1] = static_cast<int32_t>(accum64 >> 15);
+
+            index1++;
+            index1 &= 63;
+        }
+    }
+
+    TEST(Interpolator, BitExact)
+    {
+        const uint32_t sampleCounts[] = { 1, 7, 8, 9, 15, 16, 17, 801, 1000, dlc::kDLCMaxFrameSize48k };
+
+        uint32_t seed = 12345;
+
+        for (uint32_t sampleCount : sampleCounts)
+        {
+            std::vector<int32_t> samples48(dlc::kDLCInterpHistory + sampleCount, 0);
+
+            for (uint32_t i = 0; i < sampleCount; i++)
+            {
+                seed = seed * 1664525 + 1013904223;
+
+                // Full scale 24-bit samples, with runs at the extremes to exercise the accumulator range
+                int32_t sample = static_cast<int32_t>(seed) >> 8;
+
+                if ((i / 32) % 4 == 1)
+                {
+                    sample = (i & 1) ? 8388607 : -8388608;
+                }
+
+                samples48[dlc::kDLCInterpHistory + i] = sample;
+            }
+
+            std::vector<int32_t> expected(2 * sampleCount);
+            std::vector<int32_t> actual(2 * sampleCount);
+
+            ReferenceInterpolate(samples48.data() + dlc::kDLCInterpHistory, sampleCount, expected.data());
+            dlc::Interpolate48kTo96k(samples48.data() + dlc::kDLCInterpHistory, sampleCount, actual.data());
+
+            ASSERT_EQ(expected, actual) << "sample count " << sampleCount;
+        }
+    }
+
+}
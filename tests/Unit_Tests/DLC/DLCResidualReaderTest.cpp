@@ -0,0 +1,232 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include "gtest/gtest.h"
+#include "DLC/DLCResidualReader.h"
+#include "commonstream/bitstream/BitStreamWriterT.h"
+#include "commonstream/bitstream/BitStreamReaderT.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef CommonStream::BitStreamWriterT<std::ostream> StreamWriter;
+    typedef CommonStream::BitStreamReaderT<std::istream> StreamReader;
+
+    // Writes one sub block of signed residuals, PCM or Rice/Golomb coded, as in an IAB AudioDataDLC payload
+    void WriteSubBlock(StreamWriter &oWriter, dlc::CodeType iCodeType, uint8_t iCodingBits, const std::vector<int32_t> &iResiduals)
+    {
+        for (size_t i = 0; i < iResiduals.size(); i++)
+        {
+            uint32_t magnitude = static_cast<uint32_t>(iResiduals[i] < 0 ? -iResiduals[i] : iResiduals[i]);
+
+            if (iCodeType == dlc::eCodeType_PCM_CODE_TYPE)
+            {
+                oWriter.write(magnitude, iCodingBits);
+            }
+            else
+            {
+                for (uint32_t q = 0; q < (magnitude >> iCodingBits); q++)
+                {
+                    oWriter.write(1, 1);
+                }
+
+                oWriter.write(0, 1);
+                oWriter.write(magnitude & ((1u << iCodingBits) - 1), iCodingBits);
+            }
+
+            if (magnitude != 0)
+            {
+                oWriter.write(iResiduals[i] < 0 ? 1 : 0, 1);
+            }
+        }
+    }
+
+    // Bit-serial reference decode of a Rice/Golomb sub block, one read per unary bit
+    bool ReadRiceSubBlockSerial(StreamReader &iReader, uint8_t iRiceRemBits, std::vector<int32_t> &oResiduals)
+    {
+        for (size_t i = 0; i < oResiduals.size(); i++)
+        {
+            int32_t quotient = 0;
+            int32_t remainder = 0;
+            uint8_t bit = 0;
+
+            if (CMNSTRM_OK != iReader.read(bit, 1))
+            {
+                return false;
+            }
+
+            while (1 == bit)
+            {
+                quotient++;
+
+                if (CMNSTRM_OK != iReader.read(bit, 1))
+                {
+                    return false;
+                }
+            }
+
+            if (iRiceRemBits != 0 && CMNSTRM_OK != iReader.read(remainder, iRiceRemBits))
+            {
+                return false;
+            }
+
+            int32_t residualValue = (quotient << iRiceRemBits) + remainder;
+
+            if ((remainder != 0) || (quotient > 0))
+            {
+                if (CMNSTRM_OK != iReader.read(bit, 1))
+                {
+                    return false;
+                }
+
+                if (1 == bit)
+                {
+                    residualValue = -residualValue;
+                }
+            }
+
+            oResiduals[i] = residualValue;
+        }
+
+        return true;
+    }
+
+    std::vector<int32_t> RandomResiduals(uint32_t iCount, uint32_t iMaxMagnitude, uint32_t &ioSeed)
+    {
+        std::vector<int32_t> residuals(iCount);
+
+        for (uint32_t i = 0; i < iCount; i++)
+        {
+            ioSeed = ioSeed * 1103515245 + 12345;
+            int32_t magnitude = static_cast<int32_t>((ioSeed >> 8) % (iMaxMagnitude + 1));
+            residuals[i] = ((ioSeed >> 4) & 1) ? -magnitude : magnitude;
+        }
+
+        return residuals;
+    }
+
+    TEST(ResidualReader, ReadBits)
+    {
+        const uint8_t data[] = { 0xA5, 0x0F, 0xFF, 0x00, 0x12, 0x34, 0x56, 0x78, 0x9A };
+        dlc::ResidualReader reader(data, sizeof(data));
+        uint32_t value = 0;
+
+        ASSERT_TRUE(reader.readBits(value, 3));
+        EXPECT_EQ(value, 5u);
+        ASSERT_TRUE(reader.readBits(value, 0));
+        EXPECT_EQ(value, 0u);
+        ASSERT_TRUE(reader.readBits(value, 13));
+        EXPECT_EQ(value, 0x050Fu);
+        ASSERT_TRUE(reader.readBits(value, 32));
+        EXPECT_EQ(value, 0xFF001234u);
+        ASSERT_TRUE(reader.readBits(value, 24));
+        EXPECT_EQ(value, 0x56789Au);
+
+        // Payload exhausted
+        EXPECT_FALSE(reader.readBits(value, 1));
+    }
+
+    // Rice/Golomb decode must be bit-exact with the bit-serial decode, including
+    // unary prefixes longer than the bit cache.
+    TEST(ResidualReader, RiceResidualsMatchSerialDecode)
+    {
+        const uint8_t riceRemBits[] = { 0, 1, 4, 9, 17 };
+        const uint32_t maxMagnitudes[] = { 20, 300, 1000, 100000, 1 << 20 };
+        const uint32_t subBlockSize = 400;
+        uint32_t seed = 2024;
+
+        for (size_t t = 0; t < sizeof(riceRemBits); t++)
+        {
+            std::vector<int32_t> residuals = RandomResiduals(subBlockSize, maxMagnitudes[t], seed);
+
+            // Exercise unary runs of several cache lengths
+            residuals[7] = (150 << riceRemBits[t]) + 1;
+            residuals[8] = -(64 << riceRemBits[t]);
+
+            std::stringstream buffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+            StreamWriter writer(buffer);
+
+            // Start at an odd bit offset, as sub blocks do within a payload
+            writer.write(5, 3);
+            WriteSubBlock(writer, dlc::eCodeType_RICE_CODE_TYPE, riceRemBits[t], residuals);
+            writer.align();
+
+            std::string payload = buffer.str();
+
+            std::vector<int32_t> serialResiduals(subBlockSize);
+            buffer.seekg(0, std::ios::beg);
+            StreamReader serialReader(buffer);
+            uint8_t prefix = 0;
+            ASSERT_EQ(serialReader.read(prefix, 3), CMNSTRM_OK);
+            ASSERT_TRUE(ReadRiceSubBlockSerial(serialReader, riceRemBits[t], serialResiduals));
+
+            std::vector<int32_t> cachedResiduals(subBlockSize);
+            dlc::ResidualReader reader(reinterpret_cast<const uint8_t*>(payload.data()), static_cast<uint32_t>(payload.size()));
+            uint32_t value = 0;
+            ASSERT_TRUE(reader.readBits(value, 3));
+            ASSERT_TRUE(reader.readRiceResiduals(cachedResiduals.data(), subBlockSize, riceRemBits[t]));
+
+            EXPECT_TRUE(cachedResiduals == serialResiduals);
+            EXPECT_TRUE(cachedResiduals == residuals);
+
+            // A truncated payload is reported
+            dlc::ResidualReader truncatedReader(reinterpret_cast<const uint8_t*>(payload.data()), static_cast<uint32_t>(payload.size() / 2));
+            ASSERT_TRUE(truncatedReader.readBits(value, 3));
+            EXPECT_FALSE(truncatedReader.readRiceResiduals(cachedResiduals.data(), subBlockSize, riceRemBits[t]));
+        }
+    }
+
+    TEST(ResidualReader, PCMResiduals)
+    {
+        const uint32_t subBlockSize = 200;
+        uint32_t seed = 7;
+
+        std::vector<int32_t> residuals = RandomResiduals(subBlockSize, (1 << 23) - 1, seed);
+
+        std::stringstream buffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+        StreamWriter writer(buffer);
+        WriteSubBlock(writer, dlc::eCodeType_PCM_CODE_TYPE, 24, residuals);
+        writer.align();
+
+        std::string payload = buffer.str();
+        std::vector<int32_t> decoded(subBlockSize, -1);
+
+        dlc::ResidualReader reader(reinterpret_cast<const uint8_t*>(payload.data()), static_cast<uint32_t>(payload.size()));
+        ASSERT_TRUE(reader.readPCMResiduals(decoded.data(), subBlockSize, 24));
+        EXPECT_TRUE(decoded == residuals);
+
+        // Zero bit depth codes silence, and consumes no bits
+        dlc::ResidualReader emptyReader(nullptr, 0);
+        ASSERT_TRUE(emptyReader.readPCMResiduals(decoded.data(), subBlockSize, 0));
+        EXPECT_TRUE(decoded == std::vector<int32_t>(subBlockSize, 0));
+    }
+
+}
@@ -30,6 +30,7 @@
 #include "gtest/gtest.h"
 #include "DLC/DLCSimpleEncoder.h"
 #include "DLC/DLCFullDecoder.h"
+#include <cmath>
 #include <vector>
 
 namespace
@@ -144,7 +145,8 @@ namespace
         /* verify that 0 bits are used since the audio is silent */
         for (uint8_t i = 0; i < ad.getNumDLCSubBlocks(); i++)
         {
-            ASSERT_EQ(0, static_cast<dlc::PCMResidualsSubBlock*>(ad.getDLCSubBlock48(i))->getBitDepth());
+            ASSERT_EQ(dlc::eCodeType_PCM_CODE_TYPE, ad.getResidualLayer48().getCodeType(i));
+            ASSERT_EQ(0, ad.getResidualLayer48().getCodingBits(i));
         }
 
         d.decode(&(out_samples[0]), static_cast<uint32_t>(out_samples.size()), dlc::eSampleRate_48000, ad);
@@ -268,7 +270,8 @@ namespace
 		/* verify that 0 bits are used since the audio is silent */
 		for (uint8_t i = 0; i < ad.getNumDLCSubBlocks(); i++)
 		{
-			ASSERT_EQ(0, static_cast<dlc::PCMResidualsSubBlock*>(ad.getDLCSubBlock96(i))->getBitDepth());
+			ASSERT_EQ(dlc::eCodeType_PCM_CODE_TYPE, ad.getResidualLayer96().getCodeType(i));
+			ASSERT_EQ(0, ad.getResidualLayer96().getCodingBits(i));
 		}
 
 		d.decode(&(out_samples[0]), static_cast<uint32_t>(out_samples.size()), dlc::eSampleRate_96000, ad);
@@ -356,6 +359,93 @@ namespace
 		}
 	}
 
+	// Tonal signal with low level noise, 24-bit MSB-aligned
+	static void FillTonalSignal(std::vector<int32_t> &oSamples, uint32_t iStart, uint32_t &ioSeed)
+	{
+		for (uint32_t i = 0; i < oSamples.size(); i++)
+		{
+			double t = static_cast<double>(iStart + i);
+			ioSeed = ioSeed * 1103515245 + 12345;
+			double noise = static_cast<double>((ioSeed >> 16) & 0xFF) - 128.0;
+			double value = 2000000.0 * std::sin(0.031 * t) + 500000.0 * std::sin(0.173 * t) + noise;
+			oSamples[i] = static_cast<int32_t>(value) << 8;
+		}
+	}
+
+	TEST_P(SimpleEncoderFullDecoderTest, Effort)
+	{
+		const dlc::SimpleEncoder::Effort efforts[] = { dlc::SimpleEncoder::eEffort_Fast, dlc::SimpleEncoder::eEffort_Thorough };
+
+		uint32_t frameSize = GetParam();
+
+		for (uint32_t e = 0; e < sizeof(efforts) / sizeof(efforts[0]); e++)
+		{
+			dlc::SimpleEncoder encoder;
+			dlc::FullDecoder decoder;
+			dlc::AudioData ad;
+
+			encoder.setup(dlc::eSampleRate_48000, frameSizeToFrameRateMap48k_[frameSize]);
+			encoder.setEffort(efforts[e]);
+			ASSERT_EQ(encoder.getEffort(), efforts[e]);
+
+			std::vector<int32_t> in_samples(frameSize);
+			std::vector<int32_t> out_samples(frameSize);
+			uint32_t seed = 12345;
+
+			// Frames are coded independently, history does not cross frames
+			for (uint32_t frame = 0; frame < 2; frame++)
+			{
+				FillTonalSignal(in_samples, frame * frameSize, seed);
+
+				encoder.encode(&in_samples[0], frameSize, dlc::eSampleRate_48000, ad);
+				decoder.decode(&out_samples[0], frameSize, dlc::eSampleRate_48000, ad);
+
+				// A predictable signal is predicted, and coded with Rice residuals
+				ASSERT_GT(ad.getNumPredRegions48(), 0);
+				ASSERT_EQ(ad.getResidualLayer48().getCodeType(0), dlc::eCodeType_RICE_CODE_TYPE);
+
+				ASSERT_TRUE(in_samples == out_samples);
+			}
+		}
+	}
+
+	TEST_P(SimpleEncoderFullDecoderTest, Effort_96k)
+	{
+		const dlc::SimpleEncoder::Effort efforts[] = { dlc::SimpleEncoder::eEffort_Fast, dlc::SimpleEncoder::eEffort_Thorough };
+
+		uint32_t frameSize = 2 * GetParam();
+		uint32_t delay = dlc::kDLCTotal96kFiltGrpDelay;
+
+		for (uint32_t e = 0; e < sizeof(efforts) / sizeof(efforts[0]); e++)
+		{
+			dlc::SimpleEncoder encoder;
+			dlc::FullDecoder decoder;
+			dlc::AudioData ad;
+
+			encoder.setup(dlc::eSampleRate_96000, frameSizeToFrameRateMap96k_[frameSize]);
+			encoder.setEffort(efforts[e]);
+
+			std::vector<int32_t> in_samples(2 * frameSize);
+			std::vector<int32_t> out_samples(2 * frameSize);
+			uint32_t seed = 12345;
+
+			FillTonalSignal(in_samples, 0, seed);
+
+			for (uint32_t frame = 0; frame < 2; frame++)
+			{
+				encoder.encode(&in_samples[frame * frameSize], frameSize, dlc::eSampleRate_96000, ad);
+				decoder.decode(&out_samples[frame * frameSize], frameSize, dlc::eSampleRate_96000, ad);
+				ASSERT_EQ(ad.getNumPredRegions96(), 0);
+			}
+
+			// Decoded output is the input, delayed by the 96k filtering
+			for (uint32_t i = 0; i < 2 * frameSize - delay; i++)
+			{
+				ASSERT_EQ(in_samples[i], out_samples[i + delay]);
+			}
+		}
+	}
+
 	// tests the encoder and decoder across frame sizes currently specified in ST 2098-2
 	INSTANTIATE_TEST_CASE_P(FS48FrameSizes,
 		SimpleEncoderFullDecoderTest,
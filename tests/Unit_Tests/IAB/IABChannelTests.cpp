@@ -289,15 +289,18 @@ namespace
             // Set up IAB packer channel
             SetupPackerChannel();
             
-            // stream to hold serialized bitstream
-            std::stringstream  channelStream(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+            // buffer to hold serialized bitstream
+            std::vector<char> channelBytes;
             
-            // stream writer for serialing
-            StreamWriter channelWriter(channelStream);
+            // bit stream writer for serialing
+            PackingWriter channelWriter(channelBytes);
 
-            // Serialize bed channel into stream
+            // Serialize bed channel into buffer
             ASSERT_EQ(iabPackerChannel_->Serialize(channelWriter), kIABNoError);
-            channelWriter.align();      // ensure last byte (decor coefficient) is properly serilaized into stream
+            channelWriter.align();      // ensure last byte (decor coefficient) is properly serilaized into buffer
+            
+            // stream holding the serialized bitstream
+            std::stringstream  channelStream(std::string(channelBytes.begin(), channelBytes.end()), std::stringstream::in | std::stringstream::out | std::stringstream::binary);
             
             // stream reader for de-serializing channel from stream
             StreamReader channelReader(channelStream);
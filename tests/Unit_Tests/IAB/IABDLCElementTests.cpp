@@ -30,6 +30,9 @@
 #include "gtest/gtest.h"
 #include "common/IABElements.h"
 #include "IABUtilities.h"
+#include "commonstream/bitstream/BitStreamIOHelpers.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 using namespace SMPTE::ImmersiveAudioBitstream;
@@ -330,12 +333,565 @@ namespace
             IABSampleRateType dlcSampleRate;
             EXPECT_EQ(iabParserDLCElement->GetDLCSampleRate(dlcSampleRate), kIABNoError);
             EXPECT_EQ(dlcSampleRate, sampleRate_);
+
+            // Re-serializing the parsed element must reproduce the packed element
+            std::stringstream  reserializedBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+            ASSERT_EQ(iabParserDLCElement->Serialize(reserializedBuffer), kIABNoError);
+            EXPECT_EQ(reserializedBuffer.str(), elementBuffer.str());
             
 			delete iabPackerDLCElement;
 			delete iabParserDLCElement;
         }
 
 
+		// Writes a DLC element with predictor regions and alternating PCM/Rice sub blocks to oStream,
+		// and sets up oReference with the same contents for decoding by dlc::FullDecoder.
+		// iSeed selects the residuals, iOrder (1 to 3) the 48k predictor order.
+		void WriteCodedDLCElement(std::stringstream &oStream, dlc::AudioData &oReference, uint32_t iSeed = 12345, uint8_t iOrder = 3)
+		{
+			const uint8_t numSubBlocks = 10;				// 24 fps
+			const uint32_t subBlockSize48 = 200;
+			const uint8_t shiftBits = 2;
+			dlc::SampleRate dlcSampleRate = (sampleRate_ == kIABSampleRate_96000Hz) ? dlc::eSampleRate_96000 : dlc::eSampleRate_48000;
+
+			std::stringstream payloadBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+			StreamWriter payloadWriter(payloadBuffer);
+
+			oReference.setSampleRate(dlcSampleRate);
+			oReference.setShiftBits(shiftBits);
+			oReference.setNumDLCSubBlocks(numSubBlocks);
+
+			payloadWriter.write(static_cast<uint8_t>(dlcSampleRate), 2);
+			payloadWriter.write(shiftBits, 5);
+
+			uint32_t seed = iSeed;
+
+			for (uint8_t layer = 0; layer < (dlcSampleRate == dlc::eSampleRate_96000 ? 2 : 1); layer++)
+			{
+				uint32_t subBlockSize = subBlockSize48 * (layer + 1);
+				dlc::uint10_t kCoeffs[32] = { 0 };
+				kCoeffs[1] = 560;
+				kCoeffs[2] = 490;
+				kCoeffs[3] = 520;
+
+				// One predictor region covering all sub blocks
+				if (layer == 0)
+				{
+					oReference.setNumPredRegions48(1);
+				}
+				else
+				{
+					oReference.setNumPredRegions96(1);
+				}
+
+				dlc::PredRegion &region = (layer == 0) ? oReference.getPredRegion48(0) : oReference.getPredRegion96(0);
+				region.setRegionLength(numSubBlocks);
+				region.setOrder(iOrder - layer);
+				region.setKCoeff(kCoeffs);
+
+				payloadWriter.write(1, 2);
+				payloadWriter.write(region.getRegionLength(), 4);
+				payloadWriter.write(region.getOrder(), 5);
+
+				for (uint8_t m = 1; m <= region.getOrder(); m++)
+				{
+					payloadWriter.write(kCoeffs[m], 10);
+				}
+
+				for (uint8_t n = 0; n < numSubBlocks; n++)
+				{
+					dlc::CodeType codeType = (n % 2) ? dlc::eCodeType_RICE_CODE_TYPE : dlc::eCodeType_PCM_CODE_TYPE;
+
+					if (layer == 0)
+					{
+						oReference.initDLCSubBlock48(n, codeType, subBlockSize);
+					}
+					else
+					{
+						oReference.initDLCSubBlock96(n, codeType, subBlockSize);
+					}
+
+					dlc::ResidualSubBlock *subBlock = (layer == 0) ? oReference.getDLCSubBlock48(n) : oReference.getDLCSubBlock96(n);
+					payloadWriter.write(static_cast<uint8_t>(codeType), 1);
+
+					const uint8_t bitDepth = 10;
+					const uint8_t riceRemBits = 4;
+					payloadWriter.write((codeType == dlc::eCodeType_PCM_CODE_TYPE) ? bitDepth : riceRemBits, 5);
+
+					if (codeType == dlc::eCodeType_PCM_CODE_TYPE)
+					{
+						static_cast<dlc::PCMResidualsSubBlock*>(subBlock)->setBitDepth(bitDepth);
+					}
+					else
+					{
+						static_cast<dlc::RiceResidualsSubBlock*>(subBlock)->setRiceRemBits(riceRemBits);
+					}
+
+					for (uint32_t i = 0; i < subBlockSize; i++)
+					{
+						seed = seed * 1103515245 + 12345;
+						int32_t magnitude = static_cast<int32_t>((seed >> 16) % 400);
+						bool isNegative = ((seed >> 8) & 1) != 0;
+
+						if (codeType == dlc::eCodeType_PCM_CODE_TYPE)
+						{
+							static_cast<dlc::PCMResidualsSubBlock*>(subBlock)->getResiduals()[i] = isNegative ? -magnitude : magnitude;
+							payloadWriter.write(static_cast<uint32_t>(magnitude), bitDepth);
+						}
+						else
+						{
+							dlc::RiceResidual &residual = static_cast<dlc::RiceResidualsSubBlock*>(subBlock)->getResiduals()[i];
+							residual.setQuotient(magnitude >> riceRemBits);
+							residual.setRemainder(magnitude & ((1 << riceRemBits) - 1));
+							residual.setSign((isNegative && magnitude != 0) ? -1 : 1);
+
+							for (int32_t q = 0; q < residual.getQuotient(); q++)
+							{
+								payloadWriter.write(1, 1);
+							}
+
+							payloadWriter.write(0, 1);
+							payloadWriter.write(static_cast<uint32_t>(residual.getRemainder()), riceRemBits);
+						}
+
+						if (magnitude != 0)
+						{
+							payloadWriter.write(isNegative ? 1 : 0, 1);
+						}
+					}
+				}
+			}
+
+			payloadWriter.align();
+
+			std::string payload = payloadBuffer.str();
+			StreamWriter elementWriter(oStream);
+
+			write(elementWriter, Plex<8>(kIABElementID_AudioDataDLC));
+			write(elementWriter, Plex<8>(static_cast<uint32_t>(1 + 2 + payload.size())));
+			write(elementWriter, Plex<8>(dlcAudioDataID_));
+			elementWriter.write(static_cast<uint16_t>(payload.size()), 16);
+
+			for (size_t i = 0; i < payload.size(); i++)
+			{
+				elementWriter.write(static_cast<uint8_t>(payload[i]), 8);
+			}
+
+			elementWriter.align();
+		}
+
+		// Decoding a parsed element (from its parsed residuals) must match decoding the equivalent
+		// dlc::AudioData through dlc::FullDecoder::decode(), at both 48k and 96k.
+		void TestParsedElementDecode()
+		{
+			IABSampleRateType sampleRates[2] = { kIABSampleRate_48000Hz, kIABSampleRate_96000Hz };
+			frameRateCode_ = kIABFrameRate_24FPS;
+
+			for (uint32_t r = 0; r < 2; r++)
+			{
+				sampleRate_ = sampleRates[r];
+
+				std::stringstream elementBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+				dlc::AudioData referenceData;
+				WriteCodedDLCElement(elementBuffer, referenceData);
+
+				IABAudioDataDLC *iabParserDLCElement = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+				ASSERT_TRUE(NULL != iabParserDLCElement);
+
+				elementBuffer.seekg(0, std::ios::beg);
+				StreamReader elementReader(elementBuffer);
+				ASSERT_EQ(iabParserDLCElement->DeSerialize(elementReader), kIABNoError);
+
+				// Decode to the element sample rate, then to 48k from a 96k element
+				for (int32_t d = r; d >= 0; d--)
+				{
+					IABSampleRateType decodeRate = sampleRates[d];
+					uint32_t sampleCount = GetIABNumFrameSamples(frameRateCode_, decodeRate);
+
+					std::vector<int32_t> parsedSamples(sampleCount);
+					std::vector<int32_t> referenceSamples(sampleCount);
+
+					ASSERT_EQ(iabParserDLCElement->DecodeDLCToMonoPCM(parsedSamples.data(), sampleCount, decodeRate), kIABNoError);
+
+					dlc::FullDecoder referenceDecoder;
+					referenceDecoder.decode(referenceSamples.data(), sampleCount
+						, (decodeRate == kIABSampleRate_96000Hz) ? dlc::eSampleRate_96000 : dlc::eSampleRate_48000, referenceData);
+
+					EXPECT_TRUE(parsedSamples == referenceSamples);
+				}
+
+				delete iabParserDLCElement;
+			}
+
+			sampleRate_ = kIABSampleRate_48000Hz;
+		}
+
+		// Group decoding of parsed elements must match decoding each element on its own,
+		// for group sizes below, at and above the batch decoder lane counts.
+		void TestParsedElementGroupDecode()
+		{
+			IABSampleRateType sampleRates[2] = { kIABSampleRate_48000Hz, kIABSampleRate_96000Hz };
+			uint32_t groupSizes[5] = { 1, 5, 13, 16, 21 };
+			frameRateCode_ = kIABFrameRate_24FPS;
+
+			for (uint32_t r = 0; r < 2; r++)
+			{
+				sampleRate_ = sampleRates[r];
+
+				for (uint32_t g = 0; g < 5; g++)
+				{
+					uint32_t groupSize = groupSizes[g];
+					std::vector<IABAudioDataDLC*> elements(groupSize);
+					std::vector<dlc::AudioData> referenceData(groupSize);
+
+					for (uint32_t e = 0; e < groupSize; e++)
+					{
+						std::stringstream elementBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+						WriteCodedDLCElement(elementBuffer, referenceData[e], 1000 + e * 7919, static_cast<uint8_t>(1 + e % 3));
+
+						elements[e] = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+						ASSERT_TRUE(NULL != elements[e]);
+
+						elementBuffer.seekg(0, std::ios::beg);
+						StreamReader elementReader(elementBuffer);
+						ASSERT_EQ(elements[e]->DeSerialize(elementReader), kIABNoError);
+					}
+
+					// Decode to the element sample rate (decodedPCM_ is sized by the first decode)
+					IABSampleRateType decodeRate = sampleRate_;
+					uint32_t sampleCount = GetIABNumFrameSamples(frameRateCode_, decodeRate);
+
+					ASSERT_EQ(IABAudioDataDLC::DecodeDLCToMonoPCMInternal(elements.data(), groupSize, sampleCount, decodeRate), kIABNoError);
+
+					for (uint32_t e = 0; e < groupSize; e++)
+					{
+						std::vector<int32_t> referenceSamples(sampleCount);
+
+						dlc::FullDecoder referenceDecoder;
+						referenceDecoder.decode(referenceSamples.data(), sampleCount
+							, (decodeRate == kIABSampleRate_96000Hz) ? dlc::eSampleRate_96000 : dlc::eSampleRate_48000, referenceData[e]);
+
+						std::vector<int32_t> groupSamples(elements[e]->GetDecodedSampleBuffer(), elements[e]->GetDecodedSampleBuffer() + sampleCount);
+						EXPECT_TRUE(groupSamples == referenceSamples);
+
+						delete elements[e];
+					}
+				}
+			}
+
+			sampleRate_ = kIABSampleRate_48000Hz;
+		}
+
+		// Frame-level decoding must match decoding each element on its own, converted to IABSampleType,
+		// for parsed elements of mixed block lengths and an encoded (not parsed) element.
+		void TestDecodeAllDLC()
+		{
+			IABSampleRateType sampleRates[2] = { kIABSampleRate_48000Hz, kIABSampleRate_96000Hz };
+			const uint32_t parsedCount = 19;
+			frameRateCode_ = kIABFrameRate_24FPS;
+
+			for (uint32_t r = 0; r < 2; r++)
+			{
+				sampleRate_ = sampleRates[r];
+
+				IABFrame *frame = dynamic_cast<IABFrame*>(IABFrameInterface::Create(NULL));
+				ASSERT_TRUE(NULL != frame);
+				ASSERT_EQ(frame->SetSampleRate(sampleRate_), kIABNoError);
+				ASSERT_EQ(frame->SetFrameRate(frameRateCode_), kIABNoError);
+
+				std::vector<IABElement*> subElements;
+				std::vector<dlc::AudioData> referenceData(parsedCount + 1);
+
+				for (uint32_t e = 0; e < parsedCount; e++)
+				{
+					std::stringstream elementBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+					WriteCodedDLCElement(elementBuffer, referenceData[e], 2000 + e * 7919, static_cast<uint8_t>(1 + e % 4));
+
+					IABAudioDataDLC *element = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+					ASSERT_TRUE(NULL != element);
+
+					elementBuffer.seekg(0, std::ios::beg);
+					StreamReader elementReader(elementBuffer);
+					ASSERT_EQ(element->DeSerialize(elementReader), kIABNoError);
+					ASSERT_EQ(element->SetAudioDataID(e + 1), kIABNoError);
+
+					subElements.push_back(element);
+				}
+
+				// Encoded element, decoded without the batch decoder
+				uint32_t sampleCount = GetIABNumFrameSamples(frameRateCode_, sampleRate_);
+				std::vector<int32_t> samples(sampleCount);
+
+				for (uint32_t i = 0; i < sampleCount; i++)
+				{
+					samples[i] = static_cast<int32_t>((i * 2654435761u) >> 8) & ~0xFF;
+				}
+
+				IABAudioDataDLC *encodedElement = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+				ASSERT_TRUE(NULL != encodedElement);
+				ASSERT_EQ(encodedElement->SetAudioDataID(100), kIABNoError);
+				ASSERT_EQ(encodedElement->SetDLCSampleRate(sampleRate_), kIABNoError);
+				ASSERT_EQ(encodedElement->EncodeMonoPCMToDLC(samples.data(), sampleCount), kIABNoError);
+				subElements.push_back(encodedElement);
+
+				ASSERT_EQ(frame->SetSubElements(subElements), kIABNoError);
+
+				std::set<IABAudioDataIDType> allAudioDataIDs;
+
+				for (uint32_t e = 1; e <= parsedCount; e++)
+				{
+					allAudioDataIDs.insert(e);
+				}
+
+				allAudioDataIDs.insert(100);
+
+				// Decode to the frame sample rate, then to 48k from a 96k frame
+				for (int32_t d = r; d >= 0; d--)
+				{
+					IABSampleRateType decodeRate = sampleRates[d];
+					uint32_t decodeSampleCount = GetIABNumFrameSamples(frameRateCode_, decodeRate);
+					dlc::SampleRate dlcDecodeRate = (decodeRate == kIABSampleRate_96000Hz) ? dlc::eSampleRate_96000 : dlc::eSampleRate_48000;
+
+					IABDLCFrameSamples frameSamples;
+					ASSERT_EQ(IABAudioDataDLCInterface::DecodeAllDLC(*frame, allAudioDataIDs, frameSamples, decodeRate), kIABNoError);
+					ASSERT_EQ(frameSamples.sampleCount_, decodeSampleCount);
+					ASSERT_EQ(frameSamples.samples_.size(), (parsedCount + 1) * decodeSampleCount);
+
+					for (uint32_t e = 0; e <= parsedCount; e++)
+					{
+						IABAudioDataIDType audioDataID = (e < parsedCount) ? (e + 1) : 100;
+						std::vector<int32_t> referenceSamples(decodeSampleCount);
+
+						if (e < parsedCount)
+						{
+							dlc::FullDecoder referenceDecoder;
+							referenceDecoder.decode(referenceSamples.data(), decodeSampleCount, dlcDecodeRate, referenceData[e]);
+						}
+						else
+						{
+							ASSERT_EQ(encodedElement->DecodeDLCToMonoPCM(referenceSamples.data(), decodeSampleCount, decodeRate), kIABNoError);
+						}
+
+						const IABSampleType *plane = frameSamples.GetSamples(audioDataID);
+						ASSERT_TRUE(NULL != plane);
+
+						for (uint32_t i = 0; i < decodeSampleCount; i++)
+						{
+							ASSERT_EQ(plane[i], static_cast<IABSampleType>(referenceSamples[i] / kInt32BitMaxValue));
+						}
+					}
+
+					EXPECT_TRUE(NULL == frameSamples.GetSamples(200));
+
+					// Only requested elements are decoded
+					std::set<IABAudioDataIDType> oddAudioDataIDs;
+
+					for (uint32_t e = 1; e <= parsedCount; e += 2)
+					{
+						oddAudioDataIDs.insert(e);
+					}
+
+					IABDLCFrameSamples oddFrameSamples;
+					ASSERT_EQ(IABAudioDataDLCInterface::DecodeAllDLC(*frame, oddAudioDataIDs, oddFrameSamples, decodeRate), kIABNoError);
+					ASSERT_EQ(oddFrameSamples.audioDataIDs_.size(), oddAudioDataIDs.size());
+
+					for (uint32_t e = 1; e <= parsedCount; e++)
+					{
+						const IABSampleType *plane = oddFrameSamples.GetSamples(e);
+
+						if (e % 2)
+						{
+							ASSERT_TRUE(NULL != plane);
+							EXPECT_TRUE(std::equal(plane, plane + decodeSampleCount, frameSamples.GetSamples(e)));
+						}
+						else
+						{
+							EXPECT_TRUE(NULL == plane);
+						}
+					}
+
+					EXPECT_TRUE(NULL == oddFrameSamples.GetSamples(100));
+				}
+
+				// An element that fails to decode gets no plane, the others are kept
+				IABAudioDataDLC *emptyElement = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+				ASSERT_TRUE(NULL != emptyElement);
+				ASSERT_EQ(emptyElement->SetAudioDataID(300), kIABNoError);
+				subElements.insert(subElements.begin() + 3, emptyElement);
+				ASSERT_EQ(frame->SetSubElements(subElements), kIABNoError);
+				allAudioDataIDs.insert(300);
+
+				IABDLCFrameSamples frameSamples;
+				EXPECT_NE(IABAudioDataDLCInterface::DecodeAllDLC(*frame, allAudioDataIDs, frameSamples, sampleRate_), kIABNoError);
+				EXPECT_TRUE(NULL == frameSamples.GetSamples(300));
+				EXPECT_EQ(frameSamples.audioDataIDs_.size(), parsedCount + 1);
+				EXPECT_EQ(frameSamples.samples_.size(), (parsedCount + 1) * frameSamples.sampleCount_);
+
+				IABDLCFrameSamples referenceFrameSamples;
+				allAudioDataIDs.erase(300);
+				ASSERT_EQ(IABAudioDataDLCInterface::DecodeAllDLC(*frame, allAudioDataIDs, referenceFrameSamples, sampleRate_), kIABNoError);
+
+				for (std::set<IABAudioDataIDType>::const_iterator iter = allAudioDataIDs.begin(); iter != allAudioDataIDs.end(); iter++)
+				{
+					const IABSampleType *plane = frameSamples.GetSamples(*iter);
+					ASSERT_TRUE(NULL != plane);
+					EXPECT_TRUE(std::equal(plane, plane + frameSamples.sampleCount_, referenceFrameSamples.GetSamples(*iter)));
+				}
+
+				// 96k decoding needs a 96k frame
+				if (kIABSampleRate_48000Hz == sampleRate_)
+				{
+					IABDLCFrameSamples frameSamples;
+					EXPECT_EQ(IABAudioDataDLCInterface::DecodeAllDLC(*frame, allAudioDataIDs, frameSamples, kIABSampleRate_96000Hz), kIABBadArgumentsError);
+				}
+
+				delete frame;
+			}
+
+			sampleRate_ = kIABSampleRate_48000Hz;
+		}
+
+		// A 96k element parsed without its 96k layer must decode to 48k as the complete element does,
+		// refuse decoding to 96k, and re-serialize to the original bytes.
+		void TestParsedElementSkip96kLayer()
+		{
+			frameRateCode_ = kIABFrameRate_24FPS;
+			sampleRate_ = kIABSampleRate_96000Hz;
+
+			std::stringstream elementBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+			dlc::AudioData referenceData;
+			WriteCodedDLCElement(elementBuffer, referenceData);
+
+			IABAudioDataDLC *iabParserDLCElement = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+			ASSERT_TRUE(NULL != iabParserDLCElement);
+
+			iabParserDLCElement->SetDeSerializeSkips96kLayer(true);
+
+			elementBuffer.seekg(0, std::ios::beg);
+			StreamReader elementReader(elementBuffer);
+			ASSERT_EQ(iabParserDLCElement->DeSerialize(elementReader), kIABNoError);
+
+			IABSampleRateType dlcSampleRate;
+			iabParserDLCElement->GetDLCSampleRate(dlcSampleRate);
+			EXPECT_EQ(dlcSampleRate, kIABSampleRate_96000Hz);
+
+			uint32_t sampleCount = GetIABNumFrameSamples(frameRateCode_, kIABSampleRate_48000Hz);
+			std::vector<int32_t> parsedSamples(sampleCount);
+			std::vector<int32_t> referenceSamples(sampleCount);
+
+			ASSERT_EQ(iabParserDLCElement->DecodeDLCToMonoPCM(parsedSamples.data(), sampleCount, kIABSampleRate_48000Hz), kIABNoError);
+
+			dlc::FullDecoder referenceDecoder;
+			referenceDecoder.decode(referenceSamples.data(), sampleCount, dlc::eSampleRate_48000, referenceData);
+			EXPECT_TRUE(parsedSamples == referenceSamples);
+
+			std::vector<int32_t> samples96k(sampleCount * 2);
+			EXPECT_EQ(iabParserDLCElement->DecodeDLCToMonoPCM(samples96k.data(), sampleCount * 2, kIABSampleRate_96000Hz), kIABParserDLCDecodingError);
+
+			std::stringstream reSerializedBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+			ASSERT_EQ(iabParserDLCElement->Serialize(reSerializedBuffer), kIABNoError);
+			EXPECT_EQ(reSerializedBuffer.str(), elementBuffer.str());
+
+			delete iabParserDLCElement;
+
+			sampleRate_ = kIABSampleRate_48000Hz;
+		}
+
+		// Encodes a tonal frame at each encoding effort level, and checks that the serialized elements
+		// parse and decode to the same samples, with smaller payloads at higher effort levels.
+		void TestEncodeEffort()
+		{
+			const IABSampleRateType sampleRates[] = { kIABSampleRate_48000Hz, kIABSampleRate_96000Hz };
+			const IABDLCEncodeEffortType efforts[] = { kIABDLCEncodeEffort_Minimal, kIABDLCEncodeEffort_Fast, kIABDLCEncodeEffort_Thorough };
+
+			frameRateCode_ = kIABFrameRate_24FPS;
+
+			for (uint32_t r = 0; r < 2; r++)
+			{
+				sampleRate_ = sampleRates[r];
+				frameSampleCount_ = GetIABNumFrameSamples(frameRateCode_, sampleRate_);
+
+				std::vector<int32_t> samples(frameSampleCount_);
+				uint32_t seed = 12345;
+
+				for (uint32_t i = 0; i < frameSampleCount_; i++)
+				{
+					seed = seed * 1103515245 + 12345;
+					double value = 3000000.0 * std::sin(0.02 * i) + 200000.0 * std::sin(0.31 * i) + static_cast<double>((seed >> 16) & 0x3FF);
+					samples[i] = static_cast<int32_t>(value) << 8;
+				}
+
+				std::vector<int32_t> minimalDecoded;
+				uint16_t previousDLCSize = 0;
+
+				for (uint32_t e = 0; e < 3; e++)
+				{
+					IABAudioDataDLC *iabPackerDLCElement = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+					ASSERT_TRUE(NULL != iabPackerDLCElement);
+
+					IABDLCEncodeEffortType encodeEffort;
+					iabPackerDLCElement->GetDLCEncodeEffort(encodeEffort);
+					EXPECT_EQ(encodeEffort, kIABDLCEncodeEffort_Minimal);
+
+					ASSERT_EQ(iabPackerDLCElement->SetAudioDataID(dlcAudioDataID_), kIABNoError);
+					ASSERT_EQ(iabPackerDLCElement->SetDLCSampleRate(sampleRate_), kIABNoError);
+					ASSERT_EQ(iabPackerDLCElement->SetDLCEncodeEffort(efforts[e]), kIABNoError);
+					iabPackerDLCElement->GetDLCEncodeEffort(encodeEffort);
+					EXPECT_EQ(encodeEffort, efforts[e]);
+
+					ASSERT_EQ(iabPackerDLCElement->EncodeMonoPCMToDLC(samples.data(), frameSampleCount_), kIABNoError);
+
+					std::stringstream elementBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+					ASSERT_EQ(iabPackerDLCElement->Serialize(elementBuffer), kIABNoError);
+
+					IABAudioDataDLC *iabParserDLCElement = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+					ASSERT_TRUE(NULL != iabParserDLCElement);
+
+					elementBuffer.seekg(0, std::ios::beg);
+					StreamReader elementReader(elementBuffer);
+					ASSERT_EQ(iabParserDLCElement->DeSerialize(elementReader), kIABNoError);
+
+					uint16_t dlcSize = 0;
+					iabParserDLCElement->GetDLCSize(dlcSize);
+
+					std::vector<int32_t> decoded(frameSampleCount_);
+					ASSERT_EQ(iabParserDLCElement->DecodeDLCToMonoPCM(decoded.data(), frameSampleCount_, sampleRate_), kIABNoError);
+
+					if (kIABSampleRate_48000Hz == sampleRate_)
+					{
+						EXPECT_TRUE(decoded == samples);
+					}
+
+					if (kIABDLCEncodeEffort_Minimal == efforts[e])
+					{
+						minimalDecoded = decoded;
+					}
+					else
+					{
+						// Lossless at all effort levels, with smaller payloads
+						EXPECT_TRUE(decoded == minimalDecoded);
+						EXPECT_LT(dlcSize, previousDLCSize);
+					}
+
+					previousDLCSize = dlcSize;
+
+					// Re-serializing the parsed element must reproduce the packed element
+					std::stringstream reserializedBuffer(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+					ASSERT_EQ(iabParserDLCElement->Serialize(reserializedBuffer), kIABNoError);
+					EXPECT_EQ(reserializedBuffer.str(), elementBuffer.str());
+
+					delete iabPackerDLCElement;
+					delete iabParserDLCElement;
+				}
+			}
+
+			IABAudioDataDLC *iabDLCElement = dynamic_cast<IABAudioDataDLC*>(IABAudioDataDLCInterface::Create(frameRateCode_, sampleRate_));
+			EXPECT_EQ(iabDLCElement->SetDLCEncodeEffort(static_cast<IABDLCEncodeEffortType>(3)), kIABBadArgumentsError);
+			delete iabDLCElement;
+
+			sampleRate_ = kIABSampleRate_48000Hz;
+		}
+
     private:
         
         IABSampleRateType           sampleRate_;
@@ -368,4 +924,34 @@ namespace
 	{
 		TestSerializeDeSerialize96k();
 	}
+
+	// Run decode of parsed DLC elements with predictor regions and Rice coded residuals
+	TEST_F(IABDLCElement_Test, Test_Parsed_Element_Decode)
+	{
+		TestParsedElementDecode();
+	}
+
+	// Run group decode of parsed DLC elements through the lockstep batch decoder
+	TEST_F(IABDLCElement_Test, Test_Parsed_Element_Group_Decode)
+	{
+		TestParsedElementGroupDecode();
+	}
+
+	// Run frame-level decode of all DLC elements of a frame to planar samples
+	TEST_F(IABDLCElement_Test, Test_Decode_All_DLC)
+	{
+		TestDecodeAllDLC();
+	}
+
+	// Run decode and re-serialization of a 96k DLC element parsed without its 96k layer
+	TEST_F(IABDLCElement_Test, Test_Parsed_Element_Skip_96k_Layer)
+	{
+		TestParsedElementSkip96kLayer();
+	}
+
+	// Run encode, serialization and decode of DLC elements at each encoding effort level
+	TEST_F(IABDLCElement_Test, Test_Encode_Effort)
+	{
+		TestEncodeEffort();
+	}
 }
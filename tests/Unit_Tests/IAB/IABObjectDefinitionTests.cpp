@@ -41,6 +41,16 @@ namespace
     // 2. Test Serialize() into a stream (packed buffer)
     // 3. Test DeSerialize() from the stream (packed buffer).
     
+    // Generic element of a given type, standing in for a sub-element when checking allowed sub-element types
+    class IABPlaceholderElement : public IABElement
+    {
+    public:
+
+        IABPlaceholderElement(IABElementIDType iElementID) : IABElement(iElementID) {}
+
+        iabError SerializeToBuffer(IABPackingBuffer&) { return kIABNotImplementedError; }
+    };
+
     class IABObjectDefiniton_Test : public testing::Test
     {
     protected:
@@ -177,15 +187,15 @@ namespace
             EXPECT_EQ(panSubBlocksGet.size(), numPanSubBlocks);
             
             // Valid sub-element type for object definition, these will be deleted by IABObjectDefinition destructor
-            IABElement *objectDefinitionElement = new IABElement(kIABElementID_ObjectDefinition);
-            IABElement *objectZoneElement = new IABElement(kIABElementID_ObjectZoneDefinition19);
+            IABElement *objectDefinitionElement = new IABPlaceholderElement(kIABElementID_ObjectDefinition);
+            IABElement *objectZoneElement = new IABPlaceholderElement(kIABElementID_ObjectZoneDefinition19);
             
             // Invalid sub-element type for bed definition
-            IABElement *frameElement = new IABElement(kIABElementID_IAFrame);
-            IABElement *bedDefinitionElement = new IABElement(kIABElementID_BedDefinition);
-            IABElement *remapElement = new IABElement(kIABElementID_BedRemap);
-            IABElement *dlcAudioElement = new IABElement(kIABElementID_AudioDataDLC);
-            IABElement *pcmAudioElement = new IABElement(kIABElementID_AudioDataPCM);
+            IABElement *frameElement = new IABPlaceholderElement(kIABElementID_IAFrame);
+            IABElement *bedDefinitionElement = new IABPlaceholderElement(kIABElementID_BedDefinition);
+            IABElement *remapElement = new IABPlaceholderElement(kIABElementID_BedRemap);
+            IABElement *dlcAudioElement = new IABPlaceholderElement(kIABElementID_AudioDataDLC);
+            IABElement *pcmAudioElement = new IABPlaceholderElement(kIABElementID_AudioDataPCM);
             
             // Only object definition and object zone definition allowed as sub-elements
             
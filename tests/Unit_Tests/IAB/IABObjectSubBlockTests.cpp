@@ -629,20 +629,23 @@ namespace
             // Set up IAB packer object subBlock
             SetupPackerObjectSubBlock();
             
-            // stream to hold serialized bitstream
-            std::stringstream  objectSubBlockStream(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+            // buffer to hold serialized bitstream
+            std::vector<char> objectSubBlockBytes;
             
-            // stream writer for serialing
-            StreamWriter objectSubBlockWriter(objectSubBlockStream);
+            // bit stream writer for serialing
+            PackingWriter objectSubBlockWriter(objectSubBlockBytes);
             
-            // Serialize object subBlock into stream
+            // Serialize object subBlock into buffer
             ASSERT_EQ(iabPackerObjectSubBlock_->Serialize(objectSubBlockWriter), kIABNoError);
             
-            // If panInfoExists_ = 0, there is only 1 bit to write and current streamwritter will only write a minimum of 8 bits to buffer.
+            // The writer holds written bits until whole bytes are complete.
             // Use align() to force a write so panInfoExists_ = 0 can be tested.
             // Align() would not affect the panInfoExists_ = 1 test case
             objectSubBlockWriter.align();
             
+            // stream holding the serialized bitstream
+            std::stringstream  objectSubBlockStream(std::string(objectSubBlockBytes.begin(), objectSubBlockBytes.end()), std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+            
             // stream reader for de-serializing object subBlock from stream
             StreamReader objectSubBlockReader(objectSubBlockStream);
             
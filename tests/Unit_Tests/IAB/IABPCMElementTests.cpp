@@ -368,8 +368,24 @@ namespace
 				EXPECT_EQ((*inputSample++ & byteMask), (*outputSample++ & byteMask));
 			}
 
+			// Unpack parsed PCM samples, as integer and as renderer float samples
+			IABSampleType* unpackedFloatSamples = new IABSampleType[frameSampleCount_];
+
+			ASSERT_EQ(iabParserPCMElement->UnpackPCMToMonoSamples(unpackedAudioSamples, frameSampleCount_), kIABNoError);
+			ASSERT_EQ(iabParserPCMElement->UnpackPCMToFloatSamples(unpackedFloatSamples, frameSampleCount_), kIABNoError);
+			EXPECT_EQ(iabParserPCMElement->UnpackPCMToFloatSamples(unpackedFloatSamples, frameSampleCount_ - 1), kIABArgumentIncorrectPCMSampleCount);
+
+			for (uint32_t i = 0; i < frameSampleCount_; i++)
+			{
+				int32_t packedSample = static_cast<int32_t>(sourceAudioSamples[i] & byteMask);
+
+				ASSERT_EQ(unpackedAudioSamples[i], packedSample);
+				ASSERT_EQ(unpackedFloatSamples[i], static_cast<IABSampleType>(packedSample / kInt32BitMaxValue));
+			}
+
 			delete[] sourceAudioSamples;
 			delete[] unpackedAudioSamples;
+			delete[] unpackedFloatSamples;
 			delete iabPackerPCMElement;
 			delete iabParserPCMElement;
 		}
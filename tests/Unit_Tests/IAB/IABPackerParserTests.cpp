@@ -31,15 +31,76 @@
 #include "common/IABElements.h"
 #include "packer/IABPacker.h"
 #include "parser/IABParser.h"
+#include "IABUtilities.h"
+#include "commonstream/utils/MappedFile.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string.h>
 #include <vector>
 #include <memory>
+#include <set>
+#include <sstream>
 
 using namespace SMPTE::ImmersiveAudioBitstream;
 
 namespace
 {
     
+#ifdef MT_RENDERER_ENABLED
+    // Pipeline source of DLC element noise, matching the samples of IABPackerParser_Test::PackDLCFrames().
+    // Fails reading frame iFailFrame, if set.
+    class NoisePipelineSource : public IABPackerPipelineSourceInterface
+    {
+    public:
+
+        NoisePipelineSource(const std::vector<IABAudioDataIDType> &iAudioIDs, uint32_t iFrameSampleCount, uint32_t iFailFrame)
+            : audioIDs_(iAudioIDs), frameSampleCount_(iFrameSampleCount), failFrame_(iFailFrame), seed_(12345), metadataUpdates_(0)
+        {
+        }
+
+        iabError ReadFrameSamples(uint32_t iFrameIndex, const std::map<IABAudioDataIDType, int32_t*> &iAudioSources)
+        {
+            if (iFrameIndex == failFrame_)
+            {
+                return kIABSystemIOError;
+            }
+
+            for (uint32_t i = 0; i < audioIDs_.size(); i++)
+            {
+                int32_t *samples = iAudioSources.find(audioIDs_[i])->second;
+
+                for (uint32_t n = 0; n < frameSampleCount_; n++)
+                {
+                    seed_ = seed_ * 1103515245 + 12345;
+                    samples[n] = (static_cast<int32_t>(seed_) >> 12) & ~0xFF;
+                }
+            }
+
+            return kIABNoError;
+        }
+
+        iabError UpdateFrameMetadata(uint32_t iFrameIndex, IABPackerInterface &iPacker)
+        {
+            (void)iPacker;
+
+            // Called in frame order
+            EXPECT_EQ(iFrameIndex, metadataUpdates_);
+            metadataUpdates_++;
+            return kIABNoError;
+        }
+
+    private:
+
+        std::vector<IABAudioDataIDType> audioIDs_;
+        uint32_t frameSampleCount_;
+        uint32_t failFrame_;
+        uint32_t seed_;
+        uint32_t metadataUpdates_;
+    };
+#endif
+
     // IABPacker and IABParser API tests:
     // 1. Test setters and getter APIs
     // 2. Test Packing into a stream (packed buffer)
@@ -632,6 +693,621 @@ namespace
 
             RunIABFramePackParseTestCase();
         }
+
+        void TestIABParserSelectiveParsing()
+        {
+            // Test case: 5.1 bed with one object, authoring tool info and user data
+            numBedDefinitions_ = 1;
+            bedLayout_ = kIABUseCase_5_1;
+            audioIDIndex_ = audioIDStart_;
+            audioDataIDList_.clear();
+            authoringToolInfo_ = "Authoring tool info for IAB unit test";
+
+            for (uint32_t i = 0; i < 32; i++)
+            {
+                userDataBytes_.push_back(i);
+            }
+
+            iabPacker_ = IABPackerInterface::Create();
+            ASSERT_EQ(iabPacker_->SetFrameRate(kIABFrameRate_24FPS), kIABNoError);
+            ASSERT_EQ(iabPacker_->SetSampleRate(kIABSampleRate_48000Hz), kIABNoError);
+            AddElementsToFrame();
+            iabPacker_->PackIABFrame();
+
+            std::vector<char> programBuffer;
+            uint32_t progBufferLen = 0;
+            ASSERT_EQ(iabPacker_->GetPackedBuffer(programBuffer, progBufferLen), kIABNoError);
+            ASSERT_NE(progBufferLen, 0);
+
+            // Parse the packed frame twice, with and without skipping the metadata-only elements
+            std::set<IABElementIDType> skippedElementIDs;
+            skippedElementIDs.insert(kIABElementID_AuthoringToolInfo);
+            skippedElementIDs.insert(kIABElementID_UserData);
+            skippedElementIDs.insert(kIABElementID_ObjectZoneDefinition19);
+
+            iabParser_ = IABParserInterface::Create();
+            EXPECT_TRUE(iabParser_->GetParseSkippedElementIDs().empty());
+            iabParser_->SetParseSkippedElementIDs(skippedElementIDs);
+            EXPECT_EQ(iabParser_->GetParseSkippedElementIDs(), skippedElementIDs);
+
+            ASSERT_EQ(iabParser_->ParseIABFrame(&programBuffer[0], progBufferLen), kIABNoError);
+
+            // Skipped elements are not counted as sub-elements, nor reported as unallowed
+            EXPECT_EQ(iabParser_->GetFrameSubElementCount(), static_cast<IABElementCountType>(expectedElementsInParsedFrame_ - 2));
+            EXPECT_EQ(iabParser_->GetUnallowedFrameSubElementCount(), 0);
+            EXPECT_EQ(iabParser_->GetMaximumAssetsToBeRendered(), static_cast<IABMaxRenderedRangeType>(numBedChannels_ + numObjects_));
+
+            const IABFrameInterface *iabParserFrame = NULL;
+            ASSERT_EQ(kIABNoError, iabParser_->GetIABFrame(iabParserFrame));
+            ASSERT_TRUE(iabParserFrame != NULL);
+
+            std::set<IABElementIDType> frameSkippedElementIDs;
+            iabParserFrame->GetDeSerializeSkippedElementIDs(frameSkippedElementIDs);
+            EXPECT_EQ(frameSkippedElementIDs, skippedElementIDs);
+
+            std::vector<IABElement*> parserSubElements;
+            iabParserFrame->GetSubElements(parserSubElements);
+
+            uint32_t numBedsFound = 0;
+            uint32_t numObjectsFound = 0;
+            uint32_t numDLCElementsFound = 0;
+
+            for (std::vector<IABElement*>::const_iterator iter = parserSubElements.begin(); iter != parserSubElements.end(); iter++)
+            {
+                EXPECT_TRUE(dynamic_cast<const IABAuthoringToolInfoInterface*>(*iter) == NULL);
+                EXPECT_TRUE(dynamic_cast<const IABUserDataInterface*>(*iter) == NULL);
+
+                if (dynamic_cast<const IABBedDefinitionInterface*>(*iter))
+                {
+                    numBedsFound++;
+                }
+                else if (dynamic_cast<const IABObjectDefinitionInterface*>(*iter))
+                {
+                    numObjectsFound++;
+                }
+                else if (dynamic_cast<const IABAudioDataDLCInterface*>(*iter))
+                {
+                    numDLCElementsFound++;
+                }
+            }
+
+            EXPECT_EQ(numBedsFound, numBedDefinitions_);
+            EXPECT_EQ(numObjectsFound, numObjects_);
+            EXPECT_EQ(numDLCElementsFound, numDLCElements_);
+
+            // An empty set restores parsing of all elements
+            iabParser_->SetParseSkippedElementIDs(std::set<IABElementIDType>());
+            ASSERT_EQ(iabParser_->ParseIABFrame(&programBuffer[0], progBufferLen), kIABNoError);
+            EXPECT_EQ(iabParser_->GetFrameSubElementCount(), static_cast<IABElementCountType>(expectedElementsInParsedFrame_));
+
+            IABPackerInterface::Delete(iabPacker_);
+            IABParserInterface::Delete(iabParser_);
+        }
+
+        // Pack iNumFrames frames from iabPacker_ and append to oStreamData
+        void PackFramesToStreamData(uint32_t iNumFrames, std::vector<uint8_t> &oStreamData)
+        {
+            for (uint32_t i = 0; i < iNumFrames; i++)
+            {
+                ASSERT_EQ(iabPacker_->PackIABFrame(), kIABNoError);
+
+                std::vector<char> programBuffer;
+                uint32_t progBufferLen = 0;
+                ASSERT_EQ(iabPacker_->GetPackedBuffer(programBuffer, progBufferLen), kIABNoError);
+                ASSERT_NE(progBufferLen, 0);
+                oStreamData.insert(oStreamData.end(), programBuffer.begin(), programBuffer.begin() + progBufferLen);
+            }
+        }
+
+        void TestIABParserFeed()
+        {
+            // Test case: 5.1 bed with one object
+            numBedDefinitions_ = 1;
+            bedLayout_ = kIABUseCase_5_1;
+            audioIDIndex_ = audioIDStart_;
+            audioDataIDList_.clear();
+
+            iabPacker_ = IABPackerInterface::Create();
+            ASSERT_EQ(iabPacker_->SetFrameRate(kIABFrameRate_24FPS), kIABNoError);
+            ASSERT_EQ(iabPacker_->SetSampleRate(kIABSampleRate_48000Hz), kIABNoError);
+            AddElementsToFrame();
+
+            // Build a stream of frames, preceded by bytes that are not part of any frame
+            // to emulate joining a stream mid-frame
+            const uint32_t numFrames = 3;
+            std::vector<uint8_t> streamData;
+            streamData.push_back(0xAA);
+            streamData.push_back(0x55);
+            streamData.push_back(0x00);
+
+            PackFramesToStreamData(numFrames, streamData);
+
+            iabParser_ = IABParserInterface::Create();
+            EXPECT_EQ(iabParser_->GetFedFrameCount(), 0);
+
+            IABFrameInterface* fedFrame = NULL;
+            EXPECT_EQ(iabParser_->GetFedFrameReleased(fedFrame), kIABParserNoParsedFrameError);
+            EXPECT_TRUE(fedFrame == NULL);
+
+            // Feed in chunks of varying size, unaligned with frame boundaries
+            const size_t chunkSizes[] = { 1, 7, 97, 1000 };
+            size_t offset = 0;
+            uint32_t chunkIndex = 0;
+            uint32_t numFramesReleased = 0;
+
+            while (offset < streamData.size())
+            {
+                size_t chunkSize = std::min(chunkSizes[chunkIndex++ % 4], streamData.size() - offset);
+                ASSERT_EQ(iabParser_->Feed(&streamData[offset], chunkSize), kIABNoError);
+                offset += chunkSize;
+
+                while (iabParser_->GetFedFrameCount() > 0)
+                {
+                    ASSERT_EQ(iabParser_->GetFedFrameReleased(fedFrame), kIABNoError);
+                    ASSERT_TRUE(fedFrame != NULL);
+
+                    IABElementCountType frameSubElementCount = 0;
+                    fedFrame->GetSubElementCount(frameSubElementCount);
+                    EXPECT_EQ(frameSubElementCount, static_cast<IABElementCountType>(expectedElementsInParsedFrame_));
+
+                    IABMaxRenderedRangeType maxRendered = 0;
+                    fedFrame->GetMaxRendered(maxRendered);
+                    EXPECT_EQ(maxRendered, static_cast<IABMaxRenderedRangeType>(numBedChannels_ + numObjects_));
+
+                    IABFrameInterface::Delete(fedFrame);
+                    numFramesReleased++;
+                }
+            }
+
+            EXPECT_EQ(numFramesReleased, numFrames);
+
+            // Feeding all frames in a single chunk queues all of them
+            ASSERT_EQ(iabParser_->Feed(&streamData[0], streamData.size()), kIABNoError);
+            EXPECT_EQ(iabParser_->GetFedFrameCount(), numFrames);
+
+            // Queued frames are deleted with the parser
+            IABPackerInterface::Delete(iabPacker_);
+            IABParserInterface::Delete(iabParser_);
+        }
+
+        void TestIABParserFrameIndex()
+        {
+            // Test case: 5.1 bed with one object
+            numBedDefinitions_ = 1;
+            bedLayout_ = kIABUseCase_5_1;
+            audioIDIndex_ = audioIDStart_;
+            audioDataIDList_.clear();
+
+            iabPacker_ = IABPackerInterface::Create();
+            ASSERT_EQ(iabPacker_->SetFrameRate(kIABFrameRate_24FPS), kIABNoError);
+            ASSERT_EQ(iabPacker_->SetSampleRate(kIABSampleRate_48000Hz), kIABNoError);
+            AddElementsToFrame();
+
+            // Single-file bitstream of frames
+            const uint32_t numFrames = 4;
+            std::vector<uint8_t> streamData;
+            std::vector<uint64_t> frameOffsets;
+            std::vector<uint64_t> frameEnds;
+
+            for (uint32_t i = 0; i < numFrames; i++)
+            {
+                frameOffsets.push_back(streamData.size());
+                PackFramesToStreamData(1, streamData);
+                frameEnds.push_back(streamData.size());
+            }
+
+            // Add a truncated frame at end of stream, which must not be indexed
+            std::vector<uint8_t> truncatedFrame;
+            PackFramesToStreamData(1, truncatedFrame);
+            streamData.insert(streamData.end(), truncatedFrame.begin(), truncatedFrame.begin() + truncatedFrame.size() / 2);
+
+            std::stringstream packedStream(std::string(streamData.begin(), streamData.end()));
+
+            iabParser_ = IABParserInterface::Create(&packedStream);
+            EXPECT_EQ(iabParser_->GetIndexedFrameCount(), 0);
+            EXPECT_EQ(iabParser_->SeekToFrame(0), kIABParserFrameIndexError);
+
+            ASSERT_EQ(iabParser_->BuildFrameIndex(), kIABNoError);
+            ASSERT_EQ(iabParser_->GetIndexedFrameCount(), numFrames);
+
+            for (uint32_t i = 0; i < numFrames; i++)
+            {
+                uint64_t offset = 0;
+                uint32_t size = 0;
+                ASSERT_EQ(iabParser_->GetIndexedFrameLocation(i, offset, size), kIABNoError);
+                EXPECT_EQ(offset, frameOffsets[i]);
+                EXPECT_EQ(offset + size, frameEnds[i]);
+            }
+
+            // Random access, out of order. Stream must end up at the end of the requested frame.
+            const uint32_t seekOrder[] = { 2, 0, 3, 1 };
+
+            for (uint32_t i = 0; i < numFrames; i++)
+            {
+                ASSERT_EQ(iabParser_->SeekToFrame(seekOrder[i]), kIABNoError);
+                ASSERT_EQ(iabParser_->ParseIABFrame(), kIABNoError);
+                EXPECT_EQ(static_cast<uint64_t>(packedStream.tellg()), frameEnds[seekOrder[i]]);
+            }
+
+            EXPECT_EQ(iabParser_->SeekToFrame(numFrames), kIABBadArgumentsError);
+
+            // Sidecar index round trip
+            const std::string indexFilePath = "IABFrameIndexTest.idx";
+            ASSERT_EQ(iabParser_->SaveFrameIndex(indexFilePath), kIABNoError);
+
+            IABParserInterface* indexedParser = IABParserInterface::Create(&packedStream);
+            ASSERT_EQ(indexedParser->LoadFrameIndex(indexFilePath), kIABNoError);
+            ASSERT_EQ(indexedParser->GetIndexedFrameCount(), numFrames);
+            ASSERT_EQ(indexedParser->SeekToFrame(3), kIABNoError);
+            ASSERT_EQ(indexedParser->ParseIABFrame(), kIABNoError);
+            EXPECT_EQ(static_cast<uint64_t>(packedStream.tellg()), frameEnds[3]);
+            IABParserInterface::Delete(indexedParser);
+
+            // Index of a different bitstream is rejected
+            std::stringstream otherStream(std::string(streamData.begin(), streamData.begin() + frameOffsets[2]));
+            IABParserInterface* otherParser = IABParserInterface::Create(&otherStream);
+            EXPECT_EQ(otherParser->LoadFrameIndex(indexFilePath), kIABParserFrameIndexError);
+            EXPECT_EQ(otherParser->GetIndexedFrameCount(), 0);
+            IABParserInterface::Delete(otherParser);
+
+            std::remove(indexFilePath.c_str());
+
+            IABPackerInterface::Delete(iabPacker_);
+            IABParserInterface::Delete(iabParser_);
+        }
+
+#ifdef MT_RENDERER_ENABLED
+        // Returns authoring tool info text of iFrame, empty if none
+        std::string GetFrameAuthoringToolInfo(const IABFrameInterface *iFrame)
+        {
+            std::vector<IABElement*> frameSubElements;
+            iFrame->GetSubElements(frameSubElements);
+
+            for (uint32_t i = 0; i < frameSubElements.size(); i++)
+            {
+                IABAuthoringToolInfoInterface *authoringToolInfo = dynamic_cast<IABAuthoringToolInfoInterface*>(frameSubElements[i]);
+
+                if (authoringToolInfo)
+                {
+                    const char *info = NULL;
+                    authoringToolInfo->GetAuthoringToolInfo(info);
+                    return std::string(info ? info : "");
+                }
+            }
+
+            return std::string();
+        }
+
+        void TestIABParserMT()
+        {
+            // Test case: 5.1 bed with one object, authoring tool info identifies each frame
+            numBedDefinitions_ = 1;
+            bedLayout_ = kIABUseCase_5_1;
+            audioIDIndex_ = audioIDStart_;
+            audioDataIDList_.clear();
+            authoringToolInfo_ = "frame 0";
+
+            iabPacker_ = IABPackerInterface::Create();
+            ASSERT_EQ(iabPacker_->SetFrameRate(kIABFrameRate_24FPS), kIABNoError);
+            ASSERT_EQ(iabPacker_->SetSampleRate(kIABSampleRate_48000Hz), kIABNoError);
+            AddElementsToFrame();
+
+            const uint32_t numFrames = 12;
+            std::vector<uint8_t> streamData;
+
+            for (uint32_t i = 0; i < numFrames; i++)
+            {
+                std::stringstream frameName;
+                frameName << "frame " << i;
+                ASSERT_EQ(iabPacker_->AddAuthoringToolInfo(frameName.str()), kIABNoError);
+                PackFramesToStreamData(1, streamData);
+            }
+
+            std::stringstream packedStream(std::string(streamData.begin(), streamData.end()));
+
+            iabParser_ = IABParserInterface::Create(&packedStream);
+
+            // Frame index is required
+            IABParserMTInterface *parserMT = IABParserMTInterface::Create(&packedStream, 3, 4);
+            ASSERT_TRUE(parserMT != NULL);
+            IABFrameInterface *parsedFrame = NULL;
+            EXPECT_EQ(parserMT->GetNextIABFrameReleased(parsedFrame), kIABBadArgumentsError);
+            EXPECT_EQ(parserMT->Start(*iabParser_, 0, 0), kIABParserFrameIndexError);
+
+            ASSERT_EQ(iabParser_->BuildFrameIndex(), kIABNoError);
+            EXPECT_EQ(parserMT->Start(*iabParser_, numFrames, 0), kIABBadArgumentsError);
+
+            // All frames, delivered in order
+            ASSERT_EQ(parserMT->Start(*iabParser_, 0, 0), kIABNoError);
+            EXPECT_EQ(parserMT->Start(*iabParser_, 0, 0), kIABBadArgumentsError);
+
+            for (uint32_t i = 0; i < numFrames; i++)
+            {
+                ASSERT_EQ(parserMT->GetNextIABFrameReleased(parsedFrame), kIABNoError);
+                ASSERT_TRUE(parsedFrame != NULL);
+
+                std::stringstream frameName;
+                frameName << "frame " << i;
+                EXPECT_EQ(GetFrameAuthoringToolInfo(parsedFrame), frameName.str());
+
+                IABElementCountType frameSubElementCount = 0;
+                parsedFrame->GetSubElementCount(frameSubElementCount);
+                EXPECT_EQ(frameSubElementCount, expectedElementsInParsedFrame_);
+
+                IABFrameInterface::Delete(parsedFrame);
+            }
+
+            EXPECT_EQ(parserMT->GetNextIABFrameReleased(parsedFrame), kIABParserEndOfStreamReached);
+            EXPECT_TRUE(parsedFrame == NULL);
+            EXPECT_EQ(parserMT->GetUnallowedFrameSubElementCount(), 0);
+            IABParserMTInterface::Delete(parserMT);
+
+            // Frame range, with deletion before all frames are delivered
+            parserMT = IABParserMTInterface::Create(&packedStream, 2, 2);
+            ASSERT_EQ(parserMT->Start(*iabParser_, 5, 4), kIABNoError);
+
+            for (uint32_t i = 5; i < 7; i++)
+            {
+                ASSERT_EQ(parserMT->GetNextIABFrameReleased(parsedFrame), kIABNoError);
+
+                std::stringstream frameName;
+                frameName << "frame " << i;
+                EXPECT_EQ(GetFrameAuthoringToolInfo(parsedFrame), frameName.str());
+
+                IABFrameInterface::Delete(parsedFrame);
+            }
+
+            IABParserMTInterface::Delete(parserMT);
+
+            authoringToolInfo_.clear();
+            IABPackerInterface::Delete(iabPacker_);
+            IABParserInterface::Delete(iabParser_);
+        }
+#endif
+
+        void TestIABParserMappedInput()
+        {
+            // Test case: 5.1 bed with one object
+            numBedDefinitions_ = 1;
+            bedLayout_ = kIABUseCase_5_1;
+            audioIDIndex_ = audioIDStart_;
+            audioDataIDList_.clear();
+
+            iabPacker_ = IABPackerInterface::Create();
+            ASSERT_EQ(iabPacker_->SetFrameRate(kIABFrameRate_24FPS), kIABNoError);
+            ASSERT_EQ(iabPacker_->SetSampleRate(kIABSampleRate_48000Hz), kIABNoError);
+            AddElementsToFrame();
+
+            const uint32_t numFrames = 3;
+            std::vector<uint8_t> streamData;
+            PackFramesToStreamData(numFrames, streamData);
+
+            const std::string streamFilePath = "IABMappedInputTest.iab";
+            std::ofstream streamFile(streamFilePath.c_str(), std::ofstream::out | std::ofstream::binary);
+            streamFile.write(reinterpret_cast<const char*>(&streamData[0]), streamData.size());
+            streamFile.close();
+
+            CommonStream::MappedIStream mappedStream;
+            EXPECT_NE(mappedStream.open("IABMappedInputTest.missing"), CMNSTRM_OK);
+            EXPECT_FALSE(mappedStream.is_open());
+
+            ASSERT_EQ(mappedStream.open(streamFilePath), CMNSTRM_OK);
+            ASSERT_TRUE(mappedStream.is_open());
+            ASSERT_EQ(mappedStream.size(), streamData.size());
+            EXPECT_EQ(memcmp(mappedStream.data(), &streamData[0], streamData.size()), 0);
+
+            // Parse frames from the mapping, releasing parsed pages as we go
+            iabParser_ = IABParserInterface::Create(&mappedStream);
+            uint32_t parsedFrames = 0;
+
+            while (iabParser_->ParseIABFrame() == kIABNoError)
+            {
+                mappedStream.releaseConsumed();
+                parsedFrames++;
+            }
+
+            EXPECT_EQ(parsedFrames, numFrames);
+
+            // Index and seek on mapped input
+            ASSERT_EQ(iabParser_->BuildFrameIndex(), kIABNoError);
+            EXPECT_EQ(iabParser_->GetIndexedFrameCount(), numFrames);
+            ASSERT_EQ(iabParser_->SeekToFrame(numFrames - 1), kIABNoError);
+            EXPECT_EQ(iabParser_->ParseIABFrame(), kIABNoError);
+
+            IABParserInterface::Delete(iabParser_);
+
+            // Single-frame buffer parsed in place
+            iabParser_ = IABParserInterface::Create();
+            EXPECT_EQ(iabParser_->ParseIABFrame(const_cast<char*>(mappedStream.data()), static_cast<uint32_t>(streamData.size() / numFrames)), kIABNoError);
+
+            mappedStream.close();
+            EXPECT_FALSE(mappedStream.is_open());
+            std::remove(streamFilePath.c_str());
+
+            IABPackerInterface::Delete(iabPacker_);
+            IABParserInterface::Delete(iabParser_);
+        }
+
+        // Packs numFrames frames of DLC elements of noise at 96kHz, encoded on iThreadPoolSize threads
+        void PackDLCFrames(uint32_t iThreadPoolSize, IABDLCEncodeEffortType iEncodeEffort, uint32_t numFrames, std::vector<char> &oStreamData)
+        {
+            const uint32_t numElements = 20;
+            const uint32_t frameSampleCount = GetIABNumFrameSamples(kIABFrameRate_24FPS, kIABSampleRate_96000Hz);
+
+            IABPackerInterface* packer = IABPackerInterface::Create();
+            ASSERT_EQ(packer->SetFrameRate(kIABFrameRate_24FPS), kIABNoError);
+            ASSERT_EQ(packer->SetSampleRate(kIABSampleRate_96000Hz), kIABNoError);
+            ASSERT_EQ(packer->SetDLCEncodeThreadPoolSize(iThreadPoolSize), kIABNoError);
+
+            std::vector<IABAudioDataIDType> audioIDs;
+
+            for (uint32_t i = 0; i < numElements; i++)
+            {
+                audioIDs.push_back(static_cast<IABAudioDataIDType>(audioIDStart_ + i));
+            }
+
+            ASSERT_EQ(packer->AddDLCElements(audioIDs), kIABNoError);
+            ASSERT_EQ(packer->SetDLCEncodeEffort(iEncodeEffort), kIABNoError);
+
+            std::vector<std::vector<int32_t> > samples(numElements, std::vector<int32_t>(frameSampleCount));
+            uint32_t seed = 12345;
+
+            for (uint32_t frame = 0; frame < numFrames; frame++)
+            {
+                std::map<IABAudioDataIDType, int32_t*> audioSamplesMap;
+
+                for (uint32_t i = 0; i < numElements; i++)
+                {
+                    for (uint32_t n = 0; n < frameSampleCount; n++)
+                    {
+                        seed = seed * 1103515245 + 12345;
+                        samples[i][n] = (static_cast<int32_t>(seed) >> 12) & ~0xFF;
+                    }
+
+                    audioSamplesMap[audioIDs[i]] = &samples[i][0];
+                }
+
+                ASSERT_EQ(packer->UpdateAudioSamples(audioSamplesMap), kIABNoError);
+                ASSERT_EQ(packer->PackIABFrame(), kIABNoError);
+
+                std::vector<char> frameBuffer;
+                uint32_t frameBufferLength = 0;
+                ASSERT_EQ(packer->GetPackedBuffer(frameBuffer, frameBufferLength), kIABNoError);
+                oStreamData.insert(oStreamData.end(), frameBuffer.begin(), frameBuffer.begin() + frameBufferLength);
+            }
+
+            IABPackerInterface::Delete(packer);
+        }
+
+        void TestIABPackerDLCEncodeThreadPool()
+        {
+            const uint32_t numFrames = 3;
+
+            // Packed stream is identical whichever thread encodes an element
+            std::vector<char> serialStream;
+            PackDLCFrames(1, kIABDLCEncodeEffort_Minimal, numFrames, serialStream);
+            ASSERT_FALSE(serialStream.empty());
+
+            std::vector<char> threadedStream;
+            PackDLCFrames(4, kIABDLCEncodeEffort_Minimal, numFrames, threadedStream);
+            EXPECT_TRUE(serialStream == threadedStream);
+
+            // Higher encoding effort, set after the DLC elements are added
+            std::vector<char> serialFastStream;
+            PackDLCFrames(1, kIABDLCEncodeEffort_Fast, numFrames, serialFastStream);
+            EXPECT_LT(serialFastStream.size(), serialStream.size());
+
+            std::vector<char> threadedFastStream;
+            PackDLCFrames(4, kIABDLCEncodeEffort_Fast, numFrames, threadedFastStream);
+            EXPECT_TRUE(serialFastStream == threadedFastStream);
+
+            // Out of range pool sizes are clamped
+            IABPackerInterface* packer = IABPackerInterface::Create();
+            EXPECT_EQ(packer->SetDLCEncodeThreadPoolSize(0), kIABNoError);
+            EXPECT_EQ(packer->SetDLCEncodeThreadPoolSize(1000), kIABNoError);
+
+            // Out of range effort is rejected, with or without DLC elements in the frame
+            EXPECT_EQ(packer->SetDLCEncodeEffort(static_cast<IABDLCEncodeEffortType>(3)), kIABBadArgumentsError);
+            EXPECT_EQ(packer->AddDLCElements(std::vector<IABAudioDataIDType>(1, audioIDStart_)), kIABNoError);
+            EXPECT_EQ(packer->SetDLCEncodeEffort(static_cast<IABDLCEncodeEffortType>(3)), kIABBadArgumentsError);
+            EXPECT_EQ(packer->SetDLCEncodeEffort(kIABDLCEncodeEffort_Fast), kIABNoError);
+            IABPackerInterface::Delete(packer);
+        }
+
+#ifdef MT_RENDERER_ENABLED
+        // Packs numFrames frames of DLC elements of noise at 96kHz through IABPackerPipelineInterface
+        iabError PackDLCFramesPipeline(uint32_t iThreadPoolSize, uint32_t iMaxFramesInFlight, uint32_t numFrames, uint32_t iFailFrame, std::vector<char> &oStreamData)
+        {
+            const uint32_t numElements = 20;
+            const uint32_t frameSampleCount = GetIABNumFrameSamples(kIABFrameRate_24FPS, kIABSampleRate_96000Hz);
+
+            IABPackerInterface* packer = IABPackerInterface::Create();
+            EXPECT_EQ(packer->SetFrameRate(kIABFrameRate_24FPS), kIABNoError);
+            EXPECT_EQ(packer->SetSampleRate(kIABSampleRate_96000Hz), kIABNoError);
+
+            std::vector<IABAudioDataIDType> audioIDs;
+
+            for (uint32_t i = 0; i < numElements; i++)
+            {
+                audioIDs.push_back(static_cast<IABAudioDataIDType>(audioIDStart_ + i));
+            }
+
+            EXPECT_EQ(packer->AddDLCElements(audioIDs), kIABNoError);
+            EXPECT_EQ(packer->SetDLCEncodeEffort(kIABDLCEncodeEffort_Minimal), kIABNoError);
+
+            std::stringstream outputStream;
+            NoisePipelineSource source(audioIDs, frameSampleCount, iFailFrame);
+
+            IABPackerPipelineInterface* pipeline = IABPackerPipelineInterface::Create(packer, &outputStream, iThreadPoolSize, iMaxFramesInFlight);
+            EXPECT_TRUE(pipeline != NULL);
+
+            iabError errorCode = pipeline->Run(&source, audioIDs, numFrames);
+
+            // Can only run once
+            EXPECT_EQ(pipeline->Run(&source, audioIDs, numFrames), kIABBadArgumentsError);
+
+            IABPackerPipelineStageStats readStats, encodeStats, writeStats;
+            pipeline->GetStageStats(readStats, encodeStats, writeStats);
+
+            if (kIABNoError == errorCode)
+            {
+                EXPECT_EQ(readStats.frames_, numFrames);
+                EXPECT_EQ(encodeStats.frames_, numFrames);
+                EXPECT_EQ(writeStats.frames_, numFrames);
+                EXPECT_EQ(readStats.bytes_, static_cast<uint64_t>(numFrames) * numElements * frameSampleCount * sizeof(int32_t));
+                EXPECT_EQ(writeStats.bytes_, encodeStats.bytes_);
+            }
+
+            // Frames written before a failure are in the output
+            EXPECT_EQ(outputStream.str().size(), writeStats.bytes_);
+
+            std::string streamData = outputStream.str();
+            oStreamData.assign(streamData.begin(), streamData.end());
+
+            IABPackerPipelineInterface::Delete(pipeline);
+            IABPackerInterface::Delete(packer);
+
+            return errorCode;
+        }
+
+        void TestIABPackerPipeline()
+        {
+            const uint32_t numFrames = 5;
+            const uint32_t noFailFrame = 0xFFFFFFFF;
+
+            std::vector<char> serialStream;
+            PackDLCFrames(1, kIABDLCEncodeEffort_Minimal, numFrames, serialStream);
+            ASSERT_FALSE(serialStream.empty());
+
+            // Pipelined stream is identical to frame by frame packing, in frame order
+            std::vector<char> pipelineStream;
+            EXPECT_EQ(PackDLCFramesPipeline(1, 3, numFrames, noFailFrame, pipelineStream), kIABNoError);
+            EXPECT_TRUE(serialStream == pipelineStream);
+
+            pipelineStream.clear();
+            EXPECT_EQ(PackDLCFramesPipeline(4, 2, numFrames, noFailFrame, pipelineStream), kIABNoError);
+            EXPECT_TRUE(serialStream == pipelineStream);
+
+            // Read error stops the pipeline, and only frames before the failing frame are written
+            pipelineStream.clear();
+            EXPECT_EQ(PackDLCFramesPipeline(4, 3, numFrames, 2, pipelineStream), kIABSystemIOError);
+            EXPECT_LT(pipelineStream.size(), serialStream.size());
+            EXPECT_TRUE(std::equal(pipelineStream.begin(), pipelineStream.end(), serialStream.begin()));
+
+            // Bad arguments
+            std::stringstream outputStream;
+            EXPECT_TRUE(IABPackerPipelineInterface::Create(NULL, &outputStream, 1, 3) == NULL);
+
+            IABPackerInterface* packer = IABPackerInterface::Create();
+            EXPECT_TRUE(IABPackerPipelineInterface::Create(packer, NULL, 1, 3) == NULL);
+
+            IABPackerPipelineInterface* pipeline = IABPackerPipelineInterface::Create(packer, &outputStream, 1, 3);
+            std::vector<IABAudioDataIDType> audioIDs;
+            EXPECT_EQ(pipeline->Run(NULL, audioIDs, numFrames), kIABBadArgumentsError);
+            IABPackerPipelineInterface::Delete(pipeline);
+            IABPackerInterface::Delete(packer);
+        }
+#endif
         
     private:
 
@@ -723,5 +1399,42 @@ namespace
     {
         TestIABParserSkipUnsupportedElements();
     }
+
+    TEST_F(IABPackerParser_Test, Test_IABParserSelectiveParsing)
+    {
+        TestIABParserSelectiveParsing();
+    }
+
+    TEST_F(IABPackerParser_Test, Test_IABParserFeed)
+    {
+        TestIABParserFeed();
+    }
+
+    TEST_F(IABPackerParser_Test, Test_IABParserFrameIndex)
+    {
+        TestIABParserFrameIndex();
+    }
+
+    TEST_F(IABPackerParser_Test, Test_IABParserMappedInput)
+    {
+        TestIABParserMappedInput();
+    }
+
+    TEST_F(IABPackerParser_Test, Test_IABPackerDLCEncodeThreadPool)
+    {
+        TestIABPackerDLCEncodeThreadPool();
+    }
+
+#ifdef MT_RENDERER_ENABLED
+    TEST_F(IABPackerParser_Test, Test_IABParserMT)
+    {
+        TestIABParserMT();
+    }
+
+    TEST_F(IABPackerParser_Test, Test_IABPackerPipeline)
+    {
+        TestIABPackerPipeline();
+    }
+#endif
     
 }
@@ -39,6 +39,7 @@ namespace
     // 1. Test setters and getter APIs
     // 2. Test Serialize() into a stream (packed buffer)
     // 3. Test DeSerialize() from the stream (packed buffer).
+    // 4. Test Serialize() when the element size changes across Plex(8) ranges.
     
     class IABUserData_Test : public testing::Test
     {
@@ -207,6 +208,79 @@ namespace
 			delete iabParserUserData_;
 		}
 
+        // **********************************************
+        // Function to test Serialize() with a stale element size
+        // **********************************************
+
+        // Re-serialize one element with user data sizes that cross the 8-, 16- and 32-bit Plex(8) ranges
+        // of the element size field, in both directions. The size field width reserved before the payload
+        // is written then differs from the final width, and the payload has to be moved in the buffer.
+        void TestSerializeSizeFieldResize()
+        {
+			iabPackerUserData_ = new IABUserData();
+			ASSERT_TRUE(NULL != iabPackerUserData_);
+
+			uint8_t userID[16] = { 0x06,0x0E,0x2B,0x34,0x04,0x01,0x01,0x0D,0x0F,0x01,0x02,0x03,0x04,0x05,0x06,0x07 };
+			EXPECT_EQ(iabPackerUserData_->SetUserID(userID), kIABNoError);
+
+			const uint32_t userDataSizes[] = { 100, 3000, 70000, 200, 70000, 3000, 100 };
+
+			for (uint32_t n = 0; n < sizeof(userDataSizes) / sizeof(userDataSizes[0]); n++)
+			{
+				std::vector<uint8_t> testUserData(userDataSizes[n]);
+
+				for (uint32_t i = 0; i < userDataSizes[n]; i++)
+				{
+					testUserData[i] = static_cast<uint8_t>(i * 7 + n);
+				}
+
+				EXPECT_EQ(iabPackerUserData_->SetUserDataBytes(testUserData), kIABNoError);
+
+				// Serialize behind some bytes already in the buffer, as for a sub-element
+				std::vector<char> packedBytes(5, 0x55);
+				IABPackingBuffer packingBuffer(packedBytes);
+				ASSERT_EQ(iabPackerUserData_->SerializeToBuffer(packingBuffer), kIABNoError);
+
+				// Expected: existing bytes, element ID (0xFF0101), Plex(8) coded size, user ID and user data
+				uint32_t elementSize = 16 + userDataSizes[n];
+				std::vector<char> expectedBytes(5, 0x55);
+				expectedBytes.push_back(static_cast<char>(0xFF));
+				expectedBytes.push_back(0x01);
+				expectedBytes.push_back(0x01);
+
+				if (elementSize < 255)
+				{
+					expectedBytes.push_back(static_cast<char>(elementSize));
+				}
+				else if (elementSize < 65535)
+				{
+					expectedBytes.push_back(static_cast<char>(0xFF));
+					expectedBytes.push_back(static_cast<char>(elementSize >> 8));
+					expectedBytes.push_back(static_cast<char>(elementSize));
+				}
+				else
+				{
+					expectedBytes.insert(expectedBytes.end(), 3, static_cast<char>(0xFF));
+					expectedBytes.push_back(static_cast<char>(elementSize >> 24));
+					expectedBytes.push_back(static_cast<char>(elementSize >> 16));
+					expectedBytes.push_back(static_cast<char>(elementSize >> 8));
+					expectedBytes.push_back(static_cast<char>(elementSize));
+				}
+
+				expectedBytes.insert(expectedBytes.end(), userID, userID + 16);
+				expectedBytes.insert(expectedBytes.end(), testUserData.begin(), testUserData.end());
+
+				IABElementSizeType packedElementSize = 0;
+				iabPackerUserData_->GetElementSize(packedElementSize);
+				EXPECT_EQ(packedElementSize, elementSize);
+
+				ASSERT_EQ(packedBytes.size(), expectedBytes.size());
+				EXPECT_TRUE(packedBytes == expectedBytes);
+			}
+
+			delete iabPackerUserData_;
+		}
+
     private:
         
         IABUserData*   iabPackerUserData_;
@@ -279,5 +353,11 @@ namespace
     {
         TestSerializeDeSerialize();
     }
+
+    // Run serialize IAB user data with element sizes changing across Plex(8) ranges
+    TEST_F(IABUserData_Test, Test_Serialize_Size_Field_Resize)
+    {
+        TestSerializeSizeFieldResize();
+    }
     
 }
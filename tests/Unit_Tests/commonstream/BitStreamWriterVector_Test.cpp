@@ -0,0 +1,198 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "commonstream/bitstream/BitStreamWriterT.h"
+#include "commonstream/bitstream/BitStreamWriterVector.h"
+#include "commonstream/bitstream/BitStreamIOHelpers.h"
+
+using namespace CommonStream;
+
+// BitStreamWriterT<std::vector<char> > tests:
+// 1. Same bits as the generic writer, for a random mix of field widths, byte runs and helpers
+// 2. writeUnary() matches the unary code written field by field
+// 3. Appending to existing buffer contents, and back-patching the buffer while aligned
+
+class BitStreamWriterVector_Test : public testing::Test {
+
+protected:
+
+    // Writes the same pseudo random sequence of fields to any bit stream writer
+    template<typename StreamType>
+    void WriteFields(BitStreamWriterT<StreamType> &bsw)
+    {
+        uint32_t seed = 2024;
+        uint8_t bytes[37];
+
+        for (uint32_t i = 0; i < sizeof(bytes); i++)
+        {
+            bytes[i] = static_cast<uint8_t>(i * 13 + 5);
+        }
+
+        for (uint32_t n = 0; n < 5000; n++)
+        {
+            seed = seed * 1103515245 + 12345;
+            uint32_t value = seed ^ (seed >> 11);
+            uint8_t numBits = static_cast<uint8_t>(seed >> 27);
+
+            switch ((seed >> 8) % 8)
+            {
+            case 0:
+                bsw.write(static_cast<uint8_t>(value), static_cast<uint8_t>(numBits % 9));
+                break;
+            case 1:
+                bsw.write(static_cast<uint16_t>(value), static_cast<uint8_t>(numBits % 17));
+                break;
+            case 2:
+                bsw.write(value, static_cast<uint8_t>(numBits + 1));
+                break;
+            case 3:
+                bsw.write((static_cast<uint64_t>(value) << 29) ^ seed, static_cast<uint8_t>(numBits * 2 + 1));
+                break;
+            case 4:
+                bsw.write(static_cast<int32_t>(value), static_cast<uint8_t>(numBits % 24));
+                break;
+            case 5:
+                write(bsw, Plex<8>(value >> (numBits % 32)));
+                break;
+            case 6:
+                bsw.write(bytes, numBits);          // Byte run, not necessarily aligned
+                break;
+            default:
+                bsw.align();
+                bsw.write(bytes + 3, numBits);      // Aligned byte run
+                break;
+            }
+        }
+
+        bsw.align();
+    }
+
+    void TestMatchesGenericWriter()
+    {
+        std::stringstream genericStream(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
+        BitStreamWriterT<std::ostream> genericWriter(genericStream);
+        WriteFields(genericWriter);
+        std::string genericBytes = genericStream.str();
+
+        std::vector<char> vectorBytes;
+        BitStreamWriterT<std::vector<char> > vectorWriter(vectorBytes);
+        WriteFields(vectorWriter);
+
+        ASSERT_EQ(vectorBytes.size(), genericBytes.size());
+        EXPECT_TRUE(std::string(vectorBytes.begin(), vectorBytes.end()) == genericBytes);
+        EXPECT_EQ(vectorWriter.getBitCount(), genericWriter.getBitCount());
+    }
+
+    void TestWriteUnary()
+    {
+        const uint32_t counts[] = { 0, 1, 5, 30, 31, 32, 33, 63, 64, 65, 100, 1000 };
+
+        std::vector<char> unaryBytes;
+        BitStreamWriterT<std::vector<char> > unaryWriter(unaryBytes);
+
+        std::vector<char> referenceBytes;
+        BitStreamWriterT<std::vector<char> > referenceWriter(referenceBytes);
+
+        for (uint32_t n = 0; n < sizeof(counts) / sizeof(counts[0]); n++)
+        {
+            // Misalign, then write the unary code of counts[n]
+            unaryWriter.write(static_cast<uint8_t>(5), 3);
+            unaryWriter.writeUnary(counts[n]);
+
+            referenceWriter.write(static_cast<uint8_t>(5), 3);
+
+            for (uint32_t i = 0; i < counts[n]; i++)
+            {
+                referenceWriter.write(true);
+            }
+
+            referenceWriter.write(false);
+        }
+
+        EXPECT_EQ(unaryWriter.getBitCount(), referenceWriter.getBitCount());
+
+        unaryWriter.align();
+        referenceWriter.align();
+        EXPECT_TRUE(unaryBytes == referenceBytes);
+    }
+
+    void TestAppendAndPatch()
+    {
+        std::vector<char> bytes(3, 0x7F);
+        BitStreamWriterT<std::vector<char> > bsw(bytes);
+
+        bsw.write(static_cast<uint16_t>(0), 16);                    // Field to back-patch
+        bsw.write(static_cast<uint8_t>(1), 1);
+        EXPECT_EQ(bsw.getBitCount(), 17u);
+
+        bsw.align();
+        ASSERT_EQ(bytes.size(), 6u);
+        EXPECT_EQ(bytes[0], 0x7F);
+        EXPECT_EQ(static_cast<uint8_t>(bytes[5]), 0x80);
+
+        // Patch while aligned, then continue writing
+        bytes[3] = 0x12;
+        bytes[4] = 0x34;
+        bsw.write(static_cast<uint32_t>(0xABCDEF01), 32);
+        bsw.align();
+
+        const uint8_t expected[] = { 0x7F, 0x7F, 0x7F, 0x12, 0x34, 0x80, 0xAB, 0xCD, 0xEF, 0x01 };
+        ASSERT_EQ(bytes.size(), sizeof(expected));
+
+        for (uint32_t i = 0; i < sizeof(expected); i++)
+        {
+            EXPECT_EQ(static_cast<uint8_t>(bytes[i]), expected[i]);
+        }
+
+        // Widths beyond the value type are rejected
+        EXPECT_EQ(bsw.write(static_cast<uint8_t>(1), 9), CMNSTRM_PARAMS_BAD);
+        EXPECT_EQ(bsw.write(static_cast<uint32_t>(1), 33), CMNSTRM_PARAMS_BAD);
+        EXPECT_EQ(bsw.getBitCount(), 56u);
+    }
+};
+
+TEST_F(BitStreamWriterVector_Test, Matches_Generic_Writer)
+{
+    TestMatchesGenericWriter();
+}
+
+TEST_F(BitStreamWriterVector_Test, Write_Unary)
+{
+    TestWriteUnary();
+}
+
+TEST_F(BitStreamWriterVector_Test, Append_And_Patch)
+{
+    TestAppendAndPatch();
+}
@@ -34,6 +34,8 @@
 //
 //
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "commonstream/hash/CRC16.h"
 #include "commonstream/bitstream/BitStreamReaderT.h"
@@ -232,6 +234,117 @@ protected:
             outputStream.close();
         }
     }
+
+    // Bit serial reference of the CCITT CRC16 register update
+    static uint16_t ReferenceCRC(uint16_t iRegister, const uint8_t *iBytes, uint32_t iByteCount)
+    {
+        for (uint32_t n = 0; n < iByteCount; n++)
+        {
+            for (int i = 7; i >= 0; i--)
+            {
+                bool highBit = ((iRegister >> 15) != 0);
+                iRegister = static_cast<uint16_t>((iRegister << 1) | ((iBytes[n] >> i) & 1));
+
+                if (highBit)
+                {
+                    iRegister ^= 0x1021;
+                }
+            }
+        }
+
+        return iRegister;
+    }
+
+    static uint16_t GetRegister(CRC16Generator &iCRC)
+    {
+        uint16_t reg = 0;
+        iCRC.getCRCRegister(reinterpret_cast<uint8_t*>(&reg));
+        return reg;
+    }
+
+    void TestTableDrivenPaths()
+    {
+        std::vector<uint8_t> data(1021);
+        uint32_t seed = 7;
+
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            data[i] = static_cast<uint8_t>(seed >> 16);
+        }
+
+        // Byte run accumulation, for run lengths around the 8 byte slice
+        for (uint32_t length = 0; length < 40; length++)
+        {
+            CRC16Generator crc;
+            crc.start();
+            ASSERT_TRUE(crc.accumulate(&data[3], length));
+            EXPECT_EQ(GetRegister(crc), ReferenceCRC(0xFFFF, &data[3], length));
+        }
+
+        // Mixed bit widths, including sub-byte tails, must match the byte run result
+        CRC16Generator bulkCRC;
+        CRC16Generator mixedCRC;
+        bulkCRC.start();
+        mixedCRC.start();
+
+        ASSERT_TRUE(bulkCRC.accumulate(&data[0], static_cast<uint32_t>(data.size())));
+
+        size_t pos = 0;
+        while (pos + 8 <= data.size())
+        {
+            uint64_t word = 0;
+
+            for (size_t i = 0; i < 8; i++)
+            {
+                word = (word << 8) | data[pos + i];
+            }
+
+            uint8_t split = static_cast<uint8_t>((pos * 5) % 64);
+            if (split > 0)
+            {
+                mixedCRC.accumulate(static_cast<uint64_t>(word >> (64 - split)), split);
+            }
+
+            uint8_t rest = static_cast<uint8_t>(64 - split);
+            uint64_t low = (rest == 64) ? word : (word & ((static_cast<uint64_t>(1) << rest) - 1));
+
+            if (rest <= 32)
+            {
+                mixedCRC.accumulate(static_cast<uint32_t>(low), rest);
+            }
+            else
+            {
+                mixedCRC.accumulate(low, rest);
+            }
+
+            pos += 8;
+        }
+
+        for (; pos < data.size(); pos++)
+        {
+            mixedCRC.accumulate(static_cast<uint32_t>(data[pos] >> 3), 5);
+            mixedCRC.accumulate(static_cast<uint32_t>(data[pos] & 7), 3);
+        }
+
+        EXPECT_EQ(GetRegister(mixedCRC), GetRegister(bulkCRC));
+        EXPECT_EQ(GetRegister(bulkCRC), ReferenceCRC(0xFFFF, &data[0], static_cast<uint32_t>(data.size())));
+
+        // Known check value of the augmented CCITT CRC with 0xFFFF preset
+        CRC16Generator checkCRC;
+        const char *check = "123456789";
+        checkCRC.start();
+        checkCRC.accumulate(reinterpret_cast<const uint8_t*>(check), 9);
+        checkCRC.stop();
+        EXPECT_EQ(GetRegister(checkCRC), 0xE5CC);
+
+        // Paused and stopped generators leave the register alone
+        ASSERT_FALSE(checkCRC.accumulate(&data[0], 16));
+        checkCRC.start();
+        checkCRC.pause();
+        ASSERT_TRUE(checkCRC.accumulate(&data[0], 16));
+        EXPECT_EQ(GetRegister(checkCRC), 0xFFFF);
+    }
 };
 
 TEST_F(CRC16GeneratorTest, CRC16GeneratorTest_Case1)
@@ -240,3 +353,8 @@ TEST_F(CRC16GeneratorTest, CRC16GeneratorTest_Case1)
     TestRead();
     TestStateChanges();
 }
+
+TEST_F(CRC16GeneratorTest, CRC16GeneratorTest_TableDriven)
+{
+    TestTableDrivenPaths();
+}
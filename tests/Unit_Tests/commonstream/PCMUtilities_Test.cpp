@@ -0,0 +1,327 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "commonstream/utils/PCMUtilities.h"
+
+using namespace CommonStream;
+
+// PCMUtilities tests:
+// 1. FloatToInt32() scales, rounds and clips like the scalar conversion, for all sample positions
+// 2. FloatToInt32Dithered() keeps the quantization error within TPDF bounds, unbiased and reproducible
+// 3. Int32ToPCM16_LE(), Int32ToPCM24_LE() and Int32ToPCM32_LE() pack contiguous and interleaved samples
+// 4. PCM16_LEToInt32(), PCM24_LEToInt32() and the float variants unpack what the packing functions wrote
+
+namespace
+{
+    // Scalar reference conversion
+    int32_t ReferenceFloatToInt32(float iSample)
+    {
+        float sample = iSample * 2147483647.0f;
+
+        sample += (sample >= 0.0f) ? 0.5f : -0.5f;
+
+        if (sample >= 2147483648.0f)
+        {
+            return INT_MAX;
+        }
+        else if (sample < -2147483648.0f)
+        {
+            return INT_MIN;
+        }
+
+        return static_cast<int32_t>(sample);
+    }
+
+    // Pseudo random samples in [-iRange, iRange]
+    std::vector<float> RandomSamples(uint32_t iCount, float iRange, uint32_t iSeed)
+    {
+        std::vector<float> samples(iCount);
+
+        for (uint32_t i = 0; i < iCount; i++)
+        {
+            iSeed = iSeed * 1664525 + 1013904223;
+            samples[i] = (static_cast<float>(iSeed >> 8) / 8388608.0f - 1.0f) * iRange;
+        }
+
+        return samples;
+    }
+}
+
+TEST(PCMUtilities_Test, FloatToInt32_Matches_Reference)
+{
+    std::vector<float> samples = RandomSamples(1027, 1.5f, 7);
+
+    // Edge values, at vector and tail positions
+    const float edges[] = { 0.0f, -0.0f, 1.0f, -1.0f, 2.0f, -2.0f, 0.999999f, -0.999999f, 1e-10f, -1e-10f, 1e30f, -1e30f };
+
+    for (uint32_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+    {
+        samples[i] = edges[i];
+        samples[samples.size() - 1 - i] = edges[i];
+    }
+
+    std::vector<int> pcm(samples.size());
+    EXPECT_EQ(FloatToInt32(&pcm[0], &samples[0], static_cast<unsigned int>(samples.size())), KNoError);
+
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        ASSERT_EQ(pcm[i], ReferenceFloatToInt32(samples[i])) << "sample " << i << ": " << samples[i];
+    }
+
+    EXPECT_EQ(pcm[2], INT_MAX);
+    EXPECT_EQ(pcm[3], INT_MIN);
+    EXPECT_EQ(pcm[4], INT_MAX);
+    EXPECT_EQ(pcm[5], INT_MIN);
+}
+
+TEST(PCMUtilities_Test, FloatToInt32Dithered_Bounds)
+{
+    const uint32_t bitDepth = 24;
+    const uint32_t sampleCount = 65539;
+    const double lsb = 1.0 / (1 << (bitDepth - 1));
+
+    std::vector<float> samples = RandomSamples(sampleCount, 0.9f, 11);
+    std::vector<int> pcm(sampleCount);
+    std::vector<int> pcm2(sampleCount);
+    unsigned int ditherState[4];
+
+    InitDitherState(ditherState, 1);
+    EXPECT_EQ(FloatToInt32Dithered(&pcm[0], &samples[0], sampleCount, bitDepth, ditherState), KNoError);
+
+    double errorSum = 0.0;
+
+    for (uint32_t i = 0; i < sampleCount; i++)
+    {
+        // Quantized to 24 bits
+        ASSERT_EQ(pcm[i] & 0xFF, 0);
+
+        // Rounding and +/- 1 LSB of triangular dither
+        double error = (static_cast<double>(pcm[i]) / 2147483648.0 - samples[i]) / lsb;
+        ASSERT_LE(std::fabs(error), 1.5 + 1e-3) << "sample " << i;
+
+        errorSum += error;
+    }
+
+    EXPECT_LT(std::fabs(errorSum / sampleCount), 0.02);
+
+    // Same seed, same dither
+    InitDitherState(ditherState, 1);
+    FloatToInt32Dithered(&pcm2[0], &samples[0], sampleCount, bitDepth, ditherState);
+    EXPECT_TRUE(pcm == pcm2);
+
+    // Different seed, different dither
+    InitDitherState(ditherState, 2);
+    FloatToInt32Dithered(&pcm2[0], &samples[0], sampleCount, bitDepth, ditherState);
+    EXPECT_FALSE(pcm == pcm2);
+}
+
+TEST(PCMUtilities_Test, FloatToInt32Dithered_Silence_And_Clipping)
+{
+    const uint32_t bitDepth = 16;
+    const float input[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                            4.0f, 4.0f, 4.0f, 4.0f, 4.0f, -4.0f, -4.0f, -4.0f, -4.0f, -4.0f };
+    const uint32_t sampleCount = sizeof(input) / sizeof(input[0]);
+    int pcm[sampleCount];
+    unsigned int ditherState[4];
+
+    InitDitherState(ditherState, 3);
+    FloatToInt32Dithered(pcm, input, sampleCount, bitDepth, ditherState);
+
+    for (uint32_t i = 0; i < sampleCount; i++)
+    {
+        if (input[i] == 0.0f)
+        {
+            // Silence dithered by at most 1 LSB
+            EXPECT_LE(std::abs(pcm[i] >> 16), 1);
+            EXPECT_EQ(pcm[i] & 0xFFFF, 0);
+        }
+        else if (input[i] > 0.0f)
+        {
+            EXPECT_EQ(pcm[i], 0x7FFF0000);
+        }
+        else
+        {
+            EXPECT_EQ(pcm[i], INT_MIN);
+        }
+    }
+}
+
+TEST(PCMUtilities_Test, Int32ToPCM_LE_Packing)
+{
+    const uint32_t channelCount = 3;
+    const uint32_t sampleCount = 37;
+
+    std::vector<int> samples(channelCount * sampleCount);
+
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        samples[i] = static_cast<int>(0x9E3779B9u * static_cast<uint32_t>(i + 1));
+    }
+
+    for (uint32_t bytesPerSample = 2; bytesPerSample <= 4; bytesPerSample++)
+    {
+        // Contiguous, from each start position
+        for (uint32_t start = 0; start < 8; start++)
+        {
+            std::vector<char> packed(sampleCount * bytesPerSample + 1, 0x55);
+            uint32_t count = sampleCount - start;
+
+            switch (bytesPerSample)
+            {
+            case 2:
+                Int32ToPCM16_LE(&packed[0], &samples[start], count, bytesPerSample);
+                break;
+            case 3:
+                Int32ToPCM24_LE(&packed[0], &samples[start], count, bytesPerSample);
+                break;
+            default:
+                Int32ToPCM32_LE(&packed[0], &samples[start], count, bytesPerSample);
+                break;
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                uint32_t value = static_cast<uint32_t>(samples[start + i]);
+
+                for (uint32_t b = 0; b < bytesPerSample; b++)
+                {
+                    ASSERT_EQ(static_cast<unsigned char>(packed[i * bytesPerSample + b]),
+                              static_cast<unsigned char>(value >> (8 * (4 - bytesPerSample + b))));
+                }
+            }
+
+            // Nothing written past the last sample
+            EXPECT_EQ(packed[count * bytesPerSample], 0x55);
+        }
+
+        // Interleaved, one channel at a time
+        uint32_t blockAlign = channelCount * bytesPerSample;
+        std::vector<char> interleaved(sampleCount * blockAlign);
+
+        for (uint32_t ch = 0; ch < channelCount; ch++)
+        {
+            char *dest = &interleaved[ch * bytesPerSample];
+            const int *src = &samples[ch * sampleCount];
+
+            switch (bytesPerSample)
+            {
+            case 2:
+                Int32ToPCM16_LE(dest, src, sampleCount, blockAlign);
+                break;
+            case 3:
+                Int32ToPCM24_LE(dest, src, sampleCount, blockAlign);
+                break;
+            default:
+                Int32ToPCM32_LE(dest, src, sampleCount, blockAlign);
+                break;
+            }
+        }
+
+        for (uint32_t i = 0; i < sampleCount; i++)
+        {
+            for (uint32_t ch = 0; ch < channelCount; ch++)
+            {
+                uint32_t value = static_cast<uint32_t>(samples[ch * sampleCount + i]);
+
+                for (uint32_t b = 0; b < bytesPerSample; b++)
+                {
+                    ASSERT_EQ(static_cast<unsigned char>(interleaved[i * blockAlign + ch * bytesPerSample + b]),
+                              static_cast<unsigned char>(value >> (8 * (4 - bytesPerSample + b))));
+                }
+            }
+        }
+    }
+}
+
+TEST(PCMUtilities_Test, PCM_LE_Unpacking)
+{
+    const uint32_t sampleCount = 45;
+
+    std::vector<int> samples(sampleCount);
+
+    for (uint32_t i = 0; i < sampleCount; i++)
+    {
+        samples[i] = static_cast<int>(0x9E3779B9u * (i + 1));
+    }
+
+    samples[0] = INT_MIN;
+    samples[1] = INT_MAX;
+    samples[2] = 0;
+    samples[3] = -1;
+
+    for (uint32_t bytesPerSample = 2; bytesPerSample <= 3; bytesPerSample++)
+    {
+        const uint32_t mask = (bytesPerSample == 2) ? 0xFFFF0000 : 0xFFFFFF00;
+        std::vector<char> packed(sampleCount * bytesPerSample);
+
+        if (bytesPerSample == 2)
+        {
+            Int32ToPCM16_LE(&packed[0], &samples[0], sampleCount, bytesPerSample);
+        }
+        else
+        {
+            Int32ToPCM24_LE(&packed[0], &samples[0], sampleCount, bytesPerSample);
+        }
+
+        // All counts, so that the unpacked runs end at every position within a vector
+        for (uint32_t count = 1; count <= sampleCount; count++)
+        {
+            std::vector<int> unpacked(count + 1, 0x55555555);
+            std::vector<float> unpackedFloat(count + 1, 2.0f);
+
+            if (bytesPerSample == 2)
+            {
+                PCM16_LEToInt32(&unpacked[0], &packed[0], count);
+                PCM16_LEToFloat(&unpackedFloat[0], &packed[0], count);
+            }
+            else
+            {
+                PCM24_LEToInt32(&unpacked[0], &packed[0], count);
+                PCM24_LEToFloat(&unpackedFloat[0], &packed[0], count);
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                int expected = static_cast<int>(static_cast<uint32_t>(samples[i]) & mask);
+
+                ASSERT_EQ(unpacked[i], expected) << "count " << count << ", sample " << i;
+                ASSERT_EQ(unpackedFloat[i], static_cast<float>(expected) / 2147483647.0f) << "count " << count << ", sample " << i;
+            }
+
+            EXPECT_EQ(unpacked[count], 0x55555555);
+            EXPECT_EQ(unpackedFloat[count], 2.0f);
+        }
+    }
+}
@@ -0,0 +1,322 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "waveutils/WAVMappedReader.h"
+#include "waveutils/WAVStreamWriter.h"
+
+// WAVMappedReader tests:
+// 1. Mono 24-bit file read in blocks of all sizes, as samples and as views in the mapping
+// 2. Channels of interleaved 16- and 32-bit files
+// 3. RF64 file, sizes from the ds64 chunk
+// 4. Sequential reads with a small prefetch distance release pages behind, and re-reading still works
+// 5. Files that are not integer PCM wav rejected
+
+class WAVMappedReader_Test : public testing::Test {
+
+protected:
+
+    virtual void SetUp()
+    {
+        fileName_ = std::string("WAVMappedReader_Test_") + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".wav";
+    }
+
+    virtual void TearDown()
+    {
+        std::remove(fileName_.c_str());
+    }
+
+    // Sample of channel iChannel at frame iFrame
+    static int32_t TestSample(uint32_t iChannel, uint32_t iFrame)
+    {
+        return static_cast<int32_t>((iFrame + 1) * 2654435761u + iChannel * 40503u);
+    }
+
+    // Writes fileName_ with WAVStreamWriter, iChannelCount interleaved channels of iSampleCount samples
+    void WriteFile(uint32_t iChannelCount, uint32_t iBytesPerSample, uint32_t iSampleCount)
+    {
+        std::vector< std::vector<int32_t> > samples(iChannelCount, std::vector<int32_t>(iSampleCount));
+        std::vector<const int32_t*> pointers(iChannelCount);
+
+        for (uint32_t ch = 0; ch < iChannelCount; ch++)
+        {
+            for (uint32_t i = 0; i < iSampleCount; i++)
+            {
+                samples[ch][i] = TestSample(ch, i);
+            }
+
+            pointers[ch] = &samples[ch][0];
+        }
+
+        WAVStreamWriter writer;
+        std::vector<std::string> fileNames(1, fileName_);
+
+        ASSERT_EQ(writer.open(fileNames, WAVStreamWriter::kInterleavedFile, iChannelCount, 96000, iBytesPerSample), 0);
+        ASSERT_EQ(writer.writeSamples(&pointers[0], iSampleCount), 0);
+        ASSERT_EQ(writer.close(), 0);
+    }
+
+    // Checks samples read against the samples written, masked to the file sample width
+    static void CheckSamples(const int32_t *iSamples, uint32_t iChannel, uint32_t iFirstFrame, uint32_t iCount, uint32_t iBytesPerSample)
+    {
+        uint32_t mask = 0xFFFFFFFF << (8 * (4 - iBytesPerSample));
+
+        for (uint32_t i = 0; i < iCount; i++)
+        {
+            ASSERT_EQ(iSamples[i], static_cast<int32_t>(static_cast<uint32_t>(TestSample(iChannel, iFirstFrame + i)) & mask))
+                << "channel " << iChannel << ", frame " << (iFirstFrame + i);
+        }
+    }
+
+    void TestMono24()
+    {
+        const uint32_t sampleCount = 1001;
+
+        WriteFile(1, 3, sampleCount);
+
+        WAVMappedReader reader;
+        ASSERT_EQ(reader.open(fileName_), 0);
+        EXPECT_EQ(reader.getChannelCount(), 1u);
+        EXPECT_EQ(reader.getSampleRate(), 96000u);
+        EXPECT_EQ(reader.getBytesPerSample(), 3u);
+        EXPECT_EQ(reader.getSampleCount(), static_cast<uint64_t>(sampleCount));
+
+        std::vector<int32_t> samples(sampleCount + 10);
+
+        // Blocks of all sizes up to 17, from each start position, with the last block cut short by the end of the file
+        for (uint32_t blockSize = 1; blockSize <= 17; blockSize++)
+        {
+            uint32_t frame = 0;
+
+            while (frame < sampleCount)
+            {
+                uint32_t expected = (sampleCount - frame < blockSize) ? (sampleCount - frame) : blockSize;
+
+                ASSERT_EQ(reader.readSamples(0, frame, &samples[0], blockSize), expected);
+                CheckSamples(&samples[0], 0, frame, expected, 3);
+
+                frame += expected;
+            }
+        }
+
+        EXPECT_EQ(reader.readSamples(0, sampleCount, &samples[0], 10), 0u);
+        EXPECT_EQ(reader.readSamples(1, 0, &samples[0], 10), 0u);
+
+        // Views of the little-endian samples in the mapping
+        uint32_t frameCount = 0;
+        const char *frames = reader.getFrames(995, 10, frameCount);
+
+        ASSERT_TRUE(frames != NULL);
+        EXPECT_EQ(frameCount, 6u);
+
+        for (uint32_t i = 0; i < frameCount; i++)
+        {
+            uint32_t value = static_cast<uint32_t>(TestSample(0, 995 + i));
+
+            EXPECT_EQ(static_cast<unsigned char>(frames[i * 3]), static_cast<unsigned char>(value >> 8));
+            EXPECT_EQ(static_cast<unsigned char>(frames[i * 3 + 1]), static_cast<unsigned char>(value >> 16));
+            EXPECT_EQ(static_cast<unsigned char>(frames[i * 3 + 2]), static_cast<unsigned char>(value >> 24));
+        }
+
+        EXPECT_TRUE(reader.getFrames(sampleCount, 1, frameCount) == NULL);
+        EXPECT_EQ(frameCount, 0u);
+    }
+
+    void TestInterleaved(uint32_t iBytesPerSample)
+    {
+        const uint32_t channelCount = 3;
+        const uint32_t sampleCount = 257;
+
+        WriteFile(channelCount, iBytesPerSample, sampleCount);
+
+        WAVMappedReader reader;
+        ASSERT_EQ(reader.open(fileName_), 0);
+        EXPECT_EQ(reader.getChannelCount(), channelCount);
+        EXPECT_EQ(reader.getBytesPerSample(), iBytesPerSample);
+        EXPECT_EQ(reader.getSampleCount(), static_cast<uint64_t>(sampleCount));
+
+        std::vector<int32_t> samples(sampleCount);
+
+        for (uint32_t ch = 0; ch < channelCount; ch++)
+        {
+            ASSERT_EQ(reader.readSamples(ch, 0, &samples[0], sampleCount), sampleCount);
+            CheckSamples(&samples[0], ch, 0, sampleCount, iBytesPerSample);
+
+            ASSERT_EQ(reader.readSamples(ch, 100, &samples[0], 50), 50u);
+            CheckSamples(&samples[0], ch, 100, 50, iBytesPerSample);
+        }
+    }
+
+    void TestRF64()
+    {
+        const uint32_t sampleCount = 500;
+
+        WAVFile wav;
+        wav.pFile = new std::fstream(fileName_.c_str(), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+        wav.is_RF64 = true;
+
+        wav.header.fmtChunkSize = WAV_FMT_CHUNKSIZE;
+        wav.header.wFormatTag = WAVE_FORMAT_PCM;
+        wav.header.nChannels = MONO_CHANNEL;
+        wav.header.nSamplePerSec = 48000;
+        wav.header.nAvgBytesPerSec = 48000 * BITWIDTH_3BYTES;
+        wav.header.nBlockAlign = BITWIDTH_3BYTES;
+        wav.header.nBitsPerSample = BITWIDTH_3BYTES * 8;
+
+        wav.writeWavHeader();
+
+        std::vector<int> samples(sampleCount);
+
+        for (uint32_t i = 0; i < sampleCount; i++)
+        {
+            samples[i] = TestSample(0, i);
+        }
+
+        int *data[1] = { &samples[0] };
+        EXPECT_EQ(wav.writeSamplesToFile(1, data, static_cast<int>(sampleCount)), 0);
+
+        wav.setDataSize(static_cast<long long>(sampleCount) * BITWIDTH_3BYTES);
+        EXPECT_EQ(wav.updateHeader(), 0);
+
+        wav.pFile->close();
+        delete wav.pFile;
+
+        WAVMappedReader reader;
+        ASSERT_EQ(reader.open(fileName_), 0);
+        EXPECT_EQ(reader.getSampleCount(), static_cast<uint64_t>(sampleCount));
+
+        std::vector<int32_t> readSamples(sampleCount);
+        ASSERT_EQ(reader.readSamples(0, 0, &readSamples[0], sampleCount), sampleCount);
+        CheckSamples(&readSamples[0], 0, 0, sampleCount, 3);
+    }
+
+    void TestPrefetchAndRelease()
+    {
+        // 96000 samples, 288000 bytes, with a prefetch distance of 2 pages
+        const uint32_t sampleCount = 96000;
+        const uint32_t frameSize = 2000;
+
+        WriteFile(1, 3, sampleCount);
+
+        WAVMappedReader reader;
+        reader.setPrefetchSize(8192);
+        ASSERT_EQ(reader.open(fileName_), 0);
+
+        std::vector<int32_t> samples(frameSize);
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (uint32_t frame = 0; frame < sampleCount; frame += frameSize)
+            {
+                ASSERT_EQ(reader.readSamples(0, frame, &samples[0], frameSize), frameSize);
+                CheckSamples(&samples[0], 0, frame, frameSize, 3);
+            }
+        }
+
+        // Random access
+        ASSERT_EQ(reader.readSamples(0, 12345, &samples[0], frameSize), frameSize);
+        CheckSamples(&samples[0], 0, 12345, frameSize, 3);
+    }
+
+    void TestRejected()
+    {
+        WAVMappedReader reader;
+
+        EXPECT_NE(reader.open("WAVMappedReader_Test_missing.wav"), 0);
+        EXPECT_FALSE(reader.isOpen());
+
+        // Not a wav file
+        {
+            std::ofstream file(fileName_.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+            file << "This is not a wav file, but long enough to hold a header.";
+        }
+
+        EXPECT_NE(reader.open(fileName_), 0);
+
+        // 32-bit float wav file
+        WriteFile(1, 4, 100);
+
+        {
+            std::fstream file(fileName_.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+            std::vector<char> bytes(4096);
+            file.read(&bytes[0], bytes.size());
+
+            size_t fmtOffset = std::search(bytes.begin(), bytes.end(), "fmt ", "fmt " + 4) - bytes.begin();
+            ASSERT_LT(fmtOffset, bytes.size());
+
+            // WAVE_FORMAT_IEEE_FLOAT
+            file.clear();
+            file.seekp(fmtOffset + 8);
+            file.put(3);
+            file.put(0);
+        }
+
+        EXPECT_NE(reader.open(fileName_), 0);
+        EXPECT_FALSE(reader.isOpen());
+    }
+
+    std::string fileName_;
+};
+
+TEST_F(WAVMappedReader_Test, Mono_24Bit)
+{
+    TestMono24();
+}
+
+TEST_F(WAVMappedReader_Test, Interleaved_16Bit)
+{
+    TestInterleaved(2);
+}
+
+TEST_F(WAVMappedReader_Test, Interleaved_32Bit)
+{
+    TestInterleaved(4);
+}
+
+TEST_F(WAVMappedReader_Test, RF64)
+{
+    TestRF64();
+}
+
+TEST_F(WAVMappedReader_Test, Prefetch_And_Release)
+{
+    TestPrefetchAndRelease();
+}
+
+TEST_F(WAVMappedReader_Test, Rejected_Files)
+{
+    TestRejected();
+}
@@ -0,0 +1,311 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "waveutils/WAVStreamWriter.h"
+
+// WAVStreamWriter tests:
+// 1. Interleaved file, sample widths of 2, 3 and 4 bytes, buffers smaller than a write
+// 2. Per-channel files, data matching the interleaved file channel by channel
+// 3. Header size fields patched at the update interval and at close
+// 4. Invalid open parameters
+// 5. JUNK chunk reserved for ds64 by default, plain RIFF header with kLargeFileNone
+
+class WAVStreamWriter_Test : public testing::Test {
+
+protected:
+
+    virtual void SetUp()
+    {
+        channelCount_ = 5;
+        sampleCount_ = 1000;
+
+        samples_.resize(channelCount_);
+        pointers_.resize(channelCount_);
+
+        uint32_t seed = 99;
+
+        for (uint32_t c = 0; c < channelCount_; c++)
+        {
+            samples_[c].resize(sampleCount_);
+
+            for (uint32_t i = 0; i < sampleCount_; i++)
+            {
+                seed = seed * 1103515245 + 12345;
+                samples_[c][i] = static_cast<int32_t>(seed);
+            }
+
+            pointers_[c] = &samples_[c][0];
+        }
+    }
+
+    virtual void TearDown()
+    {
+        for (size_t i = 0; i < createdFiles_.size(); i++)
+        {
+            std::remove(createdFiles_[i].c_str());
+        }
+    }
+
+    std::string FileName(const std::string &iName)
+    {
+        createdFiles_.push_back(iName);
+        return iName;
+    }
+
+    static std::vector<char> ReadFile(const std::string &iFileName)
+    {
+        std::ifstream file(iFileName.c_str(), std::ios::in | std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    static uint32_t ReadUInt32(const std::vector<char> &iBytes, size_t iOffset)
+    {
+        const unsigned char *p = reinterpret_cast<const unsigned char*>(&iBytes[iOffset]);
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    // Offset of the data chunk size field, with or without a JUNK chunk reserved for ds64
+    static size_t DataSizeOffset(bool iReserveDs64)
+    {
+        return WAV_DATA_CHUNKSIZE_OFFSET + (iReserveDs64 ? (8 + WAV_DS64_CHUNKSIZE) : 0);
+    }
+
+    // Checks the header of a closed file and returns its sample data
+    static std::vector<char> CheckHeaderAndGetData(const std::vector<char> &iBytes, uint32_t iChannels, uint32_t iBytesPerSample,
+                                                   bool iReserveDs64 = true)
+    {
+        const size_t dataSizeOffset = DataSizeOffset(iReserveDs64);
+        const size_t dataStart = dataSizeOffset + 4;
+
+        EXPECT_GE(iBytes.size(), dataStart);
+
+        if (iBytes.size() < dataStart)
+        {
+            return std::vector<char>();
+        }
+
+        EXPECT_EQ(std::string(&iBytes[0], 4), "RIFF");
+        EXPECT_EQ(ReadUInt32(iBytes, WAV_FILE_CHUNKSIZE_OFFSET), iBytes.size() - 8);
+        EXPECT_EQ(std::string(&iBytes[12], 4), iReserveDs64 ? "JUNK" : "bext");
+        EXPECT_EQ(std::string(&iBytes[dataSizeOffset - 4], 4), "data");
+        EXPECT_EQ(ReadUInt32(iBytes, dataSizeOffset), iBytes.size() - dataStart);
+
+        // fmt chunk follows the bext chunk
+        size_t fmtOffset = dataSizeOffset - 4 - WAV_FMT_CHUNKSIZE;
+        EXPECT_EQ(static_cast<uint8_t>(iBytes[fmtOffset + 2]), iChannels);
+        EXPECT_EQ(static_cast<uint8_t>(iBytes[fmtOffset + 12]), iChannels * iBytesPerSample);
+        EXPECT_EQ(static_cast<uint8_t>(iBytes[fmtOffset + 14]), iBytesPerSample * 8);
+
+        return std::vector<char>(iBytes.begin() + dataStart, iBytes.end());
+    }
+
+    // Expected little-endian bytes of a sample
+    static void AppendSample(std::vector<char> &oBytes, int32_t iSample, uint32_t iBytesPerSample)
+    {
+        for (uint32_t b = 4 - iBytesPerSample; b < 4; b++)
+        {
+            oBytes.push_back(static_cast<char>(static_cast<uint32_t>(iSample) >> (8 * b)));
+        }
+    }
+
+    void TestInterleaved()
+    {
+        for (uint32_t bytesPerSample = 2; bytesPerSample <= 4; bytesPerSample++)
+        {
+            std::vector<std::string> fileNames(1, FileName("WAVStreamWriter_Test_interleaved.wav"));
+
+            WAVStreamWriter writer;
+            writer.setBufferSize(1000);        // Not a multiple of the sample frame size, smaller than a write
+
+            if (bytesPerSample == 2)
+            {
+                writer.setLargeFileFormat(WAVStreamWriter::kLargeFileNone);
+            }
+
+            ASSERT_EQ(writer.open(fileNames, WAVStreamWriter::kInterleavedFile, channelCount_, 48000, bytesPerSample), 0);
+
+            // Write in chunks of different size
+            const int32_t *chunkPointers[5];
+            uint32_t offset = 0;
+            uint32_t chunk = 1;
+
+            while (offset < sampleCount_)
+            {
+                uint32_t count = std::min(chunk, sampleCount_ - offset);
+
+                for (uint32_t c = 0; c < channelCount_; c++)
+                {
+                    chunkPointers[c] = pointers_[c] + offset;
+                }
+
+                ASSERT_EQ(writer.writeSamples(chunkPointers, count), 0);
+
+                offset += count;
+                chunk = chunk * 3 + 1;
+            }
+
+            EXPECT_EQ(writer.getSampleCount(), sampleCount_);
+            ASSERT_EQ(writer.close(), 0);
+            EXPECT_FALSE(writer.isOpen());
+
+            std::vector<char> expected;
+
+            for (uint32_t i = 0; i < sampleCount_; i++)
+            {
+                for (uint32_t c = 0; c < channelCount_; c++)
+                {
+                    AppendSample(expected, samples_[c][i], bytesPerSample);
+                }
+            }
+
+            std::vector<char> data = CheckHeaderAndGetData(ReadFile(fileNames[0]), channelCount_, bytesPerSample, bytesPerSample != 2);
+            EXPECT_TRUE(data == expected);
+        }
+    }
+
+    void TestPerChannel()
+    {
+        std::vector<std::string> fileNames;
+
+        for (uint32_t c = 0; c < channelCount_; c++)
+        {
+            fileNames.push_back(FileName("WAVStreamWriter_Test_channel" + std::to_string(c) + ".wav"));
+        }
+
+        WAVStreamWriter writer;
+        writer.setBufferSize(256);
+
+        ASSERT_EQ(writer.open(fileNames, WAVStreamWriter::kPerChannelFiles, channelCount_, 96000, 3), 0);
+        ASSERT_EQ(writer.writeSamples(&pointers_[0], sampleCount_), 0);
+        ASSERT_EQ(writer.close(), 0);
+
+        for (uint32_t c = 0; c < channelCount_; c++)
+        {
+            std::vector<char> expected;
+
+            for (uint32_t i = 0; i < sampleCount_; i++)
+            {
+                AppendSample(expected, samples_[c][i], 3);
+            }
+
+            std::vector<char> data = CheckHeaderAndGetData(ReadFile(fileNames[c]), 1, 3);
+            EXPECT_TRUE(data == expected);
+        }
+    }
+
+    void TestHeaderUpdates()
+    {
+        std::vector<std::string> fileNames(1, FileName("WAVStreamWriter_Test_header.wav"));
+
+        WAVStreamWriter writer;
+        writer.setHeaderUpdateInterval(300);
+
+        ASSERT_EQ(writer.open(fileNames, WAVStreamWriter::kInterleavedFile, channelCount_, 48000, 3), 0);
+
+        // Header not patched below the interval, samples still buffered
+        ASSERT_EQ(writer.writeSamples(&pointers_[0], 200), 0);
+        std::vector<char> bytes = ReadFile(fileNames[0]);
+        ASSERT_EQ(bytes.size(), DataSizeOffset(true) + 4);
+        EXPECT_EQ(ReadUInt32(bytes, DataSizeOffset(true)), 0u);
+        EXPECT_EQ(ReadUInt32(bytes, WAV_FILE_CHUNKSIZE_OFFSET), bytes.size() - 8);
+
+        // Interval reached, file flushed and header valid
+        ASSERT_EQ(writer.writeSamples(&pointers_[0], 100), 0);
+        CheckHeaderAndGetData(ReadFile(fileNames[0]), channelCount_, 3);
+        EXPECT_EQ(ReadFile(fileNames[0]).size(), DataSizeOffset(true) + 4 + 300 * channelCount_ * 3);
+
+        // Writing continues after the header patch
+        ASSERT_EQ(writer.writeSamples(&pointers_[0], 50), 0);
+        ASSERT_EQ(writer.close(), 0);
+
+        std::vector<char> data = CheckHeaderAndGetData(ReadFile(fileNames[0]), channelCount_, 3);
+        ASSERT_EQ(data.size(), static_cast<size_t>(350 * channelCount_ * 3));
+
+        std::vector<char> expected;
+
+        for (uint32_t i = 0; i < 50; i++)
+        {
+            for (uint32_t c = 0; c < channelCount_; c++)
+            {
+                AppendSample(expected, samples_[c][i], 3);
+            }
+        }
+
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), data.begin() + 300 * channelCount_ * 3));
+    }
+
+    void TestInvalidParameters()
+    {
+        WAVStreamWriter writer;
+        std::vector<std::string> oneFile(1, FileName("WAVStreamWriter_Test_invalid.wav"));
+
+        EXPECT_EQ(writer.writeSamples(&pointers_[0], 10), 1);
+        EXPECT_EQ(writer.open(oneFile, WAVStreamWriter::kInterleavedFile, 0, 48000, 3), 1);
+        EXPECT_EQ(writer.open(oneFile, WAVStreamWriter::kInterleavedFile, 2, 48000, 1), 1);
+        EXPECT_EQ(writer.open(oneFile, WAVStreamWriter::kPerChannelFiles, 2, 48000, 3), 1);
+        EXPECT_FALSE(writer.isOpen());
+
+        std::vector<std::string> badPath(1, "WAVStreamWriter_Test_no_such_dir/out.wav");
+        EXPECT_EQ(writer.open(badPath, WAVStreamWriter::kInterleavedFile, 2, 48000, 3), 1);
+        EXPECT_FALSE(writer.isOpen());
+        EXPECT_EQ(writer.close(), 0);
+    }
+
+    uint32_t channelCount_;
+    uint32_t sampleCount_;
+    std::vector<std::vector<int32_t> > samples_;
+    std::vector<const int32_t*> pointers_;
+    std::vector<std::string> createdFiles_;
+};
+
+TEST_F(WAVStreamWriter_Test, Interleaved_File)
+{
+    TestInterleaved();
+}
+
+TEST_F(WAVStreamWriter_Test, Per_Channel_Files)
+{
+    TestPerChannel();
+}
+
+TEST_F(WAVStreamWriter_Test, Header_Updates)
+{
+    TestHeaderUpdates();
+}
+
+TEST_F(WAVStreamWriter_Test, Invalid_Parameters)
+{
+    TestInvalidParameters();
+}
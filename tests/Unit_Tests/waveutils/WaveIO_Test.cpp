@@ -0,0 +1,224 @@
+/*======================================================================*
+    Copyright (c) 2015-2023 DTS, Inc. and its affiliates.
+
+    Redistribution and use in source and binary forms, with or without modification,
+    are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+    list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+    this list of conditions and the following disclaimer in the documentation
+    and/or other materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its contributors
+    may be used to endorse or promote products derived from this software without
+    specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+    ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *======================================================================*/
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "waveutils/WaveIO.h"
+
+// WAVFile RF64/BW64 tests:
+// 1. RIFF file with space reserved for ds64 stays RIFF, and is read back
+// 2. Header switched to RF64 and BW64 when sizes exceed the RIFF limit, and 64-bit sizes read back
+// 3. Sizes beyond the RIFF limit rejected without reserved ds64 space
+// 4. File written as RF64 from the start read back
+
+class WaveIO_Test : public testing::Test {
+
+protected:
+
+    virtual void SetUp()
+    {
+        fileName_ = std::string("WaveIO_Test_") + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".wav";
+        sampleCount_ = 1000;
+
+        for (uint32_t i = 0; i < sampleCount_; i++)
+        {
+            samples_.push_back(static_cast<int32_t>((i * 2654435761u) & 0xFFFFFF00));
+        }
+    }
+
+    virtual void TearDown()
+    {
+        std::remove(fileName_.c_str());
+    }
+
+    // Creates fileName_ as a mono 24-bit file holding samples_, with header sizes set to iDataSize
+    int WriteFile(bool iReserveDs64, bool iRF64, bool iBW64, long long iDataSize)
+    {
+        WAVFile wav;
+        wav.pFile = new std::fstream(fileName_.c_str(), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+        wav.reserve_ds64 = iReserveDs64;
+        wav.is_RF64 = iRF64;
+        wav.is_BW64 = iBW64;
+
+        wav.header.fmtChunkSize = WAV_FMT_CHUNKSIZE;
+        wav.header.wFormatTag = WAVE_FORMAT_PCM;
+        wav.header.nChannels = MONO_CHANNEL;
+        wav.header.nSamplePerSec = 48000;
+        wav.header.nAvgBytesPerSec = 48000 * BITWIDTH_3BYTES;
+        wav.header.nBlockAlign = BITWIDTH_3BYTES;
+        wav.header.nBitsPerSample = BITWIDTH_3BYTES * 8;
+
+        wav.writeWavHeader();
+
+        std::vector<int> samples(samples_.begin(), samples_.end());
+        int *data[1] = { &samples[0] };
+        EXPECT_EQ(wav.writeSamplesToFile(1, data, static_cast<int>(sampleCount_)), 0);
+
+        wav.setDataSize(iDataSize);
+        int error = wav.updateHeader();
+
+        dataChunkOffset_ = wav.dataChunkOffset;
+
+        wav.pFile->close();
+        delete wav.pFile;
+
+        return error;
+    }
+
+    // Reads fileName_, returns the sample count from its header and checks the samples
+    long long ReadFile()
+    {
+        WAVFile wav;
+        wav.pFile = new std::fstream(fileName_.c_str(), std::ios::in | std::ios::binary);
+
+        long long totalSamples = wav.readWavHeader();
+
+        std::vector<int> samples(sampleCount_);
+        EXPECT_EQ(wav.readWavSamplesFromFile(1, &samples[0], static_cast<int>(sampleCount_)), static_cast<int>(sampleCount_));
+
+        for (uint32_t i = 0; i < sampleCount_; i++)
+        {
+            EXPECT_EQ(samples[i], samples_[i]);
+        }
+
+        wav.pFile->close();
+        delete wav.pFile;
+
+        return totalSamples;
+    }
+
+    std::vector<unsigned char> ReadHeaderBytes()
+    {
+        std::ifstream file(fileName_.c_str(), std::ios::in | std::ios::binary);
+        std::vector<unsigned char> bytes(static_cast<size_t>(dataChunkOffset_));
+        file.read(reinterpret_cast<char*>(&bytes[0]), bytes.size());
+        return bytes;
+    }
+
+    static uint64_t ReadLE(const std::vector<unsigned char> &iBytes, size_t iOffset, uint32_t iSize)
+    {
+        uint64_t value = 0;
+
+        for (uint32_t i = 0; i < iSize; i++)
+        {
+            value |= static_cast<uint64_t>(iBytes[iOffset + i]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    void TestReservedRIFF()
+    {
+        ASSERT_EQ(WriteFile(true, false, false, sampleCount_ * 3), 0);
+
+        std::vector<unsigned char> header = ReadHeaderBytes();
+        EXPECT_EQ(std::string(header.begin(), header.begin() + 4), "RIFF");
+        EXPECT_EQ(std::string(header.begin() + 12, header.begin() + 16), "JUNK");
+        EXPECT_EQ(ReadLE(header, WAV_FILE_CHUNKSIZE_OFFSET, 4), dataChunkOffset_ - 8 + sampleCount_ * 3);
+        EXPECT_EQ(dataChunkOffset_, WAV_DATA_CHUNKSIZE_OFFSET + 4 + 8 + WAV_DS64_CHUNKSIZE);
+
+        EXPECT_EQ(ReadFile(), static_cast<long long>(sampleCount_));
+    }
+
+    void TestSwitchTo64Bit()
+    {
+        // Size fields beyond the RIFF limit. Only the first samples are present in the file.
+        const long long largeSampleCount = 1500000000LL;
+        const long long largeDataSize = largeSampleCount * 3;
+
+        for (int bw64 = 0; bw64 < 2; bw64++)
+        {
+            ASSERT_EQ(WriteFile(true, false, bw64 != 0, largeDataSize), 0);
+
+            std::vector<unsigned char> header = ReadHeaderBytes();
+            EXPECT_EQ(std::string(header.begin(), header.begin() + 4), bw64 ? "BW64" : "RF64");
+            EXPECT_EQ(ReadLE(header, WAV_FILE_CHUNKSIZE_OFFSET, 4), 0xFFFFFFFFu);
+            EXPECT_EQ(std::string(header.begin() + WAV_DS64_CHUNK_OFFSET, header.begin() + WAV_DS64_CHUNK_OFFSET + 4), "ds64");
+            EXPECT_EQ(ReadLE(header, WAV_DS64_FILESIZE_OFFSET, 8), static_cast<uint64_t>(dataChunkOffset_ - 8 + largeDataSize));
+            EXPECT_EQ(ReadLE(header, WAV_DS64_DATACHUNK_OFFSET, 8), static_cast<uint64_t>(largeDataSize));
+            EXPECT_EQ(ReadLE(header, WAV_DS64_SAMPLECOUNT_OFFSET, 8), static_cast<uint64_t>(largeSampleCount));
+            EXPECT_EQ(ReadLE(header, static_cast<size_t>(dataChunkOffset_ - 4), 4), 0xFFFFFFFFu);
+
+            EXPECT_EQ(ReadFile(), largeSampleCount);
+        }
+
+        // Sample count beyond the int range, about 9 GB of mono 24-bit samples
+        const long long hugeSampleCount = 3000000000LL;
+        ASSERT_EQ(WriteFile(true, false, false, hugeSampleCount * 3), 0);
+        EXPECT_EQ(ReadLE(ReadHeaderBytes(), WAV_DS64_SAMPLECOUNT_OFFSET, 8), static_cast<uint64_t>(hugeSampleCount));
+        EXPECT_EQ(ReadFile(), hugeSampleCount);
+    }
+
+    void TestLimitWithoutReserve()
+    {
+        EXPECT_EQ(WriteFile(false, false, false, 5000000000LL), 1);
+        EXPECT_EQ(WriteFile(false, false, false, sampleCount_ * 3), 0);
+        EXPECT_EQ(ReadFile(), static_cast<long long>(sampleCount_));
+    }
+
+    void TestRF64FromStart()
+    {
+        ASSERT_EQ(WriteFile(false, true, false, sampleCount_ * 3), 0);
+
+        std::vector<unsigned char> header = ReadHeaderBytes();
+        EXPECT_EQ(std::string(header.begin(), header.begin() + 4), "RF64");
+        EXPECT_EQ(ReadLE(header, WAV_DS64_DATACHUNK_OFFSET, 8), sampleCount_ * 3);
+
+        EXPECT_EQ(ReadFile(), static_cast<long long>(sampleCount_));
+    }
+
+    std::string fileName_;
+    uint32_t sampleCount_;
+    std::vector<int32_t> samples_;
+    long long dataChunkOffset_;
+};
+
+TEST_F(WaveIO_Test, Reserved_RIFF)
+{
+    TestReservedRIFF();
+}
+
+TEST_F(WaveIO_Test, Switch_To_64Bit)
+{
+    TestSwitchTo64Bit();
+}
+
+TEST_F(WaveIO_Test, Limit_Without_Reserve)
+{
+    TestLimitWithoutReserve();
+}
+
+TEST_F(WaveIO_Test, RF64_From_Start)
+{
+    TestRF64FromStart();
+}